@@ -0,0 +1,46 @@
+# Generates a C++ source that embeds GLSL files as null-terminated byte arrays.
+#
+# Usage: cmake -DOUTPUT=<file.cpp> -DSHADERS=<a.vert;b.frag;...> -P EmbedShaders.cmake
+# Each shader is registered under its file name (e.g. "shader2d.vert").
+
+if (NOT OUTPUT OR NOT SHADERS)
+  message(FATAL_ERROR "EmbedShaders.cmake needs OUTPUT and SHADERS")
+endif()
+
+set(arrays "")
+set(entries "")
+set(index 0)
+foreach(shader IN LISTS SHADERS)
+  get_filename_component(name "${shader}" NAME)
+  file(READ "${shader}" bytes HEX)
+
+  # Bytes as 0x.., literals, 16 per line, plus the terminator
+  string(LENGTH "${bytes}" length)
+  set(lines "")
+  set(offset 0)
+  while(offset LESS length)
+    string(SUBSTRING "${bytes}" ${offset} 32 line)
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1, " line "${line}")
+    string(STRIP "${line}" line)
+    string(APPEND lines "        ${line}\n")
+    math(EXPR offset "${offset} + 32")
+  endwhile()
+  string(APPEND arrays "    // ${name}\n    const char kShader${index}[] = {\n${lines}        0x00\n    };\n\n")
+  string(APPEND entries "    { \"${name}\", kShader${index} },\n")
+  math(EXPR index "${index} + 1")
+endforeach()
+
+set(content "// Generated by cmake/EmbedShaders.cmake from shaders/. Do not edit.\n\n")
+string(APPEND content "#include \"utils/embeddedShaders.h\"\n\n")
+string(APPEND content "namespace {\n\n${arrays}}\n\n")
+string(APPEND content "const EmbeddedShader kEmbeddedShaders[] = {\n${entries}};\n\n")
+string(APPEND content "const size_t kEmbeddedShaderCount = sizeof(kEmbeddedShaders) / sizeof(kEmbeddedShaders[0]);\n")
+
+# Rewrite only on change so dependants are not rebuilt needlessly
+if (EXISTS "${OUTPUT}")
+  file(READ "${OUTPUT}" previous)
+  if (previous STREQUAL content)
+    return()
+  endif()
+endif()
+file(WRITE "${OUTPUT}" "${content}")
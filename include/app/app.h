@@ -1,14 +1,18 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 struct GLFWwindow;
 
-namespace core { class Simulation; class OrbitCamera; }
-namespace render { class Renderer2D; class Renderer3D; }
-namespace ui { struct ToolbarState; struct ToolbarActions; }
-namespace app { struct InputState; }
+namespace core { class Simulation; class SimulationScheduler; class OrbitCamera; class Life; class Life3D; }
+namespace render { class Renderer2D; class Renderer3D; class VoxelRenderer; class FrameExporter; }
+namespace ui { struct ToolbarState; struct ToolbarActions; struct ProfilerOverlayState; }
+namespace utils { class GpuTimer; }
+namespace app { struct InputState; struct CompareView; }
+namespace io { class AsyncPatternIo; class Autosaver; class Recorder; class Player; class SharedGridPublisher; class StreamServer; }
 
 namespace app {
 
@@ -19,10 +23,19 @@ namespace app {
         int windowWidth = 1800;
         int windowHeight = 900;
         std::string title = "Game Of Life";
+        int fpsCap = 0;           // redraws per second at most, 0 for no cap (independent of vsync)
     };
 
     /**
      * @brief Main application. Owns window, GL context, UI and the main loop.
+     *
+     * Frames are drawn on demand: only when the grid, the camera, the hovered cell or the
+     * UI changed since the last one. In between, the loop sleeps in glfwWaitEventsTimeout
+     * until an event, the next simulation step or the idle tick that polls background work.
+     *
+     * Comparison views add further simulations, each in its own row of 2D and 3D viewports
+     * with its own toolbar, below the main one; all of them are stepped by one
+     * core::SimulationScheduler on the shared thread pool.
      */
     class App {
     public:
@@ -58,6 +71,13 @@ namespace app {
          */
         void onScroll(double yoff);
 
+        /**
+         * @brief Request a redraw of the next frame (window exposed, resized, ...).
+         */
+        void requestRedraw() {
+            redrawPending_ = true;
+        }
+
     private:
         // Non-copyable
         App(const App&) = delete;
@@ -72,8 +92,24 @@ namespace app {
         // Per-frame stages
         void updateInput();
         void simulate(double dt);
+        void updateRecording(const ui::ToolbarActions& act);
+        void updateExport(const ui::ToolbarActions& act);
+        void updateSharing(const ui::ToolbarActions& act);
+        void updateServer(const ui::ToolbarActions& act);
+        void updateVolume(const ui::ToolbarActions& act);
+        void updateViews(const ui::ToolbarActions& act);
+        void updateEditing(const ui::ToolbarActions& act);
+        void updateAutosave();
+        void updateCamera();
+        bool needsRedraw(double now);
+        void waitForWork(double now);
+        void hoveredCell(int& hx, int& hy) const;
+        int viewRows() const;
+        void rowRect(int row, int& y, int& h) const;
+        core::OrbitCamera& rowCamera(int row);
         void draw2D();
         void draw3D();
+        void drawViews();
 
     private:
         AppConfig config_{};
@@ -83,14 +119,56 @@ namespace app {
         int fbHeight_ = 0;
 
         std::unique_ptr<core::Simulation> simulation_;
+        std::unique_ptr<core::SimulationScheduler> scheduler_;
+        int schedulerId_ = 0;        // id of simulation_ in scheduler_
+        std::vector<std::unique_ptr<CompareView>> views_; // comparison simulations, one row each
         std::unique_ptr<core::OrbitCamera> camera_;
         std::unique_ptr<render::Renderer2D> r2d_;
         std::unique_ptr<render::Renderer3D> r3d_;
         std::unique_ptr<ui::ToolbarState> toolbarState_;
         std::unique_ptr<InputState> input_;
+        std::unique_ptr<ui::ProfilerOverlayState> profilerOverlay_;
+        std::unique_ptr<utils::GpuTimer> gpuTimer2D_;
+        std::unique_ptr<utils::GpuTimer> gpuTimer3D_;
+        std::unique_ptr<io::AsyncPatternIo> patternIo_;
+        std::unique_ptr<io::Autosaver> autosaver_;
+        double lastAutosaveTime_ = 0.0; // when the last checkpoint started (or autosave was off)
+        bool autosaveDirty_ = false;    // the grid changed since the generation last checkpointed
+        std::unique_ptr<io::Recorder> recorder_;
+        std::unique_ptr<io::Player> player_;
+        int recordListener_ = 0;     // Simulation listener id while recording, 0 otherwise
+        std::unique_ptr<render::FrameExporter> exporter_;
+        int exportListener_ = 0;     // Simulation listener id while exporting, 0 otherwise
+        std::unique_ptr<io::SharedGridPublisher> publisher_;
+        int shareListener_ = 0;      // Simulation listener id while sharing, 0 otherwise
+        std::unique_ptr<io::StreamServer> server_;
+        int serverListener_ = 0;     // Simulation listener id while serving, 0 otherwise
+        std::unique_ptr<core::Life3D> volume_;          // volumetric automaton, null unless shown
+        std::unique_ptr<render::VoxelRenderer> voxels_;
+        int volumeListener_ = 0;     // Simulation listener id while the volume is shown, 0 otherwise
+        bool volumeDirty_ = false;   // the volume changed since its last upload
+
+        // 2D editing: a drag belongs to the view it started in
+        bool mouseWasDown_ = false;
+        bool editing_ = false;       // left button went down over the 2D grid
+        int editAnchorX_ = -1;       // cell where the drag started
+        int editAnchorY_ = -1;
+        int editLastX_ = -1;         // last cell under the mouse during the drag
+        int editLastY_ = -1;
+        std::unique_ptr<core::Life> stamp_;  // pattern placed by the paste tool
+        bool stampPending_ = false;  // the running pattern load is for stamp_
 
         double lastTime_ = 0.0;
         double scrollDelta_ = 0.0;
+
+        // On-demand rendering: what the last drawn frame showed
+        int redrawListener_ = 0;     // Simulation listener id that flags grid changes
+        bool redrawPending_ = true;  // something changed that the last frame does not show
+        uint64_t drawnUiHash_ = 0;   // hash of the ImGui draw data last rendered
+        int drawnHoverX_ = -1;       // hovered cell last drawn
+        int drawnHoverY_ = -1;
+        std::vector<float> drawnCameras_; // distance, yaw and pitch of every row last drawn
+        double lastDrawTime_ = 0.0;  // when the last frame was presented
     };
 
 }
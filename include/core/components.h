@@ -0,0 +1,135 @@
+#pragma once
+
+#include "core/topology.h"
+#include "utils/threadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief One 8-connected group of live cells.
+     */
+    struct Component {
+        int x = 0;                 // lower-left corner of the bounding box
+        int y = 0;
+        int width = 0;             // on a torus the box may extend past the grid edge (it wraps)
+        int height = 0;
+        uint32_t population = 0;   // live cells
+        uint64_t shapeHash = 0;    // equal for translated copies of the same shape
+    };
+
+    /**
+     * @brief Multithreaded connected-component labeling on a grid of any topology.
+     *
+     * Rows are split into one band per thread. Each band finds the runs of live cells in
+     * its rows and joins touching runs with a union-find keyed by the run's first cell,
+     * whose links always point to lower cell indices so a single raster pass flattens it.
+     * The band seams are then merged serially, along with the edges the topology glues:
+     * the wrap seams of a torus, nothing on a bounded grid, and the border cells one by
+     * one for the mirrored gluings. Every run is then resolved to its component in
+     * parallel. Components are numbered in the raster order of their first cell, which
+     * makes the result independent of the thread count.
+     *
+     * On a torus, bounding boxes are measured from the first cell of each component across
+     * the wrap, so they are exact for objects smaller than half the grid in each direction.
+     * On other topologies they are measured in grid coordinates, so an object that crosses
+     * a mirrored edge gets a box spanning both sides. Grids are limited to 2^31 cells.
+     */
+    class ComponentLabeler {
+    public:
+        /**
+         * @brief Create a labeler that runs on a thread pool.
+         * @param pool Pool used for the parallel passes.
+         */
+        explicit ComponentLabeler(utils::ThreadPool& pool = utils::ThreadPool::shared());
+
+        /**
+         * @brief Label the live cells of a grid.
+         * @param cells Row-major cells (width*height bytes, 0 or 1).
+         * @param width Grid width.
+         * @param height Grid height.
+         * @param topology How the edges are glued (objects touching glued edges are one).
+         */
+        void label(const uint8_t* cells, int width, int height, Topology topology = Topology::Torus);
+
+        /**
+         * @brief Per-cell labels: 0 for dead cells, k+1 for cells of components()[k].
+         */
+        const std::vector<uint32_t>& labels() const {
+            return labels_;
+        }
+
+        /**
+         * @brief Per-cell colour index for rendering: 0 for dead cells, 1..255 otherwise.
+         *
+         * Derived from the first cell of each component, so objects that do not move keep
+         * their colour while others appear and disappear.
+         */
+        const std::vector<uint8_t>& colorIndices() const {
+            return colors_;
+        }
+
+        /**
+         * @brief Components found by the last label() call, in raster order of their first cell.
+         */
+        const std::vector<Component>& components() const {
+            return components_;
+        }
+
+    private:
+        // Running statistics of one component, relative to its first cell
+        struct Accumulator {
+            uint32_t population = 0;
+            int minDx = 0, maxDx = 0, minDy = 0, maxDy = 0;
+            uint64_t hash = 0;
+        };
+
+        // Horizontal run of live cells [begin, end) within one row
+        struct Run {
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        struct Band {
+            size_t begin = 0;                  // first cell index
+            size_t end = 0;                    // one past the last cell index
+            std::vector<Run> runs;             // in raster order
+            std::vector<uint32_t> roots;       // first cells of the components that start here
+            uint32_t firstId = 0;              // id of roots[0]
+            std::vector<std::pair<uint32_t, Accumulator>> foreign; // components that start in an earlier band
+        };
+
+        void labelBand(Band& band, const uint8_t* cells);
+        void connectRows(const Run* up, size_t upCount, size_t upRow, const Run* row, size_t rowCount, size_t rowStart, std::vector<uint32_t>* relinked);
+        void mergeSeams(const uint8_t* cells);
+        template <class Policy> void uniteAcrossEdges(const uint8_t* cells);
+        uint32_t runAt(size_t cell) const;
+        void measureBand(Band& band);
+        void paintBand(const Band& band, const uint8_t* cells);
+        void addSpan(Accumulator& acc, int dx, int length, int dy) const;
+        uint32_t find(uint32_t i);
+        void unite(uint32_t a, uint32_t b, std::vector<uint32_t>* relinked);
+        void rebuildTables();
+
+        utils::ThreadPool& pool_;
+        int width_ = 0;
+        int height_ = 0;
+        Topology topology_ = Topology::Torus;
+        std::vector<uint32_t> labels_;
+        std::vector<uint8_t> colors_;
+        std::vector<Component> components_;
+        std::vector<Band> bands_;
+        std::vector<uint32_t> relinked_;       // band roots linked while merging seams
+        std::vector<Accumulator> stats_;       // per component, indexed by id
+        std::vector<std::pair<int, int>> origins_; // first cell of each component
+
+        // Shape hash terms a^dx (as prefix sums, so a run costs one subtraction) and b^dy,
+        // plus their inverses, for offsets in [-width, width) and [-height, height) (index = offset + size)
+        std::vector<uint64_t> sumX_, powY_, invX_, invY_;
+    };
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Run-length encode the XOR of two byte-per-cell generations.
+     *
+     * The output is a sequence of varint pairs (unchanged run, changed run) covering the
+     * grid in row-major order; trailing unchanged cells are omitted. Sparse changes cost
+     * a few bytes each and long changed spans cost a single pair.
+     *
+     * Multi-state cells are encoded one bit plane at a time: plane p covers the indices
+     * [p * count, (p + 1) * count) of the run sequence. A one-plane delta is a valid
+     * delta of any number of planes, and only the low bit of each cell is encoded in it.
+     * @param prev Previous generation (count bytes).
+     * @param next Next generation (count bytes).
+     * @param count Number of cells.
+     * @param out Encoded delta is appended here (capacity is reused by callers).
+     * @param planes State bits to encode (1 for two-state grids, 2 for up to four states).
+     */
+    void encodeXorDelta(const uint8_t* prev, const uint8_t* next, size_t count, std::vector<uint8_t>& out, int planes = 1);
+
+    /**
+     * @brief Encode the XOR delta of a contiguous range of cells (e.g. the rows an edit touched).
+     *
+     * The result is a whole-grid delta (the same format as encodeXorDelta) that leaves every
+     * cell outside [begin, end) unchanged.
+     * @param before Cells begin..end-1 before the change.
+     * @param after Cells begin..end-1 after the change.
+     * @param begin Index of the first cell of the range.
+     * @param end Index one past the last cell of the range.
+     * @param count Number of cells of the grid.
+     * @param out Encoded delta is appended here.
+     * @param planes State bits to encode.
+     */
+    void encodeXorDeltaRange(const uint8_t* before, const uint8_t* after, size_t begin, size_t end, size_t count,
+                             std::vector<uint8_t>& out, int planes = 1);
+
+    /**
+     * @brief Run-length encode the live cells of a generation (XOR against an empty grid).
+     * @param cells Generation (count bytes).
+     * @param count Number of cells.
+     * @param out Encoded runs are appended here.
+     * @param planes State bits to encode.
+     */
+    void encodeCells(const uint8_t* cells, size_t count, std::vector<uint8_t>& out, int planes = 1);
+
+    /**
+     * @brief Apply an encoded delta by flipping every changed cell.
+     *
+     * XOR deltas are symmetric: applying the delta between A and B to A yields B, and
+     * applying it to B yields A.
+     * @param delta Encoded delta.
+     * @param size Size of the encoded delta in bytes.
+     * @param cells Generation to update in place (count bytes).
+     * @param count Number of cells.
+     * @param planes State bits the delta may cover.
+     * @return False if the delta is malformed or runs past the grid.
+     */
+    bool applyXorDelta(const uint8_t* delta, size_t size, uint8_t* cells, size_t count, int planes = 1);
+
+}
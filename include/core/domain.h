@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Rectangle of the global grid owned by one process.
+     */
+    struct DomainRect {
+        int x = 0;        // first column
+        int y = 0;        // first row
+        int width = 0;
+        int height = 0;
+    };
+
+    /**
+     * @brief Split of the toroidal grid into columns x rows rectangular subdomains.
+     *
+     * Rank r owns the subdomain in column r % columns and row r / columns. Sizes differ
+     * by at most one cell, and neighbours wrap around like the grid itself.
+     */
+    class DomainLayout {
+    public:
+        /**
+         * @brief Describe a split of a grid.
+         * @param gridWidth Global grid width.
+         * @param gridHeight Global grid height.
+         * @param columns Subdomains across (1..gridWidth).
+         * @param rows Subdomains down (1..gridHeight).
+         */
+        DomainLayout(int gridWidth, int gridHeight, int columns, int rows);
+
+        int gridWidth() const {
+            return gridWidth_;
+        }
+
+        int gridHeight() const {
+            return gridHeight_;
+        }
+
+        int columns() const {
+            return columns_;
+        }
+
+        int rows() const {
+            return rows_;
+        }
+
+        /**
+         * @brief Number of subdomains (and processes).
+         */
+        int ranks() const {
+            return columns_ * rows_;
+        }
+
+        /**
+         * @brief Rectangle owned by a rank.
+         */
+        DomainRect rect(int rank) const;
+
+        /**
+         * @brief Rank of the subdomain offset by (dx, dy) subdomains, wrapping around.
+         */
+        int neighbour(int rank, int dx, int dy) const;
+
+        /**
+         * @brief Deepest halo that every subdomain can supply to its neighbours.
+         */
+        int maxHalo() const;
+
+    private:
+        int gridWidth_;
+        int gridHeight_;
+        int columns_;
+        int rows_;
+    };
+
+    /**
+     * @brief Side of a subdomain whose cells are exchanged.
+     */
+    enum class Side {
+        West,   // lower x
+        East,   // higher x
+        South,  // lower y
+        North   // higher y
+    };
+
+    /**
+     * @brief One subdomain with a halo of ghost cells, stepped without wrap-around.
+     *
+     * The cells live in a (width + 2*halo) x (height + 2*halo) buffer. After the halo has
+     * been filled from the neighbours, up to `halo` generations can be computed locally:
+     * each generation is valid on a region one cell smaller on every side, so after k
+     * generations the interior is exact. The rule is always Conway's (B3/S23) on a
+     * torus, i.e. what Life::step() does with its default rule and topology; other rules
+     * and topologies are not supported.
+     *
+     * Halos are filled in two phases so corners need no diagonal messages: first the
+     * west/east columns of the interior rows, then the south/north rows across the full
+     * padded width (which by then carry the corner cells).
+     */
+    class Subdomain {
+    public:
+        /**
+         * @brief Allocate a subdomain (all cells dead).
+         * @param rect Owned rectangle of the global grid.
+         * @param halo Ghost-cell depth (1..min(width, height)).
+         */
+        Subdomain(const DomainRect& rect, int halo);
+
+        const DomainRect& rect() const {
+            return rect_;
+        }
+
+        int halo() const {
+            return halo_;
+        }
+
+        /**
+         * @brief Copy the owned cells from a global grid.
+         * @param grid Row-major global grid.
+         * @param gridWidth Global grid width.
+         */
+        void loadFrom(const uint8_t* grid, int gridWidth);
+
+        /**
+         * @brief Copy the owned cells into a global grid.
+         * @param grid Row-major global grid.
+         * @param gridWidth Global grid width.
+         */
+        void storeTo(uint8_t* grid, int gridWidth) const;
+
+        /**
+         * @brief Copy the owned cells into a contiguous width*height buffer.
+         */
+        void copyInterior(uint8_t* out) const;
+
+        /**
+         * @brief Replace the owned cells from a contiguous width*height buffer.
+         */
+        void setInterior(const uint8_t* cells);
+
+        /**
+         * @brief Bytes of the strip exchanged on a side.
+         */
+        size_t stripBytes(Side side) const;
+
+        /**
+         * @brief Copy the owned cells next to a side (what that neighbour needs as its halo).
+         * @param side West/East: halo columns of the interior rows; South/North: halo rows of the padded width.
+         * @param out Receives stripBytes(side) bytes.
+         */
+        void packEdge(Side side, uint8_t* out) const;
+
+        /**
+         * @brief Fill the halo on a side from the strip packed by the neighbour there.
+         * @param side Halo to fill.
+         * @param in stripBytes(side) bytes.
+         */
+        void unpackHalo(Side side, const uint8_t* in);
+
+        /**
+         * @brief Compute generations locally (the halo must be fresh).
+         * @param generations 1..halo().
+         */
+        void step(int generations);
+
+        /**
+         * @brief Live cells in the owned rectangle.
+         */
+        size_t population() const;
+
+    private:
+        uint8_t* row(int y) {
+            return current_.data() + static_cast<size_t>(y) * stride_;
+        }
+
+        const uint8_t* row(int y) const {
+            return current_.data() + static_cast<size_t>(y) * stride_;
+        }
+
+        DomainRect rect_;
+        int halo_;
+        int stride_;                   // padded width
+        int paddedHeight_;
+        std::vector<uint8_t> current_; // padded buffer, interior at (halo, halo)
+        std::vector<uint8_t> next_;    // work buffer
+    };
+
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Half-open cell rectangle [x0, x1) x [y0, y1).
+     */
+    struct CellRect {
+        int x0 = 0;
+        int y0 = 0;
+        int x1 = 0;
+        int y1 = 0;
+
+        bool empty() const {
+            return x0 >= x1 || y0 >= y1;
+        }
+    };
+
+    /**
+     * @brief Counter-clockwise quarter turns applied to pasted patterns.
+     */
+    enum class Rotation {
+        R0,
+        R90,
+        R180,
+        R270
+    };
+
+    /**
+     * @brief Ordered list of grid edits collected during a frame.
+     *
+     * Input handlers queue edits here instead of touching the grid; the simulation applies
+     * the whole list in one pass and uploads the bounding box of everything it touched as a
+     * single region. Coordinates may fall partly outside the grid: edits are clipped.
+     */
+    class EditBatch {
+    public:
+        /**
+         * @brief Flip one cell between dead and a state.
+         * @param x Column index.
+         * @param y Row index.
+         * @param state State of the flipped cell if it is not in it already (dead otherwise).
+         */
+        void toggle(int x, int y, uint8_t state = 1);
+
+        /**
+         * @brief Paint a round brush along a segment (a drag between two mouse samples).
+         * @param x0 Segment start column.
+         * @param y0 Segment start row.
+         * @param x1 Segment end column (equal to x0 for a single dab).
+         * @param y1 Segment end row.
+         * @param radius Brush radius in cells (0 paints single cells).
+         * @param state State to paint (0 erases).
+         */
+        void stroke(int x0, int y0, int x1, int y1, int radius, uint8_t state);
+
+        /**
+         * @brief Set every cell of a rectangle given by two inclusive corners (any order).
+         * @param state State to fill with (0 clears).
+         */
+        void fillRect(int x0, int y0, int x1, int y1, uint8_t state);
+
+        /**
+         * @brief Fill a rectangle given by two inclusive corners with random cells.
+         * @param density Probability of a live cell (0..1).
+         * @param seed Seed; the same seed and rectangle give the same cells.
+         */
+        void randomFill(int x0, int y0, int x1, int y1, float density, uint64_t seed);
+
+        /**
+         * @brief Stamp a pattern, flipped horizontally first and then rotated.
+         * @param cells Pattern cells (row-major, width*height bytes, 0 or 1), copied.
+         * @param width Pattern width.
+         * @param height Pattern height.
+         * @param x Column of the lower-left corner of the transformed pattern.
+         * @param y Row of the lower-left corner of the transformed pattern.
+         * @param rotation Quarter turns.
+         * @param flip Mirror the pattern horizontally before rotating it.
+         * @param merge True to only add live cells, false to also copy dead ones.
+         */
+        void paste(const uint8_t* cells, int width, int height, int x, int y, Rotation rotation, bool flip, bool merge);
+
+        /**
+         * @brief Size of a pattern after rotation.
+         */
+        static void rotatedSize(int width, int height, Rotation rotation, int& outW, int& outH);
+
+        /**
+         * @brief True if no edit is queued.
+         */
+        bool empty() const {
+            return ops_.empty();
+        }
+
+        /**
+         * @brief Drop all queued edits.
+         */
+        void clear();
+
+        /**
+         * @brief Bounding box of all queued edits clipped to the grid.
+         * @param width Grid width.
+         * @param height Grid height.
+         * @return Rectangle touched by apply() (empty if every edit is outside the grid).
+         */
+        CellRect bounds(int width, int height) const;
+
+        /**
+         * @brief Apply the queued edits in order (the queue is left intact).
+         * @param cells Grid cells (row-major, width*height bytes).
+         * @param width Grid width.
+         * @param height Grid height.
+         */
+        void apply(uint8_t* cells, int width, int height) const;
+
+    private:
+        enum class Kind { Toggle, Stroke, Fill, Random, Paste };
+
+        struct Op {
+            Kind kind = Kind::Toggle;
+            CellRect rect;            // unclipped area the edit can touch
+            int ax = 0, ay = 0;       // stroke segment
+            int bx = 0, by = 0;
+            int radius = 0;
+            uint8_t state = 0;        // toggle/stroke/fill value
+            uint32_t threshold = 0;   // random: live if a 16-bit draw is below this
+            uint64_t seed = 0;
+            size_t stamp = 0;         // paste: offset of the pattern in stamps_
+            int stampW = 0, stampH = 0;
+            Rotation rotation = Rotation::R0;
+            bool flip = false;
+            bool merge = false;
+        };
+
+        void applyStroke(const Op& op, const CellRect& r, uint8_t* cells, int width) const;
+        void applyRandom(const Op& op, const CellRect& r, uint8_t* cells, int width) const;
+        void applyPaste(const Op& op, const CellRect& r, uint8_t* cells, int width) const;
+
+        std::vector<Op> ops_;
+        std::vector<uint8_t> stamps_;  // pasted patterns, back to back
+    };
+
+}
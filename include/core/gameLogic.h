@@ -1,5 +1,11 @@
 #pragma once
 
+#include "core/largerThanLife.h"
+#include "core/topology.h"
+#include "utils/gridAllocator.h"
+
+#include <cstddef>
+#include <functional>
 #include <vector>
 #include <cstdint>
 
@@ -8,11 +14,24 @@ namespace core {
     /**
      * @brief Game of Life state and rules on a toroidal grid.
      *
-     * Stores the current generation in a row-major byte buffer (0 = dead, 1 = alive)
-     * and computes the next generation using double buffering.
+     * Stores the current generation in a row-major byte buffer (0 = dead, 1 = alive,
+     * 2..3 for the extra states of multi-state rules) and computes the next generation
+     * using double buffering, or in place when memory is short (see setInPlace()). The rule is Conway's by default; any Larger-than-Life rule
+     * (see stepLargerThanLife()) or multi-state rule (see stepStatePlanes()) can be set. The grid
+     * is a torus unless another Topology is set.
+     *
+     * Large grids are split into one band of rows per thread of the shared pool. The
+     * buffers are allocated untouched (see utils::allocateGrid) and zeroed band by band
+     * from the thread that steps that band, so each band stays in that thread's cache
+     * and, on NUMA machines, on its memory node.
      */
     class Life {
     public:
+        using Buffer = std::vector<uint8_t, utils::GridAllocator<uint8_t>>;
+
+        static constexpr size_t kParallelCells = 1u << 18; // smaller grids step on one thread
+        static constexpr int kInPlaceRows = 8;              // rows an in-place band computes per kernel call
+
         /**
          * @brief Construct a grid of size width x height (all cells dead).
          * @param width Number of columns.
@@ -28,10 +47,83 @@ namespace core {
         /**
          * @brief Advance the simulation by one generation.
          *
-         * Applies Conway's rules with wrap-around at the edges (toroidal topology).
+         * Applies the rule with the edges glued as the topology says.
          */
         void step();
 
+        /**
+         * @brief step() in parts, for callers that schedule the bands themselves.
+         *
+         * Call beginStep(), then stepBand(b) once for every b in [0, bands()) from any
+         * threads (concurrently is fine), then endStep() once they have all returned.
+         */
+        void beginStep();
+
+        /**
+         * @brief Compute the next generation of one band of rows (see beginStep()).
+         * @param band Band index in [0, bands()).
+         */
+        void stepBand(int band);
+
+        /**
+         * @brief Merge the bands and make the next generation current (see beginStep()).
+         */
+        void endStep();
+
+        /**
+         * @brief Rule applied by step().
+         */
+        const LifeRule& rule() const {
+            return rule_;
+        }
+
+        /**
+         * @brief Change the rule; takes effect at the next step().
+         * @param rule Rule with range in [1, kMaxRange].
+         */
+        void setRule(const LifeRule& rule);
+
+        /**
+         * @brief How the edges of the grid are glued.
+         */
+        Topology topology() const {
+            return topology_;
+        }
+
+        /**
+         * @brief Change the topology; takes effect at the next step().
+         */
+        void setTopology(Topology topology) {
+            topology_ = topology;
+        }
+
+        /**
+         * @brief Step in place instead of double buffering, to halve the grid memory.
+         *
+         * The work buffer is freed. Each band writes the next generation straight into the
+         * current buffer through a few rolling rows, and keeps its first and last rows (and,
+         * on topologies that mirror rows, the border columns of the others) until endStep(),
+         * because neighbouring rows still read them. Only rules that read the 8 nearest
+         * neighbours (range 1, Moore) can step this way; for other rules the work buffer is
+         * allocated again while they are set.
+         * @param enabled True to step in place when the rule allows it.
+         */
+        void setInPlace(bool enabled);
+
+        /**
+         * @brief True if in-place stepping was requested (see setInPlace()).
+         */
+        bool inPlace() const {
+            return inPlace_;
+        }
+
+        /**
+         * @brief True if step() runs in place with the current rule.
+         */
+        bool stepsInPlace() const {
+            return inPlace_ && rule_.range == 1 && rule_.shape == Neighbourhood::Moore;
+        }
+
         /**
          * @brief Access a cell by coordinates.
          * @param x Column index in [0, gridWidth).
@@ -50,24 +142,177 @@ namespace core {
             return currentBuffer_.data();
         }
 
-        int gridWidth_;   // number of columns
-        int gridHeight_;  // number of rows
+        /**
+         * @brief Writable pointer to the current buffer for bulk loads.
+         *
+         * Derived data (live-cell list, ages) must be refreshed after writing through it.
+         * @return Pointer to the current buffer (row-major, size = width*height).
+         */
+        inline uint8_t* data() {
+            return currentBuffer_.data();
+        }
 
-    private:
-        std::vector<uint8_t> currentBuffer_; // current generation buffer (row-major)
-        std::vector<uint8_t> nextBuffer_;    // next generation buffer (work buffer)
+        /**
+         * @brief Generation before the last step(), read from the swapped-out work buffer.
+         *
+         * Valid only until the grid is next stepped or edited; lets callers diff a step
+         * without keeping their own copy.
+         * @return Read-only pointer to the previous generation (row-major, size = width*height),
+         *         or null while stepping in place (see setInPlace()).
+         */
+        inline const uint8_t* previousData() const {
+            return nextBuffer_.empty() ? nullptr : nextBuffer_.data();
+        }
+
+        /**
+         * @brief Exchange the work buffer, which holds previousData(), with a spare buffer.
+         *
+         * Hands the previous generation out without copying it (e.g. to a background save).
+         * The spare is resized to the grid first; pages it lacks are placed by the step that
+         * first writes them. previousData() is undefined until the next step.
+         * @param spare Receives the previous generation; its old storage becomes the work buffer.
+         */
+        void swapPrevious(Buffer& spare);
+
+        /**
+         * @brief Number of row bands the buffers are touched and stepped in (1 for small grids).
+         */
+        int bands() const {
+            return bands_;
+        }
+
+        /**
+         * @brief Enable or disable the compacted live-cell list.
+         *
+         * When enabled, step() appends the index (y * width + x) of every live cell while
+         * it computes the next generation, so consumers never scan the grid themselves.
+         * @param enabled True to maintain the list.
+         */
+        void setLiveCellsEnabled(bool enabled);
+
+        /**
+         * @brief True if the live-cell list is maintained.
+         */
+        bool liveCellsEnabled() const {
+            return trackLiveCells_;
+        }
 
         /**
-         * @brief Wrap an index to [0, length) with single-step overflow handling.
-         * @param index Input index, possibly -1 or length.
-         * @param length Interval length.
-         * @return Wrapped index inside [0, length).
+         * @brief Row-major indices of live cells in the current generation (empty if disabled).
          */
-        inline int wrap(int index, int length) const {
-            if (index >= length) index -= length;
-            else if (index < 0)  index += length;
-            return index;
+        const std::vector<uint32_t>& liveCells() const {
+            return liveCells_;
         }
+
+        /**
+         * @brief Recompute the live-cell list after cells were edited through at().
+         */
+        void rebuildLiveCells();
+
+        /**
+         * @brief Enable or disable the per-cell age/trail plane.
+         *
+         * Each byte encodes either the age of a live cell (kAgeAliveBase + generations
+         * alive, saturating at 255) or the decaying trail left by a dead cell
+         * (kTrailStart just after death, down to 0). It is updated by step() in the same
+         * pass as the state; when disabled it is freed and step() does no extra work.
+         * @param enabled True to maintain the plane.
+         */
+        void setAgeEnabled(bool enabled);
+
+        /**
+         * @brief True if the age/trail plane is maintained.
+         */
+        bool ageEnabled() const {
+            return trackAge_;
+        }
+
+        /**
+         * @brief Pointer to the age/trail plane (row-major, size = width*height), or null if disabled.
+         */
+        const uint8_t* ageData() const {
+            return trackAge_ ? ageBuffer_.data() : nullptr;
+        }
+
+        /**
+         * @brief Reset ages from the current state (live cells become newborn, trails vanish).
+         */
+        void resetAge();
+
+        /**
+         * @brief Refresh the age of one cell after it was edited through at().
+         * @param x Column index.
+         * @param y Row index.
+         */
+        void touchAge(int x, int y);
+
+        /**
+         * @brief Refresh the ages of the cells of a range that changed in a bulk edit.
+         * @param before Cells begin..end-1 before the edit.
+         * @param begin Index of the first cell of the range.
+         * @param end Index one past the last cell of the range.
+         */
+        void touchAgeRange(const uint8_t* before, size_t begin, size_t end);
+
+        static constexpr uint8_t kAgeAliveBase = 128; // age value of a newborn cell
+        static constexpr uint8_t kTrailStart = 127;   // trail value right after death
+        static constexpr uint8_t kTrailDecay = 4;     // trail fade per generation
+
+        int gridWidth_;   // number of columns
+        int gridHeight_;  // number of rows
+
+    private:
+        Buffer currentBuffer_;               // current generation buffer (row-major)
+        Buffer nextBuffer_;                  // next generation buffer (work buffer), empty while stepping in place
+        bool inPlace_ = false;               // step in place when the rule allows it
+        int bands_ = 1;                      // row bands, one per pool thread for large grids
+        LifeRule rule_;                      // Conway unless set
+        Topology topology_ = Topology::Torus;
+        std::vector<RangeScratch> bandRangeScratch_; // per-band sums of Larger-than-Life rules
+
+        std::vector<uint32_t> liveCells_;    // compacted live-cell indices of the current generation
+        std::vector<std::vector<uint32_t>> bandLiveCells_; // per-band lists, merged after a parallel step
+        bool trackLiveCells_ = false;        // maintain liveCells_ during step()
+
+        Buffer ageBuffer_;                   // age/trail plane (row-major), updated in place
+        bool trackAge_ = false;              // maintain ageBuffer_ during step()
+
+        // Rows of one band stepping in place
+        struct InPlaceRows {
+            std::vector<uint8_t> rows;       // the last row computed, kInPlaceRows new rows, then the band's first and last row
+            std::vector<uint8_t> columns;    // new border columns (left, right) of each written row, for mirroring topologies
+        };
+        std::vector<InPlaceRows> bandInPlace_;
+
+        // Run body(band, firstRow, endRow) for every band, each on its own pool thread
+        void forEachBand(const std::function<void(int, int, int)>& body);
+
+        // Rows [y0, y1) of band b
+        void bandRows(int band, int& y0, int& y1) const;
+
+        // Allocate or free the work buffer to match stepsInPlace()
+        void updateWorkBuffer();
+
+        // Step band b in place or into the work buffer
+        template <class Policy>
+        void stepBandWith(int band, int y0, int y1, std::vector<uint32_t>& live, RangeScratch* scratch);
+
+        // Compute rows [y0, y1) with the kernel for the current rule and tracked features;
+        // row y goes to out + (y - y0) * width
+        template <class Policy>
+        void stepBandRows(int y0, int y1, uint8_t* out, std::vector<uint32_t>& live, RangeScratch* scratch);
+
+        // Step band b in place, kInPlaceRows at a time, holding back what other rows still read
+        template <class Policy>
+        void stepBandInPlace(int band, int y0, int y1, std::vector<uint32_t>& live, RangeScratch* scratch);
+
+        // Conway kernel for rows [y0, y1): branch-free interior, topology only on the border
+        template <class Policy, bool TrackLive, bool TrackAge>
+        void stepRows(int y0, int y1, uint8_t* out, std::vector<uint32_t>& live);
+
+        // Live-cell list and ages of rows [y0, y1) once out holds them (the old cells are still current)
+        template <bool TrackLive, bool TrackAge>
+        void finishRows(int y0, int y1, const uint8_t* out, std::vector<uint32_t>& live);
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "core/topology.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Shape of the range-R neighbourhood.
+     */
+    enum class Neighbourhood {
+        Moore,        // (2R+1) x (2R+1) square
+        VonNeumann    // diamond of cells within Manhattan distance R
+    };
+
+    constexpr int kMaxRange = 100;   // keeps every neighbourhood sum within 16 bits
+    constexpr int kMaxStates = 4;    // cell states fit two bit planes
+
+    /**
+     * @brief How a rule maps neighbourhoods to next states.
+     */
+    enum class RuleFamily {
+        Totalistic,   // Larger-than-Life / Generations: counts of live (state 1) cells
+        WireWorld     // empty, electron head, electron tail, conductor
+    };
+
+    /**
+     * @brief Totalistic Larger-than-Life rule (Conway's rule is range 1, B3/S2-3).
+     *
+     * A dead cell is born if its neighbour count lies in [birthMin, birthMax]; a live
+     * cell survives if it lies in [surviveMin, surviveMax]. With includeCenter the count
+     * includes the cell itself (Golly's "M1"). An interval with max < min is empty.
+     *
+     * With more than two states (Generations, Golly's "C"), only state 1 counts as live:
+     * a live cell that does not survive goes to state 2 and then ages one state per step
+     * until it is dead again. WireWorld ignores the intervals except birth, the number of
+     * neighbouring electron heads that turns a conductor into a head (1..2).
+     */
+    struct LifeRule {
+        int range = 1;
+        int birthMin = 3;
+        int birthMax = 3;
+        int surviveMin = 2;
+        int surviveMax = 3;
+        bool includeCenter = false;
+        Neighbourhood shape = Neighbourhood::Moore;
+        int states = 2;                         // 2..kMaxStates
+        RuleFamily family = RuleFamily::Totalistic;
+
+        /**
+         * @brief True for Conway's Life, which has its own kernel.
+         */
+        bool isConway() const {
+            return range == 1 && birthMin == 3 && birthMax == 3 && surviveMin == 2 && surviveMax == 3 &&
+                   !includeCenter && shape == Neighbourhood::Moore && states == 2 && family == RuleFamily::Totalistic;
+        }
+
+        /**
+         * @brief True for multi-state rules on the 8 nearest neighbours, stepped on packed state planes.
+         */
+        bool usesStatePlanes() const {
+            return family == RuleFamily::WireWorld ||
+                   (states > 2 && range == 1 && shape == Neighbourhood::Moore && !includeCenter);
+        }
+
+        bool operator==(const LifeRule& o) const {
+            return range == o.range && birthMin == o.birthMin && birthMax == o.birthMax && surviveMin == o.surviveMin &&
+                   surviveMax == o.surviveMax && includeCenter == o.includeCenter && shape == o.shape &&
+                   states == o.states && family == o.family;
+        }
+
+        bool operator!=(const LifeRule& o) const {
+            return !(*this == o);
+        }
+    };
+
+    /** @brief Conway's Life. */
+    constexpr LifeRule kConwayRule{};
+
+    /** @brief Bosco's Rule: R5,C0,M1,S34..58,B34..45,NM. */
+    constexpr LifeRule kBoscoRule{ 5, 34, 45, 34, 58, true, Neighbourhood::Moore };
+
+    /** @brief Majority: R4,C0,M1,S41..81,B41..81,NM. */
+    constexpr LifeRule kMajorityRule{ 4, 41, 81, 41, 81, true, Neighbourhood::Moore };
+
+    /** @brief Brian's Brain: B2/S/C3 (no cell survives; every live cell dies through one dying state). */
+    constexpr LifeRule kBriansBrainRule{ 1, 2, 2, 1, 0, false, Neighbourhood::Moore, 3 };
+
+    /** @brief Star Wars: B2/S345/C4. */
+    constexpr LifeRule kStarWarsRule{ 1, 2, 2, 3, 5, false, Neighbourhood::Moore, 4 };
+
+    /** @brief WireWorld: a conductor next to one or two electron heads becomes a head. */
+    constexpr LifeRule kWireWorldRule{ 1, 1, 2, 1, 0, false, Neighbourhood::Moore, 4, RuleFamily::WireWorld };
+
+    /**
+     * @brief Number of cells a rule counts, the upper bound of its intervals.
+     */
+    int neighbourhoodSize(const LifeRule& rule);
+
+    /**
+     * @brief Format a rule in Golly's Larger-than-Life notation (e.g. "R5,C0,M1,S34..58,B34..45,NM").
+     *
+     * WireWorld is formatted as "WireWorld".
+     */
+    std::string formatLifeRule(const LifeRule& rule);
+
+    /**
+     * @brief Parse a rule written by formatLifeRule().
+     * @param text Rule text (spaces are ignored).
+     * @param rule Receives the rule.
+     * @return False if the text is not such a rule or its values are out of range.
+     */
+    bool parseLifeRule(const std::string& text, LifeRule& rule);
+
+    /**
+     * @brief Per-thread buffers of stepLargerThanLife() and stepStatePlanes(), reused between steps.
+     */
+    struct RangeScratch {
+        std::vector<uint8_t> row;       // one grid row with the cells glued beside it
+        std::vector<uint16_t> sums;     // ring of per-row partial sums
+        std::vector<uint16_t> column;   // window sum per column (Moore) or per cell of the row (von Neumann)
+        std::vector<uint64_t> planes;   // packed state planes of stepStatePlanes()
+    };
+
+    /**
+     * @brief Compute rows [y0, y1) of the next generation of a range-R rule.
+     *
+     * The cost per cell does not depend on R. Moore windows are separable: each row
+     * gets sliding sums over x, and a running sum per column adds the row entering the
+     * window and drops the one leaving it. Von Neumann diamonds slide too: moving one
+     * cell adds the two diagonal edges in front and drops the two behind, read as
+     * differences of diagonal prefix sums. Each row is padded with the cells the topology
+     * glues beside it, so the sums need no special cases at the edges. Only 2R+3 rows of sums are kept, so any band of rows
+     * can be computed on its own thread.
+     * @param cells Current generation (row-major, width*height).
+     * @param next Receives rows [y0, y1) of the next generation, row y at next + (y - y0) * width.
+     * @param width Grid width.
+     * @param height Grid height.
+     * @param y0 First row to compute.
+     * @param y1 One past the last row to compute.
+     * @param rule Rule with range in [1, kMaxRange].
+     * @param topology How the edges are glued.
+     * @param scratch Buffers of the calling thread.
+     */
+    void stepLargerThanLife(const uint8_t* cells, uint8_t* next, int width, int height, int y0, int y1,
+                            const LifeRule& rule, Topology topology, RangeScratch& scratch);
+
+    /**
+     * @brief Compute rows [y0, y1) of the next generation of a rule with usesStatePlanes().
+     *
+     * Each row is packed into two bit planes of 64-bit words (bit 0 and bit 1 of the state),
+     * so 64 cells are stepped at once: the live neighbours are counted with bit-sliced
+     * adders on the shifted planes of three rows, and the rule is a handful of logic
+     * operations on the planes. Each row is packed once and kept in a three-row ring.
+     * Parameters as stepLargerThanLife().
+     */
+    void stepStatePlanes(const uint8_t* cells, uint8_t* next, int width, int height, int y0, int y1,
+                         const LifeRule& rule, Topology topology, RangeScratch& scratch);
+
+}
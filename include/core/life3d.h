@@ -0,0 +1,191 @@
+#pragma once
+
+#include "utils/gridAllocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Outer-totalistic rule of a 3D automaton over the 26 Moore neighbours.
+     *
+     * Bit n of birth (survive) is set if a dead (live) cell with n live neighbours is
+     * alive in the next generation.
+     */
+    struct Rule3D {
+        uint32_t birth = 0;
+        uint32_t survive = 0;
+
+        bool operator==(const Rule3D& o) const {
+            return birth == o.birth && survive == o.survive;
+        }
+    };
+
+    /** @brief Bays' Life 4555: survive on 4-5 neighbours, birth on 5. */
+    constexpr Rule3D kRule4555{ 1u << 5, (1u << 4) | (1u << 5) };
+
+    /** @brief Bays' Life 5766: survive on 5-7 neighbours, birth on 6. */
+    constexpr Rule3D kRule5766{ 1u << 6, (1u << 5) | (1u << 6) | (1u << 7) };
+
+    /**
+     * @brief Parse a 3D rule.
+     *
+     * Accepts Bays' four-digit notation "ElEuFlFu" (survive on El..Eu, birth on Fl..Fu,
+     * e.g. "4555") and "B<list>/S<list>" in either order, where a list holds neighbour
+     * counts and ranges separated by commas (e.g. "B5/S4-5", "B6,8/S5-7").
+     * @param text Rule text.
+     * @param rule Receives the rule on success.
+     * @return False if the text is not a valid rule.
+     */
+    bool parseRule3D(const std::string& text, Rule3D& rule);
+
+    /**
+     * @brief Format a rule as "B<list>/S<list>" with ranges (e.g. "B5/S4-5").
+     */
+    std::string formatRule3D(const Rule3D& rule);
+
+    /**
+     * @brief Volumetric cellular automaton on a W x H x D 3-torus.
+     *
+     * Cells are bytes (0 = dead, 1 = alive) in x-fastest order. A step sums each row over
+     * x, those sums over y and the result over z, so every cell costs three byte adds per
+     * pass instead of 26 neighbour loads; all passes are straight loops over contiguous
+     * bytes that the compiler vectorises. The volume is split into one slab of z-planes per
+     * pool thread, each keeping a ring of three summed planes, and the slabs are first
+     * touched and stepped by the same threads (see Life). Volumes are limited to 2^32 cells.
+     */
+    class Life3D {
+    public:
+        using Buffer = std::vector<uint8_t, utils::GridAllocator<uint8_t>>;
+
+        /**
+         * @brief Construct an empty volume.
+         * @param width Cells along x.
+         * @param height Cells along y.
+         * @param depth Cells along z.
+         * @param rule Birth and survival rule.
+         */
+        Life3D(int width, int height, int depth, const Rule3D& rule = kRule4555);
+
+        /** @brief Cells along x. */
+        int width() const {
+            return width_;
+        }
+
+        /** @brief Cells along y. */
+        int height() const {
+            return height_;
+        }
+
+        /** @brief Cells along z. */
+        int depth() const {
+            return depth_;
+        }
+
+        /**
+         * @brief Rule applied by step().
+         */
+        const Rule3D& rule() const {
+            return rule_;
+        }
+
+        /**
+         * @brief Change the rule; takes effect at the next step().
+         */
+        void setRule(const Rule3D& rule);
+
+        /**
+         * @brief Set all cells to dead.
+         */
+        void clear();
+
+        /**
+         * @brief Replace the cells of a centred cube with random ones.
+         *
+         * 3D rules need a dense seed to get going, so only a block around the centre is
+         * filled and the rest of the volume is cleared.
+         * @param density Probability of a live cell in the block.
+         * @param seed Random seed; the same seed always gives the same cells.
+         * @param extent Block size relative to the volume, in (0, 1].
+         */
+        void randomFill(float density, uint64_t seed, float extent);
+
+        /**
+         * @brief Access a cell; call rebuildLiveCells() after editing through it.
+         */
+        uint8_t& at(int x, int y, int z) {
+            return currentBuffer_[index(x, y, z)];
+        }
+
+        /**
+         * @brief Cells of the current generation (x fastest, then y, then z).
+         */
+        const uint8_t* data() const {
+            return currentBuffer_.data();
+        }
+
+        /**
+         * @brief Advance by one generation.
+         */
+        void step();
+
+        /**
+         * @brief Indices (z * width * height + y * width + x) of the live cells, in order.
+         */
+        const std::vector<uint32_t>& liveCells() const {
+            return liveCells_;
+        }
+
+        /**
+         * @brief Recompute the live-cell list after cells were edited through at().
+         */
+        void rebuildLiveCells();
+
+        /**
+         * @brief Generations computed since construction.
+         */
+        uint64_t generation() const {
+            return generation_;
+        }
+
+        /**
+         * @brief Number of z slabs the volume is touched and stepped in (1 for small volumes).
+         */
+        int bands() const {
+            return bands_;
+        }
+
+    private:
+        size_t index(int x, int y, int z) const {
+            return (static_cast<size_t>(z) * height_ + y) * width_ + x;
+        }
+
+        // Run body(band, firstPlane, endPlane) for every slab, each on its own pool thread
+        void forEachBand(const std::function<void(int, int, int)>& body);
+
+        // x and y sums of plane z into out (width*height bytes); rows is scratch of the same size
+        void sumPlane(int z, uint8_t* rows, uint8_t* out) const;
+
+        // Compute planes [z0, z1) of the next generation
+        void stepSlab(int z0, int z1, std::vector<uint8_t>& scratch, std::vector<uint32_t>& live);
+
+        int width_;
+        int height_;
+        int depth_;
+        Rule3D rule_;
+        uint8_t table_[2][32] = {};          // next state by [alive][live neighbours]
+        int bands_ = 1;
+        uint64_t generation_ = 0;
+
+        Buffer currentBuffer_;               // current generation (x fastest, then y, then z)
+        Buffer nextBuffer_;                  // next generation (work buffer)
+        std::vector<uint32_t> liveCells_;
+        std::vector<std::vector<uint32_t>> bandLiveCells_;
+        std::vector<std::vector<uint8_t>> bandScratch_;  // per slab: row sums and a ring of three plane sums
+    };
+
+}
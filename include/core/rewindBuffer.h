@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Bounded history of grid changes for stepping backwards.
+     *
+     * Every change (a step or an edit) is stored as the core::deltaCodec XOR delta between
+     * the state before and after it, so undoing it flips only the changed cells. Every
+     * kKeyframeInterval changes the state before the change is also stored in full, which
+     * lets long jumps start from a keyframe instead of walking every delta back.
+     *
+     * Records live in one byte ring that grows by doubling up to the memory cap and then
+     * evicts the oldest records; once it has reached its working size, recording does not
+     * allocate.
+     */
+    class RewindBuffer {
+    public:
+        /**
+         * @brief Create an empty history.
+         * @param capacityBytes Memory cap for encoded records.
+         */
+        explicit RewindBuffer(size_t capacityBytes = kDefaultCapacity);
+
+        /**
+         * @brief Change the memory cap, evicting the oldest records if needed.
+         * @param bytes New cap in bytes (0 disables the history).
+         */
+        void setCapacity(size_t bytes);
+
+        /**
+         * @brief Memory cap in bytes.
+         */
+        size_t capacity() const {
+            return capacity_;
+        }
+
+        /**
+         * @brief Bytes currently reserved for records.
+         */
+        size_t memoryUsed() const {
+            return arena_.size();
+        }
+
+        /**
+         * @brief Number of changes that can be undone.
+         */
+        size_t depth() const {
+            return count_;
+        }
+
+        /**
+         * @brief Drop all records (e.g. after the grid changed size).
+         */
+        void clear();
+
+        /**
+         * @brief State bits encoded by the next records (1 for two-state rules, 2 for up to four states).
+         *
+         * Records of one plane stay valid: undo() decodes every record as two planes.
+         */
+        void setPlanes(int planes) {
+            planes_ = planes;
+        }
+
+        /**
+         * @brief Record one generation.
+         * @param prev State before the step (count bytes).
+         * @param next State after the step.
+         * @param count Number of cells.
+         */
+        void recordStep(const uint8_t* prev, const uint8_t* next, size_t count);
+
+        /**
+         * @brief Record an edit that replaced cells without advancing the generation.
+         * @param prev State before the edit.
+         * @param next State after the edit.
+         * @param count Number of cells.
+         */
+        void recordEdit(const uint8_t* prev, const uint8_t* next, size_t count);
+
+        /**
+         * @brief Record clearing the grid (call before clearing).
+         * @param prev State before the clear.
+         * @param count Number of cells.
+         */
+        void recordClear(const uint8_t* prev, size_t count);
+
+        /**
+         * @brief Record an edit confined to a contiguous range of cells (call after editing).
+         *
+         * Only the range is scanned, so small edits on huge grids stay cheap. A keyframe that
+         * falls due here is taken by the next full record instead.
+         * @param before Cells begin..end-1 before the edit.
+         * @param after Cells begin..end-1 after the edit.
+         * @param begin Index of the first cell of the range.
+         * @param end Index one past the last cell of the range.
+         * @param count Number of cells of the grid.
+         */
+        void recordRegion(const uint8_t* before, const uint8_t* after, size_t begin, size_t end, size_t count);
+
+        /**
+         * @brief Undo the newest changes in place.
+         *
+         * Walks the deltas back from the current state, or starts from the nearest keyframe
+         * when that decodes fewer bytes.
+         * @param n Number of changes to undo (clamped to depth()).
+         * @param cells Current state, updated in place (count bytes).
+         * @param count Number of cells.
+         * @return Number of undone changes that were steps (generations to subtract).
+         */
+        uint64_t undo(size_t n, uint8_t* cells, size_t count);
+
+        static constexpr size_t kDefaultCapacity = size_t(256) << 20; // 256 MB
+        static constexpr int kKeyframeInterval = 64;                  // changes between keyframes
+        static constexpr int kMaxPlanes = 2;                          // state bits of the largest rule
+
+    private:
+        struct Record {
+            size_t offset = 0;       // start of the record in arena_
+            uint32_t keyBytes = 0;   // encoded state before the change (0 if not a keyframe)
+            uint32_t deltaBytes = 0; // encoded XOR delta, stored after the keyframe
+            bool step = false;       // advanced the generation
+        };
+
+        // Append scratch_ (keyframe bytes first, then delta bytes) as a new record
+        void push(size_t keyBytes, bool step);
+
+        // Reserve bytes for a new record and return its offset, evicting or growing as needed
+        bool reserve(size_t bytes, size_t& offset);
+
+        // Double the arena (up to the cap), keeping records in order
+        bool grow(size_t minBytes);
+
+        // Encode the state before the change as a keyframe if one is due
+        size_t encodeKeyframe(const uint8_t* prev, size_t count);
+
+        Record& at(size_t i) {
+            return records_[(first_ + i) % records_.size()];
+        }
+
+        void popOldest();
+
+        size_t capacity_ = 0;
+        std::vector<uint8_t> arena_;      // byte ring holding encoded records
+        std::vector<Record> records_;     // record ring, oldest at first_
+        size_t first_ = 0;
+        size_t count_ = 0;
+        int sinceKeyframe_ = 0;           // changes recorded since the last keyframe
+        int planes_ = 1;                  // state bits encoded per record
+        std::vector<uint8_t> scratch_;    // encode buffer, capacity reused
+    };
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+    class Simulation;
+
+    /**
+     * @brief Steps several simulations on the shared thread pool.
+     *
+     * Every frame each simulation reports the steps its speed made due, and the scheduler
+     * runs them in rounds: a round advances every simulation that still has steps left by
+     * one generation, with the bands of all of them in a single work-stealing parallelFor.
+     * N simulations therefore share one set of threads instead of each spawning its own,
+     * and a small grid's idle threads steal bands from a big one. Bands of higher-priority
+     * simulations are queued first.
+     *
+     * When two or more simulations have steps due and those cost more CPU time than the
+     * frame budget, the budget is split in proportion to their priorities (fair share: a
+     * simulation needing less than its share passes the rest on) and the steps beyond a
+     * simulation's share are dropped, which slows it down instead of the frame rate. Every
+     * simulation with steps due still gets at least one. A lone simulation steps everything
+     * due, as Simulation::advance() does.
+     */
+    class SimulationScheduler {
+    public:
+        /**
+         * @brief Create an empty scheduler.
+         * @param frameBudgetSeconds Wall time per frame the steps may take on the whole pool.
+         */
+        explicit SimulationScheduler(double frameBudgetSeconds = kDefaultFrameBudget);
+
+        /**
+         * @brief Schedule a simulation; it must outlive its registration.
+         * @param simulation Simulation to step in advance().
+         * @param priority Weight in [1, kMaxPriority].
+         * @return Id for remove() and setPriority().
+         */
+        int add(Simulation& simulation, int priority = 1);
+
+        /**
+         * @brief Stop scheduling a simulation added with add().
+         * @param id Id returned by add().
+         */
+        void remove(int id);
+
+        /**
+         * @brief Change the weight of a simulation.
+         * @param id Id returned by add().
+         * @param priority Weight, clamped to [1, kMaxPriority].
+         */
+        void setPriority(int id, int priority);
+
+        /**
+         * @brief Weight of a simulation (0 for an unknown id).
+         */
+        int priority(int id) const;
+
+        /**
+         * @brief Fraction of the stepping time of the last busy frame spent on a simulation.
+         */
+        double share(int id) const;
+
+        /**
+         * @brief Number of scheduled simulations.
+         */
+        size_t size() const {
+            return entries_.size();
+        }
+
+        /**
+         * @brief Advance every simulation according to elapsed time (GL thread).
+         * @param dt Delta time in seconds since last frame.
+         */
+        void advance(double dt);
+
+        static constexpr double kDefaultFrameBudget = 0.012;
+        static constexpr int kMaxPriority = 8;
+
+    private:
+        struct Entry {
+            int id = 0;
+            Simulation* simulation = nullptr;
+            int priority = 1;
+            double secondsPerStep = 0.0;  // smoothed CPU seconds of one step, 0 until measured
+            int granted = 0;              // steps to run this frame
+            double frameSeconds = 0.0;    // CPU seconds spent this frame
+            double share = 0.0;           // fraction of the last busy frame
+        };
+
+        // Cut the granted steps down to fair shares of the frame budget
+        void allocate();
+
+        // Step every simulation granted more than round steps by one generation
+        void runRound(int round);
+
+        Entry* find(int id);
+        const Entry* find(int id) const;
+
+        double frameBudget_ = kDefaultFrameBudget;
+        std::vector<Entry> entries_;                // highest priority first
+        int nextId_ = 1;
+        std::vector<size_t> participants_;          // entries stepped in the current round
+        std::vector<std::pair<size_t, int>> jobs_;  // (entry, band) of the current round
+        std::vector<double> jobSeconds_;            // CPU seconds of each job
+    };
+
+}
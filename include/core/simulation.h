@@ -1,11 +1,37 @@
 #pragma once
 
+#include "core/components.h"
+#include "core/editBatch.h"
 #include "core/gameLogic.h"
+#include "core/rewindBuffer.h"
 
 #include <glad/glad.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace core {
 
+    /**
+     * @brief Kind of change reported to frame listeners.
+     */
+    enum class FrameChange {
+        Step,   // a new generation was computed
+        Edit,   // cells were edited in place (same size)
+        Reset   // the grid was resized or replaced
+    };
+
+    /**
+     * @brief Callback invoked after every change of the grid.
+     *
+     * Runs on the simulation thread right after the change, once the GL textures reflect
+     * it (so listeners may render); it must be cheap (copy what it needs and hand it off)
+     * so it never slows stepping down.
+     */
+    using FrameListener = std::function<void(const Life& life, uint64_t generation, FrameChange change)>;
+
     /**
      * @brief Simulation wrapper around Life and its GPU state texture.
      *
@@ -37,12 +63,142 @@ namespace core {
         }
 
         /**
-         * @brief OpenGL texture handle containing the state (GL_R8).
+         * @brief Rule applied by every step (kept across resizes and loads).
+         */
+        const LifeRule& rule() const {
+            return life_.rule();
+        }
+
+        /**
+         * @brief Change the rule; takes effect at the next step.
+         *
+         * Cells in states the new rule does not have are cleared, as one undoable edit.
+         * @param rule Rule with range in [1, kMaxRange] and states in [2, kMaxStates].
+         */
+        void setRule(const LifeRule& rule);
+
+        /**
+         * @brief How the edges of the grid are glued (kept across resizes and loads).
+         */
+        Topology topology() const {
+            return life_.topology();
+        }
+
+        /**
+         * @brief Change the topology; takes effect at the next step.
+         */
+        void setTopology(Topology topology) {
+            life_.setTopology(topology);
+            labelsDirty_ = true; // objects touching the edges join or split
+        }
+
+        /**
+         * @brief OpenGL texture handle containing the state (GL_R8, the state index of each cell).
          */
         GLuint stateTexture() const {
             return tex_;
         }
 
+        /**
+         * @brief OpenGL buffer with the live-cell indices (one uint32 per instance).
+         */
+        GLuint liveCellBuffer() const {
+            return liveBuf_;
+        }
+
+        /**
+         * @brief Number of live-cell indices currently stored in liveCellBuffer().
+         */
+        GLsizei liveCellCount() const {
+            return liveCount_;
+        }
+
+        /**
+         * @brief Enable or disable the live-cell list used for instanced rendering.
+         * @param enabled True to compact live cells on every step and upload them.
+         */
+        void setLiveCellsEnabled(bool enabled);
+
+        /**
+         * @brief True if the live-cell list is maintained.
+         */
+        bool liveCellsEnabled() const {
+            return life_.liveCellsEnabled();
+        }
+
+        /**
+         * @brief OpenGL texture with the per-cell age/trail plane (GL_R8), or 0 if disabled.
+         */
+        GLuint ageTexture() const {
+            return ageTex_;
+        }
+
+        /**
+         * @brief Enable or disable age/trail tracking and its texture.
+         * @param enabled True to update ages on every step and upload them.
+         */
+        void setAgeEnabled(bool enabled);
+
+        /**
+         * @brief True if the age/trail plane is maintained.
+         */
+        bool ageEnabled() const {
+            return life_.ageEnabled();
+        }
+
+        /**
+         * @brief Step in place to halve the grid memory (see Life::setInPlace()).
+         *
+         * In-place steps leave no previous generation to diff against, so each one clears
+         * the rewind history: only edits made since the last step can be undone.
+         * @param enabled True to step in place when the rule allows it.
+         */
+        void setInPlace(bool enabled) {
+            life_.setInPlace(enabled);
+        }
+
+        /**
+         * @brief True if in-place stepping was requested.
+         */
+        bool inPlace() const {
+            return life_.inPlace();
+        }
+
+        /**
+         * @brief OpenGL texture with the per-cell component colour index (GL_R8), or 0 if disabled.
+         */
+        GLuint labelTexture() const {
+            return labelTex_;
+        }
+
+        /**
+         * @brief Enable or disable connected-component labeling and its texture.
+         * @param enabled True to label the grid in updateLabels() after every change.
+         */
+        void setLabelsEnabled(bool enabled);
+
+        /**
+         * @brief True if components are labeled.
+         */
+        bool labelsEnabled() const {
+            return labeler_ != nullptr;
+        }
+
+        /**
+         * @brief Relabel the grid and upload the label texture if it changed since the last call.
+         *
+         * Call once per frame before drawing: labeling costs about as much as a step, so
+         * it follows the display rather than every generation.
+         */
+        void updateLabels();
+
+        /**
+         * @brief Components of the last updateLabels() call, or null if labeling is disabled.
+         */
+        const ComponentLabeler* labeler() const {
+            return labeler_.get();
+        }
+
         /**
          * @brief Set fixed-step simulation frequency.
          * @param sps Steps per second (> 0).
@@ -57,10 +213,27 @@ namespace core {
         }
 
         /**
-         * @brief Toggle running/paused state.
+         * @brief Toggle running/paused state (stops rewinding).
          */
         void toggleRun() {
             running_ = !running_;
+            rewinding_ = false;
+        }
+
+        /**
+         * @brief Play the history backwards at the current speed (stops running).
+         * @param rewinding True to rewind, false to pause.
+         */
+        void setRewinding(bool rewinding) {
+            rewinding_ = rewinding && rewind_.depth() > 0;
+            if (rewinding_) running_ = false;
+        }
+
+        /**
+         * @brief True while the history is played backwards.
+         */
+        bool isRewinding() const {
+            return rewinding_;
         }
 
         /**
@@ -70,6 +243,49 @@ namespace core {
             return running_;
         }
 
+        /**
+         * @brief Seconds until advance() next changes the grid, or -1 while paused.
+         */
+        double secondsToNextStep() const;
+
+        /**
+         * @brief Account elapsed time and return the steps it makes due (at most 240).
+         *
+         * advance() is takeDueSteps() followed by that many stepOnce() calls. While
+         * rewinding, the history is undone here and 0 is returned.
+         * @param dt Delta time in seconds since last frame.
+         */
+        int takeDueSteps(double dt);
+
+        /**
+         * @brief Number of bands a step splits into (see beginStep()).
+         */
+        int bands() const {
+            return life_.bands();
+        }
+
+        /**
+         * @brief stepOnce() in parts, for schedulers that run the bands of several simulations together.
+         *
+         * beginStep(), then stepBand(b) for every band from any threads, then endStep() on
+         * the GL thread, which records the history, uploads and notifies listeners.
+         */
+        void beginStep() {
+            life_.beginStep();
+        }
+
+        /**
+         * @brief Compute one band of the next generation (see beginStep()).
+         */
+        void stepBand(int band) {
+            life_.stepBand(band);
+        }
+
+        /**
+         * @brief Finish a step started with beginStep() (GL thread).
+         */
+        void endStep();
+
         /**
          * @brief Advance the simulation according to elapsed time.
          * @param dt Delta time in seconds since last frame.
@@ -81,18 +297,62 @@ namespace core {
          */
         void stepOnce();
 
+        /**
+         * @brief Undo the newest change (a step or an edit).
+         * @return False if the history is empty.
+         */
+        bool stepBack();
+
+        /**
+         * @brief Number of changes that can be undone.
+         */
+        size_t rewindDepth() const {
+            return rewind_.depth();
+        }
+
+        /**
+         * @brief Memory cap of the rewind history.
+         * @param bytes Cap in bytes (0 disables the history).
+         */
+        void setRewindCapacity(size_t bytes) {
+            rewind_.setCapacity(bytes);
+        }
+
+        /**
+         * @brief Bytes currently reserved by the rewind history.
+         */
+        size_t rewindMemory() const {
+            return rewind_.memoryUsed();
+        }
+
         /**
          * @brief Clear all cells to dead.
          */
         void clear();
 
         /**
-         * @brief Toggle a single cell.
+         * @brief Toggle a single cell immediately (together with any queued edits).
          * @param x Column index.
          * @param y Row index.
          */
         void toggleCell(int x, int y);
 
+        /**
+         * @brief Edits queued for the next applyEdits() call.
+         */
+        EditBatch& edits() {
+            return edits_;
+        }
+
+        /**
+         * @brief Apply all queued edits in one pass (call once per frame).
+         *
+         * Records one rewind entry, refreshes ages and live cells, uploads the bounding box
+         * of the touched cells as one texture region and notifies listeners once. Nothing is
+         * recorded or notified if the edits left the grid unchanged.
+         */
+        void applyEdits();
+
         /**
          * @brief Resize the grid, preserving the bottom rows/left columns overlap.
          * @param newW New number of columns.
@@ -100,22 +360,108 @@ namespace core {
          */
         void resize(int newW, int newH);
 
+        /**
+         * @brief Replace the whole grid (e.g. with a loaded pattern), keeping options.
+         * @param life New grid; its size becomes the simulation size.
+         */
+        void replace(Life&& life);
+
+        /**
+         * @brief Overwrite all cells with a same-size generation (e.g. a playback frame).
+         * @param cells Row-major cells (width*height bytes, states below rule().states).
+         */
+        void setCells(const uint8_t* cells);
+
+        /**
+         * @brief Hand out the cells for a background save without holding up stepping.
+         *
+         * Right after a step, the previous generation is swapped out of Life's double
+         * buffer (see Life::swapPrevious()), which costs no copy; otherwise (paused,
+         * edited since the last step, or stepping in place) the current cells are copied.
+         * @param spare Receives width*height cells; its old storage may become Life's work buffer.
+         * @return Generation of the cells in spare.
+         */
+        uint64_t snapshot(Life::Buffer& spare);
+
+        /**
+         * @brief Number of generations computed since the simulation was created.
+         */
+        uint64_t generation() const {
+            return generation_;
+        }
+
+        /**
+         * @brief Register a callback for every step, edit and reset.
+         * @param listener Callback to invoke.
+         * @return Id for removeFrameListener().
+         */
+        int addFrameListener(FrameListener listener);
+
+        /**
+         * @brief Unregister a callback added with addFrameListener().
+         * @param id Listener id.
+         */
+        void removeFrameListener(int id);
+
+        /**
+         * @brief Read-only access to the CPU grid (e.g. for saving).
+         */
+        const Life& life() const {
+            return life_;
+        }
+
     private:
         // Upload entire CPU buffer to the GL texture
         void uploadAll();
 
-        // Upload a single cell to the GL texture
-        void uploadCell(int x, int y);
+        // Upload a rectangle of the CPU buffers to the GL textures
+        void uploadRegion(const CellRect& r);
+
+        // Upload the compacted live-cell list to its GL buffer
+        void uploadLiveCells();
+
+        // (Re)allocate the age texture for the current size and upload it
+        void allocateAgeTexture();
+
+        // (Re)allocate the label texture for the current size (contents follow in updateLabels())
+        void allocateLabelTexture();
+
+        // Re-specify textures and derived data after the grid changed size or contents
+        void onGridReplaced();
+
+        // Notify frame listeners
+        void notify(FrameChange change);
+
+        // Record a computed step in the rewind history, upload it and notify listeners
+        void finishStep();
+
+        // Undo up to n changes and refresh derived data and textures
+        void undo(size_t n);
 
     private:
         Life life_;                  // cpu-side state
         int width_ = 0;              // number of columns
         int height_ = 0;             // number of rows
         GLuint tex_ = 0;             // gl texture containing the state (GL_R8)
+        GLuint liveBuf_ = 0;         // gl buffer with live-cell indices (uint32)
+        GLsizei liveCount_ = 0;      // number of indices in liveBuf_
+        GLuint ageTex_ = 0;          // gl texture with the age/trail plane (GL_R8), 0 if disabled
+        GLuint labelTex_ = 0;        // gl texture with component colour indices (GL_R8), 0 if disabled
+        std::unique_ptr<ComponentLabeler> labeler_; // null if labeling is disabled
+        bool labelsDirty_ = false;   // the grid changed since the last updateLabels()
 
         bool running_ = false;       // play/pause flag
         float stepsPerSec_ = 5.0f;   // fixed step frequency
         double accumulator_ = 0.0;   // accumulator for fixed stepping
+        uint64_t generation_ = 0;    // generations computed so far
+        bool rewinding_ = false;     // advance() plays the history backwards
+        bool previousIsParent_ = false; // Life's work buffer holds the generation before the current one
+        RewindBuffer rewind_;        // XOR deltas of recent changes
+        EditBatch edits_;            // edits queued for applyEdits()
+        std::vector<uint8_t> editBefore_; // rows touched by applyEdits(), before the edits
+
+        std::vector<std::pair<int, FrameListener>> listeners_; // (id, callback)
+        int nextListenerId_ = 1;
     };
 
 }
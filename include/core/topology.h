@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace core {
+
+    /**
+     * @brief How the edges of the grid are glued together.
+     */
+    enum class Topology {
+        Torus,            // left-right and top-bottom edges wrap
+        KleinBottle,      // wraps, but crossing the left/right edge mirrors the row (y -> height-1-y)
+        ProjectivePlane,  // both edge pairs wrap with a mirror (cross-surface)
+        Bounded           // cells outside the grid are always dead
+    };
+
+    /**
+     * @brief Display name of a topology.
+     */
+    inline const char* topologyName(Topology topology) {
+        switch (topology) {
+        case Topology::KleinBottle: return "Klein bottle";
+        case Topology::ProjectivePlane: return "Projective plane";
+        case Topology::Bounded: return "Bounded";
+        default: return "Torus";
+        }
+    }
+
+    /**
+     * @brief Compile-time edge rules of one topology.
+     *
+     * Only the border of the grid needs them: kernels read interior neighbours directly
+     * and call fold() for cells whose neighbourhood leaves the grid.
+     */
+    template <Topology T>
+    struct TopologyPolicy {
+        static constexpr Topology kTopology = T;
+        static constexpr bool kBounded = T == Topology::Bounded;
+        static constexpr bool kMirrorAcrossX = T == Topology::KleinBottle || T == Topology::ProjectivePlane; // mirrors y
+        static constexpr bool kMirrorAcrossY = T == Topology::ProjectivePlane;                              // mirrors x
+
+        /**
+         * @brief Map a coordinate, any distance outside the grid, onto the cell it is glued to.
+         * @return False if it lies outside a bounded grid.
+         */
+        static bool fold(int& x, int& y, int width, int height) {
+            const int crossX = floorDiv(x, width);
+            if constexpr (kBounded) {
+                return crossX == 0 && floorDiv(y, height) == 0;
+            }
+            x -= crossX * width;
+            if (kMirrorAcrossX && (crossX & 1)) y = height - 1 - y;
+            const int crossY = floorDiv(y, height);
+            y -= crossY * height;
+            if (kMirrorAcrossY && (crossY & 1)) x = width - 1 - x;
+            return true;
+        }
+
+        /**
+         * @brief State of cell (x, y) after folding (0 outside a bounded grid).
+         */
+        static uint8_t cell(const uint8_t* cells, int x, int y, int width, int height) {
+            if (!fold(x, y, width, height)) return 0;
+            return cells[static_cast<size_t>(y) * width + x];
+        }
+
+        /**
+         * @brief Row r (any integer) with pad cells on each side, as the topology glues them.
+         * @param out Receives width + 2 * pad cells.
+         */
+        static void row(const uint8_t* cells, int width, int height, int r, int pad, uint8_t* out) {
+            for (int i = 0; i < pad; ++i) {
+                out[i] = cell(cells, i - pad, r, width, height);
+                out[pad + width + i] = cell(cells, width + i, r, width, height);
+            }
+
+            // The row itself is a whole grid row, mirrored when reached across a mirroring edge
+            int x = 0, y = r;
+            if (!fold(x, y, width, height)) {
+                std::memset(out + pad, 0, static_cast<size_t>(width));
+                return;
+            }
+            const uint8_t* src = cells + static_cast<size_t>(y) * width;
+            if (x == 0) std::memcpy(out + pad, src, static_cast<size_t>(width));
+            else std::reverse_copy(src, src + width, out + pad);
+        }
+
+    private:
+        static int floorDiv(int a, int n) {
+            const int q = a / n;
+            return (a % n < 0) ? q - 1 : q;
+        }
+    };
+
+}
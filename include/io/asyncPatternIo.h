@@ -0,0 +1,69 @@
+#pragma once
+
+#include "core/gameLogic.h"
+#include "io/patternFile.h"
+
+#include <future>
+#include <optional>
+#include <string>
+
+namespace io {
+
+    /**
+     * @brief Outcome of a finished background load or save.
+     */
+    struct PatternIoResult {
+        bool ok = false;                 // false if the job threw
+        std::optional<core::Life> life;  // loaded grid (loads only)
+        std::string message;             // status or error text for the UI
+    };
+
+    /**
+     * @brief Runs pattern loads and saves on a background thread, one job at a time.
+     *
+     * The render loop starts a job and polls for its result once per frame; parsing,
+     * decoding and grid allocation never happen on the calling thread.
+     */
+    class AsyncPatternIo {
+    public:
+        AsyncPatternIo() = default;
+        ~AsyncPatternIo();
+
+        AsyncPatternIo(const AsyncPatternIo&) = delete;
+        AsyncPatternIo& operator=(const AsyncPatternIo&) = delete;
+
+        /**
+         * @brief True while a job is running or its result has not been polled.
+         */
+        bool busy() const {
+            return job_.valid();
+        }
+
+        /**
+         * @brief Start loading a file in the background.
+         * @param path Source file (.gol, .rle or .mc).
+         * @param opt Placement of imported patterns.
+         * @return False if another job is still pending.
+         */
+        bool load(const std::string& path, const ImportOptions& opt);
+
+        /**
+         * @brief Start saving a copy of the grid in the background.
+         * @param path Destination file (.gol, .rle or .mc).
+         * @param snapshot Copy of the grid to write (owned by the job).
+         * @return False if another job is still pending.
+         */
+        bool save(const std::string& path, core::Life snapshot);
+
+        /**
+         * @brief Collect the finished job without blocking.
+         * @param out Result of the job.
+         * @return True if a job finished and out was filled.
+         */
+        bool poll(PatternIoResult& out);
+
+    private:
+        std::future<PatternIoResult> job_;
+    };
+
+}
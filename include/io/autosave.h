@@ -0,0 +1,78 @@
+#pragma once
+
+#include "core/gameLogic.h"
+
+#include <cstdint>
+#include <future>
+#include <string>
+
+namespace io {
+
+    /**
+     * @brief Outcome of a finished autosave.
+     */
+    struct AutosaveResult {
+        bool ok = false;          // false if the write failed
+        uint64_t generation = 0;  // generation that was saved
+        std::string message;      // status or error text for the UI
+    };
+
+    /**
+     * @brief Writes periodic checkpoints on a background thread, one at a time.
+     *
+     * The caller fills buffer() (cheaply, with core::Simulation::snapshot()) and starts a
+     * save; compression, the write, fsync and the atomic rename (see saveSnapshotDurable())
+     * all run on the worker, so stepping never waits on the disk. The buffer comes back
+     * with the result and is reused, which keeps checkpoints free of allocations.
+     */
+    class Autosaver {
+    public:
+        Autosaver() = default;
+        ~Autosaver();
+
+        Autosaver(const Autosaver&) = delete;
+        Autosaver& operator=(const Autosaver&) = delete;
+
+        /**
+         * @brief True while a save is running or its result has not been polled.
+         */
+        bool busy() const {
+            return job_.valid();
+        }
+
+        /**
+         * @brief Cells of the next save; only valid while not busy().
+         */
+        core::Life::Buffer& buffer() {
+            return buffer_;
+        }
+
+        /**
+         * @brief Start writing buffer() in the background.
+         * @param path Destination snapshot (.gol).
+         * @param width Grid width of the buffered cells.
+         * @param height Grid height of the buffered cells.
+         * @param generation Generation of the buffered cells, reported back in the result.
+         * @param rule Rule of the buffered cells; multi-state rules are saved with their states.
+         * @return False if the previous save is still pending.
+         */
+        bool save(const std::string& path, int width, int height, uint64_t generation, const core::LifeRule& rule);
+
+        /**
+         * @brief Collect the finished save without blocking.
+         * @param out Result of the save.
+         * @return True if a save finished and out was filled.
+         */
+        bool poll(AutosaveResult& out);
+
+    private:
+        struct Job {
+            AutosaveResult result;
+            core::Life::Buffer cells;   // handed back to buffer_
+        };
+
+        core::Life::Buffer buffer_;
+        std::future<Job> job_;
+    };
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "core/domain.h"
+#include "core/gameLogic.h"
+#include "io/transport.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace io {
+
+    /**
+     * @brief One process of a grid split across processes.
+     *
+     * Each rank owns one subdomain of the layout. step() refreshes the halos from the
+     * neighbours every `halo` generations (two exchanges: columns, then rows with corners)
+     * and computes the generations in between locally, so fewer, larger messages trade a
+     * little redundant work at the edges for latency. The rule is Conway's on a torus (see
+     * core::Subdomain): results are identical to core::Life::step() with the default rule
+     * and topology, not to a Life set to another one.
+     *
+     * scatter() and gather() move the whole grid between rank 0 and the others, e.g. to
+     * load a pattern or to render a frame. All ranks must make the same calls in the same
+     * order.
+     */
+    class DistributedLife {
+    public:
+        /**
+         * @brief Set up this rank's subdomain (all cells dead).
+         * @param layout Split of the grid; layout.ranks() must equal transport.ranks().
+         * @param halo Ghost-cell depth, i.e. generations per exchange (1..layout.maxHalo()).
+         * @param transport Connected transport; must reach the ranks listed by peers().
+         * @throws std::runtime_error if the layout, halo and transport do not fit together.
+         */
+        DistributedLife(const core::DomainLayout& layout, int halo, Transport& transport);
+
+        /**
+         * @brief Ranks a process talks to: its four neighbours and rank 0 (rank 0: everyone).
+         * @param layout Split of the grid.
+         * @param rank Process number.
+         */
+        static std::vector<int> peers(const core::DomainLayout& layout, int rank);
+
+        /**
+         * @brief Distribute a grid from rank 0.
+         * @param life Whole grid of the layout's size on rank 0; ignored (may be null) elsewhere.
+         */
+        void scatter(const core::Life* life);
+
+        /**
+         * @brief Collect the whole grid on rank 0.
+         * @param life Grid of the layout's size that receives the cells on rank 0; ignored elsewhere.
+         */
+        void gather(core::Life* life);
+
+        /**
+         * @brief Advance all subdomains together.
+         * @param generations Generations to compute.
+         */
+        void step(uint64_t generations);
+
+        /**
+         * @brief Generations computed since construction.
+         */
+        uint64_t generation() const {
+            return generation_;
+        }
+
+        /**
+         * @brief This rank's part of the grid.
+         */
+        const core::Subdomain& subdomain() const {
+            return sub_;
+        }
+
+    private:
+        // Fill the halos from the neighbours: west/east columns first, then south/north rows
+        void exchangeHalos();
+
+        core::DomainLayout layout_;
+        Transport& transport_;
+        core::Subdomain sub_;
+        uint64_t generation_ = 0;
+        std::vector<uint8_t> outA_, outB_, inA_, inB_; // strip buffers, reused every exchange
+        std::vector<uint8_t> parts_;                    // subdomain interiors on rank 0
+    };
+
+}
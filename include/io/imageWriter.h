@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace io {
+
+    /**
+     * @brief Write an RGBA8 image as PNG (zlib level 1: fast, still small for flat renders).
+     * @param path Destination file.
+     * @param rgba Pixels, width*height*4 bytes.
+     * @param width Image width.
+     * @param height Image height.
+     * @param bottomUp True if rows are stored bottom row first (glReadPixels order).
+     * @param scratch Reusable buffer for the filtered and compressed data.
+     * @throws std::runtime_error on I/O or compression failure.
+     */
+    void writePng(const std::string& path, const uint8_t* rgba, int width, int height, bool bottomUp, std::vector<uint8_t>& scratch);
+
+    /**
+     * @brief Write an RGBA8 image as headerless raw pixels, top row first.
+     *
+     * Frames can be fed to an encoder as `-f rawvideo -pix_fmt rgba -s WxH`.
+     * @param path Destination file.
+     * @param rgba Pixels, width*height*4 bytes.
+     * @param width Image width.
+     * @param height Image height.
+     * @param bottomUp True if rows are stored bottom row first (glReadPixels order).
+     * @throws std::runtime_error on I/O failure.
+     */
+    void writeRaw(const std::string& path, const uint8_t* rgba, int width, int height, bool bottomUp);
+
+}
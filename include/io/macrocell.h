@@ -0,0 +1,32 @@
+#pragma once
+
+#include "io/patternFile.h"
+
+namespace io {
+
+    /**
+     * @brief Load a two-state Macrocell (.mc) pattern into a new grid.
+     *
+     * Lines are read one at a time; memory is the node table (proportional to the number
+     * of distinct quadtree nodes, not to the pattern area) plus the output grid, which
+     * is sized to the bounding box of the live cells.
+     * @param path Source file.
+     * @param opt Placement options.
+     * @return Grid with the pattern centered in it.
+     * @throws std::runtime_error on I/O or format errors.
+     */
+    core::Life readMacrocell(const char* path, const ImportOptions& opt);
+
+    /**
+     * @brief Write the grid as a Macrocell quadtree.
+     *
+     * Identical 8x8 leaves and subtrees are shared and each node is written as soon as
+     * it is created, so only one level of the tree is held in memory at a time.
+     * @param path Destination file.
+     * @param life Grid to save.
+     * @throws std::runtime_error on I/O errors, or if the grid has a multi-state rule
+     *         (use .rle or .gol, which keep the states).
+     */
+    void writeMacrocell(const char* path, const core::Life& life);
+
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "core/domain.h"
+#include "utils/mappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace io {
+
+    /**
+     * @brief On-disk header of an out-of-core grid file (.cells), little-endian, 32 bytes.
+     *
+     * The cells follow at kOutOfCoreDataOffset: `height` rows of `width` bytes, row 0
+     * first, one byte per cell (0 = dead, 1 = alive), so the mapping is the grid itself.
+     */
+    struct OutOfCoreHeader {
+        char magic[4] = {'G', 'O', 'L', 'C'};
+        uint32_t version = 1;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint64_t generation = 0;     // generations computed since the file was created
+        uint64_t reserved = 0;
+    };
+
+    static_assert(sizeof(OutOfCoreHeader) == 32, "OutOfCoreHeader must stay 32 bytes");
+
+    constexpr size_t kOutOfCoreDataOffset = 4096; // cells start on a page boundary
+
+    /**
+     * @brief Throughput of OutOfCoreLife::step().
+     */
+    struct OutOfCoreStats {
+        uint64_t generations = 0;
+        uint64_t passes = 0;         // sweeps over the file
+        uint64_t bytesRead = 0;      // cells read, halo rows included
+        uint64_t bytesWritten = 0;   // cells written
+        double seconds = 0.0;
+
+        /**
+         * @brief Cells read and written per second, in MB/s.
+         */
+        double megabytesPerSecond() const {
+            return seconds > 0.0 ? static_cast<double>(bytesRead + bytesWritten) / 1e6 / seconds : 0.0;
+        }
+    };
+
+    /**
+     * @brief Conway's Game of Life on a toroidal grid kept in a memory-mapped file.
+     *
+     * For grids larger than RAM. Each pass streams the grid once, in bands of full rows:
+     * a band is loaded into a core::Subdomain with `generationsPerPass` halo rows read from
+     * its neighbours in the file (wrapping around), stepped that many generations, and
+     * written to a second file, which then becomes the current one. The file being read is
+     * read ahead one band and released behind, the one being written is released as soon
+     * as a band is done, so the resident set stays a few bands deep whatever the grid size.
+     * More generations per pass mean fewer passes over the disk for slightly wider halos.
+     * Results are identical to stepping the whole grid with core::Life::step().
+     */
+    class OutOfCoreLife {
+    public:
+        /**
+         * @brief Write a new grid file, one row at a time.
+         * @param path Destination file (overwritten).
+         * @param width Grid width.
+         * @param height Grid height.
+         * @param fillRow Called for y = 0..height-1 in order with the row to fill (width bytes, zeroed).
+         * @throws std::runtime_error on I/O failure.
+         */
+        static void create(const std::string& path, int width, int height, const std::function<void(int, uint8_t*)>& fillRow);
+
+        /**
+         * @brief Open a grid file for stepping.
+         * @param path Grid file (see create()).
+         * @param workPath Second file for the next generation (created or overwritten, same size).
+         * @param bandRows Minimum rows per band; the remainder is spread over the bands, and a shorter grid is one band.
+         * @param generationsPerPass Generations per pass over the file (1..band height and width).
+         * @throws std::runtime_error if a file cannot be mapped or is not a grid file, or the
+         *         bands are too thin for the generations per pass.
+         */
+        OutOfCoreLife(const std::string& path, const std::string& workPath, int bandRows, int generationsPerPass);
+
+        int width() const {
+            return width_;
+        }
+
+        int height() const {
+            return height_;
+        }
+
+        /**
+         * @brief Generation of the current file, as recorded in its header.
+         */
+        uint64_t generation() const {
+            return generation_;
+        }
+
+        /**
+         * @brief File that holds the current generation (path or workPath).
+         */
+        const std::string& currentPath() const {
+            return paths_[current_];
+        }
+
+        /**
+         * @brief Current generation, mapped (row-major, size = width*height).
+         */
+        const uint8_t* cells() const {
+            return files_[current_].data() + kOutOfCoreDataOffset;
+        }
+
+        /**
+         * @brief Advance the grid, generationsPerPass at a time.
+         * @param generations Generations to compute.
+         * @return Bytes moved and time taken.
+         * @throws std::runtime_error if the work file cannot be recreated.
+         */
+        OutOfCoreStats step(uint64_t generations);
+
+    private:
+        // One sweep over the file: `generations` generations from the current file into the other
+        void pass(int generations, OutOfCoreStats& stats);
+
+        // Subdomain for a band of the given height (bands come in at most two heights)
+        core::Subdomain& subdomainFor(int rows);
+
+        // Pack rows firstRow.. (wrapping) of the current file as a south/north halo strip
+        void packHaloRows(const uint8_t* cells, int firstRow, uint8_t* out) const;
+
+        std::string paths_[2];
+        utils::WritableMappedFile files_[2];
+        int current_ = 0;                     // index of the file holding the current generation
+        int width_ = 0;
+        int height_ = 0;
+        int bands_ = 1;
+        int generationsPerPass_ = 1;
+        uint64_t generation_ = 0;
+        std::vector<core::Subdomain> subdomains_; // one per band height
+        std::vector<uint8_t> strip_;          // halo strip being exchanged
+    };
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "core/gameLogic.h"
+
+#include <string>
+
+namespace io {
+
+    /**
+     * @brief Supported pattern and snapshot file formats.
+     */
+    enum class PatternFormat {
+        Snapshot,   // binary bit-packed snapshot (.gol)
+        Rle,        // run-length encoded pattern (.rle)
+        Macrocell   // hashed quadtree pattern (.mc)
+    };
+
+    /**
+     * @brief Placement of imported patterns.
+     *
+     * Patterns smaller than the minimum size are centered in a grid of that size so that
+     * loading a glider does not shrink the world to 3x3. Snapshots always keep their size.
+     */
+    struct ImportOptions {
+        int minWidth = 0;
+        int minHeight = 0;
+    };
+
+    /**
+     * @brief Detect the format from the file extension.
+     * @param path File path (.gol, .rle or .mc).
+     * @return Detected format.
+     * @throws std::runtime_error for unknown extensions.
+     */
+    PatternFormat formatFromPath(const std::string& path);
+
+    /**
+     * @brief Load a pattern or snapshot in any supported format.
+     * @param path Source file.
+     * @param opt Placement of imported patterns.
+     * @return New grid with the pattern.
+     * @throws std::runtime_error on I/O or format errors.
+     */
+    core::Life loadPattern(const std::string& path, const ImportOptions& opt);
+
+    /**
+     * @brief Save the current generation in the format given by the extension.
+     * @param path Destination file.
+     * @param life Grid to save.
+     * @throws std::runtime_error on I/O errors.
+     */
+    void savePattern(const std::string& path, const core::Life& life);
+
+    /**
+     * @brief Grid size for an imported pattern of the given size.
+     * @param patternW Pattern width in cells.
+     * @param patternH Pattern height in cells.
+     * @param opt Placement options.
+     * @param gridW Output grid width.
+     * @param gridH Output grid height.
+     * @throws std::runtime_error if the grid would exceed the engine limits.
+     */
+    void importGridSize(long long patternW, long long patternH, const ImportOptions& opt, int& gridW, int& gridH);
+
+}
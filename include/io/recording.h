@@ -0,0 +1,261 @@
+#pragma once
+
+#include "core/gameLogic.h"
+#include "io/snapshot.h"
+#include "utils/mappedFile.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace io {
+
+    /**
+     * @brief File header of a run recording (.golrec), little-endian, 32 bytes.
+     *
+     * The header is followed by frame records. Each record is a RecordingFrameHeader and
+     * its payload, a core::deltaCodec stream: keyframes encode the cells, delta frames
+     * encode the XOR with the previous frame.
+     *
+     * Version 2 recordings were made under a rule with more than two states: a
+     * SnapshotRule follows the header and the runs cover two bit planes, so cells keep
+     * their state (0..3). Version 1 recordings hold two-state cells and no rule.
+     */
+    struct RecordingHeader {
+        char magic[4] = {'G', 'O', 'L', 'R'};
+        uint32_t version = 1;           // 2 with a multi-state rule
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t keyframeInterval = 0;  // frames between keyframes
+        uint32_t reserved[3] = {0, 0, 0};
+    };
+
+    /**
+     * @brief Per-frame record header (16 bytes).
+     */
+    struct RecordingFrameHeader {
+        uint8_t keyframe = 0;        // 1 = keyframe, 0 = delta to the previous frame
+        uint8_t pad[3] = {0, 0, 0};
+        uint32_t payloadBytes = 0;
+        uint64_t generation = 0;     // simulation generation of this frame
+    };
+
+    static_assert(sizeof(RecordingHeader) == 32, "RecordingHeader must stay 32 bytes");
+    static_assert(sizeof(RecordingFrameHeader) == 16, "RecordingFrameHeader must stay 16 bytes");
+
+    /**
+     * @brief Streams a run to disk as keyframes plus XOR deltas.
+     *
+     * capture() only copies the grid into a recycled buffer and queues it; encoding and
+     * writing happen on a background thread. If the writer falls more than kMaxQueued
+     * frames behind, capture() waits for it so memory stays bounded. A recording holds
+     * one rule: stop it when the rule changes.
+     */
+    class Recorder {
+    public:
+        Recorder() = default;
+        ~Recorder();
+
+        Recorder(const Recorder&) = delete;
+        Recorder& operator=(const Recorder&) = delete;
+
+        /**
+         * @brief Create the file and start the writer thread.
+         * @param path Destination file.
+         * @param width Grid width.
+         * @param height Grid height.
+         * @param keyframeInterval Frames between keyframes (>= 1).
+         * @param rule Rule of the frames; a multi-state rule is stored with their states.
+         * @param error Error text on failure.
+         * @return True on success.
+         */
+        bool start(const std::string& path, int width, int height, int keyframeInterval, const core::LifeRule& rule,
+                   std::string& error);
+
+        /**
+         * @brief Queue the current generation as the next frame.
+         * @param life Grid (must match the recording size).
+         * @param generation Generation number stored with the frame.
+         */
+        void capture(const core::Life& life, uint64_t generation);
+
+        /**
+         * @brief Flush pending frames, close the file and join the writer.
+         */
+        void stop();
+
+        /**
+         * @brief True once a write failed (e.g. the disk is full); later frames are dropped.
+         *
+         * The file keeps the frames written before the failure. Call stop() to end the recording.
+         */
+        bool failed() const {
+            return failed_.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Why the recording failed, empty if it did not.
+         */
+        std::string lastError() const;
+
+        /**
+         * @brief True between start() and stop().
+         */
+        bool recording() const {
+            return file_ != nullptr;
+        }
+
+        /**
+         * @brief Frames written to disk so far.
+         */
+        uint64_t framesWritten() const {
+            return framesWritten_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Rule given to start().
+         */
+        const core::LifeRule& rule() const {
+            return rule_;
+        }
+
+        static constexpr size_t kMaxQueued = 16;
+
+    private:
+        struct Frame {
+            std::vector<uint8_t> cells;
+            uint64_t generation = 0;
+        };
+
+        void writerLoop();
+
+        // Record a write failure and release capture(); pending frames are dropped
+        void fail();
+
+        FILE* file_ = nullptr;
+        std::string path_;
+        size_t cellCount_ = 0;
+        int keyframeInterval_ = 1;
+        core::LifeRule rule_;
+        int planes_ = 1;                   // state bits per frame
+
+        mutable std::mutex mutex_;
+        std::condition_variable wake_;     // signals the writer
+        std::condition_variable drained_;  // signals capture() when the queue shrinks
+        std::deque<Frame> queue_;
+        std::vector<std::vector<uint8_t>> spare_; // recycled frame buffers
+        bool stopping_ = false;
+
+        std::thread writer_;
+        std::atomic<uint64_t> framesWritten_{0};
+        std::atomic<bool> failed_{false};
+        std::string error_;                // guarded by mutex_
+    };
+
+    /**
+     * @brief Random-access reader for recordings.
+     *
+     * The file is memory-mapped and its frame records are indexed on open. Seeking
+     * decodes the nearest keyframe and applies deltas, or walks deltas from the current
+     * position when that is shorter (XOR deltas apply in both directions).
+     */
+    class Player {
+    public:
+        /**
+         * @brief Open and index a recording.
+         * @param path Recording file.
+         * @param error Error text on failure.
+         * @return True on success.
+         */
+        bool open(const std::string& path, std::string& error);
+
+        /**
+         * @brief Close the file.
+         */
+        void close();
+
+        /**
+         * @brief True if a recording is open.
+         */
+        bool isOpen() const {
+            return file_.data() != nullptr;
+        }
+
+        int width() const {
+            return width_;
+        }
+
+        int height() const {
+            return height_;
+        }
+
+        /**
+         * @brief Rule of a multi-state recording; Conway's for two-state ones, which store none.
+         */
+        const core::LifeRule& rule() const {
+            return rule_;
+        }
+
+        /**
+         * @brief Number of frames in the recording.
+         */
+        size_t frameCount() const {
+            return frames_.size();
+        }
+
+        /**
+         * @brief Frame currently decoded in cells().
+         */
+        size_t position() const {
+            return position_;
+        }
+
+        /**
+         * @brief Generation number stored with a frame.
+         */
+        uint64_t generationAt(size_t frame) const {
+            return frames_[frame].generation;
+        }
+
+        /**
+         * @brief Decode a frame into cells().
+         * @param frame Frame index in [0, frameCount()).
+         * @return False if the frame is out of range or corrupt.
+         */
+        bool seek(size_t frame);
+
+        /**
+         * @brief Cells of the current frame (row-major, width*height bytes).
+         */
+        const std::vector<uint8_t>& cells() const {
+            return cells_;
+        }
+
+    private:
+        struct FrameRef {
+            size_t offset = 0;       // payload offset in the file
+            uint32_t bytes = 0;      // payload size
+            uint64_t generation = 0;
+            bool keyframe = false;
+        };
+
+        bool applyFrame(size_t frame);
+
+        utils::MappedFile file_;
+        int width_ = 0;
+        int height_ = 0;
+        core::LifeRule rule_;
+        int planes_ = 1;         // state bits per frame
+        std::vector<FrameRef> frames_;
+        std::vector<uint8_t> cells_;
+        size_t position_ = 0;
+        bool decoded_ = false;   // cells_ holds frame position_
+    };
+
+}
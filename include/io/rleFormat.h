@@ -0,0 +1,33 @@
+#pragma once
+
+#include "io/patternFile.h"
+
+namespace io {
+
+    /**
+     * @brief Stream an .rle pattern into a new grid.
+     *
+     * The file is read in fixed-size chunks and decoded directly into the grid, so
+     * memory use is the grid plus a small buffer regardless of the file size. A
+     * multi-state rule in the formatLifeRule() notation is set on the grid and its
+     * letters become states (A = 1, B = 2, ...); any other rule line is ignored and
+     * multi-state letters count as alive.
+     * @param path Source file.
+     * @param opt Placement options.
+     * @return Grid with the pattern centered in it.
+     * @throws std::runtime_error on I/O or format errors.
+     */
+    core::Life readRle(const char* path, const ImportOptions& opt);
+
+    /**
+     * @brief Stream the whole grid to an .rle file, one row at a time.
+     *
+     * Under a multi-state rule the file names the rule and writes the states as
+     * letters (. = dead, A = 1, B = 2, ...), as Golly does.
+     * @param path Destination file.
+     * @param life Grid to save.
+     * @throws std::runtime_error on I/O errors.
+     */
+    void writeRle(const char* path, const core::Life& life);
+
+}
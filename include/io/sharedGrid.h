@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace io {
+
+    /**
+     * @brief Cell encoding of a shared grid frame.
+     */
+    enum class SharedGridFormat : uint32_t {
+        Cells8 = 1   // one byte per cell, row-major, row 0 first: 0 dead, 1 alive, 2..3 the
+                     // extra states of multi-state rules (dying cells, WireWorld tails and wires)
+    };
+
+    /**
+     * @brief Layout of the shared grid segment, shared by the publisher and readers.
+     *
+     * The segment starts with a SharedGridHeader, followed by slotCount slots of
+     * slotStride bytes. Each slot is a SharedGridSlot immediately followed by the cells of
+     * one frame. The publisher fills the slots round-robin; frame n (counting from 1) is
+     * in slot (n - 1) % slotCount, and SharedGridHeader::published is n once it is
+     * complete.
+     *
+     * Every slot is guarded by a sequence lock: the sequence is odd while the publisher
+     * writes the slot and even otherwise. A reader notes the sequence, reads the slot in
+     * place and checks the sequence again; if it changed, the publisher has since reused
+     * the slot and the read must be discarded. The publisher never waits for readers.
+     *
+     * All fields a reader looks at before validating are atomics, so they can be read
+     * while being written. Both sides must be built for the same architecture.
+     */
+    struct SharedGridHeader {
+        char magic[4] = {'G', 'O', 'L', 'S'};
+        uint32_t version = 1;
+        uint32_t slotCount = 0;
+        uint32_t headerBytes = 0;                // offset of slot 0
+        uint64_t slotStride = 0;                 // bytes from one slot to the next
+        uint64_t capacity = 0;                   // cell bytes a slot can hold
+        std::atomic<uint64_t> published{0};      // frames completed so far, 0 if none
+        std::atomic<uint32_t> live{1};           // 0 once the publisher closed the segment
+        uint32_t reserved[5] = {0, 0, 0, 0, 0};
+    };
+
+    /**
+     * @brief Per-slot header (64 bytes), followed by the frame's cells.
+     */
+    struct SharedGridSlot {
+        std::atomic<uint64_t> sequence{0};       // odd while the slot is being written
+        std::atomic<uint64_t> frame{0};          // publish number of the frame in the slot
+        std::atomic<uint64_t> generation{0};     // simulation generation of the frame
+        std::atomic<uint32_t> width{0};
+        std::atomic<uint32_t> height{0};
+        std::atomic<uint32_t> format{0};         // SharedGridFormat
+        uint32_t reserved[7] = {0, 0, 0, 0, 0, 0, 0};
+    };
+
+    static_assert(sizeof(SharedGridHeader) == 64, "SharedGridHeader must stay 64 bytes");
+    static_assert(sizeof(SharedGridSlot) == 64, "SharedGridSlot must stay 64 bytes");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared grid sequence locks need lock-free 64-bit atomics");
+
+    /**
+     * @brief Segment name used by the application unless told otherwise.
+     */
+    constexpr const char* kDefaultSharedGridName = "gol-grid";
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "io/sharedGrid.h"
+#include "utils/sharedMemory.h"
+
+#include <cstdint>
+#include <string>
+
+namespace io {
+
+    /**
+     * @brief Publishes grid frames into a named shared-memory ring for other processes.
+     *
+     * Each publish() copies the cells into the next slot of the ring under its sequence
+     * lock (see SharedGridHeader), so readers in other processes map the segment and read
+     * frames in place with io::SharedGridReader. Readers never slow the publisher down: a
+     * reader that takes longer than slotCount - 1 frames simply sees its read invalidated.
+     *
+     * The segment is sized for the grid given to start(). A larger grid recreates it under
+     * the same name; readers notice the old one is closed and reopen.
+     */
+    class SharedGridPublisher {
+    public:
+        static constexpr int kDefaultSlots = 4;
+
+        SharedGridPublisher() = default;
+        ~SharedGridPublisher();
+
+        SharedGridPublisher(const SharedGridPublisher&) = delete;
+        SharedGridPublisher& operator=(const SharedGridPublisher&) = delete;
+
+        /**
+         * @brief Create the segment.
+         * @param name Segment name, e.g. kDefaultSharedGridName.
+         * @param width Grid width the slots are sized for.
+         * @param height Grid height the slots are sized for.
+         * @param slots Ring length (>= 2).
+         * @param error Error text on failure.
+         * @return True on success.
+         */
+        bool start(const std::string& name, int width, int height, int slots, std::string& error);
+
+        /**
+         * @brief Mark the segment closed for readers and remove it.
+         */
+        void stop();
+
+        /**
+         * @brief True between start() and stop().
+         */
+        bool active() const {
+            return !name_.empty();
+        }
+
+        /**
+         * @brief Copy one frame into the next slot (never waits for readers).
+         * @param cells Cells in SharedGridFormat::Cells8 layout.
+         * @param width Grid width.
+         * @param height Grid height.
+         * @param generation Generation stored with the frame.
+         */
+        void publish(const uint8_t* cells, int width, int height, uint64_t generation);
+
+        /**
+         * @brief Frames published since start().
+         */
+        uint64_t framesPublished() const {
+            return published_;
+        }
+
+        /**
+         * @brief Why the last publish() was dropped, empty if it was not.
+         */
+        const std::string& lastError() const {
+            return error_;
+        }
+
+        /**
+         * @brief Name of the segment, empty when inactive.
+         */
+        const std::string& name() const {
+            return name_;
+        }
+
+    private:
+        // Create a segment whose slots hold `capacity` cells; the frame counter carries over
+        bool createSegment(size_t capacity, std::string& error);
+
+        // Mark the mapped segment closed and unmap it
+        void closeSegment();
+
+        utils::SharedMemory memory_;
+        std::string name_;
+        std::string error_;
+        int slots_ = 0;
+        size_t capacity_ = 0;
+        uint64_t published_ = 0;
+    };
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "io/sharedGrid.h"
+#include "utils/sharedMemory.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace io {
+
+    /**
+     * @brief One frame of a shared grid, viewed in place.
+     */
+    struct SharedGridFrame {
+        const uint8_t* cells = nullptr;  // width * height cells inside the shared segment
+        int width = 0;
+        int height = 0;
+        SharedGridFormat format = SharedGridFormat::Cells8;
+        uint64_t generation = 0;         // simulation generation
+        uint64_t frame = 0;              // publish number (gaps mean frames were skipped)
+        uint32_t slot = 0;               // ring slot holding the frame
+        uint64_t sequence = 0;           // slot sequence when the frame was taken
+    };
+
+    /**
+     * @brief Reads frames published by io::SharedGridPublisher in another process.
+     *
+     * Reading is zero-copy: latest() returns a view into the shared segment, and valid()
+     * tells afterwards whether the publisher overwrote the slot meanwhile, in which case
+     * whatever was computed from the view must be discarded. The publisher keeps
+     * slotCount - 1 older frames, so a read stays valid for that many new generations.
+     *
+     * This class only depends on the standard library and utils::SharedMemory, so tools
+     * can link the small GameOfLifeReader library instead of the whole application.
+     */
+    class SharedGridReader {
+    public:
+        SharedGridReader() = default;
+
+        SharedGridReader(const SharedGridReader&) = delete;
+        SharedGridReader& operator=(const SharedGridReader&) = delete;
+
+        /**
+         * @brief Map a published segment read-only.
+         * @param name Segment name used by the publisher.
+         * @param error Error text on failure (missing, not yet initialised or incompatible).
+         * @return True on success.
+         */
+        bool open(const std::string& name, std::string& error);
+
+        /**
+         * @brief Unmap the segment.
+         */
+        void close();
+
+        /**
+         * @brief True while a segment is mapped.
+         */
+        bool isOpen() const {
+            return header_ != nullptr;
+        }
+
+        /**
+         * @brief True once the publisher closed or replaced the segment; reopen to follow it.
+         */
+        bool publisherClosed() const;
+
+        /**
+         * @brief Frames published so far (the newest frame's number).
+         */
+        uint64_t framesPublished() const;
+
+        /**
+         * @brief View the newest complete frame.
+         * @param frame Receives the view; check valid(frame) after using it.
+         * @return False if nothing was published yet or the publisher kept overwriting it.
+         */
+        bool latest(SharedGridFrame& frame) const;
+
+        /**
+         * @brief True if the slot behind a view was not rewritten since latest() returned it.
+         * @param frame View returned by latest().
+         */
+        bool valid(const SharedGridFrame& frame) const;
+
+        /**
+         * @brief Copy the newest complete frame out of the segment.
+         * @param cells Receives width * height cells.
+         * @param frame Receives the frame description (its cells point into `cells`).
+         * @return False if no consistent frame could be copied.
+         */
+        bool copyLatest(std::vector<uint8_t>& cells, SharedGridFrame& frame) const;
+
+    private:
+        const SharedGridSlot* slotAt(uint32_t index) const;
+
+        utils::SharedMemory memory_;
+        const SharedGridHeader* header_ = nullptr;
+    };
+
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "core/gameLogic.h"
+
+#include <cstdint>
+
+namespace io {
+
+    /**
+     * @brief On-disk header of a binary grid snapshot (.gol), little-endian, 32 bytes.
+     *
+     * The header is followed by the payload: `height` rows of `rowBytes` bytes, row 0
+     * first, one bit per cell (LSB = lowest column). With kSnapshotPackBits set each
+     * row is PackBits-encoded on its own, so rows can be decoded one at a time.
+     *
+     * Grids of multi-state rules are written as version 2 with kSnapshotStates: a
+     * SnapshotRule follows the header and each cell takes two bits (its state).
+     */
+    struct SnapshotHeader {
+        char magic[4] = {'G', 'O', 'L', 'S'};
+        uint32_t version = 1;        // 2 with kSnapshotStates
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t flags = 0;          // see kSnapshotPackBits
+        uint32_t rowBytes = 0;       // (width + 7) / 8
+        uint64_t payloadBytes = 0;   // bytes following the header
+    };
+
+    static_assert(sizeof(SnapshotHeader) == 32, "SnapshotHeader must stay 32 bytes");
+
+    constexpr uint32_t kSnapshotPackBits = 1u << 0; // payload is PackBits-compressed
+    constexpr uint32_t kSnapshotStates = 1u << 1;   // two bits per cell, SnapshotRule after the header
+
+    /**
+     * @brief Rule of a multi-state snapshot, 16 bytes (see core::LifeRule).
+     */
+    struct SnapshotRule {
+        uint16_t birthMin = 0;
+        uint16_t birthMax = 0;
+        uint16_t surviveMin = 0;
+        uint16_t surviveMax = 0;
+        uint8_t range = 1;
+        uint8_t includeCenter = 0;
+        uint8_t shape = 0;           // core::Neighbourhood
+        uint8_t states = 2;
+        uint8_t family = 0;          // core::RuleFamily
+        uint8_t reserved[3] = {};
+    };
+
+    static_assert(sizeof(SnapshotRule) == 16, "SnapshotRule must stay 16 bytes");
+
+    /**
+     * @brief Store a rule as a SnapshotRule (recordings reuse the record).
+     */
+    SnapshotRule toSnapshotRule(const core::LifeRule& rule);
+
+    /**
+     * @brief Read a stored multi-state rule back.
+     * @param stored Rule record from a file.
+     * @param rule Receives the rule.
+     * @return False if the record is not a valid multi-state rule.
+     */
+    bool fromSnapshotRule(const SnapshotRule& stored, core::LifeRule& rule);
+
+    /**
+     * @brief Write a snapshot of the current generation.
+     *
+     * With a multi-state rule, the states and the rule are saved as well.
+     * @param path Destination file.
+     * @param life Grid to save.
+     * @param compress True to run-length compress the bit-packed rows.
+     * @throws std::runtime_error on I/O failure.
+     */
+    void saveSnapshot(const char* path, const core::Life& life, bool compress);
+
+    /**
+     * @brief Write a compressed snapshot of raw cells so that a crash never leaves a torn file.
+     *
+     * The snapshot goes to "<path>.tmp", is flushed to the device (fsync) and then renamed
+     * over path, so path holds either the previous snapshot or the complete new one.
+     * @param path Destination file.
+     * @param cells Row-major cells (width*height bytes: nonzero is alive, or the state with a multi-state rule).
+     * @param width Grid width.
+     * @param height Grid height.
+     * @param rule Rule of the cells; a multi-state rule is saved along with the states.
+     * @throws std::runtime_error on I/O failure (path is left untouched).
+     */
+    void saveSnapshotDurable(const char* path, const uint8_t* cells, int width, int height, const core::LifeRule& rule);
+
+    /**
+     * @brief Map a snapshot and unpack it straight into a new grid (no text parsing).
+     * @param path Snapshot file.
+     * @return Grid with the snapshot size and contents; multi-state snapshots also set its rule.
+     * @throws std::runtime_error if the file is missing, truncated or malformed.
+     */
+    core::Life loadSnapshot(const char* path);
+
+    /**
+     * @brief Pack a byte-per-cell row into bits (LSB = lowest column).
+     * @param cells Source row (width bytes, 0 or 1).
+     * @param width Number of cells.
+     * @param out Destination ((width + 7) / 8 bytes).
+     */
+    void packRow(const uint8_t* cells, int width, uint8_t* out);
+
+    /**
+     * @brief Unpack a bit-packed row into bytes (0 or 1).
+     * @param bits Source ((width + 7) / 8 bytes).
+     * @param width Number of cells.
+     * @param cells Destination row (width bytes).
+     */
+    void unpackRow(const uint8_t* bits, int width, uint8_t* cells);
+
+    /**
+     * @brief Pack a row of states into two bits per cell (lowest column in the low bits).
+     * @param cells Source row (width bytes, 0..3).
+     * @param width Number of cells.
+     * @param out Destination ((width + 3) / 4 bytes).
+     */
+    void packStateRow(const uint8_t* cells, int width, uint8_t* out);
+
+    /**
+     * @brief Unpack a row of two-bit states into bytes (0..3).
+     * @param bits Source ((width + 3) / 4 bytes).
+     * @param width Number of cells.
+     * @param cells Destination row (width bytes).
+     */
+    void unpackStateRow(const uint8_t* bits, int width, uint8_t* cells);
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+// Thin portability layer over BSD sockets and Winsock, shared by the socket sources of
+// the io module. Include it from .cpp files only: it pulls in the platform headers.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace io {
+    namespace net {
+
+#ifdef _WIN32
+        using Handle = SOCKET;
+        using PollFd = WSAPOLLFD;
+        using AddressLength = int;
+        const Handle kInvalid = INVALID_SOCKET;
+
+        /**
+         * @brief Start Winsock once per process (no-op elsewhere).
+         */
+        inline void initSockets() {
+            struct WinsockInit {
+                WinsockInit() {
+                    WSADATA data;
+                    WSAStartup(MAKEWORD(2, 2), &data);
+                }
+                ~WinsockInit() {
+                    WSACleanup();
+                }
+            };
+            static WinsockInit winsock;
+        }
+
+        inline int pollSockets(PollFd* fds, size_t count, int ms) { return WSAPoll(fds, static_cast<ULONG>(count), ms); }
+        inline void closeHandle(Handle s) { closesocket(s); }
+        inline bool wouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+        inline std::string socketError() { return "socket error " + std::to_string(WSAGetLastError()); }
+        inline bool setNonBlocking(Handle s) {
+            u_long on = 1;
+            return ioctlsocket(s, FIONBIO, &on) == 0;
+        }
+        inline long sendSome(Handle s, const uint8_t* data, size_t size) {
+            return send(s, reinterpret_cast<const char*>(data), static_cast<int>(std::min<size_t>(size, 1 << 30)), 0);
+        }
+        inline long receiveSome(Handle s, uint8_t* data, size_t size) {
+            return recv(s, reinterpret_cast<char*>(data), static_cast<int>(std::min<size_t>(size, 1 << 30)), 0);
+        }
+#else
+        using Handle = int;
+        using PollFd = pollfd;
+        using AddressLength = socklen_t;
+        const Handle kInvalid = -1;
+
+        inline void initSockets() {}
+        inline int pollSockets(PollFd* fds, size_t count, int ms) { return poll(fds, static_cast<nfds_t>(count), ms); }
+        inline void closeHandle(Handle s) { close(s); }
+        inline bool wouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR; }
+        inline std::string socketError() { return std::strerror(errno); }
+        inline bool setNonBlocking(Handle s) {
+            const int flags = fcntl(s, F_GETFL, 0);
+            return flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+        }
+        inline long sendSome(Handle s, const uint8_t* data, size_t size) {
+#ifdef MSG_NOSIGNAL
+            return static_cast<long>(send(s, data, size, MSG_NOSIGNAL)); // a dead peer must not raise SIGPIPE
+#else
+            return static_cast<long>(send(s, data, size, 0));
+#endif
+        }
+        inline long receiveSome(Handle s, uint8_t* data, size_t size) {
+            return static_cast<long>(recv(s, data, size, 0));
+        }
+#endif
+
+        /**
+         * @brief Disable Nagle's algorithm on a TCP socket (small messages go out at once).
+         */
+        inline void setNoDelay(Handle s) {
+            const int on = 1;
+            setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&on), sizeof(on));
+        }
+
+        /**
+         * @brief Blocking send of a whole buffer (for short handshakes).
+         */
+        inline bool sendAll(Handle s, const uint8_t* data, size_t size) {
+            while (size > 0) {
+                const long n = sendSome(s, data, size);
+                if (n <= 0) return false;
+                data += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Blocking receive of a whole buffer (for short handshakes).
+         */
+        inline bool receiveAll(Handle s, uint8_t* data, size_t size) {
+            while (size > 0) {
+                const long n = receiveSome(s, data, size);
+                if (n <= 0) return false;
+                data += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "io/transport.h"
+
+#include <string>
+#include <vector>
+
+namespace io {
+
+    /**
+     * @brief Socket family used between processes.
+     */
+    enum class SocketKind {
+        Tcp,    // rank r listens on host:basePort+r
+        Unix    // rank r listens on <path>.<r> (POSIX only)
+    };
+
+    /**
+     * @brief Where the ranks of a run listen.
+     */
+    struct SocketEndpoint {
+        SocketKind kind = SocketKind::Tcp;
+        std::string host = "127.0.0.1";
+        int basePort = 47000;
+        std::string path = "/tmp/gol-halo";
+    };
+
+    /**
+     * @brief Transport over one stream socket per pair of communicating ranks.
+     *
+     * Every rank listens on its own address; lower ranks accept and higher ranks connect,
+     * so the mesh forms regardless of start order. Sockets are non-blocking and
+     * exchange() drives all of them from one poll() loop.
+     */
+    class SocketTransport : public Transport {
+    public:
+        /**
+         * @brief Connect to the peers this rank talks to (blocks until all are connected).
+         * @param endpoint Listening addresses of the run.
+         * @param rank Number of this process.
+         * @param ranks Number of processes.
+         * @param peers Ranks this process exchanges messages with (symmetric across ranks).
+         * @param timeoutSeconds Give up if the mesh is not complete within this time.
+         * @throws std::runtime_error on socket errors or timeout.
+         */
+        SocketTransport(const SocketEndpoint& endpoint, int rank, int ranks, const std::vector<int>& peers, double timeoutSeconds = 30.0);
+        ~SocketTransport() override;
+
+        SocketTransport(const SocketTransport&) = delete;
+        SocketTransport& operator=(const SocketTransport&) = delete;
+
+        int rank() const override {
+            return rank_;
+        }
+
+        int ranks() const override {
+            return ranks_;
+        }
+
+        void exchange(const std::vector<SendBuffer>& sends, const std::vector<ReceiveBuffer>& receives) override;
+
+        /**
+         * @brief Bytes sent to other ranks so far.
+         */
+        uint64_t bytesSent() const {
+            return bytesSent_;
+        }
+
+    private:
+        using Socket = intptr_t;     // SOCKET on Windows, file descriptor elsewhere
+
+        void closeAll();
+
+        int rank_;
+        int ranks_;
+        std::vector<Socket> sockets_;  // per rank, -1 if not connected
+        double timeout_;
+        uint64_t bytesSent_ = 0;
+    };
+
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "core/gameLogic.h"
+#include "io/streamProtocol.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace io {
+
+    /**
+     * @brief Minimal client of io::StreamServer.
+     *
+     * Keeps a copy of the server's grid up to date from the streamed frames and sends
+     * commands. Meant for tools, tests and as a reference for clients in other languages.
+     */
+    class StreamClient {
+    public:
+        /**
+         * @brief Connect to a server.
+         * @param host IPv4 address of the server.
+         * @param port TCP port of the server.
+         * @throws std::runtime_error if the connection fails.
+         */
+        StreamClient(const std::string& host, int port);
+        ~StreamClient();
+
+        StreamClient(const StreamClient&) = delete;
+        StreamClient& operator=(const StreamClient&) = delete;
+
+        /**
+         * @brief Wait for the next frame, apply it and acknowledge it.
+         * @param timeoutSeconds Give up after this long.
+         * @return True if a frame was applied, false on timeout.
+         * @throws std::runtime_error if the server disconnects or sends a malformed frame.
+         */
+        bool receiveFrame(double timeoutSeconds);
+
+        /** @brief Start the simulation. */
+        void play();
+
+        /** @brief Stop the simulation. */
+        void pause();
+
+        /**
+         * @brief Compute generations one by one.
+         * @param generations Number of steps.
+         */
+        void step(uint32_t generations);
+
+        /**
+         * @brief Change the simulation speed.
+         * @param stepsPerSecond New speed.
+         */
+        void setSpeed(float stepsPerSecond);
+
+        /**
+         * @brief Set or clear cells.
+         * @param edits Cells to change.
+         */
+        void edit(const std::vector<StreamCellEdit>& edits);
+
+        /**
+         * @brief Replace the server's grid.
+         * @param life New grid; only its live (state 1) cells are sent.
+         */
+        void load(const core::Life& life);
+
+        /** @brief Cells of the newest frame (row-major, the state of each cell: 0 dead, 1 alive, 2..3 extra states). */
+        const std::vector<uint8_t>& cells() const {
+            return cells_;
+        }
+
+        /** @brief Header of the newest frame. */
+        const StreamFrameHeader& frame() const {
+            return frame_;
+        }
+
+        /** @brief Frames received so far. */
+        uint64_t framesReceived() const {
+            return framesReceived_;
+        }
+
+        /** @brief Bytes received so far. */
+        uint64_t bytesReceived() const {
+            return bytesReceived_;
+        }
+
+    private:
+        void send(StreamMessage type, const void* payload, size_t bytes);
+
+        intptr_t socket_ = -1;       // SOCKET on Windows, file descriptor elsewhere
+        std::vector<uint8_t> cells_;
+        std::vector<uint8_t> payload_;
+        StreamFrameHeader frame_;
+        uint64_t framesReceived_ = 0;
+        uint64_t bytesReceived_ = 0;
+    };
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace io {
+
+    /**
+     * @brief Message types of the network stream protocol.
+     *
+     * Every message is a StreamMessageHeader followed by `bytes` of payload. All integers
+     * are little-endian.
+     *
+     * Server to client:
+     *  - Frame: StreamFrameHeader, then core::deltaCodec runs. A keyframe encodes the
+     *    cells; any other frame encodes the XOR with the previous frame sent to this
+     *    client. Under rules with more than two states the runs cover two bit planes, so
+     *    cells carry their state (0..3); a change of the state count sends a keyframe.
+     *
+     * Client to server:
+     *  - Ack: no payload; sent after applying each frame. The server keeps at most
+     *    kStreamFramesInFlight frames unacknowledged per client, so a slow client gets
+     *    fewer, larger deltas instead of a growing backlog in the socket buffers.
+     *  - Play, Pause: no payload.
+     *  - Step: uint32 number of generations (at most kMaxStreamSteps are run).
+     *  - Speed: float steps per second.
+     *  - Edit: any number of StreamCellEdit records.
+     *  - Load: uint32 width, uint32 height, then deltaCodec runs of the live cells (one
+     *    plane); the grid replaces the server's grid.
+     */
+    enum class StreamMessage : uint32_t {
+        Frame = 1,
+        Ack = 15,
+        Play = 16,
+        Pause = 17,
+        Step = 18,
+        Speed = 19,
+        Edit = 20,
+        Load = 21
+    };
+
+    /**
+     * @brief Header of every message (8 bytes).
+     */
+    struct StreamMessageHeader {
+        uint32_t type = 0;           // StreamMessage
+        uint32_t bytes = 0;          // payload size
+    };
+
+    /**
+     * @brief Header of a Frame payload (40 bytes).
+     */
+    struct StreamFrameHeader {
+        uint64_t generation = 0;     // simulation generation
+        uint64_t population = 0;     // live (state 1) cells, lets clients check their reconstruction
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t skipped = 0;        // grid changes not sent to this client since its last frame
+        uint8_t keyframe = 0;        // 1 = the cells, 0 = XOR with the previous frame
+        uint8_t running = 0;         // 1 if the simulation is playing
+        uint8_t states = 2;          // cell states of the rule; above 2 the runs cover two planes
+        uint8_t pad = 0;
+        float stepsPerSecond = 0.0f;
+        uint32_t reserved = 0;
+    };
+
+    /**
+     * @brief One cell of an Edit command (12 bytes).
+     */
+    struct StreamCellEdit {
+        int32_t x = 0;
+        int32_t y = 0;
+        uint32_t alive = 0;          // 1 = set, 0 = clear
+    };
+
+    static_assert(sizeof(StreamMessageHeader) == 8, "StreamMessageHeader must stay 8 bytes");
+    static_assert(sizeof(StreamFrameHeader) == 40, "StreamFrameHeader must stay 40 bytes");
+    static_assert(sizeof(StreamCellEdit) == 12, "StreamCellEdit must stay 12 bytes");
+
+    constexpr int kDefaultStreamPort = 47100;
+
+    // Frames a client may have unacknowledged; more would only add latency
+    constexpr int kStreamFramesInFlight = 2;
+
+    // Most generations one Step command computes (the simulation thread does them at once)
+    constexpr uint32_t kMaxStreamSteps = 1000;
+
+    // Largest grid a frame or a Load command may describe
+    constexpr uint64_t kMaxStreamCells = 1ull << 28;
+
+    // Largest payload either side accepts (runs take at most one byte per cell); bigger
+    // messages close the connection
+    constexpr uint32_t kMaxStreamPayload = 512u << 20;
+
+}
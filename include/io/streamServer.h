@@ -0,0 +1,203 @@
+#pragma once
+
+#include "core/gameLogic.h"
+#include "io/streamProtocol.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace io {
+
+    /**
+     * @brief Network server settings.
+     */
+    struct StreamServerSettings {
+        std::string host = "0.0.0.0";  // address to listen on (all interfaces by default)
+        int port = kDefaultStreamPort;   // 0 picks a free port, see StreamServer::port()
+        int maxClients = 8;              // further connections are refused
+    };
+
+    /**
+     * @brief Kind of a command received from a client.
+     */
+    enum class StreamCommandType {
+        Play,
+        Pause,
+        Step,
+        Speed,
+        Edit,
+        Load
+    };
+
+    /**
+     * @brief Command received from a client, applied by the simulation thread.
+     */
+    struct StreamCommand {
+        StreamCommandType type = StreamCommandType::Play;
+        uint32_t steps = 0;                    // Step
+        float stepsPerSecond = 0.0f;           // Speed
+        std::vector<StreamCellEdit> edits;     // Edit
+        std::unique_ptr<core::Life> pattern;   // Load: the new grid
+    };
+
+    /**
+     * @brief Embedded TCP server that streams generations to clients and takes commands.
+     *
+     * All socket work happens on a background thread. publish() only copies the grid
+     * into a pending buffer that the server thread swaps out, and not even that while
+     * no client is connected (see wantsGrid()); the server thread then
+     * encodes, per client, the XOR delta between the frame that client saw last and the
+     * newest grid (see streamProtocol.h). A client is sent a new frame only once it
+     * acknowledged enough of the previous ones, so slow clients skip generations instead
+     * of slowing anything down or falling behind.
+     *
+     * Commands are parsed on the server thread and queued; the owner drains them with
+     * pollCommand() and applies them between frames.
+     */
+    class StreamServer {
+    public:
+        StreamServer();
+        ~StreamServer();
+
+        StreamServer(const StreamServer&) = delete;
+        StreamServer& operator=(const StreamServer&) = delete;
+
+        /**
+         * @brief Listen and start the server thread.
+         * @param settings Address and limits.
+         * @param error Error text on failure.
+         * @return True on success.
+         */
+        bool start(const StreamServerSettings& settings, std::string& error);
+
+        /**
+         * @brief Disconnect all clients and join the server thread.
+         */
+        void stop();
+
+        /**
+         * @brief True between start() and stop().
+         */
+        bool active() const {
+            return thread_.joinable();
+        }
+
+        /**
+         * @brief TCP port the server listens on.
+         */
+        int port() const {
+            return port_;
+        }
+
+        /**
+         * @brief Offer a new grid state to the clients (cheap: one copy, no socket work).
+         *
+         * Without clients the grid is not copied at all.
+         * @param life Current grid.
+         * @param generation Generation number sent with it.
+         */
+        void publish(const core::Life& life, uint64_t generation);
+
+        /**
+         * @brief True if clients are connected but the last grid offered was skipped.
+         *
+         * Happens when a client connects while the grid does not change (e.g. paused):
+         * publish() the current grid again so it gets its first frame.
+         */
+        bool wantsGrid() const {
+            return gridSkipped_.load(std::memory_order_relaxed) && clientCount() > 0;
+        }
+
+        /**
+         * @brief Report whether the simulation runs and how fast; sent with every frame.
+         * @param running True while playing.
+         * @param stepsPerSecond Simulation speed.
+         */
+        void setStatus(bool running, float stepsPerSecond);
+
+        /**
+         * @brief Take the oldest queued command.
+         * @param command Receives the command.
+         * @return False if no command is waiting.
+         */
+        bool pollCommand(StreamCommand& command);
+
+        /**
+         * @brief Number of connected clients.
+         */
+        int clientCount() const {
+            return clientCount_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Frames sent to all clients so far.
+         */
+        uint64_t framesSent() const {
+            return framesSent_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Grid changes clients skipped because they were still receiving.
+         */
+        uint64_t framesSkipped() const {
+            return framesSkipped_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct Client;
+
+        void run();
+
+        // Read and parse what a client sent; false if it must be disconnected
+        bool receiveCommands(Client& client);
+
+        // Queue the newest grid for a client that is ready for another frame
+        void encodeFrame(Client& client);
+
+        // Push as much of a client's pending frame as its socket takes; false if it is gone
+        static bool flush(Client& client);
+
+        intptr_t listener_ = -1;     // listening socket (SOCKET on Windows)
+        int port_ = 0;
+        int maxClients_ = 0;
+        std::thread thread_;
+        std::atomic<bool> stopping_{false};
+
+        // Handoff from publish(): the pending grid is swapped into the working grid
+        std::mutex frameMutex_;
+        std::vector<uint8_t> pending_;
+        int pendingW_ = 0, pendingH_ = 0;
+        int pendingStates_ = 2;
+        uint64_t pendingGeneration_ = 0;
+        uint64_t pendingSerial_ = 0;     // number of grids copied by publish()
+        std::atomic<bool> gridSkipped_{false}; // publish() skipped a grid for lack of clients
+
+        // Newest grid on the server thread
+        std::vector<uint8_t> working_;
+        int workingW_ = 0, workingH_ = 0;
+        int workingStates_ = 2;          // states of the rule, more than 2 need two planes
+        uint64_t workingGeneration_ = 0;
+        uint64_t workingSerial_ = 0;
+        uint64_t workingPopulation_ = 0;
+
+        std::atomic<bool> running_{false};
+        std::atomic<float> stepsPerSecond_{0.0f};
+
+        std::vector<std::unique_ptr<Client>> clients_;
+        std::vector<uint8_t> scratch_;   // encoded runs, reused for every frame
+
+        std::mutex commandMutex_;
+        std::deque<StreamCommand> commands_;
+
+        std::atomic<int> clientCount_{0};
+        std::atomic<uint64_t> framesSent_{0};
+        std::atomic<uint64_t> framesSkipped_{0};
+    };
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace io {
+
+    /**
+     * @brief Bytes to send to one peer.
+     */
+    struct SendBuffer {
+        int peer = 0;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    /**
+     * @brief Space for bytes expected from one peer (the size must match what it sends).
+     */
+    struct ReceiveBuffer {
+        int peer = 0;
+        uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    /**
+     * @brief Message passing between the processes of a distributed run.
+     *
+     * Processes are numbered 0..ranks()-1. Implementations decide how bytes travel (sockets,
+     * shared memory, ...); callers only rely on exchange().
+     */
+    class Transport {
+    public:
+        virtual ~Transport() = default;
+
+        /**
+         * @brief Number of this process.
+         */
+        virtual int rank() const = 0;
+
+        /**
+         * @brief Number of processes.
+         */
+        virtual int ranks() const = 0;
+
+        /**
+         * @brief Send and receive a set of messages and wait until all of them completed.
+         *
+         * Sends and receives progress together, so two processes may exchange large
+         * buffers without deadlocking. Messages between two ranks arrive in the order they
+         * are listed; a rank may also send to itself.
+         * @param sends Messages to send.
+         * @param receives Messages to receive.
+         * @throws std::runtime_error if a peer disconnects or the transport fails.
+         */
+        virtual void exchange(const std::vector<SendBuffer>& sends, const std::vector<ReceiveBuffer>& receives) = 0;
+    };
+
+}
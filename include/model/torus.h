@@ -5,24 +5,49 @@
 namespace model {
 
     /**
-     * @brief GPU buffers and counts for a torus mesh.
+     * @brief GPU handle for the procedural torus.
+     *
+     * The torus has no vertex or index buffers: positions and UVs are generated in the
+     * vertex shader from gl_VertexID, so the mesh never depends on the grid resolution.
      */
     struct TorusMesh {
-        GLuint vao_ = 0;
-        GLuint vbo_ = 0;
-        GLuint ebo_ = 0;
-        GLsizei indexCount_ = 0;
+        GLuint vao_ = 0;             // empty VAO required by core profile draws
+        float outerRadius_ = 0.0f;   // distance from origin to the center of the tube
+        float innerRadius_ = 0.0f;   // tube radius
     };
 
     /**
-     * @brief Build a torus grid mesh and upload it to GPU buffers.
-     * @param columns Number of grid columns along the major ring.
-     * @param rows Number of grid rows along the minor tube.
+     * @brief Tessellation level used for one draw of the procedural torus.
+     */
+    struct TorusTessellation {
+        int majorSegments_ = 0;      // quads along the major ring
+        int minorSegments_ = 0;      // quads around the minor tube
+
+        /**
+         * @brief Number of non-indexed vertices to draw with GL_TRIANGLES.
+         */
+        GLsizei vertexCount() const {
+            return static_cast<GLsizei>(6 * majorSegments_ * minorSegments_);
+        }
+    };
+
+    /**
+     * @brief Create the (buffer-less) torus mesh.
      * @param outerRadius Distance from origin to the center of the tube.
      * @param innerRadius Tube radius.
-     * @return TorusMesh with VAO/VBO/EBO initialized and ready to draw with GL_TRIANGLES.
+     * @return TorusMesh with an empty VAO ready to draw with GL_TRIANGLES.
+     */
+    TorusMesh makeTorus(float outerRadius, float innerRadius);
+
+    /**
+     * @brief Pick a tessellation level from the on-screen size of the torus.
+     * @param mesh Torus to tessellate.
+     * @param cameraDistance Distance from the camera to the torus center.
+     * @param fovY Vertical field of view in radians.
+     * @param viewportH Viewport height in pixels.
+     * @return Segment counts that keep silhouette edges a few pixels long.
      */
-    TorusMesh makeTorusGrid(int columns, int rows, float outerRadius, float innerRadius);
+    TorusTessellation tessellationForView(const TorusMesh& mesh, float cameraDistance, float fovY, int viewportH);
 
     /**
      * @brief Destroy GPU resources held by a TorusMesh and reset it to defaults.
@@ -30,4 +55,4 @@ namespace model {
      */
     void destroyTorus(TorusMesh& t);
 
-}
\ No newline at end of file
+}
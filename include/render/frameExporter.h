@@ -0,0 +1,150 @@
+#pragma once
+
+#include "core/camera.h"
+#include "render/renderer2d.h"
+#include "render/renderer3d.h"
+
+#include <glad/glad.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace render {
+
+    /**
+     * @brief Views composed into an exported frame.
+     */
+    enum class ExportView {
+        View2D,   // grid only
+        View3D,   // torus only
+        Both      // grid left, torus right (as in the window)
+    };
+
+    /**
+     * @brief File format of exported frames.
+     */
+    enum class ExportFormat {
+        Png,      // one .png per frame
+        Raw       // one headerless .rgba per frame (top row first)
+    };
+
+    /**
+     * @brief Options for one export run.
+     */
+    struct ExportSettings {
+        int width = 1920;
+        int height = 1080;
+        ExportView view = ExportView::Both;
+        ExportFormat format = ExportFormat::Png;
+        int everyNth = 1;                 // export generations that are multiples of this
+        std::string directory = "frames"; // created if missing
+        int workers = 0;                  // encoder threads, 0 = hardware threads - 1
+    };
+
+    /**
+     * @brief Renders frames offscreen and writes them to disk without stalling the GPU.
+     *
+     * Each capture renders into an FBO at the export resolution and starts a glReadPixels
+     * into the next pixel buffer of a ring, guarded by a fence. Buffers are mapped only once
+     * their fence has signalled (normally a few frames later), copied into a recycled frame
+     * and handed to a pool of encoder threads. The caller only waits when the GPU is a full
+     * ring behind or the encoders fall kMaxQueued frames behind.
+     *
+     * All methods must be called on the thread that owns the GL context.
+     */
+    class FrameExporter {
+    public:
+        FrameExporter(Renderer2D& r2d, Renderer3D& r3d, const core::OrbitCamera& camera);
+        ~FrameExporter();
+
+        FrameExporter(const FrameExporter&) = delete;
+        FrameExporter& operator=(const FrameExporter&) = delete;
+
+        /**
+         * @brief Allocate the offscreen targets and start the encoder threads.
+         * @param settings Resolution, views, format and output directory.
+         * @param error Receives a message on failure.
+         * @return True if exporting started.
+         */
+        bool start(const ExportSettings& settings, std::string& error);
+
+        /**
+         * @brief Render and queue one frame if the generation is due (restores FBO and viewport).
+         * @param generation Simulation generation, used for the schedule and the file name.
+         */
+        void capture(uint64_t generation);
+
+        /**
+         * @brief Read back pending frames, wait for the encoders and release GL resources.
+         */
+        void stop();
+
+        /**
+         * @brief True between start() and stop().
+         */
+        bool active() const {
+            return active_;
+        }
+
+        /**
+         * @brief Frames written to disk so far in this run.
+         */
+        uint64_t framesWritten() const {
+            return framesWritten_.load();
+        }
+
+        /**
+         * @brief First error of this run (a frame that failed to read back or encode), empty if none.
+         */
+        std::string lastError() const;
+
+        static constexpr int kRingSize = 4;     // pixel buffers in flight
+        static constexpr size_t kMaxQueued = 8; // frames waiting for an encoder
+
+    private:
+        struct Slot {
+            GLuint pbo = 0;
+            GLsync fence = nullptr;
+            uint64_t generation = 0;
+        };
+
+        struct Job {
+            std::vector<uint8_t> pixels;  // RGBA8, bottom row first
+            uint64_t generation = 0;
+        };
+
+        // Map a finished pixel buffer and hand its frame to the encoders
+        void harvest(Slot& slot, bool wait);
+
+        void workerLoop();
+
+        Renderer2D& r2d_;
+        Renderer3D& r3d_;
+        const core::OrbitCamera& camera_;
+
+        ExportSettings settings_{};
+        bool active_ = false;
+
+        GLuint fbo_ = 0;
+        GLuint colorRb_ = 0;
+        GLuint depthRb_ = 0;
+        Slot ring_[kRingSize];
+        int next_ = 0;
+
+        std::vector<std::thread> workers_;
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;          // jobs queued or stopping
+        std::condition_variable spaceCv_;     // a job was taken
+        std::deque<Job> jobs_;
+        std::vector<std::vector<uint8_t>> spare_; // recycled frame buffers
+        bool stopping_ = false;
+        std::string error_;
+        std::atomic<uint64_t> framesWritten_{0};
+    };
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "core/largerThanLife.h"
+
+#include <glm/glm.hpp>
+
+namespace render {
+
+    /**
+     * @brief Colours of the cell states of a rule, indexed by the value in the state texture.
+     *
+     * The state texture carries the state index as is (0..kMaxStates-1), so the shaders
+     * look it up in a uPalette[kMaxStates] uniform. Generations rules fade dying cells from
+     * a strong to a light colour; WireWorld uses blue heads, red tails and amber wire.
+     * @param rule Rule whose states are coloured.
+     * @param dead Colour of state 0.
+     * @param alive Colour of state 1 of totalistic rules.
+     * @param out Receives kMaxStates colours (unused states repeat the dead colour).
+     */
+    void statePalette(const core::LifeRule& rule, const glm::vec3& dead, const glm::vec3& alive, glm::vec3 out[core::kMaxStates]);
+
+}
@@ -38,7 +38,17 @@ namespace render {
          */
         void draw(int viewportW, int viewportH, int hoverX, int hoverY);
 
+        /**
+         * @brief Rebuild the program from the current shader sources (hot reload).
+         *
+         * On a compile or link error the message is printed and the old program is kept.
+         */
+        void reloadShaders();
+
     private:
+        // Build the program and look up its uniforms
+        void buildProgram();
+
         core::Simulation& sim_;
         GLuint program_ = 0;
         GLuint vao_ = 0;
@@ -47,8 +57,13 @@ namespace render {
         GLint uGridSize_ = -1;
         GLint uViewportPx_ = -1;
         GLint uState_ = -1;
-        GLint uDeadColor_ = -1;
-        GLint uAliveColor_ = -1;
+        GLint uPalette_ = -1;
+        GLint uAge_ = -1;
+        GLint uAgeEnabled_ = -1;
+        GLint uYoungColor_ = -1;
+        GLint uTrailColor_ = -1;
+        GLint uLabels_ = -1;
+        GLint uLabelsEnabled_ = -1;
         GLint uLineThicknessPx_ = -1;
         GLint uLineColor_ = -1;
         GLint uHoverCell_ = -1;
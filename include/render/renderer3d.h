@@ -10,15 +10,21 @@
 namespace render {
 
     /**
-     * @brief 3D renderer for the torus grid.
+     * @brief 3D renderer for the grid wrapped onto the surface of its topology.
+     *
+     * A torus, a figure-8 Klein bottle, Boy's surface for the projective plane, or a flat
+     * sheet for a bounded grid; all are generated in the vertex shaders. Optionally extrudes live cells as blocks with a single instanced draw fed by the
+     * simulation's live-cell buffer.
      */
     class Renderer3D {
     public:
+        static constexpr float kFovYDegrees = 25.0f; // vertical field of view
+
         explicit Renderer3D(core::Simulation& sim);
         ~Renderer3D();
 
         /**
-         * @brief Draw the torus in the given viewport using the provided camera.
+         * @brief Draw the surface in the given viewport using the provided camera.
          * @param cam Orbit camera for view transform.
          * @param viewportW Viewport width in pixels.
          * @param viewportH Viewport height in pixels.
@@ -26,28 +32,52 @@ namespace render {
         void draw(const core::OrbitCamera& cam, int viewportW, int viewportH);
 
         /**
-         * @brief Rebuild the torus mesh when grid size changes.
-         * @param cols New grid columns.
-         * @param rows New grid rows.
+         * @brief Rebuild both programs from the current shader sources (hot reload).
+         *
+         * On a compile or link error the message is printed and the old programs are kept.
          */
-        void rebuildMesh(int cols, int rows);
+        void reloadShaders();
 
     private:
+        // Build the surface and block programs and look up their uniforms
+        void buildPrograms();
+
         core::Simulation& sim_;
         GLuint program_ = 0;
         model::TorusMesh torus_{};
 
         // Uniform locations
         GLint uMVP_ = -1;
+        GLint uSegments_ = -1;
+        GLint uRadii_ = -1;
+        GLint uSurface_ = -1;
+        GLint uSheet_ = -1;
         GLint uState_ = -1;
         GLint uGridSize_ = -1;
-        GLint uDeadColor_ = -1;
-        GLint uAliveColor_ = -1;
+        GLint uPalette_ = -1;
+        GLint uAge_ = -1;
+        GLint uAgeEnabled_ = -1;
+        GLint uYoungColor_ = -1;
+        GLint uTrailColor_ = -1;
         GLint uLinePx_ = -1;
         GLint uLineColor_ = -1;
         GLint uEdgeUColor_ = -1;
         GLint uEdgeVColor_ = -1;
         GLint uEdgePxUV_ = -1;
+
+        // Instanced live-cell blocks
+        GLuint blockProgram_ = 0;
+        GLuint blockVao_ = 0;
+        GLint uBlockMVP_ = -1;
+        GLint uBlockGridSize_ = -1;
+        GLint uBlockRadii_ = -1;
+        GLint uBlockSurface_ = -1;
+        GLint uBlockSheet_ = -1;
+        GLint uBlockFill_ = -1;
+        GLint uBlockHeight_ = -1;
+        GLint uBlockState_ = -1;
+        GLint uBlockPalette_ = -1;
+        GLint uBlockLightDir_ = -1;
     };
 
 }
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "core/camera.h"
+#include "core/life3d.h"
+
+#include <glad/glad.h>
+
+namespace render {
+
+    /**
+     * @brief 3D renderer for a volumetric automaton (core::Life3D).
+     *
+     * Live cells are drawn as cubes with a single instanced draw; each instance is one
+     * entry of the volume's live-cell list, uploaded by update() whenever it changes.
+     * The volume is centred at the origin and scaled to the size of the torus view, so
+     * the same orbit camera works for both.
+     */
+    class VoxelRenderer {
+    public:
+        VoxelRenderer();
+        ~VoxelRenderer();
+
+        /**
+         * @brief Upload the live cells of a new generation.
+         * @param volume Volume to show.
+         */
+        void update(const core::Life3D& volume);
+
+        /**
+         * @brief Draw the last uploaded generation in the given viewport.
+         * @param cam Orbit camera for view transform.
+         * @param viewportW Viewport width in pixels.
+         * @param viewportH Viewport height in pixels.
+         */
+        void draw(const core::OrbitCamera& cam, int viewportW, int viewportH);
+
+        /**
+         * @brief Rebuild the program from the current shader sources (hot reload).
+         *
+         * On a compile or link error the message is printed and the old program is kept.
+         */
+        void reloadShaders();
+
+    private:
+        // Build the program and look up its uniforms
+        void buildProgram();
+
+        GLuint program_ = 0;
+        GLuint vao_ = 0;
+        GLuint vbo_ = 0;             // live-cell indices, one per instance
+        GLsizei voxelCount_ = 0;
+        int gridW_ = 1, gridH_ = 1, gridD_ = 1;
+
+        // Uniform locations
+        GLint uMVP_ = -1;
+        GLint uGridSize_ = -1;
+        GLint uFill_ = -1;
+        GLint uLightDir_ = -1;
+    };
+
+}
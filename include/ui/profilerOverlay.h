@@ -0,0 +1,32 @@
+#pragma once
+
+#include "core/gameLogic.h"
+#include "utils/gridAllocator.h"
+#include "utils/profiler.h"
+
+#include <imgui.h>
+#include <vector>
+
+namespace ui {
+
+    /**
+     * @brief Persistent state of the profiler overlay.
+     */
+    struct ProfilerOverlayState {
+        double windowSeconds = 2.0;           // percentile window
+        double refreshPeriod = 0.25;          // seconds between recomputations
+        double lastRefresh = -1.0;            // time of the last recomputation
+        std::vector<utils::ProfileStats> stats;
+        utils::GridMemoryStats memory;        // grid allocation layout, refreshed with stats
+    };
+
+    /**
+     * @brief Draw per-stage timings (last, p50, p95, p99, max) and the grid memory layout
+     *        in the top-left corner.
+     * @param state Overlay state; statistics are recomputed every refreshPeriod seconds.
+     * @param now Current time in seconds.
+     * @param life Simulated grid, for its band split.
+     */
+    void drawProfilerOverlay(ProfilerOverlayState& state, double now, const core::Life& life);
+
+}
@@ -3,15 +3,77 @@
 #include "core/simulation.h"
 
 #include <imgui.h>
+#include <string>
 
 namespace ui {
 
+    /**
+     * @brief What a left click or drag does in the 2D view.
+     */
+    enum class EditTool {
+        Toggle,       // flip the clicked cell
+        Brush,        // paint live cells while dragging
+        Eraser,       // erase cells while dragging
+        FillRect,     // drag a rectangle to fill
+        ClearRect,    // drag a rectangle to clear
+        RandomRect,   // drag a rectangle to fill randomly
+        Paste         // stamp the loaded pattern at the click
+    };
+
     /**
      * @brief Persistent UI state for the toolbar inputs.
      */
     struct ToolbarState {
         int colsInput = 50;
         int rowsInput = 50;
+        bool showProfiler = false;             // frame profiler overlay
+        int fpsCap = 0;                        // redraws per second at most, 0 for no cap (vsync still applies)
+
+        EditTool editTool = EditTool::Toggle;  // what clicks do in the 2D view
+        int brushRadius = 1;                   // brush and eraser radius in cells
+        int paintState = 1;                    // state drawn by Toggle, Brush and Fill rect (below the rule's states)
+        float randomDensity = 0.3f;            // live-cell probability of random fills
+        int randomSeed = 1;                    // seed of random fills
+        int pasteRotation = 0;                 // quarter turns counter-clockwise
+        bool pasteFlip = false;                // mirror the stamp before rotating it
+        std::string stampName;                 // file of the paste stamp, empty if none
+
+        char patternPath[260] = "pattern.rle"; // file for Load / Save (.gol, .rle, .mc)
+        bool ioBusy = false;                   // a load or save is running
+        std::string ioStatus;                  // last load/save message
+        int autosaveSeconds = 0;               // checkpoint interval, 0 for off
+        long long autosavedGeneration = -1;    // generation of the last checkpoint, -1 if none
+
+        bool recording = false;                // a run is being recorded
+        int playbackFrames = 0;                // frames of the open recording, 0 if none
+        int playbackFrame = 0;                 // frame shown on the timeline
+        unsigned long long playbackGeneration = 0;
+
+        bool showExport = false;               // show the export settings row
+        int exportWidth = 1920;                // offscreen frame size in pixels
+        int exportHeight = 1080;
+        int exportEvery = 1;                   // export every Nth generation
+        int exportView = 2;                    // 0 = 2D, 1 = 3D, 2 = both
+        int exportFormat = 0;                  // 0 = PNG, 1 = raw RGBA
+        char exportDir[260] = "frames";        // output directory
+        bool exporting = false;                // an export run is active
+        unsigned long long exportedFrames = 0; // frames written in this run
+
+        bool sharing = false;                  // generations are published to shared memory
+        bool serving = false;                  // the network stream server is running
+        int streamClients = 0;                 // clients connected to it
+
+        bool showRule = false;                 // show the rule settings row
+        core::LifeRule rule;                   // rule being edited, applied on ruleChanged
+
+        int viewRows = 1;                      // rows of viewports, the main simulation is the top one
+        int priority = 1;                      // scheduler weight of the main simulation
+        float share = 0.0f;                    // its fraction of the last frame's stepping time
+
+        bool volume = false;                   // the 3D view shows the volumetric automaton
+        int volumeSize = 64;                   // edge of the cubic volume in cells
+        char volumeRule[32] = "4555";          // Bays "ElEuFlFu" or "B<list>/S<list>"
+        size_t volumeCells = 0;                // live cells of the volume
     };
 
     /**
@@ -20,7 +82,31 @@ namespace ui {
     struct ToolbarActions {
         bool toggledRun = false;
         bool requestStep = false;
+        bool requestStepBack = false; // undo the newest change
+        bool toggledRewind = false;   // play the history backwards
         bool requestClear = false;
+        bool requestRandomFill = false; // fill the whole grid randomly
+        bool requestStamp = false;      // load ToolbarState::patternPath as the paste stamp
+        bool toggledBlocks = false; // show/hide live cells as 3D blocks
+        bool toggledAge = false;    // enable/disable age and trail colouring
+        bool toggledLabels = false; // enable/disable colouring by connected component
+        bool toggledInPlace = false; // enable/disable in-place (low-memory) stepping
+        bool requestLoad = false;   // load ToolbarState::patternPath
+        bool requestSave = false;   // save to ToolbarState::patternPath
+        bool toggleRecording = false; // start/stop recording to <patternPath>.golrec
+        bool requestReplay = false;   // open <patternPath>.golrec for playback
+        bool closeReplay = false;     // leave playback, keeping the shown frame
+        int seekFrame = -1;           // -1 for unchanged
+        bool toggleExport = false;    // start/stop exporting frames
+        bool toggleSharing = false;   // start/stop publishing generations to shared memory
+        bool toggleServer = false;    // start/stop the network stream server
+        bool ruleChanged = false;     // apply ToolbarState::rule to the simulation
+        bool toggleVolume = false;    // show/hide the volumetric automaton in the 3D view
+        bool requestVolumeReset = false; // rebuild the volume and seed its centre randomly
+        bool volumeRuleChanged = false;  // apply ToolbarState::volumeRule
+        bool requestAddView = false;  // add a comparison simulation below the others
+        int newPriority = -1;   // scheduler weight, -1 for unchanged
+        int newTopology = -1;   // core::Topology value, -1 for unchanged
         int resizeCols = -1;    // -1 for unchanged
         int resizeRows = -1;    // -1 for unchanged
         float newSpeed = -1.0f; // -1 for unchanged
@@ -33,4 +119,42 @@ namespace ui {
      */
     ToolbarActions drawToolbar(ToolbarState& state, const core::Simulation& sim);
 
+    /**
+     * @brief Persistent UI state of a comparison view's toolbar.
+     */
+    struct CompareToolbarState {
+        int priority = 1;      // scheduler weight of the view's simulation
+        float share = 0.0f;    // its fraction of the last frame's stepping time
+    };
+
+    /**
+     * @brief Actions emitted by a comparison view's toolbar during this frame.
+     */
+    struct CompareToolbarActions {
+        bool toggledRun = false;
+        bool requestStep = false;
+        bool requestClear = false;
+        bool requestRandomFill = false; // fill with the main toolbar's density and seed
+        bool requestCopy = false;       // copy the cells of the main simulation
+        bool requestClose = false;      // remove the view
+        int newRulePreset = -1;  // index of a preset rule, -1 for unchanged
+        int newPriority = -1;    // scheduler weight, -1 for unchanged
+        int newTopology = -1;    // core::Topology value, -1 for unchanged
+        float newSpeed = -1.0f;  // -1 for unchanged
+    };
+
+    /**
+     * @brief Preset rules offered by the toolbars, in menu order.
+     */
+    const core::LifeRule& presetRule(int index);
+
+    /**
+     * @brief Draw the compact toolbar of a comparison view, anchored to its row.
+     * @param state Persistent widget state.
+     * @param sim   The view's simulation.
+     * @param row   Row of the view (1 for the first view below the main simulation).
+     * @param rows  Number of rows on screen.
+     */
+    CompareToolbarActions drawCompareToolbar(CompareToolbarState& state, const core::Simulation& sim, int row, int rows);
+
 }
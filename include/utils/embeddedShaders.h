@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief GLSL source compiled into the executable.
+ */
+struct EmbeddedShader {
+    const char* name;     // file name under shaders/ (e.g. "shader2d.vert")
+    const char* source;   // null-terminated GLSL
+};
+
+// Generated at build time by cmake/EmbedShaders.cmake
+extern const EmbeddedShader kEmbeddedShaders[];
+extern const size_t kEmbeddedShaderCount;
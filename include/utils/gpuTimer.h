@@ -0,0 +1,45 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstdint>
+
+namespace utils {
+
+    /**
+     * @brief GL_TIME_ELAPSED timer for one draw stage.
+     *
+     * Keeps a small ring of queries so results are read a few frames later, once the GPU
+     * has finished them, without ever stalling the pipeline. Needs a current GL context for
+     * its whole lifetime. Timer queries cannot nest, so stages must not overlap.
+     */
+    class GpuTimer {
+    public:
+        explicit GpuTimer(const char* name);
+        ~GpuTimer();
+
+        GpuTimer(const GpuTimer&) = delete;
+        GpuTimer& operator=(const GpuTimer&) = delete;
+
+        /**
+         * @brief Collect finished results and start timing (skipped if no query is free).
+         */
+        void begin();
+
+        /**
+         * @brief Stop timing the stage started by begin().
+         */
+        void end();
+
+    private:
+        static constexpr int kLatency = 4;   // frames in flight before a query is reused
+
+        const char* name_;
+        GLuint queries_[kLatency] = {};
+        uint64_t issuedNs_[kLatency] = {};   // CPU time at begin(), used as the event start
+        bool pending_[kLatency] = {};
+        int next_ = 0;
+        bool active_ = false;
+    };
+
+}
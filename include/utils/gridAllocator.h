@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace utils {
+
+    constexpr size_t kGridAlignment = 64;            // cache line; also enough for any SIMD load
+    constexpr size_t kHugePageBytes = 2u << 20;      // allocations from this size up get huge pages
+
+    /**
+     * @brief How the grid allocations of the process are backed (for stats displays).
+     */
+    struct GridMemoryStats {
+        size_t buffers = 0;            // live grid allocations
+        size_t bytes = 0;              // bytes reserved for them
+        size_t explicitHugeBytes = 0;  // in reserved huge pages (MAP_HUGETLB, MEM_LARGE_PAGES)
+        size_t transparentBytes = 0;   // 2 MB aligned and advised for transparent huge pages
+        size_t smallBytes = 0;         // small grids on the heap (64-byte aligned)
+        size_t backedHugeBytes = 0;    // process-wide anonymous memory the kernel backs with huge pages (Linux)
+    };
+
+    /**
+     * @brief Allocate zero-untouched memory for a grid buffer.
+     *
+     * Buffers of kHugePageBytes and more are mapped directly: in reserved huge pages
+     * when the system has some, otherwise 2 MB aligned and advised for transparent huge
+     * pages, which cuts TLB misses on large grids. Smaller buffers come from the heap.
+     * Either way the memory is kGridAlignment aligned and its pages are not touched, so
+     * the first thread to write a page decides its NUMA node.
+     * @param bytes Size in bytes.
+     * @return The memory.
+     * @throws std::bad_alloc if no memory is available.
+     */
+    void* allocateGrid(size_t bytes);
+
+    /**
+     * @brief Release memory from allocateGrid().
+     * @param memory Pointer returned by allocateGrid().
+     * @param bytes Size passed to allocateGrid().
+     */
+    void freeGrid(void* memory, size_t bytes) noexcept;
+
+    /**
+     * @brief Current totals of the grid allocations.
+     */
+    GridMemoryStats gridMemoryStats();
+
+    /**
+     * @brief Standard allocator over allocateGrid() for grid buffers.
+     *
+     * Value-less resize() leaves elements uninitialised (no page is touched), so owners
+     * can first-touch their buffers from the threads that will use each part.
+     */
+    template <class T>
+    class GridAllocator {
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        GridAllocator() noexcept = default;
+
+        template <class U>
+        GridAllocator(const GridAllocator<U>&) noexcept {}
+
+        T* allocate(size_t n) {
+            return static_cast<T*>(allocateGrid(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t n) noexcept {
+            freeGrid(p, n * sizeof(T));
+        }
+
+        // Default-initialise: trivial types stay untouched
+        template <class U>
+        void construct(U* p) noexcept(std::is_nothrow_default_constructible<U>::value) {
+            ::new (static_cast<void*>(p)) U;
+        }
+
+        template <class U, class... Args>
+        void construct(U* p, Args&&... args) {
+            ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+        }
+
+        template <class U>
+        bool operator==(const GridAllocator<U>&) const noexcept {
+            return true;
+        }
+
+        template <class U>
+        bool operator!=(const GridAllocator<U>&) const noexcept {
+            return false;
+        }
+    };
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+
+namespace utils {
+
+    /**
+     * @brief OpenGL 3.3 core context without a window (EGL), for batch rendering.
+     *
+     * Uses the default EGL display, or Mesa's surfaceless platform when no display server
+     * is available, so it also runs on servers with software rendering (llvmpipe). GLAD is
+     * loaded once the context is current. Only one instance should exist at a time.
+     */
+    class HeadlessContext {
+    public:
+        HeadlessContext() = default;
+        ~HeadlessContext();
+
+        HeadlessContext(const HeadlessContext&) = delete;
+        HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+        /**
+         * @brief Create the context, make it current and load the GL functions.
+         * @param error Receives a message on failure.
+         * @return True on success.
+         */
+        bool create(std::string& error);
+
+        /**
+         * @brief Release the context (no-op if none was created).
+         */
+        void destroy();
+
+        /**
+         * @brief GL_RENDERER of the current context, empty before create().
+         */
+        std::string renderer() const;
+
+    private:
+        void* display_ = nullptr;   // EGLDisplay
+        void* surface_ = nullptr;   // EGLSurface (1x1 pbuffer, may stay null when surfaceless)
+        void* context_ = nullptr;   // EGLContext
+    };
+
+}
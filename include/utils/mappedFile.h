@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace utils {
+
+    /**
+     * @brief Read-only memory mapping of a whole file (RAII).
+     *
+     * Uses mmap on POSIX systems and file mappings on Windows. The mapping is released
+     * when the object is destroyed.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Map a file for sequential reading.
+         * @param path File path.
+         * @return True on success, false if the file cannot be opened or mapped.
+         */
+        bool open(const char* path);
+
+        /**
+         * @brief Unmap the file (no-op if nothing is mapped).
+         */
+        void close();
+
+        /**
+         * @brief First byte of the mapping, or null if nothing is mapped.
+         */
+        const uint8_t* data() const {
+            return data_;
+        }
+
+        /**
+         * @brief Size of the mapping in bytes.
+         */
+        size_t size() const {
+            return size_;
+        }
+
+    private:
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+#ifdef _WIN32
+        void* file_ = nullptr;     // HANDLE of the file
+        void* mapping_ = nullptr;  // HANDLE of the file mapping
+#endif
+    };
+
+    /**
+     * @brief Shared read-write memory mapping of a whole file (RAII), for data larger than RAM.
+     *
+     * Writes go to the file through the page cache. Pages are read in on first access;
+     * willNeed() and release() let a sequential sweep read ahead and drop what it is done
+     * with, so the resident set stays a few bands deep whatever the file size.
+     */
+    class WritableMappedFile {
+    public:
+        WritableMappedFile() = default;
+        ~WritableMappedFile();
+
+        WritableMappedFile(const WritableMappedFile&) = delete;
+        WritableMappedFile& operator=(const WritableMappedFile&) = delete;
+
+        /**
+         * @brief Create (or truncate) a file of the given size and map it; new bytes read as zero.
+         * @param path File path.
+         * @param size Size in bytes (> 0).
+         * @param error Error text on failure.
+         * @return True on success.
+         */
+        bool create(const std::string& path, size_t size, std::string& error);
+
+        /**
+         * @brief Map an existing file for reading and writing.
+         * @param path File path.
+         * @param error Error text on failure.
+         * @return True on success.
+         */
+        bool open(const std::string& path, std::string& error);
+
+        /**
+         * @brief Unmap the file (no-op if nothing is mapped); written data stays in the file.
+         */
+        void close();
+
+        /**
+         * @brief Start reading a range in the background (madvise WILLNEED, PrefetchVirtualMemory).
+         */
+        void willNeed(size_t offset, size_t bytes) const;
+
+        /**
+         * @brief Start writing a range back and drop its pages from this process.
+         *
+         * The contents stay valid: a later access reads them back from the file.
+         */
+        void release(size_t offset, size_t bytes) const;
+
+        /**
+         * @brief First byte of the mapping, or null if nothing is mapped.
+         */
+        uint8_t* data() const {
+            return data_;
+        }
+
+        /**
+         * @brief Size of the mapping in bytes.
+         */
+        size_t size() const {
+            return size_;
+        }
+
+    private:
+        uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+#ifdef _WIN32
+        void* file_ = nullptr;     // HANDLE of the file
+        void* mapping_ = nullptr;  // HANDLE of the file mapping
+
+        // Map size bytes of file_, extending the file if it is shorter
+        bool map(size_t size, const std::string& path, std::string& error);
+#else
+        // Map size bytes of an open descriptor and close it
+        bool map(int fd, size_t size, const std::string& path, std::string& error);
+#endif
+    };
+
+}
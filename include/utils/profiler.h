@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace utils {
+
+    /**
+     * @brief One timed interval (CPU scope or GPU query).
+     */
+    struct ProfileEvent {
+        const char* name = nullptr;  // static string (e.g. a literal)
+        uint64_t startNs = 0;        // Profiler::nowNs() at the start
+        uint64_t durationNs = 0;
+        uint32_t thread = 0;         // small per-thread id, or Profiler::kGpuThread
+    };
+
+    /**
+     * @brief Percentiles of one stage over a time window, in milliseconds.
+     */
+    struct ProfileStats {
+        const char* name = nullptr;
+        bool gpu = false;
+        size_t count = 0;
+        double lastMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    /**
+     * @brief Process-wide event ring for frame profiling.
+     *
+     * Producers on any thread claim a slot with one atomic increment and publish it with a
+     * per-slot sequence number; readers copy slots and drop any that were overwritten
+     * while being read. Nothing locks and nothing allocates after construction, so timers
+     * can sit inside the simulation kernel and the writer threads.
+     */
+    class Profiler {
+    public:
+        /**
+         * @brief Shared instance used by ScopedTimer and GpuTimer.
+         */
+        static Profiler& instance();
+
+        /**
+         * @brief Monotonic time in nanoseconds since the profiler was created.
+         */
+        static uint64_t nowNs();
+
+        /**
+         * @brief Small id of the calling thread (1 for the first thread that asks).
+         */
+        static uint32_t threadId();
+
+        /**
+         * @brief Append an event, overwriting the oldest one when the ring is full.
+         * @param name Static event name.
+         * @param startNs Start time from nowNs().
+         * @param durationNs Duration in nanoseconds.
+         * @param thread Thread id from threadId() or kGpuThread.
+         */
+        void record(const char* name, uint64_t startNs, uint64_t durationNs, uint32_t thread);
+
+        /**
+         * @brief Copy the events that started at or after a given time, oldest first.
+         * @param sinceNs Lower bound on ProfileEvent::startNs.
+         * @param out Receives the events (cleared first).
+         */
+        void snapshot(uint64_t sinceNs, std::vector<ProfileEvent>& out) const;
+
+        /**
+         * @brief Per-stage percentiles over the last seconds, sorted by name.
+         * @param seconds Window length.
+         * @return One entry per distinct event name.
+         */
+        std::vector<ProfileStats> summarize(double seconds) const;
+
+        /**
+         * @brief Write the last seconds as a Chrome trace (chrome://tracing, Perfetto).
+         * @param path Output JSON file.
+         * @param seconds Window length.
+         * @param error Receives a message on failure.
+         * @return True on success.
+         */
+        bool writeChromeTrace(const std::string& path, double seconds, std::string& error) const;
+
+        static constexpr size_t kCapacity = size_t(1) << 17;   // events kept (~2 MB)
+        static constexpr uint32_t kGpuThread = 0xFFFF;         // thread id of GPU events
+
+    private:
+        Profiler();
+
+        // Event fields are atomics so readers racing a writer stay well-defined
+        struct Slot {
+            std::atomic<uint64_t> seq{0};   // 2*index+1 while writing, 2*index+2 when published
+            std::atomic<const char*> name{nullptr};
+            std::atomic<uint64_t> startNs{0};
+            std::atomic<uint64_t> durationNs{0};
+            std::atomic<uint32_t> thread{0};
+        };
+
+        std::unique_ptr<Slot[]> slots_;
+        std::atomic<uint64_t> head_{0};     // index of the next event
+    };
+
+    /**
+     * @brief Records the lifetime of a scope as one CPU event.
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(const char* name) : name_(name), startNs_(Profiler::nowNs()) {}
+
+        ~ScopedTimer() {
+            Profiler::instance().record(name_, startNs_, Profiler::nowNs() - startNs_, Profiler::threadId());
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        const char* name_;
+        uint64_t startNs_;
+    };
+
+}
+
+#define GOL_PROFILE_CONCAT_INNER(a, b) a##b
+#define GOL_PROFILE_CONCAT(a, b) GOL_PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Time the enclosing scope under a static name.
+ */
+#define PROFILE_SCOPE(name) ::utils::ScopedTimer GOL_PROFILE_CONCAT(profileScope_, __LINE__)(name)
@@ -1,7 +1,32 @@
 #pragma once
 
 #include <glad/glad.h>
+#include <string>
 
-GLuint makeProgramFromFiles(const char* vsPath, const char* fsPath);
+/**
+ * @brief Build a program from shaders by file name (e.g. "shader2d.vert").
+ *
+ * Sources are the copies embedded at build time, or the files under SHADER_DIR when the
+ * build enables SHADER_HOT_RELOAD. When a cache directory is set and the driver supports
+ * program binaries, linked programs are stored there keyed by a hash of the driver
+ * strings and both sources, so later launches skip compilation entirely.
+ * @param vsName Vertex shader file name.
+ * @param fsName Fragment shader file name.
+ * @return Linked program; throws std::runtime_error on failure.
+ */
+GLuint makeProgram(const char* vsName, const char* fsName);
 
-GLuint makeProgramFromSource(const char* vsSource, const char* fsSource, const char* debugName);
\ No newline at end of file
+/**
+ * @brief Directory for cached program binaries (created on demand; empty disables the cache).
+ * @param dir Cache directory.
+ */
+void setProgramCacheDir(const std::string& dir);
+
+/**
+ * @brief Poll the shader files used so far for changes (hot-reload builds only).
+ *
+ * Checks file times at most twice per second; always false without SHADER_HOT_RELOAD.
+ * @param now Current time in seconds.
+ * @return True once after any watched file was modified.
+ */
+bool shadersChangedOnDisk(double now);
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace utils {
+
+    /**
+     * @brief Named shared-memory segment mapped into this process (RAII).
+     *
+     * Uses POSIX shared memory (shm_open + mmap) and named file mappings on Windows.
+     * The process that creates a segment owns its name: the name is removed when the
+     * owner closes it, while processes that still have it mapped keep their view.
+     */
+    class SharedMemory {
+    public:
+        SharedMemory() = default;
+        ~SharedMemory();
+
+        SharedMemory(const SharedMemory&) = delete;
+        SharedMemory& operator=(const SharedMemory&) = delete;
+
+        /**
+         * @brief Create (or replace) a zero-filled, writable segment.
+         * @param name Segment name without a leading slash, e.g. "gol-grid".
+         * @param size Size in bytes.
+         * @param error Error text on failure.
+         * @return True on success.
+         */
+        bool create(const std::string& name, size_t size, std::string& error);
+
+        /**
+         * @brief Map an existing segment read-only.
+         * @param name Segment name used by the creator.
+         * @param error Error text on failure.
+         * @return True on success.
+         */
+        bool open(const std::string& name, std::string& error);
+
+        /**
+         * @brief Unmap the segment and remove its name if this process created it.
+         */
+        void close();
+
+        /**
+         * @brief First byte of the mapping, or null if nothing is mapped.
+         */
+        uint8_t* data() const {
+            return data_;
+        }
+
+        /**
+         * @brief Size of the mapping in bytes.
+         */
+        size_t size() const {
+            return size_;
+        }
+
+    private:
+        uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+        std::string ownedName_;      // name to remove on close(), empty for opened segments
+#ifdef _WIN32
+        void* mapping_ = nullptr;    // HANDLE of the file mapping
+#endif
+    };
+
+}
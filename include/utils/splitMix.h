@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace utils {
+
+    /**
+     * @brief Step between consecutive SplitMix64 counters (2^64 divided by the golden ratio).
+     */
+    constexpr uint64_t kSplitMixGamma = 0x9E3779B97F4A7C15ull;
+
+    /**
+     * @brief SplitMix64 finalizer: a well-mixed 64-bit value for any key.
+     *
+     * Used as a counter-based generator (the n-th draw is splitMix64(base + n * kSplitMixGamma),
+     * so draws can be skipped without generating them) and as a hash finalizer. Hash
+     * seeds through it first, or neighbouring seeds give shifted copies of one stream.
+     */
+    inline uint64_t splitMix64(uint64_t key) {
+        uint64_t z = key;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+    /**
+     * @brief Fixed set of worker threads for fork-join loops.
+     *
+     * parallelFor() gives every thread (the workers and the caller) a contiguous slice of
+     * the task indices; a thread that runs out steals the upper half of another thread's
+     * remaining slice, and the call returns once every task has finished. Without stealing,
+     * task i of a loop of size() tasks always runs on thread i. forEachThread() instead
+     * runs one task per thread with a stable thread index, for work whose data should stay
+     * with the thread that first touched it. Only one loop runs at a time; nested or
+     * concurrent calls run serially on the calling thread.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @brief Start the workers.
+         * @param threads Total threads including the caller (0 = hardware threads).
+         */
+        explicit ThreadPool(size_t threads = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Process-wide pool sized to the hardware.
+         */
+        static ThreadPool& shared();
+
+        /**
+         * @brief Threads that run tasks, including the caller.
+         */
+        size_t size() const {
+            return workers_.size() + 1;
+        }
+
+        /**
+         * @brief Run task(i) for every i in [0, count) and wait for all of them.
+         * @param count Number of tasks.
+         * @param task Callable invoked once per index, from any thread.
+         */
+        void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+        /**
+         * @brief Run task(t) once on every thread t in [0, size()) and wait for all of them.
+         *
+         * Thread 0 is the caller and thread k is always the same worker, so a caller that
+         * splits data by thread index keeps each part on one thread (and, through first
+         * touch, on that thread's NUMA node) across calls.
+         * @param task Callable invoked once per thread index.
+         */
+        void forEachThread(const std::function<void(size_t)>& task);
+
+    private:
+        // Remaining task indices of one thread, [begin, end) packed as end << 32 | begin
+        struct alignas(64) Slice {
+            std::atomic<uint64_t> span{0};
+        };
+
+        void workerLoop(size_t index);
+        void runTasks(size_t self);
+        bool popOwn(size_t self, size_t& index);
+        bool steal(size_t self, size_t victim, size_t& index);
+
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable startCv_;     // a loop was published or stopping
+        std::condition_variable doneCv_;      // a worker finished its share
+        const std::function<void(size_t)>* task_ = nullptr;
+        std::unique_ptr<Slice[]> slices_;     // one per thread, index 0 is the caller
+        uint64_t round_ = 0;                  // loops published so far
+        size_t busy_ = 0;                     // workers still inside the current loop
+        bool pinned_ = false;                 // current loop is forEachThread()
+        std::atomic<bool> running_{false};    // a loop is in progress
+        bool stopping_ = false;
+    };
+
+}
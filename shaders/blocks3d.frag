@@ -0,0 +1,15 @@
+#version 330 core
+
+in vec3 vPos;
+in vec3 vColor;             // palette colour of the cell's state
+
+uniform vec3 uLightDir;     // model space, normalized
+
+out vec4 FragColor;
+
+void main() {
+    // Flat face normal from screen-space derivatives
+    vec3 n = normalize(cross(dFdx(vPos), dFdy(vPos)));
+    float diffuse = 0.35 + 0.65 * abs(dot(n, uLightDir));
+    FragColor = vec4(vColor * diffuse, 1.0);
+}
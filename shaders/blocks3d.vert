@@ -0,0 +1,96 @@
+#version 330 core
+
+layout(location=0) in uint aCell;   // per-instance live cell index (y * width + x)
+
+uniform mat4 uMVP;
+uniform ivec2 uGridSize;
+uniform vec2 uRadii;        // (outer, inner)
+uniform float uFill;        // footprint of a block relative to its cell
+uniform float uHeight;      // block height relative to the cell's extent along the tube
+uniform int uSurface;       // 0 torus, 1 Klein bottle, 2 projective plane, 3 flat sheet (see core::Topology)
+uniform vec2 uSheet;        // half extents of the flat sheet
+uniform sampler2D uState;   // cell states, coloured through uPalette
+uniform vec3 uPalette[4];
+
+out vec3 vPos;
+out vec3 vColor;
+
+const float TWO_PI = 6.28318530718;
+const float HALF_PI = 1.57079632679;
+
+// Apery's immersion of the projective plane (Boy's surface); even, so p and -p meet
+vec3 boySurface(vec3 p) {
+    float x = p.x, y = p.y, z = p.z;
+    float x2 = x * x, y2 = y * y, z2 = z * z;
+    float r2 = x2 + y2 + z2;
+    float s = x + y + z;
+    return vec3(
+        0.5 * ((2.0 * x2 - y2 - z2) * r2 + 2.0 * y * z * (y2 - z2) + z * x * (x2 - z2) + x * y * (y2 - x2)),
+        0.8660254 * ((y2 - z2) * r2 + z * x * (z2 - x2) + x * y * (y2 - x2)),
+        0.125 * s * (s * s * s + 4.0 * (y - x) * (z - y) * (x - z)));
+}
+
+// Surface point of grid coordinates st in [0, 1]^2 (s along x, t along y), glued as the topology
+vec3 surfacePoint(vec2 st) {
+    float a = (1.0 - st.x) * TWO_PI;   // major angle (ring)
+    float b = (0.5 - st.y) * TWO_PI;   // minor angle (tube)
+
+    if (uSurface == 1) {
+        // Figure-8 Klein bottle: once around the ring the tube comes back mirrored (b -> -b)
+        float w = cos(0.5 * a) * sin(b) - sin(0.5 * a) * sin(2.0 * b);
+        float ring = uRadii.x + uRadii.y * w;
+        return vec3(ring * cos(a), ring * sin(a), uRadii.y * (sin(0.5 * a) * sin(b) + cos(0.5 * a) * sin(2.0 * b)));
+    }
+    if (uSurface == 2) {
+        // Square -> disc -> upper hemisphere: opposite edge points land on antipodes
+        vec2 q = 2.0 * st - 1.0;
+        float r = max(abs(q.x), abs(q.y));
+        float len = length(q);
+        vec2 dir = len > 0.0 ? q / len : vec2(0.0);
+        return uRadii.x * boySurface(vec3(dir * sin(r * HALF_PI), cos(r * HALF_PI)));
+    }
+    if (uSurface == 3) {
+        return vec3((1.0 - 2.0 * st.x) * uSheet.x, (1.0 - 2.0 * st.y) * uSheet.y, 0.0);
+    }
+
+    float ring = uRadii.x + uRadii.y * cos(b);
+    return vec3(ring * cos(a), ring * sin(a), uRadii.y * sin(b));
+}
+
+// Surface tangents along s and t by central differences
+void surfaceTangents(vec2 st, out vec3 ds, out vec3 dt) {
+    const float h = 1e-3;
+    ds = (surfacePoint(st + vec2(h, 0.0)) - surfacePoint(st - vec2(h, 0.0))) / (2.0 * h);
+    dt = (surfacePoint(st + vec2(0.0, h)) - surfacePoint(st - vec2(0.0, h))) / (2.0 * h);
+}
+
+void main() {
+    // Unit box without its bottom face, CCW outward (x along major, y along minor, z along normal)
+    const vec3 kBox[30] = vec3[](
+        vec3(1,0,0), vec3(1,1,0), vec3(1,1,1),  vec3(1,0,0), vec3(1,1,1), vec3(1,0,1),
+        vec3(0,0,0), vec3(0,1,1), vec3(0,1,0),  vec3(0,0,0), vec3(0,0,1), vec3(0,1,1),
+        vec3(0,1,0), vec3(0,1,1), vec3(1,1,1),  vec3(0,1,0), vec3(1,1,1), vec3(1,1,0),
+        vec3(0,0,0), vec3(1,0,0), vec3(1,0,1),  vec3(0,0,0), vec3(1,0,1), vec3(0,0,1),
+        vec3(0,0,1), vec3(1,0,1), vec3(1,1,1),  vec3(0,0,1), vec3(1,1,1), vec3(0,1,1)
+    );
+
+    int cellX = int(aCell % uint(uGridSize.x));
+    int cellY = int(aCell / uint(uGridSize.x));
+    vec3 corner = kBox[gl_VertexID];
+
+    // Inset footprint, mapped so the surface angles grow with the box axes (matches shader3d.vert UVs)
+    vec2 t = mix(vec2(0.5 - 0.5 * uFill), vec2(0.5 + 0.5 * uFill), corner.xy);
+    vec2 st = (vec2(cellX + 1, cellY + 1) - t) / vec2(uGridSize);
+
+    // Normal from the tangents; the sheet's blocks stand on its upper side
+    vec3 ds, dt;
+    surfaceTangents(st, ds, dt);
+    vec3 normal = normalize(cross(ds, dt));
+    if (uSurface == 3) normal = -normal;
+    float height = uHeight * length(dt) / float(uGridSize.y);
+    vec3 pos = surfacePoint(st) + corner.z * height * normal;
+
+    vPos = pos;
+    vColor = uPalette[min(int(texelFetch(uState, ivec2(cellX, cellY), 0).r * 255.0 + 0.5), 3)];
+    gl_Position = uMVP * vec4(pos, 1.0);
+}
@@ -7,8 +7,15 @@ uniform ivec2 uGridSize;
 uniform vec2 uViewportPx;
 uniform sampler2D uState;
 
-uniform vec3 uDeadColor;
-uniform vec3 uAliveColor;
+uniform vec3 uPalette[4];     // colour per cell state: 0 dead, 1 alive, 2..3 extra states (see render::statePalette)
+
+uniform sampler2D uAge;       // age/trail plane (see core::Life)
+uniform bool uAgeEnabled;
+uniform vec3 uYoungColor;
+uniform vec3 uTrailColor;
+
+uniform sampler2D uLabels;    // component colour index, 0 for dead cells (see core::ComponentLabeler)
+uniform bool uLabelsEnabled;
 
 uniform float uLineThicknessPx;
 uniform vec3 uLineColor;
@@ -29,8 +36,23 @@ void main() {
         discard;
     }
 
-    float stateVal = texelFetch(uState, cell, 0).r;
-    vec3 baseColor = (stateVal > 0.0) ? uAliveColor : uDeadColor;
+    int state = min(int(texelFetch(uState, cell, 0).r * 255.0 + 0.5), 3);
+    vec3 baseColor = uPalette[state];
+
+    // Age: young -> alive colour over 32 generations, trail fades back to dead
+    if (uAgeEnabled && state <= 1) {
+        float age = texelFetch(uAge, cell, 0).r * 255.0;
+        baseColor = (state == 1)
+            ? mix(uYoungColor, uPalette[1], clamp((age - 128.0) / 32.0, 0.0, 1.0))
+            : mix(uPalette[0], uTrailColor, age / 127.0);
+    }
+
+    // Labels: one hue per connected object, spread by the golden ratio
+    if (uLabelsEnabled && state > 0) {
+        float index = texelFetch(uLabels, cell, 0).r * 255.0;
+        vec3 hue = clamp(abs(fract(index * 0.618034 + vec3(0.0, 2.0, 1.0) / 3.0) * 6.0 - 3.0) - 1.0, 0.0, 1.0);
+        baseColor = mix(vec3(0.85), hue, 0.75) * 0.8;
+    }
 
     bool isHover = all(equal(cell, uHoverCell));
     if (isHover) {
@@ -3,8 +3,11 @@
 in vec2 vUV;
 
 uniform sampler2D uState;
-uniform vec3 uDeadColor;
-uniform vec3 uAliveColor;
+uniform vec3 uPalette[4];     // colour per cell state (see render::statePalette)
+uniform sampler2D uAge;       // age/trail plane (see core::Life)
+uniform bool uAgeEnabled;
+uniform vec3 uYoungColor;
+uniform vec3 uTrailColor;
 uniform ivec2 uGridSize;
 uniform float uLinePx;
 uniform vec3 uLineColor;
@@ -44,14 +47,20 @@ float axisV_px(vec2 uv, float px){
 
 void main() {
 
-    vec2 grid = vec2(uGridSize);
+    // Cells are resolved per fragment, independently of the mesh tessellation
     vec2 uv01 = fract(vUV);
-    vec2 cell = floor(uv01 * grid);
-    vec2 center = (cell + vec2(0.5)) / grid;
+    ivec2 cell = min(ivec2(floor(uv01 * vec2(uGridSize))), uGridSize - ivec2(1));
 
-    float s = texture(uState, center).r;
-    float alive = (s > (0.5/255.0)) ? 1.0 : 0.0;
-    vec3 baseCol = mix(uDeadColor, uAliveColor, alive);
+    int state = min(int(texelFetch(uState, cell, 0).r * 255.0 + 0.5), 3);
+    vec3 baseCol = uPalette[state];
+
+    // Age: young -> alive colour over 32 generations, trail fades back to dead
+    if (uAgeEnabled && state <= 1) {
+        float age = texelFetch(uAge, cell, 0).r * 255.0;
+        baseCol = (state == 1)
+            ? mix(uYoungColor, uPalette[1], clamp((age - 128.0) / 32.0, 0.0, 1.0))
+            : mix(uPalette[0], uTrailColor, age / 127.0);
+    }
 
     float lineMask = (uLinePx > 0.0) ? gridLineUV_px(uv01, uGridSize, uLinePx) : 0.0;
     vec3 color = mix(baseCol, uLineColor, lineMask);
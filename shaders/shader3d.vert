@@ -1,13 +1,68 @@
 #version 330 core
 
-layout(location=0) in vec3 aPos;
-layout(location=2) in vec2 aUV;
-
 uniform mat4 uMVP;
+uniform ivec2 uSegments;   // (major, minor) quads
+uniform vec2 uRadii;       // (outer, inner)
+uniform int uSurface;      // 0 torus, 1 Klein bottle, 2 projective plane, 3 flat sheet (see core::Topology)
+uniform vec2 uSheet;       // half extents of the flat sheet
+
+const float TWO_PI = 6.28318530718;
+const float HALF_PI = 1.57079632679;
+
+// Apery's immersion of the projective plane (Boy's surface); even, so p and -p meet
+vec3 boySurface(vec3 p) {
+    float x = p.x, y = p.y, z = p.z;
+    float x2 = x * x, y2 = y * y, z2 = z * z;
+    float r2 = x2 + y2 + z2;
+    float s = x + y + z;
+    return vec3(
+        0.5 * ((2.0 * x2 - y2 - z2) * r2 + 2.0 * y * z * (y2 - z2) + z * x * (x2 - z2) + x * y * (y2 - x2)),
+        0.8660254 * ((y2 - z2) * r2 + z * x * (z2 - x2) + x * y * (y2 - x2)),
+        0.125 * s * (s * s * s + 4.0 * (y - x) * (z - y) * (x - z)));
+}
+
+// Surface point of grid coordinates st in [0, 1]^2 (s along x, t along y), glued as the topology
+vec3 surfacePoint(vec2 st) {
+    float a = (1.0 - st.x) * TWO_PI;   // major angle (ring)
+    float b = (0.5 - st.y) * TWO_PI;   // minor angle (tube)
+
+    if (uSurface == 1) {
+        // Figure-8 Klein bottle: once around the ring the tube comes back mirrored (b -> -b)
+        float w = cos(0.5 * a) * sin(b) - sin(0.5 * a) * sin(2.0 * b);
+        float ring = uRadii.x + uRadii.y * w;
+        return vec3(ring * cos(a), ring * sin(a), uRadii.y * (sin(0.5 * a) * sin(b) + cos(0.5 * a) * sin(2.0 * b)));
+    }
+    if (uSurface == 2) {
+        // Square -> disc -> upper hemisphere: opposite edge points land on antipodes
+        vec2 q = 2.0 * st - 1.0;
+        float r = max(abs(q.x), abs(q.y));
+        float len = length(q);
+        vec2 dir = len > 0.0 ? q / len : vec2(0.0);
+        return uRadii.x * boySurface(vec3(dir * sin(r * HALF_PI), cos(r * HALF_PI)));
+    }
+    if (uSurface == 3) {
+        return vec3((1.0 - 2.0 * st.x) * uSheet.x, (1.0 - 2.0 * st.y) * uSheet.y, 0.0);
+    }
+
+    float ring = uRadii.x + uRadii.y * cos(b);
+    return vec3(ring * cos(a), ring * sin(a), uRadii.y * sin(b));
+}
 
 out vec2 vUV;
 
 void main(){
-    vUV = aUV;
-    gl_Position = uMVP * vec4(aPos, 1.0);
+    // Two triangles per quad, same winding as the former indexed mesh
+    const ivec2 kCorner[6] = ivec2[](
+        ivec2(0, 0), ivec2(0, 1), ivec2(1, 0),
+        ivec2(1, 0), ivec2(0, 1), ivec2(1, 1)
+    );
+
+    int quad = gl_VertexID / 6;
+    ivec2 ij = ivec2(quad % uSegments.x, quad / uSegments.x) + kCorner[gl_VertexID % 6];
+
+    float u = float(ij.x) / float(uSegments.x);
+    float v = float(ij.y) / float(uSegments.y);
+
+    vUV = vec2(1.0 - u, v);  // mirror U so grid-right maps to torus-right
+    gl_Position = uMVP * vec4(surfacePoint(vUV), 1.0);
 }
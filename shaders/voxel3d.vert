@@ -0,0 +1,38 @@
+#version 330 core
+
+layout(location=0) in uint aVoxel;  // per-instance live cell index (z * width * height + y * width + x)
+
+uniform mat4 uMVP;
+uniform ivec3 uGridSize;
+uniform float uFill;        // edge of a cube relative to its cell
+
+out vec3 vPos;
+out vec3 vColor;
+
+void main() {
+    // Unit cube, CCW outward
+    const vec3 kCube[36] = vec3[](
+        vec3(1,0,0), vec3(1,1,0), vec3(1,1,1),  vec3(1,0,0), vec3(1,1,1), vec3(1,0,1),
+        vec3(0,0,0), vec3(0,1,1), vec3(0,1,0),  vec3(0,0,0), vec3(0,0,1), vec3(0,1,1),
+        vec3(0,1,0), vec3(0,1,1), vec3(1,1,1),  vec3(0,1,0), vec3(1,1,1), vec3(1,1,0),
+        vec3(0,0,0), vec3(1,0,0), vec3(1,0,1),  vec3(0,0,0), vec3(1,0,1), vec3(0,0,1),
+        vec3(0,0,1), vec3(1,0,1), vec3(1,1,1),  vec3(0,0,1), vec3(1,1,1), vec3(0,1,1),
+        vec3(0,0,0), vec3(1,1,0), vec3(1,0,0),  vec3(0,0,0), vec3(0,1,0), vec3(1,1,0)
+    );
+
+    uint plane = uint(uGridSize.x * uGridSize.y);
+    uint z = aVoxel / plane;
+    uint rest = aVoxel - z * plane;
+    uint y = rest / uint(uGridSize.x);
+    uint x = rest - y * uint(uGridSize.x);
+    vec3 cell = vec3(float(x), float(y), float(z));
+
+    vec3 pos = cell + 0.5 + (kCube[gl_VertexID] - 0.5) * uFill;
+
+    // Colour by position so depth stays readable inside dense clusters
+    vec3 t = (cell + 0.5) / vec3(uGridSize);
+    vColor = mix(vec3(0.20, 0.45, 0.85), vec3(0.95, 0.55, 0.25), t.z) * (0.8 + 0.2 * t.y);
+
+    vPos = pos;
+    gl_Position = uMVP * vec4(pos, 1.0);
+}
@@ -3,11 +3,30 @@
 #include "../../include/app/input.h"
 #include "../../include/core/simulation.h"
 #include "../../include/core/camera.h"
+#include "../../include/core/life3d.h"
+#include "../../include/core/scheduler.h"
+#include "../../include/io/asyncPatternIo.h"
+#include "../../include/io/autosave.h"
+#include "../../include/io/recording.h"
+#include "../../include/io/sharedGridPublisher.h"
+#include "../../include/io/streamServer.h"
+#include "../../include/render/frameExporter.h"
 #include "../../include/render/renderer2d.h"
 #include "../../include/render/renderer3d.h"
+#include "../../include/render/voxelRenderer.h"
+#include "../../include/ui/profilerOverlay.h"
 #include "../../include/ui/toolbar.h"
+#include "../../include/utils/gpuTimer.h"
+#include "../../include/utils/profiler.h"
+#include "../../include/utils/shaderUtils.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+#include <utility>
 #include <glad/glad.h>
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
@@ -32,8 +51,62 @@ static void scrollCb(GLFWwindow* w, double /*xoff*/, double yoff) {
     if (self) self->onScroll(yoff);
 }
 
+static void refreshCb(GLFWwindow* w) {
+    App* self = reinterpret_cast<App*>(glfwGetWindowUserPointer(w));
+    if (self) self->requestRedraw();
+}
+
+// Longest sleep while idle: background results (loads, network commands, shader edits) and
+// ImGui timers such as tooltips and the text cursor are picked up at least this often
+static constexpr double kIdleWaitSeconds = 0.1;
+
+// FNV-1a over the ImGui geometry: equal hashes mean the UI would draw the same pixels
+static uint64_t hashDrawData(const ImDrawData* data) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    auto mix = [&h](const void* bytes, size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(bytes);
+        for (size_t i = 0; i < size; ++i) h = (h ^ p[i]) * 0x100000001b3ull;
+    };
+    if (!data) return h;
+    for (int n = 0; n < data->CmdListsCount; ++n) {
+        const ImDrawList* list = data->CmdLists[n];
+        mix(list->VtxBuffer.Data, static_cast<size_t>(list->VtxBuffer.Size) * sizeof(ImDrawVert));
+        mix(list->IdxBuffer.Data, static_cast<size_t>(list->IdxBuffer.Size) * sizeof(ImDrawIdx));
+        for (const ImDrawCmd& cmd : list->CmdBuffer) {
+            mix(&cmd.ClipRect, sizeof(cmd.ClipRect));
+            mix(&cmd.ElemCount, sizeof(cmd.ElemCount));
+        }
+    }
+    return h;
+}
+
+// Per-user directory for cached shader program binaries
+static std::filesystem::path shaderCacheDir() {
+#ifdef _WIN32
+    if (const char* local = std::getenv("LOCALAPPDATA")) return std::filesystem::path(local) / "GameOfLife" / "shader-cache";
+#else
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME")) return std::filesystem::path(xdg) / "GameOfLife" / "shaders";
+    if (const char* home = std::getenv("HOME")) return std::filesystem::path(home) / ".cache" / "GameOfLife" / "shaders";
+#endif
+    return std::filesystem::path("shader-cache");
+}
+
 namespace app {
 
+    // Comparison simulations beside the main one (each takes a row of the window)
+    static constexpr size_t kMaxViews = 3;
+
+    // Another simulation with its own row of viewports and its own toolbar
+    struct CompareView {
+        std::unique_ptr<core::Simulation> simulation;
+        std::unique_ptr<render::Renderer2D> r2d;
+        std::unique_ptr<render::Renderer3D> r3d;
+        core::OrbitCamera camera;
+        ui::CompareToolbarState toolbar;
+        int schedulerId = 0;
+        int redrawListener = 0;
+    };
+
     App::App(const AppConfig& cfg) : config_(cfg) {}
     App::~App() {}
 
@@ -53,12 +126,33 @@ namespace app {
         glFrontFace(GL_CCW);
 
         // Systems
+        setProgramCacheDir(shaderCacheDir().string());
         simulation_ = std::make_unique<core::Simulation>(50, 50);
+        scheduler_ = std::make_unique<core::SimulationScheduler>();
+        schedulerId_ = scheduler_->add(*simulation_);
         camera_ = std::make_unique<core::OrbitCamera>();
         r2d_ = std::make_unique<render::Renderer2D>(*simulation_);
         r3d_ = std::make_unique<render::Renderer3D>(*simulation_);
+        voxels_ = std::make_unique<render::VoxelRenderer>();
+        exporter_ = std::make_unique<render::FrameExporter>(*r2d_, *r3d_, *camera_);
         toolbarState_ = std::make_unique<ui::ToolbarState>();
         input_ = std::make_unique<InputState>();
+        profilerOverlay_ = std::make_unique<ui::ProfilerOverlayState>();
+        gpuTimer2D_ = std::make_unique<utils::GpuTimer>("GPU Draw2D");
+        gpuTimer3D_ = std::make_unique<utils::GpuTimer>("GPU Draw3D");
+        patternIo_ = std::make_unique<io::AsyncPatternIo>();
+        autosaver_ = std::make_unique<io::Autosaver>();
+        recorder_ = std::make_unique<io::Recorder>();
+        player_ = std::make_unique<io::Player>();
+        publisher_ = std::make_unique<io::SharedGridPublisher>();
+        server_ = std::make_unique<io::StreamServer>();
+        toolbarState_->fpsCap = config_.fpsCap;
+
+        // Every change of the grid (step, edit, load) needs a new frame and a new checkpoint
+        redrawListener_ = simulation_->addFrameListener([this](const core::Life&, uint64_t, core::FrameChange) {
+            redrawPending_ = true;
+            autosaveDirty_ = true;
+        });
 
         onResize(config_.windowWidth, config_.windowHeight);
         return true;
@@ -84,6 +178,7 @@ namespace app {
         glfwSetWindowUserPointer(window_, this);
         glfwSetFramebufferSizeCallback(window_, framebufferCb);
         glfwSetScrollCallback(window_, scrollCb);
+        glfwSetWindowRefreshCallback(window_, refreshCb);
         return true;
     }
 
@@ -111,6 +206,35 @@ namespace app {
     }
 
     void App::shutdown() {
+        patternIo_.reset(); // waits for a pending save
+        autosaver_.reset(); // finishes the running checkpoint
+        if (recordListener_) simulation_->removeFrameListener(recordListener_);
+        recordListener_ = 0;
+        recorder_.reset();  // flushes queued frames
+        player_.reset();
+        if (exportListener_) simulation_->removeFrameListener(exportListener_);
+        exportListener_ = 0;
+        exporter_.reset();  // drains pending frames
+        if (shareListener_) simulation_->removeFrameListener(shareListener_);
+        shareListener_ = 0;
+        publisher_.reset(); // readers see the segment closed
+        if (serverListener_) simulation_->removeFrameListener(serverListener_);
+        serverListener_ = 0;
+        server_.reset();    // disconnects clients
+        if (volumeListener_) simulation_->removeFrameListener(volumeListener_);
+        volumeListener_ = 0;
+        if (redrawListener_) simulation_->removeFrameListener(redrawListener_);
+        redrawListener_ = 0;
+        for (const std::unique_ptr<CompareView>& view : views_) {
+            scheduler_->remove(view->schedulerId);
+            view->simulation->removeFrameListener(view->redrawListener);
+        }
+        views_.clear();
+        scheduler_.reset();
+        volume_.reset();
+        voxels_.reset();
+        gpuTimer3D_.reset();
+        gpuTimer2D_.reset();
         r3d_.reset();
         r2d_.reset();
         camera_.reset();
@@ -129,6 +253,7 @@ namespace app {
         fbWidth_ = width;
         fbHeight_ = height;
         glViewport(0, 0, width, height);
+        redrawPending_ = true;
     }
 
     void App::onScroll(double yoff) {
@@ -153,101 +278,734 @@ namespace app {
         ImGui::NewFrame();
 
         ui::ToolbarActions act = ui::drawToolbar(*toolbarState_, *simulation_);
+        if (toolbarState_->showProfiler) ui::drawProfilerOverlay(*profilerOverlay_, glfwGetTime(), simulation_->life());
+
+        // F9 dumps the recent frames for chrome://tracing or Perfetto
+        if (ImGui::IsKeyPressed(ImGuiKey_F9, false)) {
+            std::string error;
+            toolbarState_->ioStatus = utils::Profiler::instance().writeChromeTrace("trace.json", 10.0, error)
+                ? "Saved last 10 s to trace.json" : error;
+        }
+
+        // Running or stepping from a playback frame continues live from it
+        if ((act.toggledRun || act.requestStep || act.requestStepBack || act.toggledRewind) && player_->isOpen()) act.closeReplay = true;
 
         if (act.toggledRun) simulation_->toggleRun();
         if (act.requestStep) simulation_->stepOnce();
+        if (act.requestStepBack) simulation_->stepBack();
+        if (act.toggledRewind) simulation_->setRewinding(!simulation_->isRewinding());
         if (act.requestClear) simulation_->clear();
+        if (act.toggledBlocks) simulation_->setLiveCellsEnabled(!simulation_->liveCellsEnabled());
+        if (act.toggledAge) simulation_->setAgeEnabled(!simulation_->ageEnabled());
+        if (act.toggledLabels) simulation_->setLabelsEnabled(!simulation_->labelsEnabled());
+        if (act.toggledInPlace) simulation_->setInPlace(!simulation_->inPlace());
         if (act.newSpeed > 0.0f) simulation_->setStepsPerSecond(act.newSpeed);
+        if (act.newPriority > 0) scheduler_->setPriority(schedulerId_, act.newPriority);
+
+        // Pattern files are read and written in the background; results are applied here
+        if (act.requestStamp) {
+            stampPending_ = patternIo_->load(toolbarState_->patternPath, io::ImportOptions{});
+        }
+        if (act.requestLoad) {
+            io::ImportOptions opt{};
+            opt.minWidth = simulation_->width();
+            opt.minHeight = simulation_->height();
+            patternIo_->load(toolbarState_->patternPath, opt);
+        }
+        if (act.requestSave) patternIo_->save(toolbarState_->patternPath, simulation_->life());
+
+        io::PatternIoResult ioResult;
+        if (patternIo_->poll(ioResult)) {
+            if (ioResult.life && stampPending_) {
+                stamp_ = std::make_unique<core::Life>(std::move(*ioResult.life));
+                toolbarState_->stampName = std::filesystem::path(toolbarState_->patternPath).filename().string();
+                toolbarState_->editTool = ui::EditTool::Paste;
+            }
+            else if (ioResult.life) {
+                // Only multi-state files (snapshots, RLE) record a rule; their states mean nothing under another one
+                const core::LifeRule loadedRule = ioResult.life->rule();
+                simulation_->replace(std::move(*ioResult.life));
+                if (loadedRule.states > 2) {
+                    simulation_->setRule(loadedRule);
+                    toolbarState_->rule = loadedRule;
+                }
+                toolbarState_->colsInput = simulation_->width();
+                toolbarState_->rowsInput = simulation_->height();
+            }
+            toolbarState_->ioStatus = ioResult.message;
+            stampPending_ = false;
+        }
+        toolbarState_->ioBusy = patternIo_->busy();
+
+        updateRecording(act);
+        updateExport(act);
+        updateSharing(act);
+        updateServer(act);
+        updateVolume(act);
+
+        if (act.newTopology >= 0) {
+            simulation_->setTopology(static_cast<core::Topology>(act.newTopology));
+            toolbarState_->ioStatus = std::string("Topology: ") + core::topologyName(simulation_->topology());
+        }
+
+        if (act.ruleChanged) {
+            simulation_->setRule(toolbarState_->rule);
+            toolbarState_->ioStatus = "Rule " + core::formatLifeRule(simulation_->rule());
+        }
+
+        updateViews(act);
+
+        // Edits queued this frame (toolbar and mouse) land as one change and one upload
+        updateEditing(act);
+        simulation_->applyEdits();
 
         if (act.resizeCols >= 0 || act.resizeRows >= 0) {
             const int cols = (act.resizeCols >= 0) ? act.resizeCols : simulation_->width();
             const int rows = (act.resizeRows >= 0) ? act.resizeRows : simulation_->height();
             simulation_->resize(cols, rows);
-            r3d_->rebuildMesh(cols, rows);
         }
 
-        // Fixed-timestep advance (accumulator lives inside Simulation)
-        simulation_->advance(dt);
+        // Fixed-timestep advance of every simulation (accumulators live inside Simulation)
+        scheduler_->advance(dt);
+        toolbarState_->share = static_cast<float>(scheduler_->share(schedulerId_));
+        for (const std::unique_ptr<CompareView>& view : views_) {
+            view->toolbar.share = static_cast<float>(scheduler_->share(view->schedulerId));
+        }
+
+        updateAutosave();
+
+        // Components are labeled once per displayed frame, however many steps ran
+        simulation_->updateLabels();
+        for (const std::unique_ptr<CompareView>& view : views_) view->simulation->updateLabels();
 
         ImGui::Render();
     }
 
-    void App::draw2D() {
+    void App::updateAutosave() {
+        io::AutosaveResult result;
+        if (autosaver_->poll(result)) {
+            if (result.ok) toolbarState_->autosavedGeneration = static_cast<long long>(result.generation);
+            else toolbarState_->ioStatus = result.message;
+        }
+
+        // The interval counts from the last checkpoint, or from when autosave was switched on
+        const double now = glfwGetTime();
+        const int interval = toolbarState_->autosaveSeconds;
+        if (interval <= 0) {
+            lastAutosaveTime_ = now;
+            return;
+        }
+        if (now - lastAutosaveTime_ < interval || !autosaveDirty_ || autosaver_->busy()) return;
+
+        // Right after a step this swaps buffers instead of copying; the worker does the rest
+        PROFILE_SCOPE("Autosave snapshot");
+        const uint64_t generation = simulation_->snapshot(autosaver_->buffer());
+        const std::string path = std::filesystem::path(toolbarState_->patternPath).replace_extension(".autosave.gol").string();
+        autosaver_->save(path, simulation_->width(), simulation_->height(), generation, simulation_->rule());
+        lastAutosaveTime_ = now;
+        autosaveDirty_ = generation != simulation_->generation(); // the parent was saved: the current one is still due
+    }
+
+    void App::updateRecording(const ui::ToolbarActions& act) {
+        const std::string recPath = std::filesystem::path(toolbarState_->patternPath).replace_extension(".golrec").string();
+
+        if (act.toggleRecording) {
+            if (recorder_->recording()) {
+                recorder_->stop();
+                toolbarState_->ioStatus = recorder_->failed() ? recorder_->lastError()
+                    : "Recorded " + std::to_string(recorder_->framesWritten()) + " frames";
+            }
+            else {
+                std::string error;
+                player_->close();
+                if (recorder_->start(recPath, simulation_->width(), simulation_->height(), 64, simulation_->rule(), error)) {
+                    recorder_->capture(simulation_->life(), simulation_->generation());
+
+                    // Every step and edit becomes a frame; a new grid size or rule ends the recording
+                    recordListener_ = simulation_->addFrameListener(
+                        [this](const core::Life& life, uint64_t generation, core::FrameChange change) {
+                            if (!recorder_->recording()) return;
+                            if (change == core::FrameChange::Reset || life.rule() != recorder_->rule()) recorder_->stop();
+                            else recorder_->capture(life, generation);
+                        });
+                    toolbarState_->ioStatus = "Recording to " + recPath;
+                }
+                else {
+                    toolbarState_->ioStatus = error;
+                }
+            }
+        }
+
+        // A failed write ends the recording; the file keeps the frames written so far
+        if (recorder_->recording() && recorder_->failed()) recorder_->stop();
+
+        // Listeners cannot unregister themselves while being notified, so drop it here
+        if (recordListener_ && !recorder_->recording()) {
+            simulation_->removeFrameListener(recordListener_);
+            recordListener_ = 0;
+            if (recorder_->failed()) {
+                toolbarState_->ioStatus = recorder_->lastError() + " (" + std::to_string(recorder_->framesWritten()) + " frames kept)";
+            }
+        }
+
+        if (act.requestReplay) {
+            std::string error;
+            if (player_->open(recPath, error) && player_->seek(0)) {
+                if (simulation_->isRunning()) simulation_->toggleRun();
+                if (player_->width() != simulation_->width() || player_->height() != simulation_->height()) {
+                    simulation_->replace(core::Life(player_->width(), player_->height()));
+                    toolbarState_->colsInput = simulation_->width();
+                    toolbarState_->rowsInput = simulation_->height();
+                }
+                // Multi-state frames need their rule; two-state ones replay under the current rule
+                if (player_->rule().states > 2 && player_->rule() != simulation_->rule()) {
+                    simulation_->setRule(player_->rule());
+                    toolbarState_->rule = player_->rule();
+                }
+                simulation_->setCells(player_->cells().data());
+                toolbarState_->ioStatus = "Replaying " + recPath;
+            }
+            else {
+                player_->close();
+                toolbarState_->ioStatus = error.empty() ? "Corrupt recording: " + recPath : error;
+            }
+        }
+
+        if (act.seekFrame >= 0 && player_->isOpen() && player_->seek(static_cast<size_t>(act.seekFrame))) {
+            simulation_->setCells(player_->cells().data());
+        }
+
+        // A grid resize leaves the recording's dimensions behind
+        if (act.closeReplay || act.resizeCols >= 0 || act.resizeRows >= 0) player_->close();
+
+        toolbarState_->recording = recorder_->recording();
+        toolbarState_->playbackFrames = player_->isOpen() ? static_cast<int>(player_->frameCount()) : 0;
+        toolbarState_->playbackFrame = player_->isOpen() ? static_cast<int>(player_->position()) : 0;
+        toolbarState_->playbackGeneration = player_->isOpen() ? player_->generationAt(player_->position()) : 0;
+    }
+
+    void App::updateExport(const ui::ToolbarActions& act) {
+        if (act.toggleExport) {
+            if (exporter_->active()) {
+                simulation_->removeFrameListener(exportListener_);
+                exportListener_ = 0;
+                exporter_->stop();
+                const std::string error = exporter_->lastError();
+                toolbarState_->ioStatus = error.empty()
+                    ? "Exported " + std::to_string(exporter_->framesWritten()) + " frames to " + toolbarState_->exportDir
+                    : error;
+            }
+            else {
+                render::ExportSettings settings;
+                settings.width = toolbarState_->exportWidth;
+                settings.height = toolbarState_->exportHeight;
+                settings.everyNth = toolbarState_->exportEvery;
+                settings.view = static_cast<render::ExportView>(toolbarState_->exportView);
+                settings.format = toolbarState_->exportFormat == 0 ? render::ExportFormat::Png : render::ExportFormat::Raw;
+                settings.directory = toolbarState_->exportDir;
+
+                std::string error;
+                if (exporter_->start(settings, error)) {
+                    simulation_->updateLabels();
+                    exporter_->capture(simulation_->generation());
+                    exportListener_ = simulation_->addFrameListener(
+                        [this](const core::Life&, uint64_t generation, core::FrameChange change) {
+                            if (change != core::FrameChange::Step) return;
+                            simulation_->updateLabels(); // exported frames show every generation's labels
+                            exporter_->capture(generation);
+                        });
+                    toolbarState_->ioStatus.clear();
+                }
+                else {
+                    toolbarState_->ioStatus = error;
+                }
+            }
+        }
+
+        toolbarState_->exporting = exporter_->active();
+        toolbarState_->exportedFrames = exporter_->framesWritten();
+    }
+
+    void App::updateSharing(const ui::ToolbarActions& act) {
+        if (act.toggleSharing) {
+            if (publisher_->active()) {
+                simulation_->removeFrameListener(shareListener_);
+                shareListener_ = 0;
+                toolbarState_->ioStatus = "Shared " + std::to_string(publisher_->framesPublished()) + " frames";
+                publisher_->stop();
+            }
+            else {
+                std::string error;
+                const core::Life& life = simulation_->life();
+                if (publisher_->start(io::kDefaultSharedGridName, life.gridWidth_, life.gridHeight_,
+                                      io::SharedGridPublisher::kDefaultSlots, error)) {
+                    publisher_->publish(life.data(), life.gridWidth_, life.gridHeight_, simulation_->generation());
+
+                    // Every change of the grid is published, edits and resizes included
+                    shareListener_ = simulation_->addFrameListener(
+                        [this](const core::Life& life, uint64_t generation, core::FrameChange) {
+                            publisher_->publish(life.data(), life.gridWidth_, life.gridHeight_, generation);
+                        });
+                    toolbarState_->ioStatus = std::string("Sharing as '") + io::kDefaultSharedGridName + "'";
+                }
+                else {
+                    toolbarState_->ioStatus = error;
+                }
+            }
+        }
+
+        if (publisher_->active() && !publisher_->lastError().empty()) toolbarState_->ioStatus = publisher_->lastError();
+        toolbarState_->sharing = publisher_->active();
+    }
+
+    void App::updateServer(const ui::ToolbarActions& act) {
+        if (act.toggleServer) {
+            if (server_->active()) {
+                simulation_->removeFrameListener(serverListener_);
+                serverListener_ = 0;
+                server_->stop();
+                toolbarState_->ioStatus = "Server stopped";
+            }
+            else {
+                std::string error;
+                if (server_->start(io::StreamServerSettings{}, error)) {
+                    server_->publish(simulation_->life(), simulation_->generation());
+                    serverListener_ = simulation_->addFrameListener(
+                        [this](const core::Life& life, uint64_t generation, core::FrameChange) {
+                            server_->publish(life, generation);
+                        });
+                    toolbarState_->ioStatus = "Serving on port " + std::to_string(server_->port());
+                }
+                else {
+                    toolbarState_->ioStatus = error;
+                }
+            }
+        }
+
+        toolbarState_->serving = server_->active();
+        toolbarState_->streamClients = server_->clientCount();
+        if (!server_->active()) return;
+        server_->setStatus(simulation_->isRunning(), simulation_->stepsPerSecond());
+
+        // Grids are not copied without clients; one that connected since needs the current one
+        if (server_->wantsGrid()) server_->publish(simulation_->life(), simulation_->generation());
+
+        // Remote commands act like the toolbar; edits join this frame's batch
+        io::StreamCommand command;
+        while (server_->pollCommand(command)) {
+            switch (command.type) {
+            case io::StreamCommandType::Play:
+                if (!simulation_->isRunning()) simulation_->toggleRun();
+                break;
+            case io::StreamCommandType::Pause:
+                if (simulation_->isRunning()) simulation_->toggleRun();
+                break;
+            case io::StreamCommandType::Step:
+                simulation_->applyEdits();
+                for (uint32_t i = 0; i < command.steps; ++i) simulation_->stepOnce();
+                break;
+            case io::StreamCommandType::Speed:
+                simulation_->setStepsPerSecond(command.stepsPerSecond);
+                break;
+            case io::StreamCommandType::Edit:
+                for (const io::StreamCellEdit& e : command.edits) {
+                    if (e.x < 0 || e.y < 0 || e.x >= simulation_->width() || e.y >= simulation_->height()) continue;
+                    simulation_->edits().fillRect(e.x, e.y, e.x, e.y, e.alive != 0);
+                }
+                break;
+            case io::StreamCommandType::Load:
+                player_->close();
+                simulation_->applyEdits();
+                simulation_->replace(std::move(*command.pattern));
+                toolbarState_->colsInput = simulation_->width();
+                toolbarState_->rowsInput = simulation_->height();
+                break;
+            }
+        }
+    }
+
+    void App::updateVolume(const ui::ToolbarActions& act) {
+        ui::ToolbarState& s = *toolbarState_;
+
+        core::Rule3D rule = volume_ ? volume_->rule() : core::kRule4555;
+        if (act.volumeRuleChanged || act.toggleVolume || act.requestVolumeReset) {
+            if (!core::parseRule3D(s.volumeRule, rule)) {
+                s.ioStatus = std::string("Invalid 3D rule: ") + s.volumeRule;
+                rule = volume_ ? volume_->rule() : core::kRule4555;
+            }
+            else if (act.volumeRuleChanged) {
+                s.ioStatus = "3D rule " + core::formatRule3D(rule);
+            }
+        }
+
+        if (act.toggleVolume && volume_) {
+            simulation_->removeFrameListener(volumeListener_);
+            volumeListener_ = 0;
+            volume_.reset();
+        }
+        else if (act.toggleVolume || (act.requestVolumeReset && volume_)) {
+            // The volume advances with the simulation: play, step and speed drive both
+            volume_ = std::make_unique<core::Life3D>(s.volumeSize, s.volumeSize, s.volumeSize, rule);
+            volume_->randomFill(s.randomDensity, static_cast<uint64_t>(static_cast<uint32_t>(s.randomSeed)), 0.5f);
+            volumeDirty_ = true;
+            if (!volumeListener_) {
+                volumeListener_ = simulation_->addFrameListener(
+                    [this](const core::Life&, uint64_t, core::FrameChange change) {
+                        if (change != core::FrameChange::Step) return;
+                        volume_->step();
+                        volumeDirty_ = true;
+                    });
+            }
+        }
+        else if (act.volumeRuleChanged && volume_) {
+            volume_->setRule(rule);
+        }
+
+        s.volume = volume_ != nullptr;
+        s.volumeCells = volume_ ? volume_->liveCells().size() : 0;
+    }
+
+    void App::updateViews(const ui::ToolbarActions& act) {
+        // New views start as a copy of the main simulation
+        if (act.requestAddView && views_.size() < kMaxViews) {
+            std::unique_ptr<CompareView> view = std::make_unique<CompareView>();
+            view->simulation = std::make_unique<core::Simulation>(simulation_->width(), simulation_->height());
+            core::Simulation& sim = *view->simulation;
+            sim.setRule(simulation_->rule());
+            sim.setTopology(simulation_->topology());
+            sim.setStepsPerSecond(simulation_->stepsPerSecond());
+            sim.replace(core::Life(simulation_->life()));
+            view->r2d = std::make_unique<render::Renderer2D>(sim);
+            view->r3d = std::make_unique<render::Renderer3D>(sim);
+            view->schedulerId = scheduler_->add(sim, view->toolbar.priority);
+            view->redrawListener = sim.addFrameListener(
+                [this](const core::Life&, uint64_t, core::FrameChange) { redrawPending_ = true; });
+            views_.push_back(std::move(view));
+            redrawPending_ = true;
+        }
+        else if (act.requestAddView) {
+            toolbarState_->ioStatus = "At most " + std::to_string(kMaxViews) + " comparison views";
+        }
+
+        const int rows = viewRows();
         const int leftW = fbWidth_ / 2;
+        const bool pressed = input_->mouseL_ && !mouseWasDown_ && !input_->wantCaptureMouse_;
+        const ui::ToolbarState& s = *toolbarState_;
+        for (size_t i = 0; i < views_.size(); ++i) {
+            CompareView& view = *views_[i];
+            core::Simulation& sim = *view.simulation;
+            const int row = static_cast<int>(i) + 1;
+            const ui::CompareToolbarActions va = ui::drawCompareToolbar(view.toolbar, sim, row, rows);
+
+            if (va.toggledRun) sim.toggleRun();
+            if (va.requestStep) sim.stepOnce();
+            if (va.requestClear) sim.clear();
+            if (va.newSpeed > 0.0f) sim.setStepsPerSecond(va.newSpeed);
+            if (va.newRulePreset >= 0) sim.setRule(ui::presetRule(va.newRulePreset));
+            if (va.newTopology >= 0) sim.setTopology(static_cast<core::Topology>(va.newTopology));
+            if (va.newPriority > 0) scheduler_->setPriority(view.schedulerId, va.newPriority);
+            if (va.requestCopy) sim.replace(core::Life(simulation_->life()));
+            if (va.requestRandomFill) {
+                sim.edits().randomFill(0, 0, sim.width() - 1, sim.height() - 1, s.randomDensity,
+                                       static_cast<uint64_t>(static_cast<uint32_t>(s.randomSeed)));
+            }
+
+            // Clicks in the view's 2D viewport toggle cells (the edit tools stay with the main view)
+            int y = 0, h = 0;
+            rowRect(row, y, h);
+            int hx = -1, hy = -1;
+            if (pressed) render::mouseToCell(input_->mouseX_, input_->mouseY_, 0, y, leftW, h, sim.width(), sim.height(), hx, hy);
+            if (hx >= 0 && hy >= 0) sim.edits().toggle(hx, hy);
+            sim.applyEdits();
+
+            if (va.requestClose) {
+                scheduler_->remove(view.schedulerId);
+                sim.removeFrameListener(view.redrawListener);
+                views_[i].reset();
+                redrawPending_ = true;
+            }
+        }
+        views_.erase(std::remove(views_.begin(), views_.end(), nullptr), views_.end());
+        toolbarState_->viewRows = viewRows();
+    }
 
-        glDisable(GL_DEPTH_TEST);
-        glViewport(0, 0, leftW, fbHeight_);
+    void App::updateEditing(const ui::ToolbarActions& act) {
+        core::EditBatch& edits = simulation_->edits();
+        const ui::ToolbarState& s = *toolbarState_;
+        const int gridW = simulation_->width();
+        const int gridH = simulation_->height();
+        const uint64_t seed = static_cast<uint64_t>(static_cast<uint32_t>(s.randomSeed));
+        const uint8_t paint = static_cast<uint8_t>(std::clamp(s.paintState, 1, simulation_->rule().states - 1));
+
+        if (act.requestRandomFill) edits.randomFill(0, 0, gridW - 1, gridH - 1, s.randomDensity, seed);
 
         int hx = -1, hy = -1;
-        if (!input_->wantCaptureMouse_) {
-            render::mouseToCell(input_->mouseX_, input_->mouseY_, 0, 0, leftW, fbHeight_, simulation_->width(), simulation_->height(), hx, hy);
+        hoveredCell(hx, hy);
+        const bool hovered = hx >= 0 && hy >= 0;
+        const bool pressed = input_->mouseL_ && !mouseWasDown_;
+        const bool released = !input_->mouseL_ && mouseWasDown_;
+        mouseWasDown_ = input_->mouseL_;
+
+        if (pressed && hovered) {
+            editing_ = true;
+            editAnchorX_ = editLastX_ = hx;
+            editAnchorY_ = editLastY_ = hy;
+
+            if (s.editTool == ui::EditTool::Toggle) {
+                edits.toggle(hx, hy, paint);
+            }
+            else if (s.editTool == ui::EditTool::Paste && stamp_) {
+                // Centre the transformed stamp on the clicked cell
+                const core::Rotation rotation = static_cast<core::Rotation>(s.pasteRotation);
+                int w = 0, h = 0;
+                core::EditBatch::rotatedSize(stamp_->gridWidth_, stamp_->gridHeight_, rotation, w, h);
+                edits.paste(stamp_->data(), stamp_->gridWidth_, stamp_->gridHeight_, hx - w / 2, hy - h / 2, rotation, s.pasteFlip, true);
+            }
         }
+        if (!editing_) return;
 
-        r2d_->draw(leftW, fbHeight_, hx, hy);
+        // Brushes paint the segment since the last sample so fast drags leave no gaps
+        const bool brush = s.editTool == ui::EditTool::Brush || s.editTool == ui::EditTool::Eraser;
+        if (brush && input_->mouseL_ && hovered) {
+            edits.stroke(editLastX_, editLastY_, hx, hy, s.brushRadius, s.editTool == ui::EditTool::Brush ? paint : 0);
+        }
+        if (hovered) {
+            editLastX_ = hx;
+            editLastY_ = hy;
+        }
 
-        // Edge-triggered toggling to avoid repeats while holding the mouse
-        static bool prevDown = false;
-        if (input_->mouseL_ && !prevDown && hx >= 0 && hy >= 0) {
-            simulation_->toggleCell(hx, hy);
+        if (released) {
+            switch (s.editTool) {
+            case ui::EditTool::FillRect:
+                edits.fillRect(editAnchorX_, editAnchorY_, editLastX_, editLastY_, paint);
+                break;
+            case ui::EditTool::ClearRect:
+                edits.fillRect(editAnchorX_, editAnchorY_, editLastX_, editLastY_, 0);
+                break;
+            case ui::EditTool::RandomRect:
+                edits.randomFill(editAnchorX_, editAnchorY_, editLastX_, editLastY_, s.randomDensity, seed);
+                break;
+            default:
+                break;
+            }
+            editing_ = false;
         }
-        prevDown = input_->mouseL_;
     }
 
-    void App::draw3D() {
+    void App::hoveredCell(int& hx, int& hy) const {
+        hx = hy = -1;
+        if (input_->wantCaptureMouse_) return;
+        int y = 0, h = 0;
+        rowRect(0, y, h);
+        render::mouseToCell(input_->mouseX_, input_->mouseY_, 0, y, fbWidth_ / 2, h, simulation_->width(), simulation_->height(), hx, hy);
+    }
+
+    int App::viewRows() const {
+        return 1 + static_cast<int>(views_.size());
+    }
+
+    void App::rowRect(int row, int& y, int& h) const {
+        // Rows split the window top to bottom; y is in window coordinates (top-left origin)
+        const int rows = viewRows();
+        y = static_cast<int>(static_cast<int64_t>(fbHeight_) * row / rows);
+        h = static_cast<int>(static_cast<int64_t>(fbHeight_) * (row + 1) / rows) - y;
+    }
+
+    core::OrbitCamera& App::rowCamera(int row) {
+        return row == 0 ? *camera_ : views_[static_cast<size_t>(row) - 1]->camera;
+    }
+
+    void App::updateCamera() {
         const int leftW = fbWidth_ / 2;
         const int rightW = fbWidth_ - leftW;
 
-        glEnable(GL_DEPTH_TEST);
-        glViewport(leftW, 0, rightW, fbHeight_);
-
-        // Interact only when mouse is inside right viewport and not over UI
-        const bool inRight = (input_->mouseX_ >= leftW && input_->mouseX_ < (double)(leftW + rightW) && input_->mouseY_ >= 0.0 && input_->mouseY_ < (double)fbHeight_) && !input_->wantCaptureMouse_;
+        // Interact only when mouse is inside a right viewport and not over UI
+        int row = -1;
+        if (input_->mouseX_ >= leftW && input_->mouseX_ < (double)(leftW + rightW) && !input_->wantCaptureMouse_) {
+            for (int r = 0; r < viewRows(); ++r) {
+                int y = 0, h = 0;
+                rowRect(r, y, h);
+                if (input_->mouseY_ >= y && input_->mouseY_ < (double)(y + h)) row = r;
+            }
+        }
 
-        static bool rotating = false;
+        // A drag orbits the camera of the row it started in
+        static int rotating = -1;
         static double lastX = 0.0, lastY = 0.0;
 
-        if (!inRight) rotating = false;
-        if (inRight && input_->mouseL_ && !rotating) {
-            rotating = true;
+        if (row != rotating) rotating = -1;
+        if (row >= 0 && input_->mouseL_ && rotating < 0) {
+            rotating = row;
             lastX = input_->mouseX_; lastY = input_->mouseY_;
         }
-        if (!input_->mouseL_) rotating = false;
+        if (!input_->mouseL_) rotating = -1;
 
-        if (inRight && rotating) {
+        if (row >= 0 && rotating == row) {
             const double dx = input_->mouseX_ - lastX;
             const double dy = input_->mouseY_ - lastY;
-            camera_->orbitBy((float)dx, (float)dy);
+            rowCamera(row).orbitBy((float)dx, (float)dy);
             lastX = input_->mouseX_; lastY = input_->mouseY_;
         }
 
-        if (inRight && scrollDelta_ != 0.0) {
-            camera_->zoomBy((float)scrollDelta_);
-            scrollDelta_ = 0.0;
+        if (row >= 0 && scrollDelta_ != 0.0) rowCamera(row).zoomBy((float)scrollDelta_);
+        scrollDelta_ = 0.0;
+    }
+
+    bool App::needsRedraw(double now) {
+        // Compare with what the last frame showed; anything new makes the frame pending
+        const uint64_t uiHash = hashDrawData(ImGui::GetDrawData());
+        int hx = -1, hy = -1;
+        hoveredCell(hx, hy);
+        std::vector<float> cameraState;
+        for (int row = 0; row < viewRows(); ++row) {
+            const core::OrbitCamera& camera = rowCamera(row);
+            cameraState.insert(cameraState.end(), { camera.distance_, camera.yaw_, camera.pitch_ });
+        }
+
+        if (uiHash != drawnUiHash_ || hx != drawnHoverX_ || hy != drawnHoverY_ ||
+            cameraState != drawnCameras_ || volumeDirty_) {
+            redrawPending_ = true;
+        }
+        // Timings would describe skipped frames, so the overlay keeps every frame drawn
+        if (toolbarState_->showProfiler) redrawPending_ = true;
+        if (!redrawPending_) return false;
+
+        // The cap delays the frame; the change stays pending until it is drawn
+        const int cap = toolbarState_->fpsCap;
+        if (cap > 0 && now - lastDrawTime_ < 1.0 / cap) return false;
+
+        redrawPending_ = false;
+        drawnUiHash_ = uiHash;
+        drawnHoverX_ = hx;
+        drawnHoverY_ = hy;
+        drawnCameras_ = std::move(cameraState);
+        lastDrawTime_ = now;
+        return true;
+    }
+
+    void App::waitForWork(double now) {
+        // Sleep until the next simulation step, the next capped frame or the idle tick
+        double timeout = kIdleWaitSeconds;
+        double nextStep = simulation_->secondsToNextStep();
+        for (const std::unique_ptr<CompareView>& view : views_) {
+            const double next = view->simulation->secondsToNextStep();
+            if (next >= 0.0 && (nextStep < 0.0 || next < nextStep)) nextStep = next;
         }
-        else if (!inRight) {
-            scrollDelta_ = 0.0;
+        if (nextStep >= 0.0) timeout = std::min(timeout, nextStep);
+        if (redrawPending_) {
+            const int cap = toolbarState_->fpsCap;
+            timeout = cap > 0 ? std::min(timeout, std::max(0.0, lastDrawTime_ + 1.0 / cap - now)) : 0.0;
         }
 
-        r3d_->draw(*camera_, rightW, fbHeight_);
+        // Events cut the wait short, except that a capped frame keeps its slot
+        if (timeout <= 0.0) {
+            glfwPollEvents();
+        }
+        else if (redrawPending_) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(timeout));
+            glfwPollEvents();
+        }
+        else {
+            glfwWaitEventsTimeout(timeout);
+        }
     }
 
-    void App::run() {
-        while (!glfwWindowShouldClose(window_)) {
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    void App::draw2D() {
+        const int leftW = fbWidth_ / 2;
+        int y = 0, h = 0;
+        rowRect(0, y, h);
+
+        glDisable(GL_DEPTH_TEST);
+        glViewport(0, fbHeight_ - y - h, leftW, h);
 
-            double now = glfwGetTime();
-            double dt = now - lastTime_;
-            lastTime_ = now;
-            if (dt > 0.25) dt = 0.25;  // clamp to avoid huge steps after stalls
+        int hx = -1, hy = -1;
+        hoveredCell(hx, hy);
 
-            updateInput();
-            simulate(dt);
-            draw2D();
-            draw3D();
+        gpuTimer2D_->begin();
+        r2d_->draw(leftW, h, hx, hy);
+        gpuTimer2D_->end();
+    }
 
-            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-            glfwSwapBuffers(window_);
-            glfwPollEvents();
+    void App::draw3D() {
+        const int leftW = fbWidth_ / 2;
+        const int rightW = fbWidth_ - leftW;
+        int y = 0, h = 0;
+        rowRect(0, y, h);
+
+        glEnable(GL_DEPTH_TEST);
+        glViewport(leftW, fbHeight_ - y - h, rightW, h);
+
+        gpuTimer3D_->begin();
+        if (volume_) {
+            // Several steps per frame upload only the newest generation
+            if (volumeDirty_) voxels_->update(*volume_);
+            volumeDirty_ = false;
+            voxels_->draw(*camera_, rightW, h);
+        }
+        else {
+            r3d_->draw(*camera_, rightW, h);
+        }
+        gpuTimer3D_->end();
+    }
+
+    void App::drawViews() {
+        const int leftW = fbWidth_ / 2;
+        const int rightW = fbWidth_ - leftW;
+        for (size_t i = 0; i < views_.size(); ++i) {
+            CompareView& view = *views_[i];
+            int y = 0, h = 0;
+            rowRect(static_cast<int>(i) + 1, y, h);
+
+            glDisable(GL_DEPTH_TEST);
+            glViewport(0, fbHeight_ - y - h, leftW, h);
+            view.r2d->draw(leftW, h, -1, -1);
+
+            glEnable(GL_DEPTH_TEST);
+            glViewport(leftW, fbHeight_ - y - h, rightW, h);
+            view.r3d->draw(view.camera, rightW, h);
+        }
+    }
+
+    void App::run() {
+        while (!glfwWindowShouldClose(window_)) {
+            double now = 0.0;
+            {
+                PROFILE_SCOPE("Frame");
+
+                now = glfwGetTime();
+                double dt = now - lastTime_;
+                lastTime_ = now;
+                if (dt > 0.25) dt = 0.25;  // clamp to avoid huge steps after stalls
+
+                // Hot-reload builds pick up edited shaders without restarting
+                if (shadersChangedOnDisk(now)) {
+                    r2d_->reloadShaders();
+                    r3d_->reloadShaders();
+                    voxels_->reloadShaders();
+                    for (const std::unique_ptr<CompareView>& view : views_) {
+                        view->r2d->reloadShaders();
+                        view->r3d->reloadShaders();
+                    }
+                    redrawPending_ = true;
+                }
+
+                { PROFILE_SCOPE("Input"); updateInput(); updateCamera(); }
+                { PROFILE_SCOPE("Simulate"); simulate(dt); }
+
+                // Nothing visible changed (or the cap holds the frame back): skip drawing
+                if (needsRedraw(now)) {
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                    { PROFILE_SCOPE("Draw2D"); draw2D(); }
+                    { PROFILE_SCOPE("Draw3D"); draw3D(); }
+                    if (!views_.empty()) { PROFILE_SCOPE("Draw views"); drawViews(); }
+                    { PROFILE_SCOPE("ImGui render"); ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData()); }
+
+                    PROFILE_SCOPE("Present");
+                    glfwSwapBuffers(window_);
+                }
+            }
+
+            waitForWork(now);
         }
     }
 
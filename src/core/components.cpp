@@ -0,0 +1,401 @@
+#include "../../include/core/components.h"
+#include "../../include/utils/profiler.h"
+#include "../../include/utils/splitMix.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
+
+namespace core {
+
+    static constexpr uint32_t kRootFlag = 0x80000000u; // marks first cells holding their component id
+
+    // Odd bases of the shape hash (odd numbers are invertible modulo 2^64)
+    static constexpr uint64_t kHashX = 0x9E3779B97F4A7C15ull;
+    static constexpr uint64_t kHashY = 0xC2B2AE3D27D4EB4Full;
+
+    static uint64_t inverseOdd(uint64_t a) {
+        uint64_t x = a; // Newton's iteration doubles the correct low bits each round
+        for (int i = 0; i < 5; ++i) x *= 2 - a * x;
+        return x;
+    }
+
+    static inline unsigned lowestSetBit(uint64_t v) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, v);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(v));
+#endif
+    }
+
+    // Bit k set if cell k of the span is live (at most 64 cells)
+    static inline uint64_t liveMask(const uint8_t* cells, int count) {
+        uint64_t m = 0;
+        if (count == 64) {
+            for (int k = 0; k < 8; ++k) {
+                uint64_t w;
+                std::memcpy(&w, cells + 8 * k, 8);
+                m |= ((w * 0x0102040810204080ull) >> 56) << (8 * k); // gathers the low bit of each byte
+            }
+            return m;
+        }
+        for (int k = 0; k < count; ++k) m |= static_cast<uint64_t>(cells[k] != 0) << k;
+        return m;
+    }
+
+    // Offset across the wrap, in [-n/2, n - n/2)
+    static inline int wrapDelta(int d, int n) {
+        if (d >= n - n / 2) return d - n;
+        if (d < -(n / 2)) return d + n;
+        return d;
+    }
+
+    ComponentLabeler::ComponentLabeler(utils::ThreadPool& pool) : pool_(pool) {}
+
+    void ComponentLabeler::label(const uint8_t* cells, int width, int height, Topology topology) {
+        PROFILE_SCOPE("Label components");
+        const size_t count = static_cast<size_t>(width) * height;
+        topology_ = topology;
+        if (width != width_ || height != height_) {
+            width_ = width;
+            height_ = height;
+            rebuildTables();
+        }
+        labels_.resize(count);
+        colors_.resize(count);
+
+        const size_t bandCount = std::min<size_t>(pool_.size(), static_cast<size_t>(height));
+        bands_.resize(bandCount);
+        for (size_t b = 0; b < bandCount; ++b) {
+            bands_[b].begin = static_cast<size_t>(height * b / bandCount) * width;
+            bands_[b].end = static_cast<size_t>(height * (b + 1) / bandCount) * width;
+        }
+
+        // Label each band on its own, then join them along the seams
+        pool_.parallelFor(bandCount, [&](size_t b) { labelBand(bands_[b], cells); });
+        mergeSeams(cells);
+
+        // Resolve every run to its component's first cell (only first cells are read across bands)
+        pool_.parallelFor(bandCount, [&](size_t b) {
+            Band& band = bands_[b];
+            band.roots.clear();
+            for (const Run& run : band.runs) {
+                const uint32_t v = labels_[run.begin];
+                const uint32_t r = labels_[v];
+                if (r != v) labels_[run.begin] = r;
+                else if (v == run.begin) band.roots.push_back(v);
+            }
+        });
+
+        // Number components in raster order of their first cell
+        uint32_t nextId = 0;
+        for (Band& band : bands_) {
+            band.firstId = nextId;
+            nextId += static_cast<uint32_t>(band.roots.size());
+        }
+        components_.resize(nextId);
+        stats_.assign(nextId, Accumulator{});
+        origins_.resize(nextId);
+
+        pool_.parallelFor(bandCount, [&](size_t b) {
+            Band& band = bands_[b];
+            for (size_t k = 0; k < band.roots.size(); ++k) {
+                const uint32_t root = band.roots[k];
+                const uint32_t id = band.firstId + static_cast<uint32_t>(k);
+                labels_[root] = kRootFlag | id;
+                origins_[id] = { static_cast<int>(root % static_cast<uint32_t>(width_)), static_cast<int>(root / static_cast<uint32_t>(width_)) };
+            }
+        });
+        pool_.parallelFor(bandCount, [&](size_t b) { measureBand(bands_[b]); });
+
+        // Components that cross a seam also collected cells in later bands
+        for (const Band& band : bands_) {
+            for (const auto& entry : band.foreign) {
+                Accumulator& acc = stats_[entry.first];
+                const Accumulator& part = entry.second;
+                acc.population += part.population;
+                acc.minDx = std::min(acc.minDx, part.minDx);
+                acc.maxDx = std::max(acc.maxDx, part.maxDx);
+                acc.minDy = std::min(acc.minDy, part.minDy);
+                acc.maxDy = std::max(acc.maxDy, part.maxDy);
+                acc.hash += part.hash;
+            }
+        }
+
+        pool_.parallelFor(bandCount, [&](size_t b) {
+            Band& band = bands_[b];
+            for (size_t k = 0; k < band.roots.size(); ++k) {
+                const uint32_t id = band.firstId + static_cast<uint32_t>(k);
+                labels_[band.roots[k]] = id + 1;
+
+                // Translate the hash so the box corner is the origin
+                const Accumulator& acc = stats_[id];
+                Component& c = components_[id];
+                c.x = (origins_[id].first + acc.minDx + width_) % width_;
+                c.y = (origins_[id].second + acc.minDy + height_) % height_;
+                c.width = acc.maxDx - acc.minDx + 1;
+                c.height = acc.maxDy - acc.minDy + 1;
+                c.population = acc.population;
+                c.shapeHash = utils::splitMix64(acc.hash * invX_[acc.minDx + width_] * invY_[acc.minDy + height_] + acc.population);
+            }
+        });
+        pool_.parallelFor(bandCount, [&](size_t b) { paintBand(bands_[b], cells); });
+    }
+
+    void ComponentLabeler::labelBand(Band& band, const uint8_t* cells) {
+        const size_t w = static_cast<size_t>(width_);
+        std::vector<Run>& runs = band.runs;
+        runs.clear();
+
+        size_t upBegin = 0;
+        for (size_t row = band.begin; row < band.end; row += w) {
+            // Runs start and end where the live mask changes
+            const size_t rowBegin = runs.size();
+            bool open = false;
+            uint32_t start = 0;
+            for (size_t x = 0; x < w; x += 64) {
+                const int n = static_cast<int>(std::min<size_t>(64, w - x));
+                const uint64_t m = liveMask(cells + row + x, n);
+                uint64_t edges = m ^ ((m << 1) | (open ? 1u : 0u));
+                if (n < 64) edges &= (uint64_t(1) << n) - 1;
+                while (edges) {
+                    const uint32_t at = static_cast<uint32_t>(row + x + lowestSetBit(edges));
+                    edges &= edges - 1;
+                    if (open) runs.push_back({ start, at });
+                    else start = at;
+                    open = !open;
+                }
+            }
+            if (open) runs.push_back({ start, static_cast<uint32_t>(row + w) });
+
+            const size_t rowEnd = runs.size();
+            for (size_t k = rowBegin; k < rowEnd; ++k) labels_[runs[k].begin] = runs[k].begin;
+            if (row > band.begin) connectRows(runs.data() + upBegin, rowBegin - upBegin, row - w, runs.data() + rowBegin, rowEnd - rowBegin, row, nullptr);
+            if (topology_ == Topology::Torus && rowEnd - rowBegin > 1 && runs[rowBegin].begin == row && runs[rowEnd - 1].end == row + w) {
+                unite(runs[rowBegin].begin, runs[rowEnd - 1].begin, nullptr); // joined across the wrap
+            }
+            upBegin = rowBegin;
+        }
+
+        // Links point to lower indices, so one raster pass leaves every run on its band root
+        for (const Run& run : runs) labels_[run.begin] = labels_[labels_[run.begin]];
+    }
+
+    void ComponentLabeler::connectRows(const Run* up, size_t upCount, size_t upRow, const Run* row, size_t rowCount, size_t rowStart, std::vector<uint32_t>* relinked) {
+        if (upCount == 0 || rowCount == 0) return;
+        const size_t w = static_cast<size_t>(width_);
+
+        // Runs touch (8-connected) when they overlap after widening by one cell. Inside a band
+        // (no relinked list) the new row is still unlinked, so its first contact just joins.
+        size_t j = 0;
+        for (size_t i = 0; i < rowCount; ++i) {
+            const size_t begin = row[i].begin - rowStart;
+            const size_t end = row[i].end - rowStart;
+            while (j < upCount && up[j].end - upRow < begin) ++j;
+            size_t k = j;
+            if (!relinked && k < upCount && up[k].begin - upRow <= end) labels_[row[i].begin] = find(up[k++].begin);
+            for (; k < upCount && up[k].begin - upRow <= end; ++k) unite(row[i].begin, up[k].begin, relinked);
+        }
+
+        // Diagonal neighbours across the horizontal wrap (mirrored gluings are joined in mergeSeams())
+        if (topology_ != Topology::Torus) return;
+        if (row[0].begin == rowStart && up[upCount - 1].end == upRow + w) unite(row[0].begin, up[upCount - 1].begin, relinked);
+        if (row[rowCount - 1].end == rowStart + w && up[0].begin == upRow) unite(row[rowCount - 1].begin, up[0].begin, relinked);
+    }
+
+    void ComponentLabeler::mergeSeams(const uint8_t* cells) {
+        const size_t w = static_cast<size_t>(width_);
+        relinked_.clear();
+
+        // The first row of each band meets the last row of the band above (on a torus band 0 meets the last band)
+        for (size_t b = 0; b < bands_.size(); ++b) {
+            if (b == 0 && topology_ != Topology::Torus) continue;
+            const Band& band = bands_[b];
+            const Band& above = bands_[b > 0 ? b - 1 : bands_.size() - 1];
+            const size_t upRow = above.end - w;
+
+            const auto first = std::partition_point(band.runs.begin(), band.runs.end(), [&](const Run& r) { return r.begin < band.begin + w; });
+            const auto last = std::partition_point(above.runs.begin(), above.runs.end(), [&](const Run& r) { return r.begin < upRow; });
+            connectRows(above.runs.data() + (last - above.runs.begin()), static_cast<size_t>(above.runs.end() - last), upRow,
+                band.runs.data(), static_cast<size_t>(first - band.runs.begin()), band.begin, &relinked_);
+        }
+
+        switch (topology_) {
+        case Topology::KleinBottle: uniteAcrossEdges<TopologyPolicy<Topology::KleinBottle>>(cells); break;
+        case Topology::ProjectivePlane: uniteAcrossEdges<TopologyPolicy<Topology::ProjectivePlane>>(cells); break;
+        default: break; // the torus wraps are joined above, bounded grids have none
+        }
+
+        // Point every relinked band root straight at its final root
+        for (uint32_t r : relinked_) labels_[r] = find(r);
+    }
+
+    template <class Policy>
+    void ComponentLabeler::uniteAcrossEdges(const uint8_t* cells) {
+        // Join each live border cell with the live cells glued to it beyond the edge
+        const int w = width_;
+        const int h = height_;
+        auto visit = [&](int x, int y) {
+            const size_t i = static_cast<size_t>(y) * w + x;
+            if (!cells[i]) return;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    int nx = x + dx, ny = y + dy;
+                    if (nx >= 0 && nx < w && ny >= 0 && ny < h) continue; // inside: joined by the bands
+                    Policy::fold(nx, ny, w, h);
+                    const size_t j = static_cast<size_t>(ny) * w + nx;
+                    if (cells[j]) unite(runAt(i), runAt(j), &relinked_);
+                }
+            }
+        };
+        for (int x = 0; x < w; ++x) {
+            visit(x, 0);
+            if (h > 1) visit(x, h - 1);
+        }
+        for (int y = 1; y < h - 1; ++y) {
+            visit(0, y);
+            if (w > 1) visit(w - 1, y);
+        }
+    }
+
+    uint32_t ComponentLabeler::runAt(size_t cell) const {
+        // First cell of the run holding a live cell
+        const auto band = std::partition_point(bands_.begin(), bands_.end(), [&](const Band& b) { return b.end <= cell; });
+        const auto run = std::partition_point(band->runs.begin(), band->runs.end(), [&](const Run& r) { return r.begin <= cell; });
+        return std::prev(run)->begin;
+    }
+
+    void ComponentLabeler::measureBand(Band& band) {
+        const size_t w = static_cast<size_t>(width_);
+        const uint32_t firstId = band.firstId;
+        const uint32_t lastId = firstId + static_cast<uint32_t>(band.roots.size());
+        std::unordered_map<uint32_t, size_t> foreignIndex;
+        band.foreign.clear();
+
+        size_t rowStart = band.begin;
+        int y = static_cast<int>(band.begin / w);
+        for (const Run& run : band.runs) {
+            while (run.begin >= rowStart + w) {
+                rowStart += w;
+                ++y;
+            }
+
+            // First cells hold their id; every other run reads it from its first cell
+            const uint32_t v = labels_[run.begin];
+            uint32_t root, id;
+            if (v & kRootFlag) {
+                root = run.begin;
+                id = v & ~kRootFlag;
+            }
+            else {
+                root = v;
+                id = labels_[v] & ~kRootFlag;
+                labels_[run.begin] = id + 1;
+            }
+            colors_[run.begin] = static_cast<uint8_t>(1 + ((static_cast<uint64_t>(root * 0x9E3779B1u) * 255) >> 32));
+
+            Accumulator* acc;
+            if (id >= firstId && id < lastId) {
+                acc = &stats_[id];
+            }
+            else {
+                auto it = foreignIndex.find(id);
+                if (it == foreignIndex.end()) {
+                    it = foreignIndex.emplace(id, band.foreign.size()).first;
+                    band.foreign.emplace_back(id, Accumulator{});
+                }
+                acc = &band.foreign[it->second].second;
+            }
+
+            // Offsets wrap on a torus only; elsewhere they are plain grid distances
+            const std::pair<int, int>& origin = origins_[id];
+            const bool torus = topology_ == Topology::Torus;
+            int dx = static_cast<int>(run.begin - rowStart) - origin.first;
+            int dy = y - origin.second;
+            if (torus) {
+                dx = wrapDelta(dx, width_);
+                dy = wrapDelta(dy, height_);
+            }
+            const int length = static_cast<int>(run.end - run.begin);
+
+            // A run can straddle the point where offsets wrap (only in objects over half the grid)
+            const int fits = torus ? std::min(length, width_ - width_ / 2 - dx) : length;
+            addSpan(*acc, dx, fits, dy);
+            if (fits < length) addSpan(*acc, dx + fits - width_, length - fits, dy);
+        }
+    }
+
+    void ComponentLabeler::paintBand(const Band& band, const uint8_t* cells) {
+        // Copy each run's label and colour from its first cell over the run; clear dead cells
+        const size_t w = static_cast<size_t>(width_);
+        for (size_t row = band.begin; row < band.end; row += w) {
+            uint32_t prev = 0, label = 0, color = 0;
+            for (size_t i = row; i < row + w; ++i) {
+                // Masks instead of branches: live cells are unpredictable
+                const uint32_t live = 0u - static_cast<uint32_t>(cells[i] != 0);
+                const uint32_t start = live & ~prev;
+                label = (labels_[i] & start) | (label & ~start);
+                color = (colors_[i] & start) | (color & ~start);
+                labels_[i] = label & live;
+                colors_[i] = static_cast<uint8_t>(color & live);
+                prev = live;
+            }
+        }
+    }
+
+    void ComponentLabeler::addSpan(Accumulator& acc, int dx, int length, int dy) const {
+        acc.population += static_cast<uint32_t>(length);
+        acc.minDx = std::min(acc.minDx, dx);
+        acc.maxDx = std::max(acc.maxDx, dx + length - 1);
+        acc.minDy = std::min(acc.minDy, dy);
+        acc.maxDy = std::max(acc.maxDy, dy);
+        const size_t x0 = static_cast<size_t>(dx + width_);
+        acc.hash += (sumX_[x0 + length] - sumX_[x0]) * powY_[dy + height_];
+    }
+
+    uint32_t ComponentLabeler::find(uint32_t i) {
+        while (labels_[i] != i) {
+            labels_[i] = labels_[labels_[i]]; // path halving
+            i = labels_[i];
+        }
+        return i;
+    }
+
+    void ComponentLabeler::unite(uint32_t a, uint32_t b, std::vector<uint32_t>* relinked) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return;
+        if (a > b) std::swap(a, b);
+        labels_[b] = a; // the higher root joins the lower one
+        if (relinked) relinked->push_back(b);
+    }
+
+    void ComponentLabeler::rebuildTables() {
+        const uint64_t invBaseX = inverseOdd(kHashX);
+        sumX_.assign(2 * static_cast<size_t>(width_) + 1, 0);
+        invX_.resize(2 * static_cast<size_t>(width_));
+        uint64_t p = 1, q = 1;
+        for (int k = 0; k < 2 * width_; ++k) {
+            sumX_[k + 1] = sumX_[k] + p;
+            invX_[k] = q;
+            p *= kHashX;
+            q *= invBaseX;
+        }
+
+        const uint64_t invBaseY = inverseOdd(kHashY);
+        powY_.resize(2 * static_cast<size_t>(height_));
+        invY_.resize(2 * static_cast<size_t>(height_));
+        p = 1;
+        q = 1;
+        for (int k = 0; k < 2 * height_; ++k) {
+            powY_[k] = p;
+            invY_[k] = q;
+            p *= kHashY;
+            q *= invBaseY;
+        }
+    }
+
+}
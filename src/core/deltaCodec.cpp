@@ -0,0 +1,168 @@
+#include "../../include/core/deltaCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace core {
+
+    static inline void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+        while (v >= 0x80) {
+            out.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(v));
+    }
+
+    static inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p == end) return false;
+            const uint8_t b = *p++;
+            v |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+
+    static inline unsigned lowestSetBit(uint64_t v) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, v);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(v));
+#endif
+    }
+
+    // Bit k set if cell i+k is marked (word() yields bytes of 0 or 1; cells past count read as 0)
+    template <typename Word>
+    static inline uint64_t cellMask(Word word, size_t i, size_t count) {
+        uint64_t m = 0;
+        if (i + 64 <= count) {
+            uint64_t w[8];
+            uint64_t any = 0;
+            for (int k = 0; k < 8; ++k) any |= (w[k] = word(i + 8 * k));
+            if (!any) return 0; // quiet regions cost one pass over the words
+
+            // Multiplying gathers the low bit of each byte into the top byte
+            for (int k = 0; k < 8; ++k) m |= ((w[k] * 0x0102040810204080ull) >> 56) << (8 * k);
+            return m;
+        }
+        for (size_t k = 0; i + k < count; ++k) m |= static_cast<uint64_t>(word.at(i + k) != 0) << k;
+        return m;
+    }
+
+    namespace {
+
+        constexpr uint64_t kLowBits = 0x0101010101010101ull;
+
+        // Changed-cell mask of one state bit of two generations
+        struct XorWord {
+            const uint8_t* a;
+            const uint8_t* b;
+            int plane;
+            uint64_t operator()(size_t i) const {
+                uint64_t x, y;
+                std::memcpy(&x, a + i, 8);
+                std::memcpy(&y, b + i, 8);
+                return ((x ^ y) >> plane) & kLowBits;
+            }
+            uint8_t at(size_t i) const { return ((a[i] ^ b[i]) >> plane) & 1u; }
+        };
+
+        // Cells of one generation with a state bit set
+        struct CellWord {
+            const uint8_t* a;
+            int plane;
+            uint64_t operator()(size_t i) const {
+                uint64_t x;
+                std::memcpy(&x, a + i, 8);
+                return (x >> plane) & kLowBits;
+            }
+            uint8_t at(size_t i) const { return (a[i] >> plane) & 1u; }
+        };
+
+        // Writes the (unchanged, changed) pairs of marked cells. Plane p of a count-cell grid
+        // is the index range [p * count, (p + 1) * count), so several planes (and ranges
+        // within them) scanned in increasing order chain into one stream.
+        class RunWriter {
+        public:
+            explicit RunWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+            // Scans 64 cells per mask and jumps between run boundaries with bit scans.
+            // Cells base..base+count-1 are word(0)..word(count-1); cells around them are unchanged
+            template <typename Word>
+            void scan(Word word, size_t base, size_t count) {
+                size_t runStart = 0;   // first cell of the current run
+                bool changed = false;  // kind of the current run
+
+                for (size_t i = 0; i < count; i += 64) {
+                    const uint64_t m = cellMask(word, i, count);
+                    unsigned p = 0;
+                    for (;;) {
+                        const uint64_t ends = (changed ? ~m : m) >> p; // cells that end the run
+                        if (ends == 0) break;
+                        p += lowestSetBit(ends);
+                        const size_t at = i + p;
+                        if (at >= count) break;
+                        if (changed) emit(base + runStart, base + at);
+                        runStart = at;
+                        changed = !changed;
+                    }
+                }
+                if (changed) emit(base + runStart, base + count);
+            }
+
+        private:
+            void emit(size_t begin, size_t end) {
+                putVarint(out_, begin - cursor_);
+                putVarint(out_, end - begin);
+                cursor_ = end;
+            }
+
+            std::vector<uint8_t>& out_;
+            size_t cursor_ = 0;   // end of the last changed run
+        };
+
+    }
+
+    void encodeXorDelta(const uint8_t* prev, const uint8_t* next, size_t count, std::vector<uint8_t>& out, int planes) {
+        RunWriter runs(out);
+        for (int p = 0; p < planes; ++p) runs.scan(XorWord{prev, next, p}, p * count, count);
+    }
+
+    void encodeXorDeltaRange(const uint8_t* before, const uint8_t* after, size_t begin, size_t end, size_t count,
+                             std::vector<uint8_t>& out, int planes) {
+        RunWriter runs(out);
+        for (int p = 0; p < planes; ++p) runs.scan(XorWord{before, after, p}, p * count + begin, end - begin);
+    }
+
+    void encodeCells(const uint8_t* cells, size_t count, std::vector<uint8_t>& out, int planes) {
+        RunWriter runs(out);
+        for (int p = 0; p < planes; ++p) runs.scan(CellWord{cells, p}, p * count, count);
+    }
+
+    bool applyXorDelta(const uint8_t* delta, size_t size, uint8_t* cells, size_t count, int planes) {
+        const uint8_t* p = delta;
+        const uint8_t* end = delta + size;
+        const size_t total = count * static_cast<size_t>(planes);
+        size_t i = 0;
+        while (p < end) {
+            uint64_t same = 0, changed = 0;
+            if (!getVarint(p, end, same) || !getVarint(p, end, changed)) return false;
+            if (same > total - i || changed > total - i - same) return false;
+            i += static_cast<size_t>(same);
+            while (changed > 0) {
+                // A run may continue from the end of one plane into the next
+                const size_t cell = i % count;
+                const uint8_t bit = static_cast<uint8_t>(1u << (i / count));
+                const size_t n = std::min(static_cast<size_t>(changed), count - cell);
+                for (size_t k = 0; k < n; ++k) cells[cell + k] ^= bit;
+                i += n;
+                changed -= n;
+            }
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,147 @@
+#include "../../include/core/domain.h"
+#include "../../include/utils/profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace core {
+
+    DomainLayout::DomainLayout(int gridWidth, int gridHeight, int columns, int rows)
+        : gridWidth_(gridWidth), gridHeight_(gridHeight), columns_(columns), rows_(rows) {
+        if (columns < 1 || rows < 1 || columns > gridWidth || rows > gridHeight) {
+            throw std::runtime_error("Cannot split a " + std::to_string(gridWidth) + "x" + std::to_string(gridHeight) +
+                " grid into " + std::to_string(columns) + "x" + std::to_string(rows) + " subdomains");
+        }
+    }
+
+    DomainRect DomainLayout::rect(int rank) const {
+        const int cx = rank % columns_;
+        const int cy = rank / columns_;
+        DomainRect r;
+        r.x = static_cast<int>(static_cast<long long>(gridWidth_) * cx / columns_);
+        r.y = static_cast<int>(static_cast<long long>(gridHeight_) * cy / rows_);
+        r.width = static_cast<int>(static_cast<long long>(gridWidth_) * (cx + 1) / columns_) - r.x;
+        r.height = static_cast<int>(static_cast<long long>(gridHeight_) * (cy + 1) / rows_) - r.y;
+        return r;
+    }
+
+    int DomainLayout::neighbour(int rank, int dx, int dy) const {
+        const int cx = ((rank % columns_ + dx) % columns_ + columns_) % columns_;
+        const int cy = ((rank / columns_ + dy) % rows_ + rows_) % rows_;
+        return cy * columns_ + cx;
+    }
+
+    int DomainLayout::maxHalo() const {
+        // The smallest subdomain limits how deep a strip can be
+        return std::min(gridWidth_ / columns_, gridHeight_ / rows_);
+    }
+
+    Subdomain::Subdomain(const DomainRect& rect, int halo)
+        : rect_(rect), halo_(halo), stride_(rect.width + 2 * halo), paddedHeight_(rect.height + 2 * halo) {
+        if (halo < 1 || halo > rect.width || halo > rect.height) {
+            throw std::runtime_error("Halo of " + std::to_string(halo) + " cells does not fit a " +
+                std::to_string(rect.width) + "x" + std::to_string(rect.height) + " subdomain");
+        }
+        current_.assign(static_cast<size_t>(stride_) * paddedHeight_, 0);
+        next_.assign(current_.size(), 0);
+    }
+
+    void Subdomain::loadFrom(const uint8_t* grid, int gridWidth) {
+        for (int y = 0; y < rect_.height; ++y) {
+            std::memcpy(row(halo_ + y) + halo_, grid + static_cast<size_t>(rect_.y + y) * gridWidth + rect_.x, rect_.width);
+        }
+    }
+
+    void Subdomain::storeTo(uint8_t* grid, int gridWidth) const {
+        for (int y = 0; y < rect_.height; ++y) {
+            std::memcpy(grid + static_cast<size_t>(rect_.y + y) * gridWidth + rect_.x, row(halo_ + y) + halo_, rect_.width);
+        }
+    }
+
+    void Subdomain::copyInterior(uint8_t* out) const {
+        for (int y = 0; y < rect_.height; ++y) {
+            std::memcpy(out + static_cast<size_t>(y) * rect_.width, row(halo_ + y) + halo_, rect_.width);
+        }
+    }
+
+    void Subdomain::setInterior(const uint8_t* cells) {
+        for (int y = 0; y < rect_.height; ++y) {
+            std::memcpy(row(halo_ + y) + halo_, cells + static_cast<size_t>(y) * rect_.width, rect_.width);
+        }
+    }
+
+    size_t Subdomain::stripBytes(Side side) const {
+        if (side == Side::West || side == Side::East) return static_cast<size_t>(halo_) * rect_.height;
+        return static_cast<size_t>(halo_) * stride_;
+    }
+
+    void Subdomain::packEdge(Side side, uint8_t* out) const {
+        const int k = halo_;
+        switch (side) {
+        case Side::West:
+        case Side::East: {
+            const int x = (side == Side::West) ? k : rect_.width; // first owned column of the strip
+            for (int y = 0; y < rect_.height; ++y) std::memcpy(out + static_cast<size_t>(y) * k, row(k + y) + x, k);
+            break;
+        }
+        case Side::South:
+        case Side::North: {
+            const int y0 = (side == Side::South) ? k : rect_.height; // first owned row of the strip
+            std::memcpy(out, row(y0), static_cast<size_t>(k) * stride_);
+            break;
+        }
+        }
+    }
+
+    void Subdomain::unpackHalo(Side side, const uint8_t* in) {
+        const int k = halo_;
+        switch (side) {
+        case Side::West:
+        case Side::East: {
+            const int x = (side == Side::West) ? 0 : k + rect_.width;
+            for (int y = 0; y < rect_.height; ++y) std::memcpy(row(k + y) + x, in + static_cast<size_t>(y) * k, k);
+            break;
+        }
+        case Side::South:
+        case Side::North: {
+            const int y0 = (side == Side::South) ? 0 : k + rect_.height;
+            std::memcpy(row(y0), in, static_cast<size_t>(k) * stride_);
+            break;
+        }
+        }
+    }
+
+    void Subdomain::step(int generations) {
+        PROFILE_SCOPE("Subdomain::step");
+        generations = std::clamp(generations, 0, halo_);
+
+        // Generation g is exact on the padded buffer minus g cells on every side
+        for (int g = 1; g <= generations; ++g) {
+            for (int y = g; y < paddedHeight_ - g; ++y) {
+                const uint8_t* up = current_.data() + static_cast<size_t>(y - 1) * stride_;
+                const uint8_t* mid = up + stride_;
+                const uint8_t* down = mid + stride_;
+                uint8_t* out = next_.data() + static_cast<size_t>(y) * stride_;
+                for (int x = g; x < stride_ - g; ++x) {
+                    const int n = up[x - 1] + up[x] + up[x + 1] + mid[x - 1] + mid[x + 1] + down[x - 1] + down[x] + down[x + 1];
+
+                    // Conway's rules, as in Life::step()
+                    out[x] = mid[x] ? (n == 2 || n == 3) : (n == 3);
+                }
+            }
+            std::swap(current_, next_);
+        }
+    }
+
+    size_t Subdomain::population() const {
+        size_t live = 0;
+        for (int y = 0; y < rect_.height; ++y) {
+            const uint8_t* r = row(halo_ + y) + halo_;
+            for (int x = 0; x < rect_.width; ++x) live += r[x];
+        }
+        return live;
+    }
+
+}
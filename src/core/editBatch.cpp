@@ -0,0 +1,227 @@
+#include "../../include/core/editBatch.h"
+#include "../../include/utils/splitMix.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace core {
+
+    static CellRect cornersToRect(int x0, int y0, int x1, int y1) {
+        CellRect r;
+        r.x0 = std::min(x0, x1);
+        r.y0 = std::min(y0, y1);
+        r.x1 = std::max(x0, x1) + 1;
+        r.y1 = std::max(y0, y1) + 1;
+        return r;
+    }
+
+    static CellRect clip(const CellRect& r, int width, int height) {
+        CellRect c;
+        c.x0 = std::max(r.x0, 0);
+        c.y0 = std::max(r.y0, 0);
+        c.x1 = std::min(r.x1, width);
+        c.y1 = std::min(r.y1, height);
+        return c;
+    }
+
+    void EditBatch::toggle(int x, int y, uint8_t state) {
+        Op op;
+        op.kind = Kind::Toggle;
+        op.rect = cornersToRect(x, y, x, y);
+        op.state = state;
+        ops_.push_back(op);
+    }
+
+    void EditBatch::stroke(int x0, int y0, int x1, int y1, int radius, uint8_t state) {
+        Op op;
+        op.kind = Kind::Stroke;
+        op.radius = std::max(radius, 0);
+        op.rect = cornersToRect(x0, y0, x1, y1);
+        op.rect.x0 -= op.radius;
+        op.rect.y0 -= op.radius;
+        op.rect.x1 += op.radius;
+        op.rect.y1 += op.radius;
+        op.ax = x0;
+        op.ay = y0;
+        op.bx = x1;
+        op.by = y1;
+        op.state = state;
+        ops_.push_back(op);
+    }
+
+    void EditBatch::fillRect(int x0, int y0, int x1, int y1, uint8_t state) {
+        Op op;
+        op.kind = Kind::Fill;
+        op.rect = cornersToRect(x0, y0, x1, y1);
+        op.state = state;
+        ops_.push_back(op);
+    }
+
+    void EditBatch::randomFill(int x0, int y0, int x1, int y1, float density, uint64_t seed) {
+        Op op;
+        op.kind = Kind::Random;
+        op.rect = cornersToRect(x0, y0, x1, y1);
+        op.threshold = static_cast<uint32_t>(std::clamp(density, 0.0f, 1.0f) * 65536.0f);
+        op.seed = seed;
+        ops_.push_back(op);
+    }
+
+    void EditBatch::paste(const uint8_t* cells, int width, int height, int x, int y, Rotation rotation, bool flip, bool merge) {
+        if (width <= 0 || height <= 0) return;
+        Op op;
+        op.kind = Kind::Paste;
+        int w = 0, h = 0;
+        rotatedSize(width, height, rotation, w, h);
+        op.rect = CellRect{x, y, x + w, y + h};
+        op.stamp = stamps_.size();
+        op.stampW = width;
+        op.stampH = height;
+        op.rotation = rotation;
+        op.flip = flip;
+        op.merge = merge;
+        stamps_.insert(stamps_.end(), cells, cells + static_cast<size_t>(width) * height);
+        ops_.push_back(op);
+    }
+
+    void EditBatch::rotatedSize(int width, int height, Rotation rotation, int& outW, int& outH) {
+        const bool quarter = rotation == Rotation::R90 || rotation == Rotation::R270;
+        outW = quarter ? height : width;
+        outH = quarter ? width : height;
+    }
+
+    void EditBatch::clear() {
+        ops_.clear();
+        stamps_.clear();
+    }
+
+    CellRect EditBatch::bounds(int width, int height) const {
+        CellRect box;
+        bool any = false;
+        for (const Op& op : ops_) {
+            const CellRect r = clip(op.rect, width, height);
+            if (r.empty()) continue;
+            if (!any) {
+                box = r;
+                any = true;
+                continue;
+            }
+            box.x0 = std::min(box.x0, r.x0);
+            box.y0 = std::min(box.y0, r.y0);
+            box.x1 = std::max(box.x1, r.x1);
+            box.y1 = std::max(box.y1, r.y1);
+        }
+        return box;
+    }
+
+    void EditBatch::apply(uint8_t* cells, int width, int height) const {
+        for (const Op& op : ops_) {
+            const CellRect r = clip(op.rect, width, height);
+            if (r.empty()) continue;
+
+            switch (op.kind) {
+            case Kind::Toggle: {
+                uint8_t& cell = cells[static_cast<size_t>(r.y0) * width + r.x0];
+                cell = cell == op.state ? 0 : op.state;
+                break;
+            }
+            case Kind::Stroke:
+                applyStroke(op, r, cells, width);
+                break;
+            case Kind::Fill:
+                for (int y = r.y0; y < r.y1; ++y) {
+                    std::memset(cells + static_cast<size_t>(y) * width + r.x0, op.state, static_cast<size_t>(r.x1 - r.x0));
+                }
+                break;
+            case Kind::Random:
+                applyRandom(op, r, cells, width);
+                break;
+            case Kind::Paste:
+                applyPaste(op, r, cells, width);
+                break;
+            }
+        }
+    }
+
+    void EditBatch::applyStroke(const Op& op, const CellRect& r, uint8_t* cells, int width) const {
+        // A cell is painted if its distance to the segment is within the radius
+        const double dx = op.bx - op.ax;
+        const double dy = op.by - op.ay;
+        const double lengthSq = dx * dx + dy * dy;
+        const double reach = (op.radius + 0.5) * (op.radius + 0.5);
+        const uint8_t value = op.state;
+
+        for (int y = r.y0; y < r.y1; ++y) {
+            uint8_t* row = cells + static_cast<size_t>(y) * width;
+            for (int x = r.x0; x < r.x1; ++x) {
+                double t = 0.0;
+                if (lengthSq > 0.0) t = std::clamp(((x - op.ax) * dx + (y - op.ay) * dy) / lengthSq, 0.0, 1.0);
+                const double ex = x - (op.ax + t * dx);
+                const double ey = y - (op.ay + t * dy);
+                if (ex * ex + ey * ey <= reach) row[x] = value;
+            }
+        }
+    }
+
+    void EditBatch::applyRandom(const Op& op, const CellRect& r, uint8_t* cells, int width) const {
+        // Draw n covers cells 4n..4n+3 of its row (16 bits each), so clipping keeps the cells
+        // that remain identical and rows can be produced in any order. The seed is hashed so
+        // that neighbouring seeds do not give the same stream shifted by a few draws
+        const uint64_t rowWidth = static_cast<uint64_t>(op.rect.x1 - op.rect.x0);
+        const uint64_t draws = (rowWidth + 3) / 4;
+        const uint64_t base = utils::splitMix64(op.seed);
+        for (int y = r.y0; y < r.y1; ++y) {
+            uint8_t* row = cells + static_cast<size_t>(y) * width + r.x0;
+            const uint64_t rowKey = base + static_cast<uint64_t>(y - op.rect.y0) * draws * utils::kSplitMixGamma;
+            const int first = r.x0 - op.rect.x0;
+            const int count = r.x1 - r.x0;
+
+            auto draw = [&](int cell) { return utils::splitMix64(rowKey + static_cast<uint64_t>(cell / 4 + 1) * utils::kSplitMixGamma); };
+
+            // Partial first group, whole groups, partial last group
+            int x = 0;
+            if (first % 4 != 0) {
+                uint64_t bits = draw(first) >> (16 * (first % 4));
+                for (int k = first % 4; k < 4 && x < count; ++k, ++x, bits >>= 16) row[x] = (bits & 0xFFFFu) < op.threshold;
+            }
+            for (; x + 4 <= count; x += 4) {
+                const uint64_t bits = draw(first + x);
+                row[x] = (bits & 0xFFFFu) < op.threshold;
+                row[x + 1] = ((bits >> 16) & 0xFFFFu) < op.threshold;
+                row[x + 2] = ((bits >> 32) & 0xFFFFu) < op.threshold;
+                row[x + 3] = (bits >> 48) < op.threshold;
+            }
+            if (x < count) {
+                uint64_t bits = draw(first + x);
+                for (; x < count; ++x, bits >>= 16) row[x] = (bits & 0xFFFFu) < op.threshold;
+            }
+        }
+    }
+
+    void EditBatch::applyPaste(const Op& op, const CellRect& r, uint8_t* cells, int width) const {
+        const uint8_t* stamp = stamps_.data() + op.stamp;
+        const int w = op.stampW;
+        const int h = op.stampH;
+
+        for (int y = r.y0; y < r.y1; ++y) {
+            uint8_t* row = cells + static_cast<size_t>(y) * width;
+            const int dy = y - op.rect.y0;
+            for (int x = r.x0; x < r.x1; ++x) {
+                const int dx = x - op.rect.x0;
+
+                // Inverse of "flip, then rotate counter-clockwise"
+                int sx = dx, sy = dy;
+                switch (op.rotation) {
+                case Rotation::R0:   break;
+                case Rotation::R90:  sx = dy;         sy = h - 1 - dx; break;
+                case Rotation::R180: sx = w - 1 - dx; sy = h - 1 - dy; break;
+                case Rotation::R270: sx = w - 1 - dy; sy = dx;         break;
+                }
+                if (op.flip) sx = w - 1 - sx;
+
+                const uint8_t v = stamp[static_cast<size_t>(sy) * w + sx];
+                if (v || !op.merge) row[x] = v;
+            }
+        }
+    }
+
+}
@@ -1,44 +1,349 @@
 #include "../../include/core/gameLogic.h"
+#include "../../include/utils/profiler.h"
+#include "../../include/utils/threadPool.h"
 
 #include <algorithm>
+#include <cstring>
 
 namespace core {
 
     Life::Life(int width, int height) :
         gridWidth_(width),
-        gridHeight_(height),
-        currentBuffer_(static_cast<size_t>(width)* static_cast<size_t>(height), 0),
-        nextBuffer_(static_cast<size_t>(width)* static_cast<size_t>(height), 0) {
+        gridHeight_(height) {
+        const size_t cells = static_cast<size_t>(width) * static_cast<size_t>(height);
+        if (cells >= kParallelCells) {
+            bands_ = static_cast<int>(std::min<size_t>(utils::ThreadPool::shared().size(), static_cast<size_t>(height)));
+        }
+
+        // Value-less resize leaves the pages untouched; the first write below places them
+        currentBuffer_.resize(cells);
+        nextBuffer_.resize(cells);
+        forEachBand([this](int, int y0, int y1) {
+            const size_t begin = static_cast<size_t>(y0) * gridWidth_, count = static_cast<size_t>(y1 - y0) * gridWidth_;
+            std::memset(currentBuffer_.data() + begin, 0, count);
+            std::memset(nextBuffer_.data() + begin, 0, count);
+        });
+    }
+
+    void Life::setRule(const LifeRule& rule) {
+        rule_ = rule;
+        updateWorkBuffer();
+    }
+
+    void Life::setInPlace(bool enabled) {
+        inPlace_ = enabled;
+        updateWorkBuffer();
+    }
+
+    void Life::updateWorkBuffer() {
+        if (stepsInPlace()) {
+            Buffer().swap(nextBuffer_);
+            return;
+        }
+        if (nextBuffer_.size() == currentBuffer_.size()) return;
+        nextBuffer_.resize(currentBuffer_.size());
+        forEachBand([this](int, int y0, int y1) {
+            std::memset(nextBuffer_.data() + static_cast<size_t>(y0) * gridWidth_, 0, static_cast<size_t>(y1 - y0) * gridWidth_);
+        });
+    }
+
+    void Life::swapPrevious(Buffer& spare) {
+        spare.resize(nextBuffer_.size());
+        std::swap(spare, nextBuffer_);
+    }
+
+    void Life::bandRows(int band, int& y0, int& y1) const {
+        y0 = static_cast<int>(static_cast<int64_t>(gridHeight_) * band / bands_);
+        y1 = static_cast<int>(static_cast<int64_t>(gridHeight_) * (band + 1) / bands_);
+    }
+
+    void Life::forEachBand(const std::function<void(int, int, int)>& body) {
+        if (bands_ == 1) {
+            body(0, 0, gridHeight_);
+            return;
+        }
+        // Band b always runs on pool thread b, the same thread that first touched it
+        utils::ThreadPool::shared().forEachThread([&](size_t thread) {
+            const int band = static_cast<int>(thread);
+            if (band >= bands_) return;
+            int y0 = 0, y1 = 0;
+            bandRows(band, y0, y1);
+            body(band, y0, y1);
+        });
     }
 
     void Life::clear() {
         std::fill(currentBuffer_.begin(), currentBuffer_.end(), 0);
+        std::fill(ageBuffer_.begin(), ageBuffer_.end(), 0);
+        liveCells_.clear();
+    }
+
+    void Life::setLiveCellsEnabled(bool enabled) {
+        trackLiveCells_ = enabled;
+        if (enabled) {
+            rebuildLiveCells();
+        }
+        else {
+            liveCells_.clear();
+            liveCells_.shrink_to_fit();
+        }
+    }
+
+    void Life::rebuildLiveCells() {
+        liveCells_.clear();
+        if (!trackLiveCells_) return;
+        const size_t count = currentBuffer_.size();
+        for (size_t i = 0; i < count; ++i) {
+            if (currentBuffer_[i]) liveCells_.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    void Life::setAgeEnabled(bool enabled) {
+        trackAge_ = enabled;
+        if (enabled) {
+            resetAge();
+        }
+        else {
+            ageBuffer_.clear();
+            ageBuffer_.shrink_to_fit();
+        }
+    }
+
+    void Life::resetAge() {
+        if (!trackAge_) return;
+        ageBuffer_.resize(currentBuffer_.size());
+        forEachBand([this](int, int y0, int y1) {
+            const size_t end = static_cast<size_t>(y1) * gridWidth_;
+            for (size_t i = static_cast<size_t>(y0) * gridWidth_; i < end; ++i) {
+                ageBuffer_[i] = currentBuffer_[i] ? kAgeAliveBase : 0;
+            }
+        });
+    }
+
+    void Life::touchAge(int x, int y) {
+        if (!trackAge_) return;
+        const size_t i = static_cast<size_t>(y) * gridWidth_ + x;
+        ageBuffer_[i] = currentBuffer_[i] ? kAgeAliveBase : kTrailStart;
+    }
+
+    void Life::touchAgeRange(const uint8_t* before, size_t begin, size_t end) {
+        if (!trackAge_) return;
+        const uint8_t* cells = currentBuffer_.data();
+        uint8_t* age = ageBuffer_.data();
+        // Branchless: bulk edits (random fills) change cells unpredictably
+        for (size_t i = begin; i < end; ++i) {
+            const uint8_t c = cells[i];
+            const uint8_t touched = static_cast<uint8_t>(kTrailStart + c * (kAgeAliveBase - kTrailStart));
+            const uint8_t keep = static_cast<uint8_t>((c ^ before[i - begin]) - 1); // 0xFF if unchanged
+            age[i] = static_cast<uint8_t>((age[i] & keep) | (touched & ~keep));
+        }
     }
 
     void Life::step() {
-        for (int y = 0; y < gridHeight_; ++y) {
-            for (int x = 0; x < gridWidth_; ++x) {
-                const int xm = wrap(x - 1, gridWidth_), xp = wrap(x + 1, gridWidth_);
-                const int ym = wrap(y - 1, gridHeight_), yp = wrap(y + 1, gridHeight_);
+        PROFILE_SCOPE("Life::step");
+        beginStep();
+        forEachBand([this](int band, int, int) { stepBand(band); });
+        endStep();
+    }
 
-                int aliveNeighbours = 0;
-                aliveNeighbours += currentBuffer_[ym * gridWidth_ + xm];
-                aliveNeighbours += currentBuffer_[ym * gridWidth_ + x];
-                aliveNeighbours += currentBuffer_[ym * gridWidth_ + xp];
-                aliveNeighbours += currentBuffer_[y * gridWidth_ + xm];
-                aliveNeighbours += currentBuffer_[y * gridWidth_ + xp];
-                aliveNeighbours += currentBuffer_[yp * gridWidth_ + xm];
-                aliveNeighbours += currentBuffer_[yp * gridWidth_ + x];
-                aliveNeighbours += currentBuffer_[yp * gridWidth_ + xp];
+    void Life::beginStep() {
+        liveCells_.clear();
+        bandLiveCells_.resize(bands_);
+        if (!rule_.isConway()) bandRangeScratch_.resize(bands_);
+        if (stepsInPlace()) bandInPlace_.resize(bands_);
+    }
 
-                const uint8_t alive = currentBuffer_[y * gridWidth_ + x] ? 1u : 0u; // current cell state
+    void Life::stepBand(int band) {
+        // The single band appends straight to liveCells_; bands are merged in row order
+        int y0 = 0, y1 = 0;
+        bandRows(band, y0, y1);
+        std::vector<uint32_t>& live = bands_ == 1 ? liveCells_ : bandLiveCells_[band];
+        RangeScratch* scratch = bandRangeScratch_.empty() ? nullptr : &bandRangeScratch_[band];
+        live.clear();
+        switch (topology_) {
+        case Topology::Torus: stepBandWith<TopologyPolicy<Topology::Torus>>(band, y0, y1, live, scratch); break;
+        case Topology::KleinBottle: stepBandWith<TopologyPolicy<Topology::KleinBottle>>(band, y0, y1, live, scratch); break;
+        case Topology::ProjectivePlane: stepBandWith<TopologyPolicy<Topology::ProjectivePlane>>(band, y0, y1, live, scratch); break;
+        case Topology::Bounded: stepBandWith<TopologyPolicy<Topology::Bounded>>(band, y0, y1, live, scratch); break;
+        }
+    }
+
+    void Life::endStep() {
+        if (trackLiveCells_ && bands_ > 1) {
+            for (const std::vector<uint32_t>& live : bandLiveCells_) liveCells_.insert(liveCells_.end(), live.begin(), live.end());
+        }
 
-                // Conway's rules
-                nextBuffer_[y * gridWidth_ + x] = alive ? (aliveNeighbours == 2 || aliveNeighbours == 3) : (aliveNeighbours == 3);
+        if (!stepsInPlace()) {
+            std::swap(currentBuffer_, nextBuffer_);
+            return;
+        }
+
+        // Write what the bands held back now that no band reads the old cells
+        const size_t w = static_cast<size_t>(gridWidth_);
+        uint8_t* cells = currentBuffer_.data();
+        for (int band = 0; band < bands_; ++band) {
+            int y0 = 0, y1 = 0;
+            bandRows(band, y0, y1);
+            const InPlaceRows& s = bandInPlace_[band];
+            const uint8_t* held = s.rows.data() + (kInPlaceRows + 1) * w;
+            std::memcpy(cells + y0 * w, held, w);
+            if (y1 - 1 > y0) std::memcpy(cells + (y1 - 1) * w, held + w, w);
+            if (s.columns.empty()) continue;
+            for (int y = y0 + 1; y < y1 - 1; ++y) {
+                cells[y * w] = s.columns[2 * (y - y0)];
+                cells[y * w + w - 1] = s.columns[2 * (y - y0) + 1];
+            }
+        }
+    }
+
+    template <class Policy>
+    void Life::stepBandWith(int band, int y0, int y1, std::vector<uint32_t>& live, RangeScratch* scratch) {
+        if (stepsInPlace()) stepBandInPlace<Policy>(band, y0, y1, live, scratch);
+        else stepBandRows<Policy>(y0, y1, nextBuffer_.data() + static_cast<size_t>(y0) * gridWidth_, live, scratch);
+    }
+
+    template <class Policy>
+    void Life::stepBandInPlace(int band, int y0, int y1, std::vector<uint32_t>& live, RangeScratch* scratch) {
+        // Every kernel that steps in place reads rows y-1..y+1 for row y (and, across a mirroring
+        // edge, the border columns of any row). A new row can overwrite the old one once the
+        // row below it is computed, except the band's first and last rows, which the bands
+        // beside it read, and the border columns the mirrored rows read: those wait for endStep()
+        const size_t w = static_cast<size_t>(gridWidth_);
+        InPlaceRows& s = bandInPlace_[band];
+        s.rows.resize((kInPlaceRows + 3) * w);
+        if constexpr (Policy::kMirrorAcrossX) s.columns.resize(2 * static_cast<size_t>(y1 - y0));
+        else s.columns.clear();
+
+        uint8_t* cells = currentBuffer_.data();
+        uint8_t* pending = s.rows.data();                 // new row c-1, still needed as old cells by row c
+        uint8_t* chunk = pending + w;                     // new rows [c, c + kInPlaceRows)
+        uint8_t* first = chunk + kInPlaceRows * w;        // new rows y0 and y1-1, written by endStep()
+        uint8_t* last = first + w;
+
+        auto settle = [&](int y, const uint8_t* row) {
+            if (y == y0) {
+                std::memcpy(first, row, w);
+                return;
+            }
+            if (y == y1 - 1) {
+                std::memcpy(last, row, w);
+                return;
+            }
+            uint8_t* dst = cells + y * w;
+            if constexpr (Policy::kMirrorAcrossX) {
+                s.columns[2 * (y - y0)] = row[0];
+                s.columns[2 * (y - y0) + 1] = row[w - 1];
+                if (w > 2) std::memcpy(dst + 1, row + 1, w - 2);
+            }
+            else {
+                std::memcpy(dst, row, w);
+            }
+        };
+
+        for (int c = y0; c < y1; c += kInPlaceRows) {
+            const int end = std::min(c + kInPlaceRows, y1);
+            stepBandRows<Policy>(c, end, chunk, live, scratch);
+            if (c > y0) settle(c - 1, pending);
+            for (int y = c; y < end - 1; ++y) settle(y, chunk + (y - c) * w);
+            std::memcpy(pending, chunk + (end - 1 - c) * w, w);
+        }
+        settle(y1 - 1, pending);
+    }
+
+    template <class Policy>
+    void Life::stepBandRows(int y0, int y1, uint8_t* out, std::vector<uint32_t>& live, RangeScratch* scratch) {
+        if (rule_.isConway()) {
+            if (trackLiveCells_) {
+                if (trackAge_) stepRows<Policy, true, true>(y0, y1, out, live);
+                else stepRows<Policy, true, false>(y0, y1, out, live);
+            }
+            else {
+                if (trackAge_) stepRows<Policy, false, true>(y0, y1, out, live);
+                else stepRows<Policy, false, false>(y0, y1, out, live);
+            }
+            return;
+        }
+
+        if (rule_.usesStatePlanes()) stepStatePlanes(currentBuffer_.data(), out, gridWidth_, gridHeight_, y0, y1, rule_, Policy::kTopology, *scratch);
+        else stepLargerThanLife(currentBuffer_.data(), out, gridWidth_, gridHeight_, y0, y1, rule_, Policy::kTopology, *scratch);
+        if (trackLiveCells_) {
+            if (trackAge_) finishRows<true, true>(y0, y1, out, live);
+            else finishRows<true, false>(y0, y1, out, live);
+        }
+        else if (trackAge_) {
+            finishRows<false, true>(y0, y1, out, live);
+        }
+    }
+
+    template <class Policy, bool TrackLive, bool TrackAge>
+    void Life::stepRows(int y0, int y1, uint8_t* out, std::vector<uint32_t>& live) {
+        const int w = gridWidth_, h = gridHeight_;
+        const uint8_t* cells = currentBuffer_.data();
+        const size_t base = static_cast<size_t>(y0) * w;
+
+        // Conway's rules, live-cell list and age for cell i with n live neighbours
+        auto emit = [&](size_t i, int n) {
+            const uint8_t alive = cells[i] ? 1u : 0u;
+            const uint8_t next = alive ? (n == 2 || n == 3) : (n == 3);
+            out[i - base] = next;
+
+            if constexpr (TrackLive) {
+                if (next) live.push_back(static_cast<uint32_t>(i));
+            }
+
+            // Age grows while alive (saturating), trail decays while dead
+            if constexpr (TrackAge) {
+                uint8_t& age = ageBuffer_[i];
+                if (next) age = alive ? (age < 255 ? age + 1 : 255) : kAgeAliveBase;
+                else age = alive ? kTrailStart : (age > kTrailDecay ? age - kTrailDecay : 0);
             }
+        };
+
+        // Border cells: each neighbour goes through the topology
+        auto border = [&](int x, int y) {
+            int n = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (dx != 0 || dy != 0) n += Policy::cell(cells, x + dx, y + dy, w, h);
+                }
+            }
+            emit(static_cast<size_t>(y) * w + x, n);
+        };
+
+        for (int y = y0; y < y1; ++y) {
+            if (y == 0 || y == h - 1) {
+                for (int x = 0; x < w; ++x) border(x, y);
+                continue;
+            }
+
+            const uint8_t* up = cells + static_cast<size_t>(y - 1) * w;
+            const uint8_t* mid = up + w;
+            const uint8_t* down = mid + w;
+            const size_t row = static_cast<size_t>(y) * w;
+            border(0, y);
+            for (int x = 1; x < w - 1; ++x) {
+                const int n = up[x - 1] + up[x] + up[x + 1] + mid[x - 1] + mid[x + 1] + down[x - 1] + down[x] + down[x + 1];
+                emit(row + x, n);
+            }
+            if (w > 1) border(w - 1, y);
         }
+    }
 
-        std::swap(currentBuffer_, nextBuffer_);
+    template <bool TrackLive, bool TrackAge>
+    void Life::finishRows(int y0, int y1, const uint8_t* out, std::vector<uint32_t>& live) {
+        const size_t base = static_cast<size_t>(y0) * gridWidth_, end = static_cast<size_t>(y1) * gridWidth_;
+        for (size_t i = base; i < end; ++i) {
+            const uint8_t next = out[i - base];
+            if constexpr (TrackLive) {
+                if (next) live.push_back(static_cast<uint32_t>(i));
+            }
+            if constexpr (TrackAge) {
+                const uint8_t alive = currentBuffer_[i];
+                uint8_t& age = ageBuffer_[i];
+                if (next) age = alive ? (age < 255 ? age + 1 : 255) : kAgeAliveBase;
+                else age = alive ? kTrailStart : (age > kTrailDecay ? age - kTrailDecay : 0);
+            }
+        }
     }
 
-}
\ No newline at end of file
+}
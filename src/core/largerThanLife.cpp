@@ -0,0 +1,371 @@
+#include "../../include/core/largerThanLife.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+namespace core {
+
+    // Row r (any integer) padded as the topology glues it; with dying states only state 1 counts
+    template <class Policy>
+    static void countedRow(const uint8_t* cells, int width, int height, int r, int pad, const LifeRule& rule, uint8_t* out) {
+        Policy::row(cells, width, height, r, pad, out);
+        if (rule.states <= 2) return;
+        const int n = width + 2 * pad;
+        for (int i = 0; i < n; ++i) out[i] = out[i] == 1;
+    }
+
+    // Next state of one row from its neighbourhood sums
+    template <class Sum>
+    static void applyRule(const uint8_t* cells, uint8_t* next, int width, const LifeRule& rule, Sum sumAt) {
+        const int self = rule.includeCenter ? 0 : 1;
+        const uint8_t dying = rule.states > 2 ? 2 : 0;   // where a live cell that does not survive goes
+        for (int x = 0; x < width; ++x) {
+            const uint8_t state = cells[x];
+            const uint8_t alive = state == 1;
+            const int n = sumAt(x) - self * alive;
+            if (state <= 1) {
+                next[x] = alive ? ((n >= rule.surviveMin && n <= rule.surviveMax) ? 1 : dying)
+                                : (n >= rule.birthMin && n <= rule.birthMax);
+            }
+            else {
+                next[x] = state + 1 < rule.states ? static_cast<uint8_t>(state + 1) : 0;
+            }
+        }
+    }
+
+    int neighbourhoodSize(const LifeRule& rule) {
+        const int r = rule.range;
+        const int cells = rule.shape == Neighbourhood::Moore ? (2 * r + 1) * (2 * r + 1) : 2 * r * r + 2 * r + 1;
+        return rule.includeCenter ? cells : cells - 1;
+    }
+
+    std::string formatLifeRule(const LifeRule& rule) {
+        if (rule.family == RuleFamily::WireWorld) return "WireWorld";
+        return "R" + std::to_string(rule.range) + ",C" + std::to_string(rule.states > 2 ? rule.states : 0) + ",M" + (rule.includeCenter ? "1" : "0") +
+               ",S" + std::to_string(rule.surviveMin) + ".." + std::to_string(rule.surviveMax) +
+               ",B" + std::to_string(rule.birthMin) + ".." + std::to_string(rule.birthMax) +
+               (rule.shape == Neighbourhood::Moore ? ",NM" : ",NN");
+    }
+
+    bool parseLifeRule(const std::string& text, LifeRule& rule) {
+        std::string t;
+        for (char c : text) {
+            if (!std::isspace(static_cast<unsigned char>(c))) t += c;
+        }
+        if (t == "WireWorld") {
+            rule = kWireWorldRule;
+            return true;
+        }
+
+        int range = 0, states = 0, center = 0, sMin = 0, sMax = 0, bMin = 0, bMax = 0, used = 0;
+        char shape = 0;
+        if (std::sscanf(t.c_str(), "R%d,C%d,M%d,S%d..%d,B%d..%d,N%c%n", &range, &states, &center, &sMin, &sMax,
+                        &bMin, &bMax, &shape, &used) != 8 || static_cast<size_t>(used) != t.size()) {
+            return false;
+        }
+        LifeRule parsed;
+        parsed.range = range;
+        parsed.states = states == 0 ? 2 : states;
+        parsed.includeCenter = center == 1;
+        parsed.shape = shape == 'M' ? Neighbourhood::Moore : Neighbourhood::VonNeumann;
+        if (range < 1 || range > kMaxRange || parsed.states < 2 || parsed.states > kMaxStates || center < 0 || center > 1 ||
+            (shape != 'M' && shape != 'N')) {
+            return false;
+        }
+        const int size = neighbourhoodSize(parsed);
+        for (int v : { sMin, sMax, bMin, bMax }) {
+            if (v < 0 || v > size) return false; // max < min is a valid, empty interval
+        }
+        parsed.surviveMin = sMin;
+        parsed.surviveMax = sMax;
+        parsed.birthMin = bMin;
+        parsed.birthMax = bMax;
+        rule = parsed;
+        return true;
+    }
+
+    template <class Policy>
+    static void stepMoore(const uint8_t* cells, uint8_t* next, int width, int height, int y0, int y1,
+                          const LifeRule& rule, RangeScratch& s) {
+        const int r = rule.range;
+        const int ring = 2 * r + 2;   // rows y-R-1 .. y+R
+        const int first = y0 - r - 1;
+        s.row.resize(static_cast<size_t>(width) + 2 * r);
+        s.sums.resize(static_cast<size_t>(ring) * width);
+        s.column.assign(static_cast<size_t>(width), 0);
+
+        auto rowSums = [&](int y) { return s.sums.data() + static_cast<size_t>((y - first) % ring) * width; };
+
+        // Sliding sum over x of row y
+        auto sumRow = [&](int y) {
+            countedRow<Policy>(cells, width, height, y, r, rule, s.row.data());
+            const uint8_t* p = s.row.data();
+            uint16_t* out = rowSums(y);
+            uint16_t sum = 0;
+            for (int i = 0; i <= 2 * r; ++i) sum += p[i];
+            out[0] = sum;
+            for (int x = 1; x < width; ++x) {
+                sum = static_cast<uint16_t>(sum + p[x + 2 * r] - p[x - 1]);
+                out[x] = sum;
+            }
+        };
+
+        uint16_t* column = s.column.data();
+        for (int y = y0 - r; y <= y0 + r; ++y) {
+            sumRow(y);
+            const uint16_t* h = rowSums(y);
+            for (int x = 0; x < width; ++x) column[x] = static_cast<uint16_t>(column[x] + h[x]);
+        }
+
+        for (int y = y0; y < y1; ++y) {
+            if (y > y0) {
+                sumRow(y + r);
+                const uint16_t* in = rowSums(y + r);
+                const uint16_t* out = rowSums(y - r - 1);
+                for (int x = 0; x < width; ++x) column[x] = static_cast<uint16_t>(column[x] + in[x] - out[x]);
+            }
+            applyRule(cells + static_cast<size_t>(y) * width, next + static_cast<size_t>(y - y0) * width, width, rule,
+                      [column](int x) { return static_cast<int>(column[x]); });
+        }
+    }
+
+    template <class Policy>
+    static void stepVonNeumann(const uint8_t* cells, uint8_t* next, int width, int height, int y0, int y1,
+                               const LifeRule& rule, RangeScratch& s) {
+        const int r = rule.range;
+        const int pad = r + 1;
+        const int paddedW = width + 2 * pad;
+        const int ring = 2 * r + 3;   // rows y-R-2 .. y+R
+        const int first = y0 - r - 2;
+        s.row.resize(static_cast<size_t>(paddedW));
+        s.sums.resize(2 * static_cast<size_t>(ring) * paddedW);
+
+        // Prefix sums along the two diagonals; 16-bit wrap-around cancels in the differences
+        auto down = [&](int y) { return s.sums.data() + static_cast<size_t>((y - first) % ring) * paddedW; };
+        auto downLeft = [&](int y) { return s.sums.data() + static_cast<size_t>(ring + (y - first) % ring) * paddedW; };
+
+        auto prefixRow = [&](int y) {
+            countedRow<Policy>(cells, width, height, y, pad, rule, s.row.data());
+            const uint8_t* p = s.row.data();
+            uint16_t* d = down(y);
+            uint16_t* a = downLeft(y);
+            if (y == first) {
+                for (int i = 0; i < paddedW; ++i) d[i] = a[i] = p[i];
+                return;
+            }
+            const uint16_t* pd = down(y - 1);
+            const uint16_t* pa = downLeft(y - 1);
+            d[0] = p[0];
+            for (int i = 1; i < paddedW; ++i) d[i] = static_cast<uint16_t>(p[i] + pd[i - 1]);
+            for (int i = 0; i < paddedW - 1; ++i) a[i] = static_cast<uint16_t>(p[i] + pa[i + 1]);
+            a[paddedW - 1] = p[paddedW - 1];
+        };
+
+        // n cells from (x, y) stepping down-right, or down-left
+        auto sumDown = [&](int x, int y, int n) {
+            return static_cast<uint16_t>(down(y + n - 1)[x + n - 1] - down(y - 1)[x - 1]);
+        };
+        auto sumDownLeft = [&](int x, int y, int n) {
+            return static_cast<uint16_t>(downLeft(y + n - 1)[x - n + 1] - downLeft(y - 1)[x + 1]);
+        };
+
+        for (int y = first; y <= y0 + r; ++y) prefixRow(y);
+
+        // The first diamond of the band is summed directly, every other one slides
+        int rowStart = 0;
+        for (int dy = -r; dy <= r; ++dy) {
+            const int k = r - (dy < 0 ? -dy : dy);
+            for (int dx = -k; dx <= k; ++dx) rowStart += Policy::cell(cells, dx, y0 + dy, width, height) == 1;
+        }
+
+        s.column.resize(static_cast<size_t>(width));
+        uint16_t* sums = s.column.data();
+        for (int y = y0; y < y1; ++y) {
+            if (y > y0) {
+                prefixRow(y + r);
+                // Down one row: gain the lower V of the new diamond, lose the upper peak of the old
+                rowStart += sumDown(pad - r, y, r + 1) + sumDownLeft(pad + r, y, r) -
+                            sumDownLeft(pad, y - 1 - r, r + 1) - sumDown(pad + 1, y - r, r);
+            }
+
+            // Right one cell: gain the right edges of the new diamond, lose the left edges of the old
+            int sum = rowStart;
+            for (int x = 0; x < width; ++x) {
+                sums[x] = static_cast<uint16_t>(sum);
+                if (x + 1 == width) break;
+                const int c = pad + x;
+                sum += sumDown(c + 1, y - r, r + 1) + sumDownLeft(c + r, y + 1, r) -
+                       sumDownLeft(c, y - r, r + 1) - sumDown(c - r + 1, y + 1, r);
+            }
+
+            applyRule(cells + static_cast<size_t>(y) * width, next + static_cast<size_t>(y - y0) * width, width, rule,
+                      [sums](int x) { return static_cast<int>(sums[x]); });
+        }
+    }
+
+    template <class Policy>
+    static void stepShape(const uint8_t* cells, uint8_t* next, int width, int height, int y0, int y1,
+                          const LifeRule& rule, RangeScratch& scratch) {
+        if (rule.shape == Neighbourhood::Moore) stepMoore<Policy>(cells, next, width, height, y0, y1, rule, scratch);
+        else stepVonNeumann<Policy>(cells, next, width, height, y0, y1, rule, scratch);
+    }
+
+    void stepLargerThanLife(const uint8_t* cells, uint8_t* next, int width, int height, int y0, int y1,
+                            const LifeRule& rule, Topology topology, RangeScratch& scratch) {
+        switch (topology) {
+        case Topology::Torus: stepShape<TopologyPolicy<Topology::Torus>>(cells, next, width, height, y0, y1, rule, scratch); break;
+        case Topology::KleinBottle: stepShape<TopologyPolicy<Topology::KleinBottle>>(cells, next, width, height, y0, y1, rule, scratch); break;
+        case Topology::ProjectivePlane: stepShape<TopologyPolicy<Topology::ProjectivePlane>>(cells, next, width, height, y0, y1, rule, scratch); break;
+        case Topology::Bounded: stepShape<TopologyPolicy<Topology::Bounded>>(cells, next, width, height, y0, y1, rule, scratch); break;
+        }
+    }
+
+    // Entry b holds bit k of b in byte k: spreads 8 bits of a plane back to 8 cells
+    static const uint64_t* spreadTable() {
+        static const std::array<uint64_t, 256> table = [] {
+            std::array<uint64_t, 256> t{};
+            for (int b = 0; b < 256; ++b) {
+                for (int k = 0; k < 8; ++k) t[b] |= static_cast<uint64_t>((b >> k) & 1) << (8 * k);
+            }
+            return t;
+        }();
+        return table.data();
+    }
+
+    // Bit k of the result is bit `plane` of byte k (cells are loaded little-endian)
+    static inline uint64_t gatherPlane(uint64_t eightCells, int plane) {
+        return (((eightCells >> plane) & 0x0101010101010101ull) * 0x0102040810204080ull) >> 56;
+    }
+
+    // Pack a padded row of bytes (zero past its end, up to words * 64) into its two state planes
+    static void packRow(const uint8_t* bytes, int words, uint64_t* low, uint64_t* high) {
+        for (int i = 0; i < words; ++i) {
+            uint64_t lo = 0, hi = 0;
+            for (int g = 0; g < 8; ++g) {
+                uint64_t v;
+                std::memcpy(&v, bytes + 64 * i + 8 * g, 8);
+                lo |= gatherPlane(v, 0) << (8 * g);
+                hi |= gatherPlane(v, 1) << (8 * g);
+            }
+            low[i] = lo;
+            high[i] = hi;
+        }
+    }
+
+    // Neighbour counts 0..8 inside [lo, hi] as a bit set
+    static uint16_t countSet(int lo, int hi) {
+        uint16_t set = 0;
+        for (int k = std::max(lo, 0); k <= std::min(hi, 8); ++k) set |= static_cast<uint16_t>(1u << k);
+        return set;
+    }
+
+    template <class Policy>
+    static void stepPlanes(const uint8_t* cells, uint8_t* next, int width, int height, int y0, int y1,
+                           const LifeRule& rule, RangeScratch& s) {
+        const int words = (width + 2 + 63) / 64;   // padded row: cell x is bit x + 1
+        s.row.assign(static_cast<size_t>(words) * 64, 0);
+        s.planes.resize(static_cast<size_t>(words) * 8);
+        uint64_t* out0 = s.planes.data() + static_cast<size_t>(words) * 6;
+        uint64_t* out1 = out0 + words;
+
+        // Ring of three packed rows, two planes each
+        auto plane = [&](int y, int bit) { return s.planes.data() + static_cast<size_t>(((y - y0 + 1) % 3) * 2 + bit) * words; };
+        auto pack = [&](int y) {
+            Policy::row(cells, width, height, y, 1, s.row.data());
+            packRow(s.row.data(), words, plane(y, 0), plane(y, 1));
+        };
+
+        const uint16_t birth = countSet(rule.birthMin, rule.birthMax);
+        const uint16_t survive = countSet(rule.surviveMin, rule.surviveMax);
+        const bool wireWorld = rule.family == RuleFamily::WireWorld;
+        const uint64_t fades = rule.states > 2 ? ~0ull : 0;    // live cells that do not survive go to state 2
+        const uint64_t ages = rule.states > 3 ? ~0ull : 0;     // state 2 goes on to 3
+        const uint64_t* spread = spreadTable();
+
+        pack(y0 - 1);
+        pack(y0);
+        for (int y = y0; y < y1; ++y) {
+            pack(y + 1);
+            const uint64_t* u0 = plane(y - 1, 0); const uint64_t* u1 = plane(y - 1, 1);
+            const uint64_t* m0 = plane(y, 0);     const uint64_t* m1 = plane(y, 1);
+            const uint64_t* d0 = plane(y + 1, 0); const uint64_t* d1 = plane(y + 1, 1);
+
+            // Live (state 1) cells of the three rows, rolled along the words
+            uint64_t up = u0[0] & ~u1[0], mid = m0[0] & ~m1[0], down = d0[0] & ~d1[0];
+            uint64_t upPrev = 0, midPrev = 0, downPrev = 0;
+            for (int i = 0; i < words; ++i) {
+                const bool last = i + 1 == words;
+                const uint64_t upNext = last ? 0 : u0[i + 1] & ~u1[i + 1];
+                const uint64_t midNext = last ? 0 : m0[i + 1] & ~m1[i + 1];
+                const uint64_t downNext = last ? 0 : d0[i + 1] & ~d1[i + 1];
+
+                // Bit j of a west plane is the cell at j - 1, of an east plane the cell at j + 1
+                const uint64_t n[8] = {
+                    (up << 1) | (upPrev >> 63), up, (up >> 1) | (upNext << 63),
+                    (mid << 1) | (midPrev >> 63), (mid >> 1) | (midNext << 63),
+                    (down << 1) | (downPrev >> 63), down, (down >> 1) | (downNext << 63)
+                };
+
+                // Bit-sliced sum of the eight neighbour planes into count bits c0..c3
+                const uint64_t s1 = n[0] ^ n[1] ^ n[2], k1 = (n[0] & n[1]) | (n[2] & (n[0] ^ n[1]));
+                const uint64_t s2 = n[3] ^ n[4] ^ n[5], k2 = (n[3] & n[4]) | (n[5] & (n[3] ^ n[4]));
+                const uint64_t s3 = n[6] ^ n[7], k3 = n[6] & n[7];
+                const uint64_t c0 = s1 ^ s2 ^ s3, k4 = (s1 & s2) | (s3 & (s1 ^ s2));
+                const uint64_t t0 = k1 ^ k2 ^ k3, t1 = (k1 & k2) | (k3 & (k1 ^ k2));
+                const uint64_t c1 = t0 ^ k4, u = t0 & k4;
+                const uint64_t c2 = t1 ^ u, c3 = t1 & u;
+                auto inSet = [&](uint16_t set) {
+                    uint64_t m = 0;
+                    for (int k = 0; k <= 8; ++k) {
+                        if (set >> k & 1) m |= (k & 1 ? c0 : ~c0) & (k & 2 ? c1 : ~c1) & (k & 4 ? c2 : ~c2) & (k & 8 ? c3 : ~c3);
+                    }
+                    return m;
+                };
+
+                const uint64_t st0 = m0[i], st1 = m1[i];
+                const uint64_t live = st0 & ~st1, second = ~st0 & st1, third = st0 & st1;
+                if (wireWorld) {
+                    // Head -> tail -> conductor -> head when 1-2 heads are adjacent
+                    out0[i] = second | third;
+                    out1[i] = live | second | (third & ~inSet(birth));
+                }
+                else {
+                    const uint64_t born = ~st0 & ~st1 & inSet(birth);
+                    const uint64_t stay = live & inSet(survive);
+                    out0[i] = born | stay | (second & ages);
+                    out1[i] = (live & ~stay & fades) | (second & ages);
+                }
+
+                upPrev = up; midPrev = mid; downPrev = down;
+                up = upNext; mid = midNext; down = downNext;
+            }
+
+            // Unpack bits 1..width back to one byte per cell, 8 at a time
+            auto bits8 = [&](const uint64_t* p, int j) {
+                const int w = j >> 6, b = j & 63;
+                uint64_t v = p[w] >> b;
+                if (b > 56 && w + 1 < words) v |= p[w + 1] << (64 - b);
+                return v & 0xFF;
+            };
+            uint8_t* row = next + static_cast<size_t>(y - y0) * width;
+            for (int x = 0; x < width; x += 8) {
+                const uint64_t v = spread[bits8(out0, x + 1)] | (spread[bits8(out1, x + 1)] << 1);
+                std::memcpy(row + x, &v, static_cast<size_t>(std::min(8, width - x)));
+            }
+        }
+    }
+
+    void stepStatePlanes(const uint8_t* cells, uint8_t* next, int width, int height, int y0, int y1,
+                         const LifeRule& rule, Topology topology, RangeScratch& scratch) {
+        switch (topology) {
+        case Topology::Torus: stepPlanes<TopologyPolicy<Topology::Torus>>(cells, next, width, height, y0, y1, rule, scratch); break;
+        case Topology::KleinBottle: stepPlanes<TopologyPolicy<Topology::KleinBottle>>(cells, next, width, height, y0, y1, rule, scratch); break;
+        case Topology::ProjectivePlane: stepPlanes<TopologyPolicy<Topology::ProjectivePlane>>(cells, next, width, height, y0, y1, rule, scratch); break;
+        case Topology::Bounded: stepPlanes<TopologyPolicy<Topology::Bounded>>(cells, next, width, height, y0, y1, rule, scratch); break;
+        }
+    }
+
+}
@@ -0,0 +1,259 @@
+#include "../../include/core/life3d.h"
+#include "../../include/core/gameLogic.h"
+#include "../../include/utils/profiler.h"
+#include "../../include/utils/splitMix.h"
+#include "../../include/utils/threadPool.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace core {
+
+    static constexpr int kMaxNeighbours = 26;
+
+    static uint32_t countRange(int lo, int hi) {
+        uint32_t bits = 0;
+        for (int n = lo; n <= hi; ++n) bits |= 1u << n;
+        return bits;
+    }
+
+    // "4,6-8" -> bits 4, 6, 7, 8
+    static bool parseCounts(const std::string& list, uint32_t& bits) {
+        size_t i = 0;
+        auto number = [&](int& value) {
+            if (i >= list.size() || !std::isdigit(static_cast<unsigned char>(list[i]))) return false;
+            value = 0;
+            while (i < list.size() && std::isdigit(static_cast<unsigned char>(list[i]))) {
+                value = value * 10 + (list[i++] - '0');
+                if (value > kMaxNeighbours) return false;
+            }
+            return true;
+        };
+
+        bits = 0;
+        while (i < list.size()) {
+            int lo = 0, hi = 0;
+            if (!number(lo)) return false;
+            hi = lo;
+            if (i < list.size() && list[i] == '-') {
+                ++i;
+                if (!number(hi) || hi < lo) return false;
+            }
+            bits |= countRange(lo, hi);
+            if (i < list.size() && (list[i++] != ',' || i == list.size())) return false;
+        }
+        return true;
+    }
+
+    static std::string formatCounts(uint32_t bits) {
+        std::string out;
+        for (int n = 0; n <= kMaxNeighbours; ++n) {
+            if (!(bits & (1u << n))) continue;
+            int end = n;
+            while (end < kMaxNeighbours && (bits & (1u << (end + 1)))) ++end;
+            if (!out.empty()) out += ',';
+            out += std::to_string(n);
+            if (end > n) out += '-' + std::to_string(end);
+            n = end;
+        }
+        return out;
+    }
+
+    bool parseRule3D(const std::string& text, Rule3D& rule) {
+        std::string t;
+        for (char c : text) {
+            if (!std::isspace(static_cast<unsigned char>(c))) t += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+
+        // Bays: survival range then birth range, one digit each
+        if (t.size() == 4 && std::all_of(t.begin(), t.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+            const int el = t[0] - '0', eu = t[1] - '0', fl = t[2] - '0', fu = t[3] - '0';
+            if (el > eu || fl > fu) return false;
+            rule.survive = countRange(el, eu);
+            rule.birth = countRange(fl, fu);
+            return true;
+        }
+
+        const size_t slash = t.find('/');
+        if (slash == std::string::npos) return false;
+        const std::string parts[2] = { t.substr(0, slash), t.substr(slash + 1) };
+        bool haveBirth = false, haveSurvive = false;
+        Rule3D parsed;
+        for (const std::string& part : parts) {
+            if (part.empty()) return false;
+            bool& have = part[0] == 'B' ? haveBirth : haveSurvive;
+            if ((part[0] != 'B' && part[0] != 'S') || have) return false;
+            if (!parseCounts(part.substr(1), part[0] == 'B' ? parsed.birth : parsed.survive)) return false;
+            have = true;
+        }
+        rule = parsed;
+        return true;
+    }
+
+    std::string formatRule3D(const Rule3D& rule) {
+        return "B" + formatCounts(rule.birth) + "/S" + formatCounts(rule.survive);
+    }
+
+    Life3D::Life3D(int width, int height, int depth, const Rule3D& rule) :
+        width_(width),
+        height_(height),
+        depth_(depth) {
+        setRule(rule);
+
+        const size_t cells = static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(depth);
+        if (cells >= Life::kParallelCells) {
+            bands_ = static_cast<int>(std::min<size_t>(utils::ThreadPool::shared().size(), static_cast<size_t>(depth)));
+        }
+        bandLiveCells_.resize(bands_);
+        bandScratch_.resize(bands_);
+
+        // Untouched until each slab's thread zeroes it, as in Life
+        currentBuffer_.resize(cells);
+        nextBuffer_.resize(cells);
+        forEachBand([this](int, int z0, int z1) {
+            const size_t begin = index(0, 0, z0), count = index(0, 0, z1) - begin;
+            std::memset(currentBuffer_.data() + begin, 0, count);
+            std::memset(nextBuffer_.data() + begin, 0, count);
+        });
+    }
+
+    void Life3D::forEachBand(const std::function<void(int, int, int)>& body) {
+        if (bands_ == 1) {
+            body(0, 0, depth_);
+            return;
+        }
+        utils::ThreadPool::shared().forEachThread([&](size_t thread) {
+            const int band = static_cast<int>(thread);
+            if (band >= bands_) return;
+            const int z0 = static_cast<int>(static_cast<int64_t>(depth_) * band / bands_);
+            const int z1 = static_cast<int>(static_cast<int64_t>(depth_) * (band + 1) / bands_);
+            body(band, z0, z1);
+        });
+    }
+
+    void Life3D::setRule(const Rule3D& rule) {
+        rule_ = rule;
+        for (int n = 0; n < 32; ++n) {
+            table_[0][n] = (rule.birth >> n) & 1u;
+            table_[1][n] = (rule.survive >> n) & 1u;
+        }
+    }
+
+    void Life3D::clear() {
+        forEachBand([this](int, int z0, int z1) {
+            std::memset(currentBuffer_.data() + index(0, 0, z0), 0, index(0, 0, z1) - index(0, 0, z0));
+        });
+        liveCells_.clear();
+    }
+
+    void Life3D::randomFill(float density, uint64_t seed, float extent) {
+        clear();
+        extent = std::clamp(extent, 0.0f, 1.0f);
+        const int size[3] = { width_, height_, depth_ };
+        int lo[3], hi[3];
+        for (int a = 0; a < 3; ++a) {
+            const int n = std::max(1, static_cast<int>(size[a] * extent + 0.5f));
+            lo[a] = (size[a] - std::min(n, size[a])) / 2;
+            hi[a] = lo[a] + std::min(n, size[a]);
+        }
+
+        // Threshold on the top 32 bits of a counter-based draw per cell; the seed is hashed so
+        // that neighbouring seeds do not give the same volume shifted by a cell
+        const uint64_t threshold = static_cast<uint64_t>(static_cast<double>(std::clamp(density, 0.0f, 1.0f)) * 4294967296.0);
+        const uint64_t base = utils::splitMix64(seed);
+        for (int z = lo[2]; z < hi[2]; ++z) {
+            for (int y = lo[1]; y < hi[1]; ++y) {
+                for (int x = lo[0]; x < hi[0]; ++x) {
+                    const size_t i = index(x, y, z);
+                    currentBuffer_[i] = (utils::splitMix64(base + (i + 1) * utils::kSplitMixGamma) >> 32) < threshold;
+                }
+            }
+        }
+        rebuildLiveCells();
+    }
+
+    void Life3D::rebuildLiveCells() {
+        liveCells_.clear();
+        const size_t count = currentBuffer_.size();
+        for (size_t i = 0; i < count; ++i) {
+            if (currentBuffer_[i]) liveCells_.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    void Life3D::sumPlane(int z, uint8_t* rows, uint8_t* out) const {
+        const int w = width_, h = height_;
+        const uint8_t* plane = currentBuffer_.data() + index(0, 0, z);
+
+        // x pass: each cell plus its left and right neighbours
+        for (int y = 0; y < h; ++y) {
+            const uint8_t* c = plane + static_cast<size_t>(y) * w;
+            uint8_t* s = rows + static_cast<size_t>(y) * w;
+            if (w < 3) {
+                for (int x = 0; x < w; ++x) s[x] = c[(x + w - 1) % w] + c[x] + c[(x + 1) % w];
+                continue;
+            }
+            s[0] = c[w - 1] + c[0] + c[1];
+            for (int x = 1; x < w - 1; ++x) s[x] = c[x - 1] + c[x] + c[x + 1];
+            s[w - 1] = c[w - 2] + c[w - 1] + c[0];
+        }
+
+        // y pass: each row sum plus the rows above and below
+        for (int y = 0; y < h; ++y) {
+            const uint8_t* up = rows + static_cast<size_t>((y + h - 1) % h) * w;
+            const uint8_t* mid = rows + static_cast<size_t>(y) * w;
+            const uint8_t* down = rows + static_cast<size_t>((y + 1) % h) * w;
+            uint8_t* s = out + static_cast<size_t>(y) * w;
+            for (int x = 0; x < w; ++x) s[x] = up[x] + mid[x] + down[x];
+        }
+    }
+
+    void Life3D::stepSlab(int z0, int z1, std::vector<uint8_t>& scratch, std::vector<uint32_t>& live) {
+        const size_t plane = static_cast<size_t>(width_) * height_;
+        scratch.resize(4 * plane);
+        uint8_t* rows = scratch.data();
+        uint8_t* ring[3] = { rows + plane, rows + 2 * plane, rows + 3 * plane };  // sums of planes z-1, z, z+1
+
+        sumPlane((z0 + depth_ - 1) % depth_, rows, ring[0]);
+        sumPlane(z0, rows, ring[1]);
+        live.clear();
+
+        for (int z = z0; z < z1; ++z) {
+            sumPlane((z + 1) % depth_, rows, ring[2]);
+
+            // z pass: the 27-cell sum minus the cell itself, then the rule table
+            const uint8_t* cells = currentBuffer_.data() + index(0, 0, z);
+            uint8_t* out = nextBuffer_.data() + index(0, 0, z);
+            const uint8_t* below = ring[0];
+            const uint8_t* here = ring[1];
+            const uint8_t* above = ring[2];
+            for (size_t i = 0; i < plane; ++i) {
+                const uint8_t self = cells[i];
+                out[i] = table_[self][static_cast<uint8_t>(below[i] + here[i] + above[i] - self)];
+            }
+
+            const uint32_t base = static_cast<uint32_t>(index(0, 0, z));
+            for (size_t i = 0; i < plane; ++i) {
+                if (out[i]) live.push_back(base + static_cast<uint32_t>(i));
+            }
+
+            std::rotate(ring, ring + 1, ring + 3);
+        }
+    }
+
+    void Life3D::step() {
+        PROFILE_SCOPE("Life3D::step");
+        liveCells_.clear();
+
+        forEachBand([this](int band, int z0, int z1) {
+            stepSlab(z0, z1, bandScratch_[band], bands_ == 1 ? liveCells_ : bandLiveCells_[band]);
+        });
+        if (bands_ > 1) {
+            for (const std::vector<uint32_t>& live : bandLiveCells_) liveCells_.insert(liveCells_.end(), live.begin(), live.end());
+        }
+
+        std::swap(currentBuffer_, nextBuffer_);
+        ++generation_;
+    }
+
+}
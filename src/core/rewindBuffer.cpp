@@ -0,0 +1,225 @@
+#include "../../include/core/rewindBuffer.h"
+#include "../../include/core/deltaCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace core {
+
+    // Smallest arena allocation; later growth doubles it
+    static constexpr size_t kMinArenaBytes = size_t(1) << 20;
+
+    RewindBuffer::RewindBuffer(size_t capacityBytes) : capacity_(capacityBytes) {}
+
+    void RewindBuffer::setCapacity(size_t bytes) {
+        capacity_ = bytes;
+        if (bytes == 0) {
+            clear();
+            arena_ = {};
+            records_ = {};
+            return;
+        }
+
+        // Keep the newest records that fit, then compact them into a smaller arena
+        const size_t recordBytes = records_.size() * sizeof(Record);
+        if (arena_.size() + recordBytes <= bytes) return;
+
+        const size_t budget = bytes > recordBytes ? bytes - recordBytes : 0;
+        size_t keep = 0, used = 0;
+        while (keep < count_) {
+            const Record& r = at(count_ - 1 - keep);
+            const size_t size = std::max<size_t>(r.keyBytes + r.deltaBytes, 1);
+            if (used + size > budget) break;
+            used += size;
+            ++keep;
+        }
+        while (count_ > keep) popOldest();
+
+        std::vector<uint8_t> arena(std::min(budget, arena_.size()));
+        size_t pos = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            Record& r = at(i);
+            std::memcpy(arena.data() + pos, arena_.data() + r.offset, r.keyBytes + r.deltaBytes);
+            r.offset = pos;
+            pos += std::max<size_t>(r.keyBytes + r.deltaBytes, 1);
+        }
+        arena_ = std::move(arena);
+    }
+
+    void RewindBuffer::clear() {
+        first_ = 0;
+        count_ = 0;
+        sinceKeyframe_ = 0;
+    }
+
+    size_t RewindBuffer::encodeKeyframe(const uint8_t* prev, size_t count) {
+        scratch_.clear();
+        if (++sinceKeyframe_ < kKeyframeInterval) return 0;
+        sinceKeyframe_ = 0;
+        encodeCells(prev, count, scratch_, planes_);
+        return scratch_.size();
+    }
+
+    void RewindBuffer::recordStep(const uint8_t* prev, const uint8_t* next, size_t count) {
+        if (capacity_ == 0) return;
+        const size_t key = encodeKeyframe(prev, count);
+        encodeXorDelta(prev, next, count, scratch_, planes_);
+        push(key, true);
+    }
+
+    void RewindBuffer::recordEdit(const uint8_t* prev, const uint8_t* next, size_t count) {
+        if (capacity_ == 0) return;
+        const size_t key = encodeKeyframe(prev, count);
+        encodeXorDelta(prev, next, count, scratch_, planes_);
+        push(key, false);
+    }
+
+    void RewindBuffer::recordClear(const uint8_t* prev, size_t count) {
+        if (capacity_ == 0) return;
+        const size_t key = encodeKeyframe(prev, count);
+        encodeCells(prev, count, scratch_, planes_); // XOR with an empty grid
+        push(key, false);
+    }
+
+    void RewindBuffer::recordRegion(const uint8_t* before, const uint8_t* after, size_t begin, size_t end, size_t count) {
+        if (capacity_ == 0) return;
+        ++sinceKeyframe_; // a due keyframe needs the whole grid: the next full record writes it
+        scratch_.clear();
+        encodeXorDeltaRange(before, after, begin, end, count, scratch_, planes_);
+        push(0, false);
+    }
+
+    void RewindBuffer::push(size_t keyBytes, bool step) {
+        // Records never share an offset, which keeps the ring's wrap state unambiguous
+        const size_t bytes = std::max<size_t>(scratch_.size(), 1);
+
+        // The record ring itself counts against the cap
+        if (count_ == records_.size()) {
+            const size_t grown = std::max<size_t>(records_.size() * 2, 256);
+            if (arena_.size() + grown * sizeof(Record) + bytes <= capacity_) {
+                std::vector<Record> records(grown);
+                for (size_t i = 0; i < count_; ++i) records[i] = at(i);
+                records_ = std::move(records);
+                first_ = 0;
+            }
+            else if (count_ > 0) {
+                popOldest();
+            }
+        }
+
+        size_t offset = 0;
+        if (records_.empty() || !reserve(bytes, offset)) {
+            clear(); // the change does not fit at all: the history can no longer reach back
+            return;
+        }
+
+        std::memcpy(arena_.data() + offset, scratch_.data(), scratch_.size());
+        Record r;
+        r.offset = offset;
+        r.keyBytes = static_cast<uint32_t>(keyBytes);
+        r.deltaBytes = static_cast<uint32_t>(scratch_.size() - keyBytes);
+        r.step = step;
+        records_[(first_ + count_) % records_.size()] = r;
+        ++count_;
+    }
+
+    bool RewindBuffer::reserve(size_t bytes, size_t& offset) {
+        for (;;) {
+            if (count_ == 0) {
+                if (bytes <= arena_.size()) {
+                    offset = 0;
+                    return true;
+                }
+            }
+            else {
+                const Record& oldest = at(0);
+                const Record& newest = at(count_ - 1);
+                const size_t tail = oldest.offset;
+                const size_t head = newest.offset + std::max<size_t>(newest.keyBytes + newest.deltaBytes, 1);
+
+                if (newest.offset >= oldest.offset) {
+                    // Used region is [tail, head): space after it, else wrap to the start
+                    if (arena_.size() - head >= bytes) { offset = head; return true; }
+                    if (tail >= bytes) { offset = 0; return true; }
+                }
+                else if (tail - head >= bytes) {
+                    // Wrapped: free space is the gap [head, tail)
+                    offset = head;
+                    return true;
+                }
+            }
+
+            if (grow(bytes)) continue;
+            if (count_ == 0) return false;
+            popOldest();
+        }
+    }
+
+    bool RewindBuffer::grow(size_t minBytes) {
+        // Leave part of the cap for the record ring so many small changes can still be kept
+        const size_t recordReserve = std::max(records_.size() * sizeof(Record), capacity_ / 16);
+        const size_t limit = capacity_ > recordReserve ? capacity_ - recordReserve : 0;
+        size_t size = std::max(arena_.size() * 2, kMinArenaBytes);
+        while (size < minBytes) size *= 2;
+        size = std::min(size, limit);
+        if (size <= arena_.size()) return false;
+
+        // Relocate records oldest first so the ring starts unwrapped
+        std::vector<uint8_t> arena(size);
+        size_t pos = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            Record& r = at(i);
+            std::memcpy(arena.data() + pos, arena_.data() + r.offset, r.keyBytes + r.deltaBytes);
+            r.offset = pos;
+            pos += std::max<size_t>(r.keyBytes + r.deltaBytes, 1);
+        }
+        arena_ = std::move(arena);
+        return true;
+    }
+
+    void RewindBuffer::popOldest() {
+        first_ = (first_ + 1) % records_.size();
+        if (--count_ == 0) first_ = 0;
+    }
+
+    uint64_t RewindBuffer::undo(size_t n, uint8_t* cells, size_t count) {
+        n = std::min(n, count_);
+        if (n == 0) return 0;
+        const size_t target = count_ - n;
+
+        // Bytes to decode walking back from the current state...
+        size_t walkBytes = 0;
+        for (size_t i = target; i < count_; ++i) walkBytes += at(i).deltaBytes;
+
+        // ...versus decoding the first keyframe after the target and walking back from it
+        size_t key = count_, keyPathBytes = 0;
+        for (size_t i = target; i < count_; ++i) {
+            if (at(i).keyBytes) {
+                key = i;
+                keyPathBytes += at(i).keyBytes;
+                break;
+            }
+            keyPathBytes += at(i).deltaBytes;
+        }
+
+        size_t from = count_;
+        if (key < count_ && keyPathBytes < walkBytes) {
+            const Record& k = at(key);
+            std::memset(cells, 0, count);
+            applyXorDelta(arena_.data() + k.offset, k.keyBytes, cells, count, kMaxPlanes);
+            from = key;
+        }
+
+        uint64_t steps = 0;
+        for (size_t i = count_; i-- > target;) {
+            const Record& r = at(i);
+            if (i < from) applyXorDelta(arena_.data() + r.offset + r.keyBytes, r.deltaBytes, cells, count, kMaxPlanes);
+            if (r.step) ++steps;
+        }
+
+        count_ = target;
+        if (count_ == 0) first_ = 0;
+        return steps;
+    }
+
+}
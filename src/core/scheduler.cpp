@@ -0,0 +1,169 @@
+#include "../../include/core/scheduler.h"
+#include "../../include/core/simulation.h"
+#include "../../include/utils/profiler.h"
+#include "../../include/utils/threadPool.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace core {
+
+    static double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    SimulationScheduler::SimulationScheduler(double frameBudgetSeconds) : frameBudget_(frameBudgetSeconds) {
+    }
+
+    int SimulationScheduler::add(Simulation& simulation, int priority) {
+        Entry e;
+        e.id = nextId_++;
+        e.simulation = &simulation;
+        entries_.push_back(e);
+        setPriority(e.id, priority);
+        return e.id;
+    }
+
+    void SimulationScheduler::remove(int id) {
+        entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+            [id](const Entry& e) { return e.id == id; }), entries_.end());
+    }
+
+    void SimulationScheduler::setPriority(int id, int priority) {
+        Entry* e = find(id);
+        if (!e) return;
+        e->priority = std::clamp(priority, 1, kMaxPriority);
+        std::stable_sort(entries_.begin(), entries_.end(),
+            [](const Entry& a, const Entry& b) { return a.priority > b.priority; });
+    }
+
+    int SimulationScheduler::priority(int id) const {
+        const Entry* e = find(id);
+        return e ? e->priority : 0;
+    }
+
+    double SimulationScheduler::share(int id) const {
+        const Entry* e = find(id);
+        return e ? e->share : 0.0;
+    }
+
+    SimulationScheduler::Entry* SimulationScheduler::find(int id) {
+        for (Entry& e : entries_) {
+            if (e.id == id) return &e;
+        }
+        return nullptr;
+    }
+
+    const SimulationScheduler::Entry* SimulationScheduler::find(int id) const {
+        return const_cast<SimulationScheduler*>(this)->find(id);
+    }
+
+    void SimulationScheduler::advance(double dt) {
+        PROFILE_SCOPE("Scheduler::advance");
+        int rounds = 0;
+        int contenders = 0;
+        for (Entry& e : entries_) {
+            e.granted = e.simulation->takeDueSteps(dt);
+            e.frameSeconds = 0.0;
+            rounds = std::max(rounds, e.granted);
+            if (e.granted > 0) ++contenders;
+        }
+        if (rounds == 0) return;
+
+        if (contenders > 1) {
+            allocate();
+            rounds = 0;
+            for (const Entry& e : entries_) rounds = std::max(rounds, e.granted);
+        }
+        for (int round = 0; round < rounds; ++round) runRound(round);
+
+        double total = 0.0;
+        for (const Entry& e : entries_) total += e.frameSeconds;
+        if (total <= 0.0) return;
+        for (Entry& e : entries_) e.share = e.frameSeconds / total;
+    }
+
+    void SimulationScheduler::allocate() {
+        // Water-filling: simulations whose due steps fit their share are granted in full and
+        // leave the rest of the budget to the others, until the remaining ones all exceed it
+        double left = frameBudget_ * static_cast<double>(utils::ThreadPool::shared().size());
+        std::vector<Entry*> open;
+        for (Entry& e : entries_) {
+            if (e.granted > 0 && e.secondsPerStep > 0.0) open.push_back(&e); // unmeasured ones run in full once
+        }
+
+        bool settled = true;
+        while (settled && !open.empty()) {
+            settled = false;
+            int weight = 0;
+            for (const Entry* e : open) weight += e->priority;
+            const double unit = left / weight;
+            for (size_t i = 0; i < open.size();) {
+                const double need = open[i]->granted * open[i]->secondsPerStep;
+                if (need <= unit * open[i]->priority) {
+                    left -= need;
+                    open[i] = open.back();
+                    open.pop_back();
+                    settled = true;
+                } else {
+                    ++i;
+                }
+            }
+        }
+
+        int weight = 0;
+        for (const Entry* e : open) weight += e->priority;
+        for (Entry* e : open) {
+            const double share = std::max(0.0, left) * e->priority / weight;
+            const int steps = static_cast<int>(share / e->secondsPerStep);
+            e->granted = std::clamp(steps, 1, e->granted);
+        }
+    }
+
+    void SimulationScheduler::runRound(int round) {
+        participants_.clear();
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (entries_[i].granted > round) participants_.push_back(i);
+        }
+        utils::ThreadPool& pool = utils::ThreadPool::shared();
+        auto record = [](Entry& e, double seconds) {
+            e.frameSeconds += seconds;
+            e.secondsPerStep = e.secondsPerStep > 0.0 ? 0.8 * e.secondsPerStep + 0.2 * seconds : seconds;
+        };
+
+        // Alone, the simulation keeps its bands on their own threads (see Life::bands())
+        if (participants_.size() == 1) {
+            Entry& e = entries_[participants_[0]];
+            const auto start = std::chrono::steady_clock::now();
+            e.simulation->stepOnce();
+            const size_t threads = std::min(pool.size(), static_cast<size_t>(e.simulation->bands()));
+            record(e, secondsSince(start) * static_cast<double>(threads));
+            return;
+        }
+
+        jobs_.clear();
+        for (size_t i : participants_) {
+            Simulation& s = *entries_[i].simulation;
+            s.beginStep();
+            for (int band = 0; band < s.bands(); ++band) jobs_.emplace_back(i, band);
+        }
+        jobSeconds_.assign(jobs_.size(), 0.0);
+        pool.parallelFor(jobs_.size(), [this](size_t job) {
+            const auto start = std::chrono::steady_clock::now();
+            entries_[jobs_[job].first].simulation->stepBand(jobs_[job].second);
+            jobSeconds_[job] = secondsSince(start);
+        });
+
+        // Uploads and listeners need the GL thread; jobs are grouped by entry
+        size_t job = 0;
+        for (size_t i : participants_) {
+            Entry& e = entries_[i];
+            double seconds = 0.0;
+            for (; job < jobs_.size() && jobs_[job].first == i; ++job) seconds += jobSeconds_[job];
+            const auto start = std::chrono::steady_clock::now();
+            e.simulation->endStep();
+            record(e, seconds + secondsSince(start));
+        }
+    }
+
+}
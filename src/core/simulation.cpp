@@ -1,6 +1,9 @@
 #include "../../include/core/simulation.h"
+#include "../../include/utils/profiler.h"
 
 #include <algorithm>
+#include <cstring>
+#include <utility>
 
 namespace core {
 
@@ -13,44 +16,218 @@ namespace core {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width_, height_, 0, GL_RED, GL_UNSIGNED_BYTE, life_.data());
+
+        glGenBuffers(1, &liveBuf_);
     }
 
     Simulation::~Simulation() {
+        if (labelTex_) glDeleteTextures(1, &labelTex_);
+        if (ageTex_) glDeleteTextures(1, &ageTex_);
+        if (liveBuf_) glDeleteBuffers(1, &liveBuf_);
         if (tex_) glDeleteTextures(1, &tex_);
     }
 
+    void Simulation::setLiveCellsEnabled(bool enabled) {
+        life_.setLiveCellsEnabled(enabled);
+        uploadLiveCells();
+    }
+
+    void Simulation::setAgeEnabled(bool enabled) {
+        life_.setAgeEnabled(enabled);
+        if (enabled) {
+            allocateAgeTexture();
+        }
+        else if (ageTex_) {
+            glDeleteTextures(1, &ageTex_);
+            ageTex_ = 0;
+        }
+    }
+
+    void Simulation::setLabelsEnabled(bool enabled) {
+        if (enabled == labelsEnabled()) return;
+        if (enabled) {
+            labeler_ = std::make_unique<ComponentLabeler>();
+            allocateLabelTexture();
+            labelsDirty_ = true;
+        }
+        else {
+            labeler_.reset();
+            glDeleteTextures(1, &labelTex_);
+            labelTex_ = 0;
+        }
+    }
+
+    void Simulation::updateLabels() {
+        if (!labeler_ || !labelsDirty_) return;
+        labelsDirty_ = false;
+        labeler_->label(life_.data(), width_, height_, life_.topology());
+
+        PROFILE_SCOPE("Upload labels");
+        glBindTexture(GL_TEXTURE_2D, labelTex_);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width_, height_, GL_RED, GL_UNSIGNED_BYTE, labeler_->colorIndices().data());
+    }
+
     void Simulation::setStepsPerSecond(float sps) {
         stepsPerSec_ = (sps <= 0.0f) ? 0.0001f : sps;
     }
 
-    void Simulation::advance(double dt) {
-        if (!running_) return;
+    double Simulation::secondsToNextStep() const {
+        if (!running_ && !rewinding_) return -1.0;
+        const double period = 1.0 / std::max(0.0001, (double)stepsPerSec_);
+        return std::max(0.0, period - accumulator_);
+    }
+
+    int Simulation::takeDueSteps(double dt) {
+        if (!running_ && !rewinding_) return 0;
         accumulator_ += dt;
         const double period = 1.0 / std::max(0.0001, (double)stepsPerSec_);
         int steps = 0;
         while (accumulator_ >= period && steps < 240) { // prevents "spiral of death" (no drawing if there are more than 240 steps per frame)
-            life_.step();
-            uploadAll();
             accumulator_ -= period;
             ++steps;
         }
+
+        // Rewinding undoes the whole batch at once so it can start from a keyframe
+        if (rewinding_) {
+            if (steps > 0) {
+                undo(static_cast<size_t>(steps));
+                if (rewind_.depth() == 0) rewinding_ = false;
+            }
+            return 0;
+        }
+        return steps;
+    }
+
+    void Simulation::advance(double dt) {
+        const int steps = takeDueSteps(dt);
+        for (int i = 0; i < steps; ++i) stepOnce();
     }
 
     void Simulation::stepOnce() {
         life_.step();
+        finishStep();
+    }
+
+    void Simulation::endStep() {
+        life_.endStep();
+        finishStep();
+    }
+
+    bool Simulation::stepBack() {
+        if (rewind_.depth() == 0) return false;
+        undo(1);
+        return true;
+    }
+
+    void Simulation::finishStep() {
+        ++generation_;
+        if (const uint8_t* previous = life_.previousData()) rewind_.recordStep(previous, life_.data(), static_cast<size_t>(width_) * height_);
+        else rewind_.clear(); // nothing to diff an in-place step against, and older records no longer lead here
         uploadAll();
+        notify(FrameChange::Step);
+    }
+
+    void Simulation::undo(size_t n) {
+        generation_ -= rewind_.undo(n, life_.data(), static_cast<size_t>(width_) * height_);
+        life_.rebuildLiveCells();
+        life_.resetAge(); // ages are not part of the history
+        uploadAll();
+        notify(FrameChange::Edit);
+    }
+
+    void Simulation::setRule(const LifeRule& rule) {
+        const size_t count = static_cast<size_t>(width_) * height_;
+        uint8_t* cells = life_.data();
+        if (std::any_of(cells, cells + count, [&](uint8_t c) { return c >= rule.states; })) {
+            editBefore_.assign(cells, cells + count);
+            for (size_t i = 0; i < count; ++i) {
+                if (cells[i] >= rule.states) cells[i] = 0;
+            }
+            rewind_.recordEdit(editBefore_.data(), cells, count);
+            life_.rebuildLiveCells();
+            uploadAll();
+            notify(FrameChange::Edit);
+        }
+        rewind_.setPlanes(rule.states > 2 ? 2 : 1);
+        life_.setRule(rule);
     }
 
     void Simulation::clear() {
+        rewind_.recordClear(life_.data(), static_cast<size_t>(width_) * height_);
         life_.clear();
         uploadAll();
+        notify(FrameChange::Edit);
+    }
+
+    void Simulation::setCells(const uint8_t* cells) {
+        rewind_.recordEdit(life_.data(), cells, static_cast<size_t>(width_) * height_);
+        std::copy(cells, cells + static_cast<size_t>(width_) * height_, life_.data());
+        life_.rebuildLiveCells();
+        life_.resetAge();
+        uploadAll();
+        notify(FrameChange::Edit);
+    }
+
+    int Simulation::addFrameListener(FrameListener listener) {
+        const int id = nextListenerId_++;
+        listeners_.emplace_back(id, std::move(listener));
+        return id;
+    }
+
+    void Simulation::removeFrameListener(int id) {
+        listeners_.erase(std::remove_if(listeners_.begin(), listeners_.end(),
+            [id](const std::pair<int, FrameListener>& l) { return l.first == id; }), listeners_.end());
+    }
+
+    uint64_t Simulation::snapshot(Life::Buffer& spare) {
+        if (previousIsParent_) {
+            life_.swapPrevious(spare);
+            previousIsParent_ = false;
+            return generation_ - 1;
+        }
+        spare.resize(static_cast<size_t>(width_) * height_);
+        std::copy(life_.data(), life_.data() + spare.size(), spare.data());
+        return generation_;
+    }
+
+    void Simulation::notify(FrameChange change) {
+        // Any other change leaves the work buffer stale; in-place steps have none
+        previousIsParent_ = change == FrameChange::Step && life_.previousData() != nullptr;
+        for (auto& l : listeners_) l.second(life_, generation_, change);
     }
 
     void Simulation::toggleCell(int x, int y) {
-        if (x < 0 || y < 0 || x >= width_ || y >= height_) return;
-        uint8_t& v = life_.at(x, y);
-        v ^= 1;
-        uploadCell(x, y);
+        edits_.toggle(x, y);
+        applyEdits();
+    }
+
+    void Simulation::applyEdits() {
+        if (edits_.empty()) return;
+        PROFILE_SCOPE("Apply edits");
+
+        const CellRect r = edits_.bounds(width_, height_);
+        if (r.empty()) {
+            edits_.clear();
+            return;
+        }
+
+        // Whole rows keep the saved span contiguous for the rewind delta
+        const size_t begin = static_cast<size_t>(r.y0) * width_;
+        const size_t end = static_cast<size_t>(r.y1) * width_;
+        uint8_t* cells = life_.data();
+        editBefore_.assign(cells + begin, cells + end);
+        edits_.apply(cells, width_, height_);
+        edits_.clear();
+        if (std::memcmp(editBefore_.data(), cells + begin, end - begin) == 0) return;
+
+        rewind_.recordRegion(editBefore_.data(), cells + begin, begin, end, static_cast<size_t>(width_) * height_);
+        life_.touchAgeRange(editBefore_.data(), begin, end);
+        life_.rebuildLiveCells();
+
+        uploadRegion(r);
+        uploadLiveCells();
+        notify(FrameChange::Edit);
     }
 
     void Simulation::resize(int newW, int newH) {
@@ -61,6 +238,11 @@ namespace core {
         width_ = newW;
         height_ = newH;
         life_ = Life(width_, height_);
+        life_.setRule(old.rule());
+        life_.setTopology(old.topology());
+        life_.setLiveCellsEnabled(old.liveCellsEnabled());
+        life_.setAgeEnabled(old.ageEnabled());
+        life_.setInPlace(old.inPlace());
 
         int copyW = std::min(oldW, width_);
         int copyH = std::min(oldH, height_);
@@ -72,22 +254,117 @@ namespace core {
             }
         }
 
+        onGridReplaced();
+    }
+
+    void Simulation::replace(Life&& life) {
+        const bool liveCells = life_.liveCellsEnabled();
+        const bool age = life_.ageEnabled();
+        const LifeRule rule = life_.rule();
+        const Topology topology = life_.topology();
+        const bool inPlace = life_.inPlace();
+
+        life_ = std::move(life);
+        width_ = life_.gridWidth_;
+        height_ = life_.gridHeight_;
+        life_.setRule(rule);
+        life_.setTopology(topology);
+        life_.setLiveCellsEnabled(liveCells);
+        life_.setAgeEnabled(age);
+        life_.setInPlace(inPlace);
+
+        onGridReplaced();
+    }
+
+    void Simulation::onGridReplaced() {
         glBindTexture(GL_TEXTURE_2D, tex_);
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width_, height_, 0, GL_RED, GL_UNSIGNED_BYTE, life_.data());
         accumulator_ = 0.0;
+        rewind_.clear();     // deltas of another grid size cannot be applied
+        rewinding_ = false;
+
+        life_.rebuildLiveCells();
+        uploadLiveCells();
+
+        life_.resetAge();
+        if (life_.ageEnabled()) allocateAgeTexture();
+        if (labelTex_) allocateLabelTexture();
+        labelsDirty_ = true;
+
+        notify(FrameChange::Reset);
     }
 
     void Simulation::uploadAll() {
+        PROFILE_SCOPE("Upload textures");
         glBindTexture(GL_TEXTURE_2D, tex_);
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
         glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width_, height_, GL_RED, GL_UNSIGNED_BYTE, life_.data());
+
+        if (ageTex_) {
+            glBindTexture(GL_TEXTURE_2D, ageTex_);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width_, height_, GL_RED, GL_UNSIGNED_BYTE, life_.ageData());
+        }
+
+        uploadLiveCells();
+        labelsDirty_ = true;
     }
 
-    void Simulation::uploadCell(int x, int y) {
-        glBindTexture(GL_TEXTURE_2D, tex_);
+    void Simulation::allocateAgeTexture() {
+        if (!ageTex_) {
+            glGenTextures(1, &ageTex_);
+            glBindTexture(GL_TEXTURE_2D, ageTex_);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        }
+        glBindTexture(GL_TEXTURE_2D, ageTex_);
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 1, 1, GL_RED, GL_UNSIGNED_BYTE, &life_.at(x, y));
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width_, height_, 0, GL_RED, GL_UNSIGNED_BYTE, life_.ageData());
+    }
+
+    void Simulation::allocateLabelTexture() {
+        if (!labelTex_) {
+            glGenTextures(1, &labelTex_);
+            glBindTexture(GL_TEXTURE_2D, labelTex_);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        }
+        glBindTexture(GL_TEXTURE_2D, labelTex_);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width_, height_, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    void Simulation::uploadLiveCells() {
+        PROFILE_SCOPE("Upload live cells");
+        const std::vector<uint32_t>& cells = life_.liveCells();
+        liveCount_ = static_cast<GLsizei>(cells.size());
+        if (!life_.liveCellsEnabled()) return;
+
+        // Orphan and refill so the driver never waits on the previous frame's instances
+        glBindBuffer(GL_ARRAY_BUFFER, liveBuf_);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(cells.size() * sizeof(uint32_t)), cells.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void Simulation::uploadRegion(const CellRect& r) {
+        PROFILE_SCOPE("Upload region");
+        const size_t first = static_cast<size_t>(r.y0) * width_ + r.x0;
+
+        // Rows of the sub-rectangle are width_ apart in the CPU buffers
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, width_);
+        glBindTexture(GL_TEXTURE_2D, tex_);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, r.x0, r.y0, r.x1 - r.x0, r.y1 - r.y0, GL_RED, GL_UNSIGNED_BYTE, life_.data() + first);
+
+        if (ageTex_) {
+            glBindTexture(GL_TEXTURE_2D, ageTex_);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, r.x0, r.y0, r.x1 - r.x0, r.y1 - r.y0, GL_RED, GL_UNSIGNED_BYTE, life_.ageData() + first);
+        }
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        labelsDirty_ = true; // an edit can join or split components anywhere they reach
     }
 
 }
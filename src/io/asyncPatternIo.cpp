@@ -0,0 +1,54 @@
+#include "../../include/io/asyncPatternIo.h"
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace io {
+
+    AsyncPatternIo::~AsyncPatternIo() {
+        if (job_.valid()) job_.wait();
+    }
+
+    bool AsyncPatternIo::load(const std::string& path, const ImportOptions& opt) {
+        if (busy()) return false;
+        job_ = std::async(std::launch::async, [path, opt]() {
+            PatternIoResult r{};
+            try {
+                r.life.emplace(loadPattern(path, opt));
+                r.ok = true;
+                r.message = "Loaded " + path;
+            }
+            catch (const std::exception& e) {
+                r.message = e.what();
+            }
+            return r;
+        });
+        return true;
+    }
+
+    bool AsyncPatternIo::save(const std::string& path, core::Life snapshot) {
+        if (busy()) return false;
+        job_ = std::async(std::launch::async, [path, life = std::move(snapshot)]() {
+            PatternIoResult r{};
+            try {
+                savePattern(path, life);
+                r.ok = true;
+                r.message = "Saved " + path;
+            }
+            catch (const std::exception& e) {
+                r.message = e.what();
+            }
+            return r;
+        });
+        return true;
+    }
+
+    bool AsyncPatternIo::poll(PatternIoResult& out) {
+        if (!job_.valid()) return false;
+        if (job_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+        out = job_.get();
+        return true;
+    }
+
+}
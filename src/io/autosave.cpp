@@ -0,0 +1,42 @@
+#include "../../include/io/autosave.h"
+#include "../../include/io/snapshot.h"
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace io {
+
+    Autosaver::~Autosaver() {
+        if (job_.valid()) job_.wait();
+    }
+
+    bool Autosaver::save(const std::string& path, int width, int height, uint64_t generation, const core::LifeRule& rule) {
+        if (busy()) return false;
+        job_ = std::async(std::launch::async, [path, width, height, generation, rule, cells = std::move(buffer_)]() mutable {
+            Job job{};
+            job.result.generation = generation;
+            try {
+                saveSnapshotDurable(path.c_str(), cells.data(), width, height, rule);
+                job.result.ok = true;
+                job.result.message = "Autosaved generation " + std::to_string(generation) + " to " + path;
+            }
+            catch (const std::exception& e) {
+                job.result.message = e.what();
+            }
+            job.cells = std::move(cells);
+            return job;
+        });
+        return true;
+    }
+
+    bool Autosaver::poll(AutosaveResult& out) {
+        if (!job_.valid()) return false;
+        if (job_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+        Job job = job_.get();
+        buffer_ = std::move(job.cells);
+        out = std::move(job.result);
+        return true;
+    }
+
+}
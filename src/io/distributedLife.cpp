@@ -0,0 +1,144 @@
+#include "../../include/io/distributedLife.h"
+#include "../../include/utils/profiler.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace io {
+
+    DistributedLife::DistributedLife(const core::DomainLayout& layout, int halo, Transport& transport)
+        : layout_(layout), transport_(transport), sub_(layout.rect(transport.rank()), halo) {
+        if (layout.ranks() != transport.ranks()) {
+            throw std::runtime_error("Layout has " + std::to_string(layout.ranks()) + " subdomains but the transport connects " +
+                std::to_string(transport.ranks()) + " ranks");
+        }
+        if (halo > layout.maxHalo()) {
+            throw std::runtime_error("Halo of " + std::to_string(halo) + " cells exceeds the smallest subdomain (max " +
+                std::to_string(layout.maxHalo()) + ")");
+        }
+    }
+
+    std::vector<int> DistributedLife::peers(const core::DomainLayout& layout, int rank) {
+        std::vector<int> result;
+        if (rank == 0) {
+            for (int r = 1; r < layout.ranks(); ++r) result.push_back(r);
+            return result;
+        }
+        const int candidates[] = { 0, layout.neighbour(rank, -1, 0), layout.neighbour(rank, 1, 0),
+                                   layout.neighbour(rank, 0, -1), layout.neighbour(rank, 0, 1) };
+        for (int p : candidates) {
+            if (p != rank && std::find(result.begin(), result.end(), p) == result.end()) result.push_back(p);
+        }
+        return result;
+    }
+
+    void DistributedLife::scatter(const core::Life* life) {
+        const int rank = transport_.rank();
+        const size_t ownBytes = static_cast<size_t>(sub_.rect().width) * sub_.rect().height;
+        if (rank != 0) {
+            parts_.resize(ownBytes);
+            transport_.exchange({}, { { 0, parts_.data(), ownBytes } });
+            sub_.setInterior(parts_.data());
+            return;
+        }
+
+        if (!life || life->gridWidth_ != layout_.gridWidth() || life->gridHeight_ != layout_.gridHeight()) {
+            throw std::runtime_error("scatter() needs a grid of the layout's size on rank 0");
+        }
+
+        // Cut every other rank's rectangle out of the grid, then send them all at once
+        std::vector<SendBuffer> sends;
+        size_t total = 0;
+        for (int r = 1; r < layout_.ranks(); ++r) total += static_cast<size_t>(layout_.rect(r).width) * layout_.rect(r).height;
+        parts_.resize(total);
+        size_t offset = 0;
+        for (int r = 1; r < layout_.ranks(); ++r) {
+            core::Subdomain part(layout_.rect(r), 1);
+            part.loadFrom(life->data(), layout_.gridWidth());
+            const size_t bytes = static_cast<size_t>(part.rect().width) * part.rect().height;
+            part.copyInterior(parts_.data() + offset);
+            sends.push_back({ r, parts_.data() + offset, bytes });
+            offset += bytes;
+        }
+        sub_.loadFrom(life->data(), layout_.gridWidth());
+        transport_.exchange(sends, {});
+    }
+
+    void DistributedLife::gather(core::Life* life) {
+        PROFILE_SCOPE("Gather");
+        const int rank = transport_.rank();
+        if (rank != 0) {
+            parts_.resize(static_cast<size_t>(sub_.rect().width) * sub_.rect().height);
+            sub_.copyInterior(parts_.data());
+            transport_.exchange({ { 0, parts_.data(), parts_.size() } }, {});
+            return;
+        }
+
+        if (!life || life->gridWidth_ != layout_.gridWidth() || life->gridHeight_ != layout_.gridHeight()) {
+            throw std::runtime_error("gather() needs a grid of the layout's size on rank 0");
+        }
+
+        std::vector<ReceiveBuffer> receives;
+        size_t total = 0;
+        for (int r = 1; r < layout_.ranks(); ++r) total += static_cast<size_t>(layout_.rect(r).width) * layout_.rect(r).height;
+        parts_.resize(total);
+        size_t offset = 0;
+        for (int r = 1; r < layout_.ranks(); ++r) {
+            const size_t bytes = static_cast<size_t>(layout_.rect(r).width) * layout_.rect(r).height;
+            receives.push_back({ r, parts_.data() + offset, bytes });
+            offset += bytes;
+        }
+        transport_.exchange({}, receives);
+
+        // Copy each interior into place (rows of a rectangle are gridWidth apart)
+        uint8_t* grid = life->data();
+        const int gridW = layout_.gridWidth();
+        sub_.storeTo(grid, gridW);
+        offset = 0;
+        for (int r = 1; r < layout_.ranks(); ++r) {
+            const core::DomainRect rect = layout_.rect(r);
+            for (int y = 0; y < rect.height; ++y) {
+                std::copy_n(parts_.data() + offset + static_cast<size_t>(y) * rect.width, rect.width,
+                    grid + static_cast<size_t>(rect.y + y) * gridW + rect.x);
+            }
+            offset += static_cast<size_t>(rect.width) * rect.height;
+        }
+        life->rebuildLiveCells();
+        life->resetAge();
+    }
+
+    void DistributedLife::step(uint64_t generations) {
+        while (generations > 0) {
+            const int batch = static_cast<int>(std::min<uint64_t>(generations, static_cast<uint64_t>(sub_.halo())));
+            exchangeHalos();
+            sub_.step(batch);
+            generations -= static_cast<uint64_t>(batch);
+            generation_ += static_cast<uint64_t>(batch);
+        }
+    }
+
+    void DistributedLife::exchangeHalos() {
+        PROFILE_SCOPE("Halo exchange");
+        const int rank = transport_.rank();
+
+        // Our west strip is the west neighbour's east halo and vice versa. Receiving the
+        // east halo first keeps this right when both neighbours are the same rank (or us):
+        // that rank sends its west strip before its east strip.
+        auto phase = [&](core::Side low, core::Side high, int lowPeer, int highPeer) {
+            outA_.resize(sub_.stripBytes(low));
+            outB_.resize(sub_.stripBytes(high));
+            inA_.resize(outB_.size());
+            inB_.resize(outA_.size());
+            sub_.packEdge(low, outA_.data());
+            sub_.packEdge(high, outB_.data());
+            transport_.exchange({ { lowPeer, outA_.data(), outA_.size() }, { highPeer, outB_.data(), outB_.size() } },
+                                { { highPeer, inA_.data(), inA_.size() }, { lowPeer, inB_.data(), inB_.size() } });
+            sub_.unpackHalo(high, inA_.data());
+            sub_.unpackHalo(low, inB_.data());
+        };
+        phase(core::Side::West, core::Side::East, layout_.neighbour(rank, -1, 0), layout_.neighbour(rank, 1, 0));
+        phase(core::Side::South, core::Side::North, layout_.neighbour(rank, 0, -1), layout_.neighbour(rank, 0, 1));
+    }
+
+}
@@ -0,0 +1,97 @@
+#include "../../include/io/imageWriter.h"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace io {
+
+    static void putU32(uint8_t* p, uint32_t v) {
+        p[0] = static_cast<uint8_t>(v >> 24);
+        p[1] = static_cast<uint8_t>(v >> 16);
+        p[2] = static_cast<uint8_t>(v >> 8);
+        p[3] = static_cast<uint8_t>(v);
+    }
+
+    // Length, type, data, CRC of type + data
+    static bool writeChunk(std::FILE* f, const char* type, const uint8_t* data, size_t size) {
+        uint8_t head[8];
+        putU32(head, static_cast<uint32_t>(size));
+        std::memcpy(head + 4, type, 4);
+
+        uLong crc = crc32(0L, Z_NULL, 0);
+        crc = crc32(crc, head + 4, 4);
+        if (size) crc = crc32(crc, data, static_cast<uInt>(size));
+        uint8_t tail[4];
+        putU32(tail, static_cast<uint32_t>(crc));
+
+        return std::fwrite(head, 1, 8, f) == 8
+            && (size == 0 || std::fwrite(data, 1, size, f) == size)
+            && std::fwrite(tail, 1, 4, f) == 4;
+    }
+
+    void writePng(const std::string& path, const uint8_t* rgba, int width, int height, bool bottomUp, std::vector<uint8_t>& scratch) {
+        const size_t stride = static_cast<size_t>(width) * 4;
+
+        // Stream rows (filter byte 0 + pixels) through deflate without building the filtered image
+        z_stream zs{};
+        if (deflateInit(&zs, 1) != Z_OK) throw std::runtime_error("deflateInit failed");
+        scratch.resize(deflateBound(&zs, static_cast<uLong>((stride + 1) * height))); // for this stream's level and header
+        zs.next_out = scratch.data();
+        zs.avail_out = static_cast<uInt>(scratch.size());
+
+        uint8_t filter = 0;
+        int rc = Z_OK;
+        for (int y = 0; y < height && rc == Z_OK; ++y) {
+            const uint8_t* row = rgba + stride * static_cast<size_t>(bottomUp ? height - 1 - y : y);
+            zs.next_in = &filter;
+            zs.avail_in = 1;
+            rc = deflate(&zs, Z_NO_FLUSH);
+            if (rc != Z_OK) break;
+            zs.next_in = const_cast<Bytef*>(row);
+            zs.avail_in = static_cast<uInt>(stride);
+            rc = deflate(&zs, Z_NO_FLUSH);
+        }
+        if (rc == Z_OK) rc = deflate(&zs, Z_FINISH);
+        const size_t compressed = zs.total_out;
+        deflateEnd(&zs);
+        if (rc != Z_STREAM_END) throw std::runtime_error("PNG compression failed: " + path);
+
+        uint8_t ihdr[13];
+        putU32(ihdr, static_cast<uint32_t>(width));
+        putU32(ihdr + 4, static_cast<uint32_t>(height));
+        ihdr[8] = 8;   // bit depth
+        ihdr[9] = 6;   // colour type RGBA
+        ihdr[10] = 0;  // deflate
+        ihdr[11] = 0;  // adaptive filtering (all rows use filter 0)
+        ihdr[12] = 0;  // no interlace
+
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) throw std::runtime_error("Cannot write " + path);
+        static const uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        const bool ok = std::fwrite(kSignature, 1, 8, f) == 8
+            && writeChunk(f, "IHDR", ihdr, sizeof(ihdr))
+            && writeChunk(f, "IDAT", scratch.data(), compressed)
+            && writeChunk(f, "IEND", nullptr, 0);
+        if (std::fclose(f) != 0 || !ok) throw std::runtime_error("Failed writing " + path);
+    }
+
+    void writeRaw(const std::string& path, const uint8_t* rgba, int width, int height, bool bottomUp) {
+        const size_t stride = static_cast<size_t>(width) * 4;
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) throw std::runtime_error("Cannot write " + path);
+
+        bool ok = true;
+        if (!bottomUp) {
+            ok = std::fwrite(rgba, 1, stride * height, f) == stride * height;
+        }
+        else {
+            for (int y = height - 1; y >= 0 && ok; --y) {
+                ok = std::fwrite(rgba + stride * static_cast<size_t>(y), 1, stride, f) == stride;
+            }
+        }
+        if (std::fclose(f) != 0 || !ok) throw std::runtime_error("Failed writing " + path);
+    }
+
+}
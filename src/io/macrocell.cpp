@@ -0,0 +1,285 @@
+#include "../../include/io/macrocell.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace io {
+
+    namespace {
+
+        // Quadtree node as read from the file; leaves (level 3) are 8x8 bitmaps
+        struct Node {
+            int level = 0;
+            uint32_t child[4] = {0, 0, 0, 0}; // nw, ne, sw, se (0 = empty)
+            uint64_t leaf = 0;                 // bit (row * 8 + col), row 0 on top
+        };
+
+        // Live-cell bounding box relative to the node origin
+        struct Box {
+            bool empty = true;
+            long long minX = 0, minY = 0, maxX = 0, maxY = 0;
+            bool done = false; // memoized
+        };
+
+        struct FileCloser {
+            void operator()(FILE* f) const { if (f) std::fclose(f); }
+        };
+
+        uint64_t parseLeaf(const std::string& line) {
+            uint64_t bits = 0;
+            int row = 0, col = 0;
+            for (char c : line) {
+                if (c == '$') { ++row; col = 0; continue; }
+                if (c == '*' && row < 8 && col < 8) bits |= 1ull << (row * 8 + col);
+                if (c == '*' || c == '.') ++col;
+            }
+            return bits;
+        }
+
+        class Reader {
+        public:
+            std::vector<Node> nodes_{Node{}}; // index 0 is the empty node
+            std::vector<Box> boxes_;
+
+            Box box(uint32_t id) {
+                if (id == 0 || boxes_[id].done) return boxes_[id];
+
+                const Node& n = nodes_[id];
+                Box b{};
+                if (n.level == 3) {
+                    for (int i = 0; i < 64; ++i) {
+                        if (!(n.leaf >> i & 1ull)) continue;
+                        const long long x = i & 7, y = i >> 3;
+                        if (b.empty) { b = {false, x, y, x, y, false}; continue; }
+                        b.minX = std::min(b.minX, x); b.maxX = std::max(b.maxX, x);
+                        b.minY = std::min(b.minY, y); b.maxY = std::max(b.maxY, y);
+                    }
+                }
+                else {
+                    const long long half = 1ll << (n.level - 1);
+                    for (int q = 0; q < 4; ++q) {
+                        if (!n.child[q]) continue;
+                        Box c = box(n.child[q]);
+                        if (c.empty) continue;
+                        const long long ox = (q & 1) ? half : 0, oy = (q & 2) ? half : 0;
+                        c.minX += ox; c.maxX += ox; c.minY += oy; c.maxY += oy;
+                        if (b.empty) { b = c; continue; }
+                        b.minX = std::min(b.minX, c.minX); b.maxX = std::max(b.maxX, c.maxX);
+                        b.minY = std::min(b.minY, c.minY); b.maxY = std::max(b.maxY, c.maxY);
+                    }
+                }
+                b.done = true;
+                boxes_[id] = b;
+                return b;
+            }
+
+            // Paint node id whose top-left is (ox, oy) in tree space
+            void paint(uint32_t id, long long ox, long long oy, const Box& root, long long offX, long long topY, core::Life& life) {
+                if (!id) return;
+                const Node& n = nodes_[id];
+                if (n.level == 3) {
+                    uint8_t* cells = life.data();
+                    for (int i = 0; i < 64; ++i) {
+                        if (!(n.leaf >> i & 1ull)) continue;
+                        const long long x = offX + (ox + (i & 7) - root.minX);
+                        const long long y = topY - (oy + (i >> 3) - root.minY);
+                        if (x >= 0 && y >= 0 && x < life.gridWidth_ && y < life.gridHeight_) {
+                            cells[static_cast<size_t>(y) * life.gridWidth_ + x] = 1;
+                        }
+                    }
+                    return;
+                }
+                const long long half = 1ll << (n.level - 1);
+                for (int q = 0; q < 4; ++q) {
+                    paint(n.child[q], ox + ((q & 1) ? half : 0), oy + ((q & 2) ? half : 0), root, offX, topY, life);
+                }
+            }
+        };
+
+    }
+
+    core::Life readMacrocell(const char* path, const ImportOptions& opt) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error(std::string("Cannot open: ") + path);
+
+        Reader r;
+        std::string line;
+        bool first = true;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (first) {
+                if (line.compare(0, 4, "[M2]") != 0) throw std::runtime_error(std::string("Not a Macrocell file: ") + path);
+                first = false;
+                continue;
+            }
+            if (line.empty() || line[0] == '#') continue;
+
+            Node n{};
+            if (line[0] == '.' || line[0] == '*' || line[0] == '$') {
+                n.level = 3;
+                n.leaf = parseLeaf(line);
+            }
+            else {
+                long long v[5] = {0, 0, 0, 0, 0};
+                if (std::sscanf(line.c_str(), "%lld %lld %lld %lld %lld", &v[0], &v[1], &v[2], &v[3], &v[4]) != 5) {
+                    throw std::runtime_error(std::string("Bad Macrocell node line in: ") + path);
+                }
+                if (v[0] < 4 || v[0] > 62) {
+                    throw std::runtime_error(std::string("Unsupported Macrocell node (only two-state patterns are supported): ") + path);
+                }
+                n.level = (int)v[0];
+                for (int q = 0; q < 4; ++q) {
+                    if (v[q + 1] < 0 || v[q + 1] >= (long long)r.nodes_.size() ||
+                        (v[q + 1] && r.nodes_[(size_t)v[q + 1]].level != n.level - 1)) {
+                        throw std::runtime_error(std::string("Bad Macrocell child reference in: ") + path);
+                    }
+                    n.child[q] = (uint32_t)v[q + 1];
+                }
+            }
+            r.nodes_.push_back(n);
+        }
+        if (first) throw std::runtime_error(std::string("Empty Macrocell file: ") + path);
+
+        const uint32_t rootId = (uint32_t)(r.nodes_.size() - 1);
+        r.boxes_.assign(r.nodes_.size(), Box{});
+        const Box root = rootId ? r.box(rootId) : Box{};
+
+        const long long patW = root.empty ? 0 : root.maxX - root.minX + 1;
+        const long long patH = root.empty ? 0 : root.maxY - root.minY + 1;
+
+        int gridW = 0, gridH = 0;
+        importGridSize(patW, patH, opt, gridW, gridH);
+        core::Life life(gridW, gridH);
+
+        if (!root.empty) {
+            const long long offX = (gridW - patW) / 2;
+            const long long topY = (gridH - patH) / 2 + patH - 1;
+            r.paint(rootId, 0, 0, root, offX, topY, life);
+        }
+
+        life.rebuildLiveCells();
+        life.resetAge();
+        return life;
+    }
+
+    namespace {
+
+        struct QuadKey {
+            uint32_t c[4];
+            bool operator==(const QuadKey& o) const {
+                return c[0] == o.c[0] && c[1] == o.c[1] && c[2] == o.c[2] && c[3] == o.c[3];
+            }
+        };
+
+        struct QuadKeyHash {
+            size_t operator()(const QuadKey& k) const {
+                uint64_t h = 1469598103934665603ull;
+                for (uint32_t v : k.c) h = (h ^ v) * 1099511628211ull;
+                return (size_t)h;
+            }
+        };
+
+        void writeLeaf(FILE* f, uint64_t bits) {
+            int lastRow = 7;
+            while (lastRow > 0 && ((bits >> (lastRow * 8)) & 0xFFu) == 0) --lastRow;
+            for (int row = 0; row <= lastRow; ++row) {
+                const unsigned rowBits = (unsigned)((bits >> (row * 8)) & 0xFFu);
+                for (int col = 0; col < 8 && (rowBits >> col); ++col) {
+                    std::fputc((rowBits >> col & 1u) ? '*' : '.', f);
+                }
+                std::fputc('$', f);
+            }
+            std::fputc('\n', f);
+        }
+
+    }
+
+    void writeMacrocell(const char* path, const core::Life& life) {
+        if (life.rule().states > 2) {
+            throw std::runtime_error(std::string("Macrocell files hold two-state patterns, save as .rle or .gol: ") + path);
+        }
+        std::unique_ptr<FILE, FileCloser> file(std::fopen(path, "wb"));
+        if (!file) throw std::runtime_error(std::string("Cannot open for writing: ") + path);
+        FILE* f = file.get();
+
+        const int w = life.gridWidth_;
+        const int h = life.gridHeight_;
+        const uint8_t* cells = life.data();
+
+        int level = 3;
+        while ((1ll << level) < std::max(w, h)) ++level;
+        const long long blocks = 1ll << (level - 3); // leaves per side
+
+        std::fputs("[M2] (GameOfLife)\n#R B3/S23\n", f);
+
+        uint32_t nextId = 1;
+        std::vector<uint32_t> ids(static_cast<size_t>(blocks * blocks), 0);
+
+        // Level 3: 8x8 leaves, tree row 0 is the top grid row
+        {
+            std::unordered_map<uint64_t, uint32_t> leaves;
+            for (long long by = 0; by < blocks; ++by) {
+                for (long long bx = 0; bx < blocks; ++bx) {
+                    uint64_t bits = 0;
+                    for (int r = 0; r < 8; ++r) {
+                        const long long y = h - 1 - (by * 8 + r);
+                        if (y < 0) break;
+                        const uint8_t* src = cells + static_cast<size_t>(y) * w;
+                        for (int c = 0; c < 8; ++c) {
+                            const long long x = bx * 8 + c;
+                            if (x >= w) break;
+                            if (src[x]) bits |= 1ull << (r * 8 + c);
+                        }
+                    }
+                    if (!bits) continue;
+                    auto it = leaves.find(bits);
+                    if (it == leaves.end()) {
+                        writeLeaf(f, bits);
+                        it = leaves.emplace(bits, nextId++).first;
+                    }
+                    ids[static_cast<size_t>(by * blocks + bx)] = it->second;
+                }
+            }
+        }
+
+        // Higher levels: merge 2x2 children, sharing identical subtrees
+        uint32_t root = ids.empty() ? 0 : ids[0];
+        for (long long side = blocks, k = 4; side > 1; side /= 2, ++k) {
+            const long long half = side / 2;
+            std::vector<uint32_t> parents(static_cast<size_t>(half * half), 0);
+            std::unordered_map<QuadKey, uint32_t, QuadKeyHash> seen;
+            for (long long y = 0; y < half; ++y) {
+                for (long long x = 0; x < half; ++x) {
+                    const QuadKey key{{
+                        ids[static_cast<size_t>((2 * y) * side + 2 * x)],
+                        ids[static_cast<size_t>((2 * y) * side + 2 * x + 1)],
+                        ids[static_cast<size_t>((2 * y + 1) * side + 2 * x)],
+                        ids[static_cast<size_t>((2 * y + 1) * side + 2 * x + 1)]}};
+                    if (!(key.c[0] | key.c[1] | key.c[2] | key.c[3])) continue;
+                    auto it = seen.find(key);
+                    if (it == seen.end()) {
+                        std::fprintf(f, "%lld %u %u %u %u\n", k, key.c[0], key.c[1], key.c[2], key.c[3]);
+                        it = seen.emplace(key, nextId++).first;
+                    }
+                    parents[static_cast<size_t>(y * half + x)] = it->second;
+                }
+            }
+            ids.swap(parents);
+            root = ids[0];
+        }
+
+        // Golly expects at least one node: an empty leaf stands for an empty world
+        if (!root) std::fputs("$\n", f);
+
+        FILE* raw = file.release();
+        if (std::ferror(raw) || std::fclose(raw) != 0) throw std::runtime_error(std::string("Write failed: ") + path);
+    }
+
+}
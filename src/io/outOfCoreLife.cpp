@@ -0,0 +1,182 @@
+#include "../../include/io/outOfCoreLife.h"
+#include "../../include/utils/profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace io {
+
+    static constexpr int kCreateRows = 256; // rows written between releases by create()
+
+    static size_t fileBytes(int width, int height) {
+        return kOutOfCoreDataOffset + static_cast<size_t>(width) * height;
+    }
+
+    void OutOfCoreLife::create(const std::string& path, int width, int height, const std::function<void(int, uint8_t*)>& fillRow) {
+        if (width <= 0 || height <= 0) throw std::runtime_error("Invalid grid size for " + path);
+
+        utils::WritableMappedFile file;
+        std::string error;
+        if (!file.create(path, fileBytes(width, height), error)) throw std::runtime_error(error);
+
+        OutOfCoreHeader header;
+        header.width = static_cast<uint32_t>(width);
+        header.height = static_cast<uint32_t>(height);
+        std::memcpy(file.data(), &header, sizeof(header));
+
+        // The new file reads as zero; drop rows once written so any size fits
+        const size_t w = static_cast<size_t>(width);
+        uint8_t* cells = file.data() + kOutOfCoreDataOffset;
+        for (int y = 0; y < height; y += kCreateRows) {
+            const int end = std::min(height, y + kCreateRows);
+            for (int row = y; row < end; ++row) fillRow(row, cells + row * w);
+            file.release(kOutOfCoreDataOffset + y * w, (end - y) * w);
+        }
+    }
+
+    OutOfCoreLife::OutOfCoreLife(const std::string& path, const std::string& workPath, int bandRows, int generationsPerPass)
+        : generationsPerPass_(generationsPerPass) {
+        if (path == workPath) throw std::runtime_error("The work file must differ from " + path);
+        paths_[0] = path;
+        paths_[1] = workPath;
+
+        std::string error;
+        if (!files_[0].open(path, error)) throw std::runtime_error(error);
+
+        OutOfCoreHeader header{};
+        if (files_[0].size() < kOutOfCoreDataOffset) throw std::runtime_error("Truncated grid file: " + path);
+        std::memcpy(&header, files_[0].data(), sizeof(header));
+
+        const OutOfCoreHeader expected{};
+        if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version) {
+            throw std::runtime_error("Not a grid file: " + path);
+        }
+        if (header.width == 0 || header.height == 0 || header.width > 1u << 30 || header.height > 1u << 30 ||
+            files_[0].size() != fileBytes(static_cast<int>(header.width), static_cast<int>(header.height))) {
+            throw std::runtime_error("Corrupt grid file header: " + path);
+        }
+        width_ = static_cast<int>(header.width);
+        height_ = static_cast<int>(header.height);
+        generation_ = header.generation;
+
+        // Whole bands of at least bandRows rows (the remainder is spread over them); each must
+        // supply a full halo to its neighbours
+        bands_ = std::max(1, height_ / std::max(bandRows, 1));
+        const core::DomainLayout layout(width_, height_, 1, bands_);
+        if (generationsPerPass < 1 || generationsPerPass > layout.maxHalo()) {
+            throw std::runtime_error(std::to_string(generationsPerPass) + " generations per pass do not fit bands of " +
+                std::to_string(height_ / bands_) + " rows on a grid " + std::to_string(width_) + " cells wide");
+        }
+    }
+
+    core::Subdomain& OutOfCoreLife::subdomainFor(int rows) {
+        for (core::Subdomain& sub : subdomains_) {
+            if (sub.rect().height == rows) return sub;
+        }
+        // Bands are contiguous rows of the file, so only their size matters
+        core::DomainRect rect;
+        rect.width = width_;
+        rect.height = rows;
+        subdomains_.emplace_back(rect, generationsPerPass_);
+        return subdomains_.back();
+    }
+
+    void OutOfCoreLife::packHaloRows(const uint8_t* cells, int firstRow, uint8_t* out) const {
+        // Each row of the strip spans the padded width: the wrapped-around corners, then the row
+        const int k = generationsPerPass_;
+        const size_t w = static_cast<size_t>(width_);
+        const size_t stride = w + 2 * k;
+        for (int i = 0; i < k; ++i) {
+            const int y = ((firstRow + i) % height_ + height_) % height_;
+            const uint8_t* row = cells + y * w;
+            uint8_t* line = out + i * stride;
+            std::memcpy(line, row + w - k, k);
+            std::memcpy(line + k, row, w);
+            std::memcpy(line + k + w, row, k);
+        }
+    }
+
+    OutOfCoreStats OutOfCoreLife::step(uint64_t generations) {
+        OutOfCoreStats stats;
+        const auto t0 = std::chrono::steady_clock::now();
+        while (stats.generations < generations) {
+            const int batch = static_cast<int>(std::min<uint64_t>(generationsPerPass_, generations - stats.generations));
+            pass(batch, stats);
+            stats.generations += batch;
+            ++stats.passes;
+        }
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        return stats;
+    }
+
+    void OutOfCoreLife::pass(int generations, OutOfCoreStats& stats) {
+        PROFILE_SCOPE("OutOfCoreLife::pass");
+
+        // Recreate the file being written: truncated pages have no old contents to read back
+        const int next = 1 - current_;
+        std::string error;
+        if (!files_[next].create(paths_[next], fileBytes(width_, height_), error)) throw std::runtime_error(error);
+
+        const utils::WritableMappedFile& source = files_[current_];
+        const utils::WritableMappedFile& target = files_[next];
+        const uint8_t* from = source.data() + kOutOfCoreDataOffset;
+        uint8_t* to = target.data() + kOutOfCoreDataOffset;
+
+        const int k = generationsPerPass_;
+        const size_t w = static_cast<size_t>(width_);
+        const core::DomainLayout layout(width_, height_, 1, bands_);
+        const size_t tallestBand = static_cast<size_t>((height_ + bands_ - 1) / bands_);
+        strip_.resize(static_cast<size_t>(k) * std::max(w + 2 * k, tallestBand));
+
+        source.willNeed(kOutOfCoreDataOffset + (height_ - k) * w, k * w);
+        source.willNeed(kOutOfCoreDataOffset, (layout.rect(0).height + k) * w);
+        size_t released = k; // rows [0, k) are read again by the last band
+
+        for (int b = 0; b < bands_; ++b) {
+            const core::DomainRect rect = layout.rect(b);
+            core::Subdomain& sub = subdomainFor(rect.height);
+            sub.setInterior(from + rect.y * w);
+
+            // The band spans the full width: its west and east halos are its own opposite edges
+            sub.packEdge(core::Side::East, strip_.data());
+            sub.unpackHalo(core::Side::West, strip_.data());
+            sub.packEdge(core::Side::West, strip_.data());
+            sub.unpackHalo(core::Side::East, strip_.data());
+            packHaloRows(from, rect.y - k, strip_.data());
+            sub.unpackHalo(core::Side::South, strip_.data());
+            packHaloRows(from, rect.y + rect.height, strip_.data());
+            sub.unpackHalo(core::Side::North, strip_.data());
+
+            // Read the next band ahead while this one steps
+            if (b + 1 < bands_) {
+                const core::DomainRect ahead = layout.rect(b + 1);
+                source.willNeed(kOutOfCoreDataOffset + (ahead.y + k) * w, ahead.height * w);
+            }
+
+            sub.step(generations);
+            sub.copyInterior(to + rect.y * w);
+            target.release(kOutOfCoreDataOffset + rect.y * w, rect.height * w);
+
+            // Drop source rows no later band reads
+            const size_t done = static_cast<size_t>(rect.y + rect.height - k);
+            if (done > released) {
+                source.release(kOutOfCoreDataOffset + released * w, (done - released) * w);
+                released = done;
+            }
+
+            stats.bytesRead += (rect.height + 2 * static_cast<size_t>(k)) * w;
+            stats.bytesWritten += rect.height * w;
+        }
+        source.release(kOutOfCoreDataOffset, static_cast<size_t>(height_) * w);
+
+        generation_ += static_cast<uint64_t>(generations);
+        OutOfCoreHeader header{};
+        std::memcpy(&header, source.data(), sizeof(header));
+        header.generation = generation_;
+        std::memcpy(target.data(), &header, sizeof(header));
+        current_ = next;
+    }
+
+}
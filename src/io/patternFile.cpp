@@ -0,0 +1,59 @@
+#include "../../include/io/patternFile.h"
+
+#include "../../include/io/macrocell.h"
+#include "../../include/io/rleFormat.h"
+#include "../../include/io/snapshot.h"
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <stdexcept>
+
+namespace io {
+
+    static std::string lowerExtension(const std::string& path) {
+        const size_t dot = path.find_last_of('.');
+        if (dot == std::string::npos) return {};
+        std::string ext = path.substr(dot);
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        return ext;
+    }
+
+    PatternFormat formatFromPath(const std::string& path) {
+        const std::string ext = lowerExtension(path);
+        if (ext == ".gol") return PatternFormat::Snapshot;
+        if (ext == ".rle") return PatternFormat::Rle;
+        if (ext == ".mc") return PatternFormat::Macrocell;
+        throw std::runtime_error("Unknown pattern format (expected .gol, .rle or .mc): " + path);
+    }
+
+    core::Life loadPattern(const std::string& path, const ImportOptions& opt) {
+        switch (formatFromPath(path)) {
+        case PatternFormat::Snapshot: return loadSnapshot(path.c_str());
+        case PatternFormat::Rle: return readRle(path.c_str(), opt);
+        case PatternFormat::Macrocell: return readMacrocell(path.c_str(), opt);
+        }
+        throw std::runtime_error("Unsupported format: " + path);
+    }
+
+    void savePattern(const std::string& path, const core::Life& life) {
+        switch (formatFromPath(path)) {
+        case PatternFormat::Snapshot: saveSnapshot(path.c_str(), life, true); return;
+        case PatternFormat::Rle: writeRle(path.c_str(), life); return;
+        case PatternFormat::Macrocell: writeMacrocell(path.c_str(), life); return;
+        }
+    }
+
+    void importGridSize(long long patternW, long long patternH, const ImportOptions& opt, int& gridW, int& gridH) {
+        const long long w = std::max<long long>({patternW, (long long)opt.minWidth, 1});
+        const long long h = std::max<long long>({patternH, (long long)opt.minHeight, 1});
+
+        // Life indexes cells with int
+        if (w > INT_MAX || h > INT_MAX || w * h > INT_MAX) {
+            throw std::runtime_error("Pattern too large: " + std::to_string(patternW) + " x " + std::to_string(patternH));
+        }
+        gridW = static_cast<int>(w);
+        gridH = static_cast<int>(h);
+    }
+
+}
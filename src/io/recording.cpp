@@ -0,0 +1,265 @@
+#include "../../include/io/recording.h"
+
+#include "../../include/core/deltaCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace io {
+
+    // Recorder
+
+    Recorder::~Recorder() {
+        stop();
+    }
+
+    bool Recorder::start(const std::string& path, int width, int height, int keyframeInterval, const core::LifeRule& rule,
+                         std::string& error) {
+        stop();
+
+        file_ = std::fopen(path.c_str(), "wb");
+        if (!file_) {
+            error = "Cannot open for writing: " + path;
+            return false;
+        }
+        std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+
+        RecordingHeader header{};
+        header.width = static_cast<uint32_t>(width);
+        header.height = static_cast<uint32_t>(height);
+        header.keyframeInterval = static_cast<uint32_t>(std::max(1, keyframeInterval));
+        const bool states = rule.states > 2;
+        if (states) header.version = 2;
+        const SnapshotRule stored = toSnapshotRule(rule);
+        if (std::fwrite(&header, sizeof(header), 1, file_) != 1 || (states && std::fwrite(&stored, sizeof(stored), 1, file_) != 1)) {
+            std::fclose(file_);
+            file_ = nullptr;
+            error = "Write failed: " + path;
+            return false;
+        }
+
+        path_ = path;
+        cellCount_ = static_cast<size_t>(width) * static_cast<size_t>(height);
+        keyframeInterval_ = static_cast<int>(header.keyframeInterval);
+        rule_ = rule;
+        planes_ = states ? 2 : 1;
+        stopping_ = false;
+        framesWritten_ = 0;
+        failed_ = false;
+        error_.clear();
+        writer_ = std::thread(&Recorder::writerLoop, this);
+        return true;
+    }
+
+    void Recorder::capture(const core::Life& life, uint64_t generation) {
+        if (!file_ || failed()) return;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        drained_.wait(lock, [this] { return queue_.size() < kMaxQueued || failed(); });
+        if (failed()) return;
+
+        Frame frame{};
+        if (!spare_.empty()) {
+            frame.cells = std::move(spare_.back());
+            spare_.pop_back();
+        }
+        lock.unlock();
+
+        // The only work on the stepping thread: one copy into a recycled buffer
+        frame.cells.assign(life.data(), life.data() + cellCount_);
+        frame.generation = generation;
+
+        lock.lock();
+        queue_.push_back(std::move(frame));
+        lock.unlock();
+        wake_.notify_one();
+    }
+
+    void Recorder::stop() {
+        if (!file_) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        if (writer_.joinable()) writer_.join();
+
+        // Closing flushes the last buffered frames, which can fail too
+        if (std::fclose(file_) != 0 && !failed()) fail();
+        file_ = nullptr;
+        queue_.clear();
+        spare_.clear();
+    }
+
+    std::string Recorder::lastError() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return error_;
+    }
+
+    void Recorder::fail() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            error_ = "Recording write failed (disk full?): " + path_;
+            queue_.clear();
+        }
+        failed_.store(true, std::memory_order_release);
+        drained_.notify_all();
+    }
+
+    void Recorder::writerLoop() {
+        std::vector<uint8_t> previous(cellCount_, 0);
+        std::vector<uint8_t> payload;
+        uint64_t index = 0;
+
+        for (;;) {
+            Frame frame{};
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) return; // stopping and drained
+                frame = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            drained_.notify_one();
+
+            RecordingFrameHeader fh{};
+            fh.keyframe = (index % static_cast<uint64_t>(keyframeInterval_)) == 0 ? 1 : 0;
+            fh.generation = frame.generation;
+
+            payload.clear();
+            if (fh.keyframe) core::encodeCells(frame.cells.data(), cellCount_, payload, planes_);
+            else core::encodeXorDelta(previous.data(), frame.cells.data(), cellCount_, payload, planes_);
+            fh.payloadBytes = static_cast<uint32_t>(payload.size());
+
+            if (std::fwrite(&fh, sizeof(fh), 1, file_) != 1 ||
+                std::fwrite(payload.data(), 1, payload.size(), file_) != payload.size()) {
+                fail(); // stop writing; pending and later frames are dropped
+                return;
+            }
+            ++index;
+            framesWritten_.fetch_add(1, std::memory_order_relaxed);
+
+            // The frame becomes the reference and the old reference is recycled
+            previous.swap(frame.cells);
+            std::lock_guard<std::mutex> lock(mutex_);
+            spare_.push_back(std::move(frame.cells));
+        }
+    }
+
+    // Player
+
+    bool Player::open(const std::string& path, std::string& error) {
+        close();
+        if (!file_.open(path.c_str())) {
+            error = "Cannot open: " + path;
+            return false;
+        }
+
+        RecordingHeader header{};
+        const RecordingHeader expected{};
+        if (file_.size() < sizeof(header)) {
+            error = "Truncated recording: " + path;
+            close();
+            return false;
+        }
+        std::memcpy(&header, file_.data(), sizeof(header));
+        if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version < 1 || header.version > 2 ||
+            header.width == 0 || header.height == 0) {
+            error = "Not a recording: " + path;
+            close();
+            return false;
+        }
+        width_ = static_cast<int>(header.width);
+        height_ = static_cast<int>(header.height);
+
+        // Multi-state recordings store their rule after the header
+        size_t offset = sizeof(header);
+        if (header.version == 2) {
+            SnapshotRule stored;
+            if (file_.size() < offset + sizeof(stored)) {
+                error = "Truncated recording: " + path;
+                close();
+                return false;
+            }
+            std::memcpy(&stored, file_.data() + offset, sizeof(stored));
+            if (!fromSnapshotRule(stored, rule_)) {
+                error = "Corrupt recording rule: " + path;
+                close();
+                return false;
+            }
+            planes_ = 2;
+            offset += sizeof(stored);
+        }
+
+        // Index frame records; a truncated tail (e.g. after a crash) is ignored
+        while (offset + sizeof(RecordingFrameHeader) <= file_.size()) {
+            RecordingFrameHeader fh{};
+            std::memcpy(&fh, file_.data() + offset, sizeof(fh));
+            offset += sizeof(fh);
+            if (fh.payloadBytes > file_.size() - offset) break;
+            if (frames_.empty() && !fh.keyframe) break;
+            frames_.push_back(FrameRef{offset, fh.payloadBytes, fh.generation, fh.keyframe != 0});
+            offset += fh.payloadBytes;
+        }
+        if (frames_.empty()) {
+            error = "Recording has no frames: " + path;
+            close();
+            return false;
+        }
+
+        cells_.assign(static_cast<size_t>(width_) * static_cast<size_t>(height_), 0);
+        return seek(0);
+    }
+
+    void Player::close() {
+        file_.close();
+        frames_.clear();
+        cells_.clear();
+        width_ = height_ = 0;
+        rule_ = core::LifeRule{};
+        planes_ = 1;
+        position_ = 0;
+        decoded_ = false;
+    }
+
+    bool Player::applyFrame(size_t frame) {
+        const FrameRef& f = frames_[frame];
+        return core::applyXorDelta(file_.data() + f.offset, f.bytes, cells_.data(), cells_.size(), planes_);
+    }
+
+    bool Player::seek(size_t frame) {
+        if (frame >= frames_.size()) return false;
+        if (decoded_ && frame == position_) return true;
+
+        size_t key = frame;
+        while (!frames_[key].keyframe) --key;
+
+        size_t currentKey = position_;
+        while (decoded_ && !frames_[currentKey].keyframe) --currentKey;
+
+        // Walking from the current frame (within the same keyframe span) is cheaper when it is closer
+        if (decoded_ && currentKey == key) {
+            if (position_ < frame) {
+                for (size_t i = position_ + 1; i <= frame; ++i) {
+                    if (!applyFrame(i)) return decoded_ = false;
+                }
+                position_ = frame;
+                return true;
+            }
+            if (position_ - frame < frame - key + 1) {
+                for (size_t i = position_; i > frame; --i) {
+                    if (!applyFrame(i)) return decoded_ = false;
+                }
+                position_ = frame;
+                return true;
+            }
+        }
+
+        std::fill(cells_.begin(), cells_.end(), 0);
+        decoded_ = applyFrame(key);
+        for (size_t i = key + 1; decoded_ && i <= frame; ++i) decoded_ = applyFrame(i);
+        position_ = frame;
+        return decoded_;
+    }
+
+}
@@ -0,0 +1,228 @@
+#include "../../include/io/rleFormat.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace io {
+
+    namespace {
+
+        // Buffered byte reader over a FILE* (fixed-size chunk, no whole-file reads)
+        class ChunkReader {
+        public:
+            explicit ChunkReader(FILE* f) : file_(f), buf_(1 << 16) {}
+
+            // Next byte or EOF
+            int next() {
+                if (pos_ == len_) {
+                    len_ = std::fread(buf_.data(), 1, buf_.size(), file_);
+                    pos_ = 0;
+                    if (len_ == 0) return EOF;
+                }
+                return buf_[pos_++];
+            }
+
+            // Read the rest of the current line (capped) into out
+            void line(std::string& out, size_t cap) {
+                out.clear();
+                for (int c = next(); c != EOF && c != '\n'; c = next()) {
+                    if (out.size() < cap && c != '\r') out.push_back((char)c);
+                }
+            }
+
+        private:
+            FILE* file_;
+            std::vector<unsigned char> buf_;
+            size_t pos_ = 0;
+            size_t len_ = 0;
+        };
+
+        struct FileCloser {
+            void operator()(FILE* f) const { if (f) std::fclose(f); }
+        };
+
+        // Parse "x = 12, y = 34, rule = ..." (spaces optional, the rule runs to the end of the line)
+        bool parseHeader(const std::string& line, long long& w, long long& h, std::string& rule) {
+            w = h = -1;
+            rule.clear();
+            size_t i = 0;
+            while (i < line.size()) {
+                while (i < line.size() && (line[i] == ' ' || line[i] == ',' || line[i] == '\t')) ++i;
+                if (i >= line.size()) break;
+                const char key = line[i];
+                size_t eq = line.find('=', i);
+                if (eq == std::string::npos) break;
+                if (line.compare(i, 4, "rule") == 0) {
+                    rule = line.substr(eq + 1);
+                    break;
+                }
+                size_t end = line.find(',', eq);
+                const std::string value = line.substr(eq + 1, end == std::string::npos ? std::string::npos : end - eq - 1);
+                if (key == 'x') w = std::atoll(value.c_str());
+                else if (key == 'y') h = std::atoll(value.c_str());
+                if (end == std::string::npos) break;
+                i = end + 1;
+            }
+            return w >= 0 && h >= 0;
+        }
+
+    }
+
+    core::Life readRle(const char* path, const ImportOptions& opt) {
+        std::unique_ptr<FILE, FileCloser> file(std::fopen(path, "rb"));
+        if (!file) throw std::runtime_error(std::string("Cannot open: ") + path);
+        ChunkReader in(file.get());
+
+        // Comments and header
+        long long patW = -1, patH = -1;
+        std::string line, ruleText;
+        for (;;) {
+            int c = in.next();
+            while (c == ' ' || c == '\t' || c == '\r' || c == '\n') c = in.next();
+            if (c == EOF) throw std::runtime_error(std::string("Missing RLE header: ") + path);
+            in.line(line, 4096);
+            if (c == '#') continue;
+            if (c != 'x' || !parseHeader(std::string(1, (char)c) + line, patW, patH, ruleText)) {
+                throw std::runtime_error(std::string("Bad RLE header: ") + path);
+            }
+            break;
+        }
+
+        int gridW = 0, gridH = 0;
+        importGridSize(patW, patH, opt, gridW, gridH);
+        core::Life life(gridW, gridH);
+        uint8_t* cells = life.data();
+
+        // Only multi-state rules change what the letters mean
+        core::LifeRule rule;
+        const bool states = core::parseLifeRule(ruleText, rule) && rule.states > 2;
+        if (states) life.setRule(rule);
+
+        // Pattern top-left in grid coordinates (row 0 of the file is the top row)
+        const long long offX = (gridW - patW) / 2;
+        const long long topY = (gridH - patH) / 2 + patH - 1;
+
+        long long col = 0, row = 0, run = 0;
+        for (int c = in.next(); c != EOF && c != '!'; c = in.next()) {
+            if (c >= '0' && c <= '9') {
+                run = run * 10 + (c - '0');
+                if (run > (1ll << 40)) throw std::runtime_error(std::string("Bad run count in: ") + path);
+                continue;
+            }
+            const long long n = run > 0 ? run : 1;
+            run = 0;
+
+            if (c == 'b' || c == '.') {
+                col += n;
+            }
+            else if (c == '$') {
+                row += n;
+                col = 0;
+            }
+            else if (c == '#') {
+                in.line(line, 0); // comment inside the body
+            }
+            else if (c >= 'p' && c <= 'y') {
+                // Multi-state prefix: the following letter completes the state (25 and up)
+                const int s = in.next();
+                if (s < 'A' || s > 'X' || states) throw std::runtime_error(std::string("Bad RLE state in: ") + path);
+                c = 'o';
+            }
+            if (c == 'o' || (c >= 'A' && c <= 'X')) {
+                const int state = (states && c != 'o') ? c - 'A' + 1 : 1;
+                if (states && state >= rule.states) throw std::runtime_error(std::string("Bad RLE state in: ") + path);
+                const long long y = topY - row;
+                if (y >= 0 && y < gridH) {
+                    uint8_t* dst = cells + static_cast<size_t>(y) * gridW;
+                    for (long long k = 0; k < n; ++k) {
+                        const long long x = offX + col + k;
+                        if (x >= 0 && x < gridW) dst[x] = static_cast<uint8_t>(state);
+                    }
+                }
+                col += n;
+            }
+            else if (!std::isspace(c) && c != 'b' && c != '.' && c != '$' && c != '#') {
+                throw std::runtime_error(std::string("Unexpected character in RLE body: ") + path);
+            }
+        }
+
+        life.rebuildLiveCells();
+        life.resetAge();
+        return life;
+    }
+
+    namespace {
+
+        // Emits RLE tokens with the customary 70-column line wrap
+        class RleWriter {
+        public:
+            explicit RleWriter(FILE* f) : file_(f) {}
+
+            void token(long long count, char tag) {
+                if (count <= 0) return;
+                char tok[32];
+                const int len = (count > 1) ? std::snprintf(tok, sizeof(tok), "%lld%c", count, tag) : std::snprintf(tok, sizeof(tok), "%c", tag);
+                if (column_ + len > 70) {
+                    std::fputc('\n', file_);
+                    column_ = 0;
+                }
+                std::fwrite(tok, 1, (size_t)len, file_);
+                column_ += len;
+            }
+
+        private:
+            FILE* file_;
+            int column_ = 0;
+        };
+
+    }
+
+    void writeRle(const char* path, const core::Life& life) {
+        std::unique_ptr<FILE, FileCloser> file(std::fopen(path, "wb"));
+        if (!file) throw std::runtime_error(std::string("Cannot open for writing: ") + path);
+
+        const int w = life.gridWidth_;
+        const int h = life.gridHeight_;
+        const bool states = life.rule().states > 2;
+        std::fprintf(file.get(), "x = %d, y = %d, rule = %s\n", w, h, states ? core::formatLifeRule(life.rule()).c_str() : "B3/S23");
+
+        // Two-state cells are b/o; multi-state ones are . and a letter per state
+        auto tag = [states](uint8_t v) { return states ? (v ? static_cast<char>('A' + v - 1) : '.') : (v ? 'o' : 'b'); };
+
+        RleWriter out(file.get());
+        const uint8_t* cells = life.data();
+        long long pendingRows = 0; // row ends not yet written (merged into n$)
+
+        // Top row first
+        for (int y = h - 1; y >= 0; --y) {
+            const uint8_t* src = cells + static_cast<size_t>(y) * w;
+            bool rowStarted = false;
+            int x = 0;
+            while (x < w) {
+                const uint8_t v = states ? src[x] : (src[x] ? 1 : 0);
+                int end = x + 1;
+                while (end < w && (states ? src[end] : (src[end] ? 1 : 0)) == v) ++end;
+                if (v || end < w) { // trailing dead cells are omitted
+                    if (!rowStarted) {
+                        out.token(pendingRows, '$');
+                        pendingRows = 0;
+                        rowStarted = true;
+                    }
+                    out.token(end - x, tag(v));
+                }
+                x = end;
+            }
+            ++pendingRows;
+        }
+        std::fputs("!\n", file.get());
+
+        FILE* raw = file.release();
+        if (std::ferror(raw) || std::fclose(raw) != 0) throw std::runtime_error(std::string("Write failed: ") + path);
+    }
+
+}
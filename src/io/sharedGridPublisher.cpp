@@ -0,0 +1,104 @@
+#include "../../include/io/sharedGridPublisher.h"
+#include "../../include/utils/profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace io {
+
+    // Slots start on page boundaries so large frames copy at full speed
+    static constexpr size_t kPageBytes = 4096;
+
+    static size_t roundUp(size_t value, size_t multiple) {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+    SharedGridPublisher::~SharedGridPublisher() {
+        stop();
+    }
+
+    bool SharedGridPublisher::start(const std::string& name, int width, int height, int slots, std::string& error) {
+        stop();
+        if (name.empty() || width <= 0 || height <= 0 || slots < 2) {
+            error = "Shared grid needs a name, a non-empty grid and at least 2 slots";
+            return false;
+        }
+
+        name_ = name;
+        slots_ = slots;
+        published_ = 0;
+        capacity_ = 0;
+        if (!createSegment(static_cast<size_t>(width) * static_cast<size_t>(height), error)) {
+            name_.clear();
+            return false;
+        }
+        error_.clear();
+        return true;
+    }
+
+    void SharedGridPublisher::stop() {
+        closeSegment();
+        name_.clear();
+    }
+
+    bool SharedGridPublisher::createSegment(size_t capacity, std::string& error) {
+        const size_t stride = roundUp(sizeof(SharedGridSlot) + capacity, kPageBytes);
+        if (!memory_.create(name_, kPageBytes + stride * static_cast<size_t>(slots_), error)) return false;
+
+        // A fresh segment is zero-filled; construct the header and the slot locks in place
+        uint8_t* base = memory_.data();
+        for (int i = 0; i < slots_; ++i) new (base + kPageBytes + stride * static_cast<size_t>(i)) SharedGridSlot();
+        SharedGridHeader* header = new (base) SharedGridHeader();
+        header->slotCount = static_cast<uint32_t>(slots_);
+        header->headerBytes = static_cast<uint32_t>(kPageBytes);
+        header->slotStride = stride;
+        header->capacity = capacity;
+        header->published.store(published_, std::memory_order_release);
+
+        capacity_ = capacity;
+        return true;
+    }
+
+    void SharedGridPublisher::closeSegment() {
+        if (!memory_.data()) return;
+        reinterpret_cast<SharedGridHeader*>(memory_.data())->live.store(0, std::memory_order_release);
+        memory_.close();
+    }
+
+    void SharedGridPublisher::publish(const uint8_t* cells, int width, int height, uint64_t generation) {
+        if (!active()) return;
+        PROFILE_SCOPE("Share frame");
+
+        // A grid that outgrew the slots gets a new segment; if that fails, retry next frame
+        const size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+        if (!memory_.data() || count > capacity_) {
+            closeSegment();
+            if (!createSegment(std::max(count, capacity_), error_)) return;
+        }
+        error_.clear();
+
+        uint8_t* base = memory_.data();
+        SharedGridHeader* header = reinterpret_cast<SharedGridHeader*>(base);
+        const uint64_t frame = published_ + 1;
+        uint8_t* slotBase = base + header->headerBytes + header->slotStride * ((frame - 1) % static_cast<uint64_t>(slots_));
+        SharedGridSlot* slot = reinterpret_cast<SharedGridSlot*>(slotBase);
+
+        // Odd sequence: readers of this slot will discard what they read from now on
+        const uint64_t sequence = slot->sequence.load(std::memory_order_relaxed);
+        slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot->frame.store(frame, std::memory_order_relaxed);
+        slot->generation.store(generation, std::memory_order_relaxed);
+        slot->width.store(static_cast<uint32_t>(width), std::memory_order_relaxed);
+        slot->height.store(static_cast<uint32_t>(height), std::memory_order_relaxed);
+        slot->format.store(static_cast<uint32_t>(SharedGridFormat::Cells8), std::memory_order_relaxed);
+        std::memcpy(slotBase + sizeof(SharedGridSlot), cells, count);
+
+        slot->sequence.store(sequence + 2, std::memory_order_release);
+        header->published.store(frame, std::memory_order_release);
+        published_ = frame;
+    }
+
+}
@@ -0,0 +1,110 @@
+#include "../../include/io/sharedGridReader.h"
+
+#include <cstring>
+
+namespace io {
+
+    // Retries before giving up on a slot the publisher keeps rewriting
+    static constexpr int kReadAttempts = 8;
+
+    bool SharedGridReader::open(const std::string& name, std::string& error) {
+        close();
+        if (!memory_.open(name, error)) return false;
+
+        const SharedGridHeader* header = reinterpret_cast<const SharedGridHeader*>(memory_.data());
+        const bool fits = memory_.size() >= sizeof(SharedGridHeader);
+        if (!fits || std::memcmp(header->magic, "GOLS", 4) != 0 || header->version != 1) {
+            error = "'" + name + "' is not a shared grid (or is still being set up)";
+            memory_.close();
+            return false;
+        }
+
+        const uint64_t slotsEnd = header->headerBytes + header->slotStride * header->slotCount;
+        if (header->slotCount < 2 || header->headerBytes < sizeof(SharedGridHeader) ||
+            header->slotStride < sizeof(SharedGridSlot) + header->capacity || slotsEnd > memory_.size()) {
+            error = "Shared grid '" + name + "' has an invalid layout";
+            memory_.close();
+            return false;
+        }
+
+        header_ = header;
+        return true;
+    }
+
+    void SharedGridReader::close() {
+        header_ = nullptr;
+        memory_.close();
+    }
+
+    bool SharedGridReader::publisherClosed() const {
+        return !header_ || header_->live.load(std::memory_order_acquire) == 0;
+    }
+
+    uint64_t SharedGridReader::framesPublished() const {
+        return header_ ? header_->published.load(std::memory_order_acquire) : 0;
+    }
+
+    const SharedGridSlot* SharedGridReader::slotAt(uint32_t index) const {
+        return reinterpret_cast<const SharedGridSlot*>(memory_.data() + header_->headerBytes + header_->slotStride * index);
+    }
+
+    bool SharedGridReader::latest(SharedGridFrame& frame) const {
+        if (!header_) return false;
+
+        for (int attempt = 0; attempt < kReadAttempts; ++attempt) {
+            const uint64_t published = header_->published.load(std::memory_order_acquire);
+            if (published == 0) return false;
+
+            const uint32_t index = static_cast<uint32_t>((published - 1) % header_->slotCount);
+            const SharedGridSlot* slot = slotAt(index);
+            const uint64_t before = slot->sequence.load(std::memory_order_acquire);
+            if (before & 1) continue; // being rewritten; a newer frame is on its way
+
+            SharedGridFrame view;
+            view.width = static_cast<int>(slot->width.load(std::memory_order_relaxed));
+            view.height = static_cast<int>(slot->height.load(std::memory_order_relaxed));
+            view.format = static_cast<SharedGridFormat>(slot->format.load(std::memory_order_relaxed));
+            view.generation = slot->generation.load(std::memory_order_relaxed);
+            view.frame = slot->frame.load(std::memory_order_relaxed);
+            view.slot = index;
+            view.sequence = before;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot->sequence.load(std::memory_order_relaxed) != before) continue;
+
+            // A consistent slot never claims more cells than it holds; refuse it if it does
+            const uint64_t count = static_cast<uint64_t>(view.width) * static_cast<uint64_t>(view.height);
+            if (view.format != SharedGridFormat::Cells8 || view.width <= 0 || view.height <= 0 || count > header_->capacity) {
+                return false;
+            }
+
+            view.cells = reinterpret_cast<const uint8_t*>(slot) + sizeof(SharedGridSlot);
+            frame = view;
+            return true;
+        }
+        return false;
+    }
+
+    bool SharedGridReader::valid(const SharedGridFrame& frame) const {
+        if (!header_ || !frame.cells) return false;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slotAt(frame.slot)->sequence.load(std::memory_order_relaxed) == frame.sequence;
+    }
+
+    bool SharedGridReader::copyLatest(std::vector<uint8_t>& cells, SharedGridFrame& frame) const {
+        for (int attempt = 0; attempt < kReadAttempts; ++attempt) {
+            SharedGridFrame view;
+            if (!latest(view)) return false;
+
+            cells.resize(static_cast<size_t>(view.width) * static_cast<size_t>(view.height));
+            std::memcpy(cells.data(), view.cells, cells.size());
+            if (!valid(view)) continue;
+
+            view.cells = cells.data();
+            frame = view;
+            return true;
+        }
+        return false;
+    }
+
+}
@@ -0,0 +1,289 @@
+#include "../../include/io/snapshot.h"
+
+#include "../../include/utils/mappedFile.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace io {
+
+    void packRow(const uint8_t* cells, int width, uint8_t* out) {
+        const int rowBytes = (width + 7) / 8;
+        std::memset(out, 0, static_cast<size_t>(rowBytes));
+        for (int x = 0; x < width; ++x) {
+            out[x >> 3] |= static_cast<uint8_t>((cells[x] ? 1u : 0u) << (x & 7));
+        }
+    }
+
+    void unpackRow(const uint8_t* bits, int width, uint8_t* cells) {
+        for (int x = 0; x < width; ++x) {
+            cells[x] = (bits[x >> 3] >> (x & 7)) & 1u;
+        }
+    }
+
+    void packStateRow(const uint8_t* cells, int width, uint8_t* out) {
+        const int rowBytes = (width + 3) / 4;
+        std::memset(out, 0, static_cast<size_t>(rowBytes));
+        for (int x = 0; x < width; ++x) {
+            out[x >> 2] |= static_cast<uint8_t>((cells[x] & 3u) << (2 * (x & 3)));
+        }
+    }
+
+    void unpackStateRow(const uint8_t* bits, int width, uint8_t* cells) {
+        for (int x = 0; x < width; ++x) {
+            cells[x] = (bits[x >> 2] >> (2 * (x & 3))) & 3u;
+        }
+    }
+
+    SnapshotRule toSnapshotRule(const core::LifeRule& rule) {
+        SnapshotRule r;
+        r.birthMin = static_cast<uint16_t>(rule.birthMin);
+        r.birthMax = static_cast<uint16_t>(rule.birthMax);
+        r.surviveMin = static_cast<uint16_t>(rule.surviveMin);
+        r.surviveMax = static_cast<uint16_t>(rule.surviveMax);
+        r.range = static_cast<uint8_t>(rule.range);
+        r.includeCenter = rule.includeCenter ? 1 : 0;
+        r.shape = static_cast<uint8_t>(rule.shape);
+        r.states = static_cast<uint8_t>(rule.states);
+        r.family = static_cast<uint8_t>(rule.family);
+        return r;
+    }
+
+    bool fromSnapshotRule(const SnapshotRule& r, core::LifeRule& rule) {
+        if (r.range < 1 || r.range > core::kMaxRange || r.states < 3 || r.states > core::kMaxStates ||
+            r.shape > static_cast<uint8_t>(core::Neighbourhood::VonNeumann) || r.family > static_cast<uint8_t>(core::RuleFamily::WireWorld)) {
+            return false;
+        }
+        rule.birthMin = r.birthMin;
+        rule.birthMax = r.birthMax;
+        rule.surviveMin = r.surviveMin;
+        rule.surviveMax = r.surviveMax;
+        rule.range = r.range;
+        rule.includeCenter = r.includeCenter != 0;
+        rule.shape = static_cast<core::Neighbourhood>(r.shape);
+        rule.states = r.states;
+        rule.family = static_cast<core::RuleFamily>(r.family);
+        return true;
+    }
+
+    // PackBits: control byte n in [0,127] -> n+1 literals, [129,255] -> 257-n repeats
+    static void packBitsEncode(const uint8_t* src, size_t len, std::vector<uint8_t>& out) {
+        size_t i = 0;
+        while (i < len) {
+            size_t run = 1;
+            while (i + run < len && run < 128 && src[i + run] == src[i]) ++run;
+
+            if (run >= 3) {
+                out.push_back(static_cast<uint8_t>(257 - run));
+                out.push_back(src[i]);
+                i += run;
+                continue;
+            }
+
+            // Literal block up to the next run of 3 or 128 bytes
+            size_t lit = 0;
+            while (i + lit < len && lit < 128) {
+                if (i + lit + 2 < len && src[i + lit] == src[i + lit + 1] && src[i + lit] == src[i + lit + 2]) break;
+                ++lit;
+            }
+            out.push_back(static_cast<uint8_t>(lit - 1));
+            out.insert(out.end(), src + i, src + i + lit);
+            i += lit;
+        }
+    }
+
+    // Decode PackBits from [src, src+len) until exactly dstLen bytes are produced.
+    // Returns the number of source bytes consumed, or 0 if the input is malformed.
+    static size_t packBitsDecode(const uint8_t* src, size_t len, uint8_t* dst, size_t dstLen) {
+        size_t i = 0, o = 0;
+        while (o < dstLen) {
+            if (i >= len) return 0;
+            const uint8_t n = src[i++];
+            if (n < 128) {
+                const size_t count = static_cast<size_t>(n) + 1;
+                if (i + count > len || o + count > dstLen) return 0;
+                std::memcpy(dst + o, src + i, count);
+                i += count;
+                o += count;
+            }
+            else if (n > 128) {
+                const size_t count = 257 - static_cast<size_t>(n);
+                if (i >= len || o + count > dstLen) return 0;
+                std::memset(dst + o, src[i++], count);
+                o += count;
+            }
+        }
+        return i;
+    }
+
+    // Header (and the rule of multi-state grids), then the rows; the header is rewritten
+    // at the end once the payload size is known
+    static bool writeSnapshot(FILE* f, const uint8_t* cells, int w, int h, const core::LifeRule& rule, bool compress) {
+        const bool states = rule.states > 2;
+        SnapshotHeader header{};
+        header.version = states ? 2u : 1u; // two-state snapshots stay readable by version 1 readers
+        header.width = static_cast<uint32_t>(w);
+        header.height = static_cast<uint32_t>(h);
+        header.flags = (compress ? kSnapshotPackBits : 0u) | (states ? kSnapshotStates : 0u);
+        header.rowBytes = static_cast<uint32_t>(states ? (w + 3) / 4 : (w + 7) / 8);
+
+        bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1;
+        if (states) {
+            const SnapshotRule stored = toSnapshotRule(rule);
+            ok = ok && std::fwrite(&stored, sizeof(stored), 1, f) == 1;
+        }
+
+        std::vector<uint8_t> packed(header.rowBytes);
+        std::vector<uint8_t> encoded;
+        for (int y = 0; y < h && ok; ++y) {
+            if (states) packStateRow(cells + static_cast<size_t>(y) * w, w, packed.data());
+            else packRow(cells + static_cast<size_t>(y) * w, w, packed.data());
+            if (compress) {
+                // Rows are encoded independently so memory stays bounded by one row
+                encoded.clear();
+                packBitsEncode(packed.data(), packed.size(), encoded);
+                ok = std::fwrite(encoded.data(), 1, encoded.size(), f) == encoded.size();
+                header.payloadBytes += encoded.size();
+            }
+            else {
+                ok = std::fwrite(packed.data(), 1, packed.size(), f) == packed.size();
+                header.payloadBytes += packed.size();
+            }
+        }
+
+        return ok && std::fseek(f, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, f) == 1;
+    }
+
+    // Flush the file's data to the device (not just to the OS cache)
+    static bool syncFile(FILE* f) {
+        if (std::fflush(f) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(f)) == 0;
+#else
+        return fsync(fileno(f)) == 0;
+#endif
+    }
+
+    // Make a rename inside dir durable (POSIX; NTFS journals renames itself)
+    static void syncDirectory(const std::filesystem::path& dir) {
+#ifndef _WIN32
+        const int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        fsync(fd);
+        ::close(fd);
+#else
+        (void)dir;
+#endif
+    }
+
+    void saveSnapshot(const char* path, const core::Life& life, bool compress) {
+        FILE* f = std::fopen(path, "wb");
+        if (!f) throw std::runtime_error(std::string("Cannot open for writing: ") + path);
+
+        bool ok = writeSnapshot(f, life.data(), life.gridWidth_, life.gridHeight_, life.rule(), compress);
+        ok = (std::fclose(f) == 0) && ok;
+        if (!ok) throw std::runtime_error(std::string("Write failed: ") + path);
+    }
+
+    void saveSnapshotDurable(const char* path, const uint8_t* cells, int width, int height, const core::LifeRule& rule) {
+        const std::filesystem::path target(path);
+        std::filesystem::path tmp = target;
+        tmp += ".tmp";
+
+        FILE* f = std::fopen(tmp.string().c_str(), "wb");
+        if (!f) throw std::runtime_error("Cannot open for writing: " + tmp.string());
+
+        bool ok = writeSnapshot(f, cells, width, height, rule, true) && syncFile(f);
+        ok = (std::fclose(f) == 0) && ok;
+
+        // Readers see the old file or the whole new one, never a torn one
+        std::error_code ec;
+        if (ok) std::filesystem::rename(tmp, target, ec);
+        if (!ok || ec) {
+            std::filesystem::remove(tmp, ec);
+            throw std::runtime_error(std::string("Write failed: ") + path);
+        }
+        syncDirectory(target.parent_path());
+    }
+
+    core::Life loadSnapshot(const char* path) {
+        utils::MappedFile file;
+        if (!file.open(path)) throw std::runtime_error(std::string("Cannot open: ") + path);
+
+        SnapshotHeader header{};
+        if (file.size() < sizeof(header)) throw std::runtime_error(std::string("Truncated snapshot: ") + path);
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        const SnapshotHeader expected{};
+        const bool states = (header.flags & kSnapshotStates) != 0;
+        if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != (states ? 2u : 1u)) {
+            throw std::runtime_error(std::string("Not a snapshot: ") + path);
+        }
+        const size_t ruleBytes = states ? sizeof(SnapshotRule) : 0;
+        if (header.width == 0 || header.height == 0 || header.width > 1u << 20 || header.height > 1u << 20 ||
+            header.rowBytes != (states ? (header.width + 3) / 4 : (header.width + 7) / 8) ||
+            file.size() < sizeof(header) + ruleBytes || header.payloadBytes > file.size() - sizeof(header) - ruleBytes) {
+            throw std::runtime_error(std::string("Corrupt snapshot header: ") + path);
+        }
+        // Life indexes cells with int
+        if (static_cast<uint64_t>(header.width) * header.height > INT_MAX) {
+            throw std::runtime_error(std::string("Snapshot too large: ") + path);
+        }
+        // Check the payload can cover every row before allocating the grid: a PackBits control byte
+        // plus its data byte yields at most 128 bytes, so a row takes at least 2 per 128
+        const uint64_t minPayload = header.flags & kSnapshotPackBits
+            ? static_cast<uint64_t>(header.height) * 2 * ((header.rowBytes + 127) / 128)
+            : static_cast<uint64_t>(header.rowBytes) * header.height;
+        if (header.payloadBytes < minPayload) throw std::runtime_error(std::string("Corrupt snapshot payload: ") + path);
+
+        const int w = static_cast<int>(header.width);
+        const int h = static_cast<int>(header.height);
+        const uint8_t* payload = file.data() + sizeof(header) + ruleBytes;
+        const size_t rawBytes = static_cast<size_t>(header.rowBytes) * header.height;
+
+        core::Life life(w, h);
+        uint8_t* cells = life.data();
+        if (states) {
+            SnapshotRule stored;
+            std::memcpy(&stored, file.data() + sizeof(header), sizeof(stored));
+            core::LifeRule rule;
+            if (!fromSnapshotRule(stored, rule)) throw std::runtime_error(std::string("Corrupt snapshot rule: ") + path);
+            life.setRule(rule);
+        }
+        const auto unpack = states ? unpackStateRow : unpackRow;
+
+        if (header.flags & kSnapshotPackBits) {
+            // Rows were encoded independently: decode one row at a time from the mapping
+            std::vector<uint8_t> row(header.rowBytes);
+            size_t offset = 0;
+            for (int y = 0; y < h; ++y) {
+                const size_t used = packBitsDecode(payload + offset, static_cast<size_t>(header.payloadBytes) - offset, row.data(), row.size());
+                if (used == 0) throw std::runtime_error(std::string("Corrupt snapshot payload: ") + path);
+                offset += used;
+                unpack(row.data(), w, cells + static_cast<size_t>(y) * w);
+            }
+        }
+        else {
+            if (header.payloadBytes != rawBytes) throw std::runtime_error(std::string("Corrupt snapshot payload: ") + path);
+            // Rows are unpacked straight from the mapped pages
+            for (int y = 0; y < h; ++y) {
+                unpack(payload + static_cast<size_t>(y) * header.rowBytes, w, cells + static_cast<size_t>(y) * w);
+            }
+        }
+
+        return life;
+    }
+
+}
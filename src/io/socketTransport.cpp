@@ -0,0 +1,259 @@
+#include "../../include/io/socketTransport.h"
+#include "../../include/io/socketPlatform.h"
+#include "../../include/utils/profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+namespace io {
+
+    namespace {
+
+        using namespace net;
+
+        struct Address {
+            sockaddr_storage storage{};
+            AddressLength length = 0;
+            int family = AF_INET;
+            std::string path;         // socket file of a Unix address
+        };
+
+        Address makeAddress(const SocketEndpoint& endpoint, int rank) {
+            Address a;
+            if (endpoint.kind == SocketKind::Tcp) {
+                sockaddr_in in{};
+                in.sin_family = AF_INET;
+                in.sin_port = htons(static_cast<uint16_t>(endpoint.basePort + rank));
+                if (endpoint.basePort + rank > 65535 || inet_pton(AF_INET, endpoint.host.c_str(), &in.sin_addr) != 1) {
+                    throw std::runtime_error("Invalid TCP address " + endpoint.host + ":" + std::to_string(endpoint.basePort + rank));
+                }
+                std::memcpy(&a.storage, &in, sizeof(in));
+                a.length = sizeof(in);
+                return a;
+            }
+#ifdef _WIN32
+            throw std::runtime_error("Unix sockets are not supported on this platform");
+#else
+            sockaddr_un un{};
+            un.sun_family = AF_UNIX;
+            a.path = endpoint.path + "." + std::to_string(rank);
+            if (a.path.size() >= sizeof(un.sun_path)) throw std::runtime_error("Socket path too long: " + a.path);
+            std::memcpy(un.sun_path, a.path.c_str(), a.path.size() + 1);
+            std::memcpy(&a.storage, &un, sizeof(un));
+            a.length = sizeof(un);
+            a.family = AF_UNIX;
+            return a;
+#endif
+        }
+
+        // Progress of the messages to and from one peer
+        struct Channel {
+            std::vector<const SendBuffer*> sends;
+            std::vector<const ReceiveBuffer*> receives;
+            size_t sendIndex = 0, sendOffset = 0;
+            size_t receiveIndex = 0, receiveOffset = 0;
+
+            bool sending() {
+                while (sendIndex < sends.size() && sendOffset == sends[sendIndex]->size) {
+                    ++sendIndex;
+                    sendOffset = 0;
+                }
+                return sendIndex < sends.size();
+            }
+
+            bool receiving() {
+                while (receiveIndex < receives.size() && receiveOffset == receives[receiveIndex]->size) {
+                    ++receiveIndex;
+                    receiveOffset = 0;
+                }
+                return receiveIndex < receives.size();
+            }
+        };
+
+    }
+
+    SocketTransport::SocketTransport(const SocketEndpoint& endpoint, int rank, int ranks, const std::vector<int>& peers, double timeoutSeconds)
+        : rank_(rank), ranks_(ranks), sockets_(static_cast<size_t>(ranks), -1), timeout_(timeoutSeconds) {
+        net::initSockets();
+        if (rank < 0 || rank >= ranks) throw std::runtime_error("Rank " + std::to_string(rank) + " outside 0.." + std::to_string(ranks - 1));
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeoutSeconds);
+
+        std::vector<int> lower, higher;
+        for (int p : peers) {
+            if (p < 0 || p >= ranks) throw std::runtime_error("Peer rank " + std::to_string(p) + " outside 0.." + std::to_string(ranks - 1));
+            if (p < rank && std::find(lower.begin(), lower.end(), p) == lower.end()) lower.push_back(p);
+            if (p > rank && std::find(higher.begin(), higher.end(), p) == higher.end()) higher.push_back(p);
+        }
+
+        // Listen first so higher ranks can queue their connections while we connect down
+        const Address self = makeAddress(endpoint, rank);
+        Handle listener = socket(self.family, SOCK_STREAM, 0);
+        if (listener == kInvalid) throw std::runtime_error("Cannot create socket: " + socketError());
+        if (self.family == AF_INET) {
+            const int on = 1;
+            setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&on), sizeof(on));
+        }
+#ifndef _WIN32
+        if (!self.path.empty()) unlink(self.path.c_str());
+#endif
+        auto cleanupListener = [&]() {
+            closeHandle(listener);
+#ifndef _WIN32
+            if (!self.path.empty()) unlink(self.path.c_str());
+#endif
+        };
+
+        try {
+            if (bind(listener, reinterpret_cast<const sockaddr*>(&self.storage), self.length) != 0 ||
+                listen(listener, std::max(ranks, 8)) != 0) {
+                throw std::runtime_error("Cannot listen as rank " + std::to_string(rank) + ": " + socketError());
+            }
+
+            // Connect to lower ranks, retrying until they listen
+            for (int p : lower) {
+                const Address peer = makeAddress(endpoint, p);
+                for (;;) {
+                    const Handle s = socket(peer.family, SOCK_STREAM, 0);
+                    if (s == kInvalid) throw std::runtime_error("Cannot create socket: " + socketError());
+                    if (connect(s, reinterpret_cast<const sockaddr*>(&peer.storage), peer.length) == 0) {
+                        sockets_[p] = static_cast<Socket>(s);
+                        break;
+                    }
+                    closeHandle(s);
+                    if (std::chrono::steady_clock::now() > deadline) throw std::runtime_error("Timed out connecting to rank " + std::to_string(p));
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                }
+
+                // Introduce ourselves: the acceptor cannot tell ranks apart otherwise
+                const uint8_t id[4] = { uint8_t(rank), uint8_t(rank >> 8), uint8_t(rank >> 16), uint8_t(rank >> 24) };
+                if (!sendAll(static_cast<Handle>(sockets_[p]), id, sizeof(id))) throw std::runtime_error("Lost rank " + std::to_string(p) + " while connecting");
+            }
+
+            // Accept higher ranks in whatever order they arrive
+            for (size_t accepted = 0; accepted < higher.size(); ++accepted) {
+                PollFd fd{};
+                fd.fd = listener;
+                fd.events = POLLIN;
+                const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+                if (left <= 0 || pollSockets(&fd, 1, static_cast<int>(left)) <= 0) throw std::runtime_error("Timed out waiting for higher ranks to connect");
+
+                const Handle s = accept(listener, nullptr, nullptr);
+                if (s == kInvalid) throw std::runtime_error("Cannot accept a connection: " + socketError());
+                uint8_t id[4];
+                if (!receiveAll(s, id, sizeof(id))) {
+                    closeHandle(s);
+                    throw std::runtime_error("A peer disconnected while connecting");
+                }
+                const int p = id[0] | (id[1] << 8) | (id[2] << 16) | (id[3] << 24);
+                if (std::find(higher.begin(), higher.end(), p) == higher.end() || sockets_[p] != -1) {
+                    closeHandle(s);
+                    throw std::runtime_error("Unexpected connection from rank " + std::to_string(p));
+                }
+                sockets_[p] = static_cast<Socket>(s);
+            }
+
+            for (int p = 0; p < ranks; ++p) {
+                if (sockets_[p] == -1) continue;
+                const Handle s = static_cast<Handle>(sockets_[p]);
+                if (!setNonBlocking(s)) throw std::runtime_error("Cannot make a socket non-blocking: " + socketError());
+                if (self.family == AF_INET) setNoDelay(s); // halos are small and latency-bound
+            }
+        }
+        catch (...) {
+            cleanupListener();
+            closeAll();
+            throw;
+        }
+        cleanupListener();
+    }
+
+    SocketTransport::~SocketTransport() {
+        closeAll();
+    }
+
+    void SocketTransport::closeAll() {
+        for (Socket& s : sockets_) {
+            if (s != -1) closeHandle(static_cast<Handle>(s));
+            s = -1;
+        }
+    }
+
+    void SocketTransport::exchange(const std::vector<SendBuffer>& sends, const std::vector<ReceiveBuffer>& receives) {
+        PROFILE_SCOPE("Transport exchange");
+
+        // Messages to ourselves pair up in order and never touch a socket
+        std::vector<const SendBuffer*> selfSends;
+        std::vector<const ReceiveBuffer*> selfReceives;
+        std::vector<Channel> channels(static_cast<size_t>(ranks_));
+        for (const SendBuffer& s : sends) {
+            if (s.peer == rank_) selfSends.push_back(&s);
+            else if (s.peer < 0 || s.peer >= ranks_ || sockets_[s.peer] == -1) throw std::runtime_error("Rank " + std::to_string(rank_) + " is not connected to rank " + std::to_string(s.peer));
+            else channels[s.peer].sends.push_back(&s);
+        }
+        for (const ReceiveBuffer& r : receives) {
+            if (r.peer == rank_) selfReceives.push_back(&r);
+            else if (r.peer < 0 || r.peer >= ranks_ || sockets_[r.peer] == -1) throw std::runtime_error("Rank " + std::to_string(rank_) + " is not connected to rank " + std::to_string(r.peer));
+            else channels[r.peer].receives.push_back(&r);
+        }
+        if (selfSends.size() != selfReceives.size()) throw std::runtime_error("Unmatched message to self");
+        for (size_t i = 0; i < selfSends.size(); ++i) {
+            if (selfSends[i]->size != selfReceives[i]->size) throw std::runtime_error("Message to self has the wrong size");
+            if (selfSends[i]->size) std::memcpy(selfReceives[i]->data, selfSends[i]->data, selfSends[i]->size);
+        }
+
+        std::vector<PollFd> fds;
+        std::vector<int> fdPeers;
+        for (;;) {
+            fds.clear();
+            fdPeers.clear();
+            for (int p = 0; p < ranks_; ++p) {
+                Channel& c = channels[p];
+                const short events = static_cast<short>((c.sending() ? POLLOUT : 0) | (c.receiving() ? POLLIN : 0));
+                if (!events) continue;
+                PollFd fd{};
+                fd.fd = static_cast<Handle>(sockets_[p]);
+                fd.events = events;
+                fds.push_back(fd);
+                fdPeers.push_back(p);
+            }
+            if (fds.empty()) return;
+
+            const int ready = pollSockets(fds.data(), fds.size(), static_cast<int>(timeout_ * 1000.0));
+            if (ready == 0) throw std::runtime_error("Timed out exchanging with rank " + std::to_string(fdPeers.front()));
+            if (ready < 0) {
+                if (wouldBlock()) continue;
+                throw std::runtime_error("poll failed: " + socketError());
+            }
+
+            for (size_t i = 0; i < fds.size(); ++i) {
+                const int p = fdPeers[i];
+                Channel& c = channels[p];
+                const Handle s = fds[i].fd;
+                const short revents = fds[i].revents;
+
+                while ((revents & POLLOUT) && c.sending()) {
+                    const SendBuffer& m = *c.sends[c.sendIndex];
+                    const long n = sendSome(s, m.data + c.sendOffset, m.size - c.sendOffset);
+                    if (n < 0 && wouldBlock()) break;
+                    if (n <= 0) throw std::runtime_error("Lost rank " + std::to_string(p) + ": " + socketError());
+                    c.sendOffset += static_cast<size_t>(n);
+                    bytesSent_ += static_cast<uint64_t>(n);
+                }
+
+                while ((revents & (POLLIN | POLLHUP | POLLERR)) && c.receiving()) {
+                    const ReceiveBuffer& m = *c.receives[c.receiveIndex];
+                    const long n = receiveSome(s, m.data + c.receiveOffset, m.size - c.receiveOffset);
+                    if (n < 0 && wouldBlock()) break;
+                    if (n == 0) throw std::runtime_error("Rank " + std::to_string(p) + " disconnected");
+                    if (n < 0) throw std::runtime_error("Lost rank " + std::to_string(p) + ": " + socketError());
+                    c.receiveOffset += static_cast<size_t>(n);
+                }
+                if ((revents & (POLLERR | POLLNVAL)) && !(revents & POLLIN)) throw std::runtime_error("Lost rank " + std::to_string(p));
+            }
+        }
+    }
+
+}
@@ -0,0 +1,130 @@
+#include "../../include/io/streamClient.h"
+#include "../../include/core/deltaCodec.h"
+#include "../../include/io/socketPlatform.h"
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace io {
+
+    using namespace net;
+
+    StreamClient::StreamClient(const std::string& host, int port) {
+        initSockets();
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        if (port <= 0 || port > 65535 || inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+            throw std::runtime_error("Invalid address " + host + ":" + std::to_string(port));
+        }
+
+        const Handle s = socket(AF_INET, SOCK_STREAM, 0);
+        if (s == kInvalid) throw std::runtime_error("Cannot create socket: " + socketError());
+        if (connect(s, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            const std::string error = socketError();
+            closeHandle(s);
+            throw std::runtime_error("Cannot connect to " + host + ":" + std::to_string(port) + ": " + error);
+        }
+        setNoDelay(s);
+        socket_ = static_cast<intptr_t>(s);
+    }
+
+    StreamClient::~StreamClient() {
+        if (socket_ != -1) closeHandle(static_cast<Handle>(socket_));
+    }
+
+    bool StreamClient::receiveFrame(double timeoutSeconds) {
+        const Handle s = static_cast<Handle>(socket_);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeoutSeconds);
+
+        // Frames are the only messages a server sends; wait for the start of one
+        PollFd fd{};
+        fd.fd = s;
+        fd.events = POLLIN;
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        if (pollSockets(&fd, 1, static_cast<int>(left > 0 ? left : 0)) <= 0) return false;
+
+        StreamMessageHeader header;
+        if (!receiveAll(s, reinterpret_cast<uint8_t*>(&header), sizeof(header))) throw std::runtime_error("Server disconnected");
+        if (static_cast<StreamMessage>(header.type) != StreamMessage::Frame || header.bytes < sizeof(StreamFrameHeader) ||
+            header.bytes > kMaxStreamPayload) {
+            throw std::runtime_error("Malformed message from the server");
+        }
+
+        payload_.resize(header.bytes);
+        if (!receiveAll(s, payload_.data(), payload_.size())) throw std::runtime_error("Server disconnected");
+        bytesReceived_ += sizeof(header) + header.bytes;
+
+        StreamFrameHeader frame;
+        std::memcpy(&frame, payload_.data(), sizeof(frame));
+        const uint64_t count = static_cast<uint64_t>(frame.width) * frame.height;
+        if (count > kMaxStreamCells) throw std::runtime_error("Frame too large");
+        if (frame.states < 2 || frame.states > core::kMaxStates) throw std::runtime_error("Malformed frame");
+
+        // A keyframe replaces the grid; a delta flips the cells that changed
+        if (frame.keyframe) cells_.assign(static_cast<size_t>(count), 0);
+        else if (cells_.size() != count) throw std::runtime_error("Delta frame without a keyframe");
+        if (!core::applyXorDelta(payload_.data() + sizeof(frame), payload_.size() - sizeof(frame), cells_.data(), cells_.size(),
+                                 frame.states > 2 ? 2 : 1)) {
+            throw std::runtime_error("Corrupt frame");
+        }
+
+        frame_ = frame;
+        ++framesReceived_;
+        send(StreamMessage::Ack, nullptr, 0);
+        return true;
+    }
+
+    void StreamClient::send(StreamMessage type, const void* payload, size_t bytes) {
+        StreamMessageHeader header;
+        header.type = static_cast<uint32_t>(type);
+        header.bytes = static_cast<uint32_t>(bytes);
+        const Handle s = static_cast<Handle>(socket_);
+        if (!sendAll(s, reinterpret_cast<const uint8_t*>(&header), sizeof(header)) ||
+            (bytes && !sendAll(s, static_cast<const uint8_t*>(payload), bytes))) {
+            throw std::runtime_error("Lost the server: " + socketError());
+        }
+    }
+
+    void StreamClient::play() {
+        send(StreamMessage::Play, nullptr, 0);
+    }
+
+    void StreamClient::pause() {
+        send(StreamMessage::Pause, nullptr, 0);
+    }
+
+    void StreamClient::step(uint32_t generations) {
+        send(StreamMessage::Step, &generations, sizeof(generations));
+    }
+
+    void StreamClient::setSpeed(float stepsPerSecond) {
+        send(StreamMessage::Speed, &stepsPerSecond, sizeof(stepsPerSecond));
+    }
+
+    void StreamClient::edit(const std::vector<StreamCellEdit>& edits) {
+        send(StreamMessage::Edit, edits.data(), edits.size() * sizeof(StreamCellEdit));
+    }
+
+    void StreamClient::load(const core::Life& life) {
+        const size_t count = static_cast<size_t>(life.gridWidth_) * static_cast<size_t>(life.gridHeight_);
+        if (count > kMaxStreamCells) throw std::runtime_error("Grid too large to send");
+
+        const uint32_t size[2] = { static_cast<uint32_t>(life.gridWidth_), static_cast<uint32_t>(life.gridHeight_) };
+        std::vector<uint8_t> message(sizeof(size));
+        std::memcpy(message.data(), size, sizeof(size));
+        if (life.rule().states > 2) {
+            // Only the live cells are sent; the server keeps its own rule
+            std::vector<uint8_t> live(count);
+            for (size_t i = 0; i < count; ++i) live[i] = life.data()[i] == 1;
+            core::encodeCells(live.data(), count, message);
+        }
+        else {
+            core::encodeCells(life.data(), count, message);
+        }
+        send(StreamMessage::Load, message.data(), message.size());
+    }
+
+}
@@ -0,0 +1,347 @@
+#include "../../include/io/streamServer.h"
+#include "../../include/core/deltaCodec.h"
+#include "../../include/io/socketPlatform.h"
+#include "../../include/utils/profiler.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace io {
+
+    using namespace net;
+
+    // How long the server thread sleeps in poll() before looking for a new grid
+    static constexpr int kPollMs = 5;
+
+    // Bytes read from a client per recv()
+    static constexpr size_t kReceiveChunk = 64 * 1024;
+
+    struct StreamServer::Client {
+        Handle socket = kInvalid;
+        std::vector<uint8_t> in;       // received bytes not parsed yet
+        std::vector<uint8_t> out;      // frame being sent
+        size_t outOffset = 0;
+
+        std::vector<uint8_t> shown;    // grid as the client has it after its last frame
+        int shownW = 0, shownH = 0, shownStates = 2;
+        uint64_t serial = 0;           // working serial of the last frame, 0 before the first
+        int inFlight = 0;              // frames sent but not acknowledged
+        bool running = false;          // status sent with the last frame
+        float stepsPerSecond = 0.0f;
+
+        bool sending() const {
+            return outOffset < out.size();
+        }
+    };
+
+    StreamServer::StreamServer() = default;
+
+    StreamServer::~StreamServer() {
+        stop();
+    }
+
+    bool StreamServer::start(const StreamServerSettings& settings, std::string& error) {
+        stop();
+        initSockets();
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(settings.port));
+        if (settings.port < 0 || settings.port > 65535 || inet_pton(AF_INET, settings.host.c_str(), &address.sin_addr) != 1) {
+            error = "Invalid address " + settings.host + ":" + std::to_string(settings.port);
+            return false;
+        }
+
+        const Handle s = socket(AF_INET, SOCK_STREAM, 0);
+        if (s == kInvalid) {
+            error = "Cannot create socket: " + socketError();
+            return false;
+        }
+        const int on = 1;
+        setsockopt(s, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&on), sizeof(on));
+
+        AddressLength length = sizeof(address);
+        if (bind(s, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(s, 8) != 0 ||
+            !setNonBlocking(s) || getsockname(s, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            error = "Cannot listen on " + settings.host + ":" + std::to_string(settings.port) + ": " + socketError();
+            closeHandle(s);
+            return false;
+        }
+
+        listener_ = static_cast<intptr_t>(s);
+        port_ = ntohs(address.sin_port);
+        maxClients_ = settings.maxClients;
+        stopping_ = false;
+        gridSkipped_ = false;
+        thread_ = std::thread(&StreamServer::run, this);
+        return true;
+    }
+
+    void StreamServer::stop() {
+        if (!active()) return;
+        stopping_ = true;
+        thread_.join();
+
+        for (const std::unique_ptr<Client>& c : clients_) closeHandle(c->socket);
+        clients_.clear();
+        closeHandle(static_cast<Handle>(listener_));
+        listener_ = -1;
+        clientCount_ = 0;
+
+        std::lock_guard<std::mutex> lock(commandMutex_);
+        commands_.clear();
+    }
+
+    void StreamServer::publish(const core::Life& life, uint64_t generation) {
+        const size_t count = static_cast<size_t>(life.gridWidth_) * static_cast<size_t>(life.gridHeight_);
+        if (!active() || count > kMaxStreamCells) return;
+
+        // Nobody to send it to; wantsGrid() asks for a grid once someone connects
+        if (clientCount() == 0) {
+            gridSkipped_.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        // The server thread holds the lock only to swap buffers
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        gridSkipped_.store(false, std::memory_order_relaxed);
+        pending_.assign(life.data(), life.data() + count);
+        pendingW_ = life.gridWidth_;
+        pendingH_ = life.gridHeight_;
+        pendingStates_ = life.rule().states;
+        pendingGeneration_ = generation;
+        ++pendingSerial_;
+    }
+
+    void StreamServer::setStatus(bool running, float stepsPerSecond) {
+        running_.store(running, std::memory_order_relaxed);
+        stepsPerSecond_.store(stepsPerSecond, std::memory_order_relaxed);
+    }
+
+    bool StreamServer::pollCommand(StreamCommand& command) {
+        std::lock_guard<std::mutex> lock(commandMutex_);
+        if (commands_.empty()) return false;
+        command = std::move(commands_.front());
+        commands_.pop_front();
+        return true;
+    }
+
+    void StreamServer::run() {
+        const Handle listener = static_cast<Handle>(listener_);
+        std::vector<PollFd> fds;
+
+        while (!stopping_.load(std::memory_order_relaxed)) {
+            fds.clear();
+            PollFd fd{};
+            fd.fd = listener;
+            fd.events = POLLIN;
+            fds.push_back(fd);
+            for (const std::unique_ptr<Client>& c : clients_) {
+                fd.fd = c->socket;
+                fd.events = static_cast<short>(POLLIN | (c->sending() ? POLLOUT : 0));
+                fds.push_back(fd);
+            }
+            // Short timeout: new grids arrive without a socket event
+            pollSockets(fds.data(), fds.size(), kPollMs);
+
+            // Socket events of the clients that were polled
+            std::vector<bool> alive(clients_.size(), true);
+            for (size_t i = 0; i < clients_.size(); ++i) {
+                Client& c = *clients_[i];
+                const short revents = fds[i + 1].revents;
+                if (revents & (POLLIN | POLLHUP | POLLERR)) alive[i] = receiveCommands(c);
+                if (alive[i] && (revents & POLLOUT)) alive[i] = flush(c);
+                if (revents & POLLNVAL) alive[i] = false;
+            }
+
+            // New clients start with a keyframe of the newest grid
+            if (fds[0].revents & POLLIN) {
+                for (;;) {
+                    const Handle s = accept(listener, nullptr, nullptr);
+                    if (s == kInvalid) break;
+                    if (static_cast<int>(clients_.size()) >= maxClients_ || !setNonBlocking(s)) {
+                        closeHandle(s);
+                        continue;
+                    }
+                    setNoDelay(s);
+                    auto client = std::make_unique<Client>();
+                    client->socket = s;
+                    clients_.push_back(std::move(client));
+                    alive.push_back(true);
+                }
+            }
+
+            // Take the newest grid, if publish() offered one
+            bool fresh = false;
+            {
+                std::lock_guard<std::mutex> lock(frameMutex_);
+                if (pendingSerial_ != workingSerial_) {
+                    working_.swap(pending_);
+                    workingW_ = pendingW_;
+                    workingH_ = pendingH_;
+                    workingStates_ = pendingStates_;
+                    workingGeneration_ = pendingGeneration_;
+                    workingSerial_ = pendingSerial_;
+                    fresh = true;
+                }
+            }
+            if (fresh) {
+                uint64_t population = 0;
+                for (uint8_t cell : working_) population += cell == 1; // dying states are not live
+                workingPopulation_ = population;
+            }
+
+            // Clients ready for another frame get the newest state, unless it is outdated
+            const bool outdated = gridSkipped_.load(std::memory_order_relaxed);
+            const bool running = running_.load(std::memory_order_relaxed);
+            const float stepsPerSecond = stepsPerSecond_.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < clients_.size(); ++i) {
+                Client& c = *clients_[i];
+                if (!alive[i] || c.sending() || c.inFlight >= kStreamFramesInFlight || workingSerial_ == 0 || outdated) continue;
+                if (c.serial == workingSerial_ && c.running == running && c.stepsPerSecond == stepsPerSecond) continue;
+                encodeFrame(c);
+                alive[i] = flush(c);
+            }
+
+            for (size_t i = clients_.size(); i-- > 0;) {
+                if (alive[i]) continue;
+                closeHandle(clients_[i]->socket);
+                clients_.erase(clients_.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+            clientCount_.store(static_cast<int>(clients_.size()), std::memory_order_relaxed);
+        }
+    }
+
+    bool StreamServer::flush(Client& c) {
+        while (c.sending()) {
+            const long n = sendSome(c.socket, c.out.data() + c.outOffset, c.out.size() - c.outOffset);
+            if (n < 0 && wouldBlock()) return true;
+            if (n <= 0) return false;
+            c.outOffset += static_cast<size_t>(n);
+        }
+        c.out.clear();
+        c.outOffset = 0;
+        return true;
+    }
+
+    void StreamServer::encodeFrame(Client& c) {
+        PROFILE_SCOPE("Stream encode");
+        const size_t count = working_.size();
+        const bool keyframe = c.serial == 0 || c.shownW != workingW_ || c.shownH != workingH_ || c.shownStates != workingStates_;
+        const int planes = workingStates_ > 2 ? 2 : 1;
+
+        scratch_.clear();
+        if (keyframe) core::encodeCells(working_.data(), count, scratch_, planes);
+        else core::encodeXorDelta(c.shown.data(), working_.data(), count, scratch_, planes);
+
+        StreamFrameHeader frame;
+        frame.generation = workingGeneration_;
+        frame.population = workingPopulation_;
+        frame.width = static_cast<uint32_t>(workingW_);
+        frame.height = static_cast<uint32_t>(workingH_);
+        frame.skipped = (c.serial == 0 || workingSerial_ == c.serial) ? 0 : static_cast<uint32_t>(workingSerial_ - c.serial - 1);
+        frame.keyframe = keyframe ? 1 : 0;
+        frame.states = static_cast<uint8_t>(workingStates_);
+        frame.running = running_.load(std::memory_order_relaxed) ? 1 : 0;
+        frame.stepsPerSecond = stepsPerSecond_.load(std::memory_order_relaxed);
+
+        StreamMessageHeader header;
+        header.type = static_cast<uint32_t>(StreamMessage::Frame);
+        header.bytes = static_cast<uint32_t>(sizeof(frame) + scratch_.size());
+
+        c.out.resize(sizeof(header) + sizeof(frame) + scratch_.size());
+        std::memcpy(c.out.data(), &header, sizeof(header));
+        std::memcpy(c.out.data() + sizeof(header), &frame, sizeof(frame));
+        if (!scratch_.empty()) std::memcpy(c.out.data() + sizeof(header) + sizeof(frame), scratch_.data(), scratch_.size());
+        c.outOffset = 0;
+
+        c.shown.assign(working_.begin(), working_.end());
+        c.shownW = workingW_;
+        c.shownH = workingH_;
+        c.shownStates = workingStates_;
+        c.serial = workingSerial_;
+        ++c.inFlight;
+        c.running = frame.running != 0;
+        c.stepsPerSecond = frame.stepsPerSecond;
+
+        framesSent_.fetch_add(1, std::memory_order_relaxed);
+        framesSkipped_.fetch_add(frame.skipped, std::memory_order_relaxed);
+    }
+
+    bool StreamServer::receiveCommands(Client& c) {
+        // Drain the socket
+        for (;;) {
+            const size_t used = c.in.size();
+            c.in.resize(used + kReceiveChunk);
+            const long n = receiveSome(c.socket, c.in.data() + used, kReceiveChunk);
+            c.in.resize(used + (n > 0 ? static_cast<size_t>(n) : 0));
+            if (n < 0 && wouldBlock()) break;
+            if (n <= 0) return false;
+        }
+
+        // Parse every complete message
+        size_t pos = 0;
+        while (c.in.size() - pos >= sizeof(StreamMessageHeader)) {
+            StreamMessageHeader header;
+            std::memcpy(&header, c.in.data() + pos, sizeof(header));
+            if (header.bytes > kMaxStreamPayload) return false;
+            if (c.in.size() - pos - sizeof(header) < header.bytes) break;
+
+            const uint8_t* payload = c.in.data() + pos + sizeof(header);
+            pos += sizeof(header) + header.bytes;
+
+            if (static_cast<StreamMessage>(header.type) == StreamMessage::Ack) {
+                if (header.bytes != 0 || c.inFlight == 0) return false;
+                --c.inFlight;
+                continue;
+            }
+
+            StreamCommand command;
+            switch (static_cast<StreamMessage>(header.type)) {
+            case StreamMessage::Play:
+            case StreamMessage::Pause:
+                if (header.bytes != 0) return false;
+                command.type = static_cast<StreamMessage>(header.type) == StreamMessage::Play ? StreamCommandType::Play : StreamCommandType::Pause;
+                break;
+            case StreamMessage::Step:
+                if (header.bytes != sizeof(uint32_t)) return false;
+                command.type = StreamCommandType::Step;
+                std::memcpy(&command.steps, payload, sizeof(uint32_t));
+                if (command.steps > kMaxStreamSteps) command.steps = kMaxStreamSteps;
+                break;
+            case StreamMessage::Speed:
+                if (header.bytes != sizeof(float)) return false;
+                command.type = StreamCommandType::Speed;
+                std::memcpy(&command.stepsPerSecond, payload, sizeof(float));
+                if (!std::isfinite(command.stepsPerSecond)) return false;
+                break;
+            case StreamMessage::Edit:
+                if (header.bytes % sizeof(StreamCellEdit) != 0) return false;
+                command.type = StreamCommandType::Edit;
+                command.edits.resize(header.bytes / sizeof(StreamCellEdit));
+                if (header.bytes) std::memcpy(command.edits.data(), payload, header.bytes);
+                break;
+            case StreamMessage::Load: {
+                // Decoded here so the simulation thread only swaps the grid in
+                uint32_t size[2];
+                if (header.bytes < sizeof(size)) return false;
+                std::memcpy(size, payload, sizeof(size));
+                const uint64_t count = static_cast<uint64_t>(size[0]) * size[1];
+                if (size[0] == 0 || size[1] == 0 || size[0] > 0x7FFFFFFF || size[1] > 0x7FFFFFFF || count > kMaxStreamCells) return false;
+                command.type = StreamCommandType::Load;
+                command.pattern = std::make_unique<core::Life>(static_cast<int>(size[0]), static_cast<int>(size[1]));
+                if (!core::applyXorDelta(payload + sizeof(size), header.bytes - sizeof(size), command.pattern->data(), static_cast<size_t>(count))) return false;
+                break;
+            }
+            default:
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(commandMutex_);
+            commands_.push_back(std::move(command));
+        }
+        c.in.erase(c.in.begin(), c.in.begin() + static_cast<std::ptrdiff_t>(pos));
+        return true;
+    }
+
+}
@@ -0,0 +1,257 @@
+#include "../../include/render/frameExporter.h"
+
+#include "../../include/io/imageWriter.h"
+#include "../../include/utils/profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace render {
+
+    FrameExporter::FrameExporter(Renderer2D& r2d, Renderer3D& r3d, const core::OrbitCamera& camera)
+        : r2d_(r2d), r3d_(r3d), camera_(camera) {
+    }
+
+    FrameExporter::~FrameExporter() {
+        stop();
+    }
+
+    bool FrameExporter::start(const ExportSettings& settings, std::string& error) {
+        stop();
+
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxSize);
+        if (settings.width < 16 || settings.height < 16 || settings.width > maxSize || settings.height > maxSize) {
+            error = "Export size must be between 16 and " + std::to_string(maxSize) + " pixels";
+            return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(settings.directory, ec);
+        if (ec) {
+            error = "Cannot create " + settings.directory + ": " + ec.message();
+            return false;
+        }
+
+        settings_ = settings;
+        settings_.everyNth = std::max(1, settings.everyNth);
+
+        // Offscreen target at the export resolution
+        glGenFramebuffers(1, &fbo_);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+        glGenRenderbuffers(1, &colorRb_);
+        glBindRenderbuffer(GL_RENDERBUFFER, colorRb_);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, settings_.width, settings_.height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRb_);
+        glGenRenderbuffers(1, &depthRb_);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthRb_);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, settings_.width, settings_.height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRb_);
+        const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        // Pixel buffers the reads land in asynchronously
+        const GLsizeiptr frameBytes = static_cast<GLsizeiptr>(settings_.width) * settings_.height * 4;
+        for (Slot& s : ring_) {
+            glGenBuffers(1, &s.pbo);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+            glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        active_ = true;
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            stop();
+            error = "Export framebuffer incomplete";
+            return false;
+        }
+
+        stopping_ = false;
+        error_.clear();
+        framesWritten_ = 0;
+        next_ = 0;
+
+        const unsigned hw = std::max(2u, std::thread::hardware_concurrency());
+        const int workers = settings_.workers > 0 ? settings_.workers : static_cast<int>(hw - 1);
+        for (int i = 0; i < workers; ++i) workers_.emplace_back(&FrameExporter::workerLoop, this);
+        return true;
+    }
+
+    void FrameExporter::capture(uint64_t generation) {
+        if (!active_ || generation % static_cast<uint64_t>(settings_.everyNth) != 0) return;
+        PROFILE_SCOPE("Export capture");
+
+        // The GPU is a whole ring behind: wait for the oldest read
+        Slot& slot = ring_[next_];
+        if (slot.fence) harvest(slot, true);
+
+        GLint prevFbo = 0;
+        GLint prevViewport[4] = {0, 0, 0, 0};
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFbo);
+        glGetIntegerv(GL_VIEWPORT, prevViewport);
+        const GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+
+        const int w = settings_.width;
+        const int h = settings_.height;
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+        glViewport(0, 0, w, h);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // Same layout as the window: grid on the left, torus on the right
+        const int leftW = (settings_.view == ExportView::Both) ? w / 2 : (settings_.view == ExportView::View2D ? w : 0);
+        if (leftW > 0) {
+            glDisable(GL_DEPTH_TEST);
+            glViewport(0, 0, leftW, h);
+            r2d_.draw(leftW, h, -1, -1);
+        }
+        if (w - leftW > 0) {
+            glEnable(GL_DEPTH_TEST);
+            glViewport(leftW, 0, w - leftW, h);
+            r3d_.draw(camera_, w - leftW, h);
+        }
+
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.generation = generation;
+        next_ = (next_ + 1) % kRingSize;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFbo));
+        glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+        if (depthTest) glEnable(GL_DEPTH_TEST);
+        else glDisable(GL_DEPTH_TEST);
+
+        // Hand over whatever the GPU has already finished, oldest first
+        for (int i = 0; i < kRingSize; ++i) {
+            Slot& s = ring_[(next_ + i) % kRingSize];
+            if (s.fence) harvest(s, false);
+        }
+    }
+
+    void FrameExporter::harvest(Slot& slot, bool wait) {
+        const GLuint64 timeout = wait ? 1000000000ull : 0; // 1 s per attempt when waiting
+        for (;;) {
+            const GLenum r = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+            if (r == GL_ALREADY_SIGNALED || r == GL_CONDITION_SATISFIED) break;
+            if (r == GL_WAIT_FAILED) {
+                // The read will never be known to be complete: free the slot and drop the frame
+                glDeleteSync(slot.fence);
+                slot.fence = nullptr;
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (error_.empty()) error_ = "Dropped frame " + std::to_string(slot.generation) + ": waiting for the GPU failed";
+                return;
+            }
+            if (!wait) return;
+        }
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+
+        const size_t frameBytes = static_cast<size_t>(settings_.width) * settings_.height * 4;
+        Job job;
+        job.generation = slot.generation;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!spare_.empty()) {
+                job.pixels = std::move(spare_.back());
+                spare_.pop_back();
+            }
+        }
+        job.pixels.resize(frameBytes);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        bool copied = false;
+        if (const void* src = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(frameBytes), GL_MAP_READ_BIT)) {
+            std::memcpy(job.pixels.data(), src, frameBytes);
+            copied = glUnmapBuffer(GL_PIXEL_PACK_BUFFER) == GL_TRUE; // false: the data was corrupted while mapped
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if (!copied) {
+            // The recycled buffer still holds an older frame: drop this one rather than write that
+            std::lock_guard<std::mutex> lock(mutex_);
+            spare_.push_back(std::move(job.pixels));
+            if (error_.empty()) error_ = "Dropped frame " + std::to_string(slot.generation) + ": read-back failed";
+            return;
+        }
+
+        // Bounded queue: if encoding is slower than rendering, slow the caller down
+        std::unique_lock<std::mutex> lock(mutex_);
+        spaceCv_.wait(lock, [this] { return jobs_.size() < kMaxQueued; });
+        jobs_.push_back(std::move(job));
+        cv_.notify_one();
+    }
+
+    void FrameExporter::workerLoop() {
+        std::vector<uint8_t> scratch;
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+                if (jobs_.empty()) return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+                spaceCv_.notify_one();
+            }
+
+            const bool png = settings_.format == ExportFormat::Png;
+            char name[40];
+            std::snprintf(name, sizeof(name), "frame_%08llu.%s", static_cast<unsigned long long>(job.generation), png ? "png" : "rgba");
+            const std::string path = (std::filesystem::path(settings_.directory) / name).string();
+
+            try {
+                if (png) io::writePng(path, job.pixels.data(), settings_.width, settings_.height, true, scratch);
+                else io::writeRaw(path, job.pixels.data(), settings_.width, settings_.height, true);
+                ++framesWritten_;
+            }
+            catch (const std::runtime_error& e) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (error_.empty()) error_ = e.what();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            spare_.push_back(std::move(job.pixels));
+        }
+    }
+
+    void FrameExporter::stop() {
+        if (!active_) return;
+
+        // Drain reads in submission order
+        for (int i = 0; i < kRingSize; ++i) {
+            Slot& s = ring_[(next_ + i) % kRingSize];
+            if (s.fence) harvest(s, true);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (std::thread& t : workers_) t.join();
+        workers_.clear();
+        spare_.clear();
+
+        for (Slot& s : ring_) {
+            if (s.fence) glDeleteSync(s.fence);
+            if (s.pbo) glDeleteBuffers(1, &s.pbo);
+            s = Slot{};
+        }
+        if (depthRb_) glDeleteRenderbuffers(1, &depthRb_);
+        if (colorRb_) glDeleteRenderbuffers(1, &colorRb_);
+        if (fbo_) glDeleteFramebuffers(1, &fbo_);
+        depthRb_ = colorRb_ = fbo_ = 0;
+        active_ = false;
+    }
+
+    std::string FrameExporter::lastError() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return error_;
+    }
+
+}
@@ -0,0 +1,21 @@
+#include "../../include/render/palette.h"
+
+namespace render {
+
+    void statePalette(const core::LifeRule& rule, const glm::vec3& dead, const glm::vec3& alive, glm::vec3 out[core::kMaxStates]) {
+        for (int i = 0; i < core::kMaxStates; ++i) out[i] = dead;
+
+        if (rule.family == core::RuleFamily::WireWorld) {
+            out[1] = glm::vec3(0.20f, 0.45f, 0.95f);   // electron head
+            out[2] = glm::vec3(0.90f, 0.30f, 0.25f);   // electron tail
+            out[3] = glm::vec3(0.95f, 0.70f, 0.15f);   // conductor
+            return;
+        }
+
+        // Dying states go from a strong to a light orange
+        out[1] = alive;
+        if (rule.states > 2) out[2] = glm::vec3(0.90f, 0.45f, 0.20f);
+        if (rule.states > 3) out[3] = glm::vec3(0.97f, 0.75f, 0.50f);
+    }
+
+}
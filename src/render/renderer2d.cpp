@@ -1,7 +1,11 @@
 #include "../../include/render/renderer2d.h"
 
+#include "../../include/render/palette.h"
 #include "../../include/utils/shaderUtils.h"
 
+#include <cstdio>
+#include <stdexcept>
+
 namespace render {
 
     void mouseToCell(double mx, double my, int vpX, int vpY, int vpW, int vpH, int gridW, int gridH, int& cx, int& cy) {
@@ -22,14 +26,35 @@ namespace render {
     }
 
     Renderer2D::Renderer2D(core::Simulation& sim) : sim_(sim) {
-        program_ = makeProgramFromFiles(SHADER_DIR "/shader2d.vert", SHADER_DIR "/shader2d.frag");
+        buildProgram();
+        glGenVertexArrays(1, &vao_);
+    }
+
+    void Renderer2D::reloadShaders() {
+        try {
+            buildProgram();
+        }
+        catch (const std::runtime_error& e) {
+            std::fprintf(stderr, "%s\n", e.what()); // keep drawing with the previous program
+        }
+    }
+
+    void Renderer2D::buildProgram() {
+        const GLuint program = makeProgram("shader2d.vert", "shader2d.frag");
+        if (program_) glDeleteProgram(program_);
+        program_ = program;
         glUseProgram(program_);
 
         uGridSize_ = glGetUniformLocation(program_, "uGridSize");
         uViewportPx_ = glGetUniformLocation(program_, "uViewportPx");
         uState_ = glGetUniformLocation(program_, "uState");
-        uDeadColor_ = glGetUniformLocation(program_, "uDeadColor");
-        uAliveColor_ = glGetUniformLocation(program_, "uAliveColor");
+        uPalette_ = glGetUniformLocation(program_, "uPalette");
+        uAge_ = glGetUniformLocation(program_, "uAge");
+        uAgeEnabled_ = glGetUniformLocation(program_, "uAgeEnabled");
+        uYoungColor_ = glGetUniformLocation(program_, "uYoungColor");
+        uTrailColor_ = glGetUniformLocation(program_, "uTrailColor");
+        uLabels_ = glGetUniformLocation(program_, "uLabels");
+        uLabelsEnabled_ = glGetUniformLocation(program_, "uLabelsEnabled");
         uLineThicknessPx_ = glGetUniformLocation(program_, "uLineThicknessPx");
         uLineColor_ = glGetUniformLocation(program_, "uLineColor");
         uHoverCell_ = glGetUniformLocation(program_, "uHoverCell");
@@ -37,8 +62,6 @@ namespace render {
         uEdgeUColor_ = glGetUniformLocation(program_, "uEdgeUColor");
         uEdgeVColor_ = glGetUniformLocation(program_, "uEdgeVColor");
         uEdgeThicknessPx_ = glGetUniformLocation(program_, "uEdgeThicknessPx");
-
-        glGenVertexArrays(1, &vao_);
     }
 
     Renderer2D::~Renderer2D() {
@@ -51,8 +74,9 @@ namespace render {
 
         glUniform2f(uViewportPx_, (float)viewportW, (float)viewportH);
         glUniform2i(uGridSize_, sim_.width(), sim_.height());
-        glUniform3f(uDeadColor_, 0.92f, 0.92f, 0.92f);
-        glUniform3f(uAliveColor_, 0.12f, 0.12f, 0.12f);
+        glm::vec3 palette[core::kMaxStates];
+        statePalette(sim_.rule(), glm::vec3(0.92f), glm::vec3(0.12f), palette);
+        glUniform3fv(uPalette_, core::kMaxStates, &palette[0].x);
         glUniform1f(uLineThicknessPx_, 0.5f);
         glUniform3f(uLineColor_, 0.76f, 0.76f, 0.76f);
         glUniform1f(uHoverBoost_, 0.25f);
@@ -62,6 +86,18 @@ namespace render {
         glUniform3f(uEdgeVColor_, 1.00f, 0.35f, 0.35f);
         glUniform1f(uEdgeThicknessPx_, 1.5f);
 
+        glUniform1i(uAge_, 1);
+        glUniform1i(uAgeEnabled_, sim_.ageTexture() != 0);
+        glUniform3f(uYoungColor_, 0.10f, 0.55f, 0.30f);
+        glUniform3f(uTrailColor_, 0.98f, 0.72f, 0.40f);
+
+        glUniform1i(uLabels_, 2);
+        glUniform1i(uLabelsEnabled_, sim_.labelTexture() != 0);
+
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, sim_.labelTexture());
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, sim_.ageTexture());
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, sim_.stateTexture());
 
@@ -1,19 +1,69 @@
 #include "../../include/render/renderer3d.h"
 
+#include "../../include/render/palette.h"
 #include "../../include/utils/shaderUtils.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace render {
 
     Renderer3D::Renderer3D(core::Simulation& sim) : sim_(sim) {
-        program_ = makeProgramFromFiles(SHADER_DIR "/shader3d.vert", SHADER_DIR "/shader3d.frag");
+        buildPrograms();
+        torus_ = model::makeTorus(2.0f, 0.7f);
+
+        // One uint per instance, read straight from the simulation's live-cell buffer
+        glGenVertexArrays(1, &blockVao_);
+        glBindVertexArray(blockVao_);
+        glBindBuffer(GL_ARRAY_BUFFER, sim_.liveCellBuffer());
+        glEnableVertexAttribArray(0);
+        glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+        glVertexAttribDivisor(0, 1);
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void Renderer3D::reloadShaders() {
+        try {
+            buildPrograms();
+        }
+        catch (const std::runtime_error& e) {
+            std::fprintf(stderr, "%s\n", e.what()); // keep drawing with the previous programs
+        }
+    }
+
+    void Renderer3D::buildPrograms() {
+        // Build both before replacing either so a failure leaves the old pair intact
+        const GLuint program = makeProgram("shader3d.vert", "shader3d.frag");
+        GLuint blockProgram = 0;
+        try {
+            blockProgram = makeProgram("blocks3d.vert", "blocks3d.frag");
+        }
+        catch (...) {
+            glDeleteProgram(program);
+            throw;
+        }
+        if (program_) glDeleteProgram(program_);
+        if (blockProgram_) glDeleteProgram(blockProgram_);
+        program_ = program;
+        blockProgram_ = blockProgram;
+
         glUseProgram(program_);
 
         uMVP_ = glGetUniformLocation(program_, "uMVP");
+        uSegments_ = glGetUniformLocation(program_, "uSegments");
+        uRadii_ = glGetUniformLocation(program_, "uRadii");
+        uSurface_ = glGetUniformLocation(program_, "uSurface");
+        uSheet_ = glGetUniformLocation(program_, "uSheet");
         uState_ = glGetUniformLocation(program_, "uState");
-        uDeadColor_ = glGetUniformLocation(program_, "uDeadColor");
-        uAliveColor_ = glGetUniformLocation(program_, "uAliveColor");
+        uPalette_ = glGetUniformLocation(program_, "uPalette");
+        uAge_ = glGetUniformLocation(program_, "uAge");
+        uAgeEnabled_ = glGetUniformLocation(program_, "uAgeEnabled");
+        uYoungColor_ = glGetUniformLocation(program_, "uYoungColor");
+        uTrailColor_ = glGetUniformLocation(program_, "uTrailColor");
         uGridSize_ = glGetUniformLocation(program_, "uGridSize");
         uLinePx_ = glGetUniformLocation(program_, "uLinePx");
         uLineColor_ = glGetUniformLocation(program_, "uLineColor");
@@ -21,45 +71,104 @@ namespace render {
         uEdgeVColor_ = glGetUniformLocation(program_, "uEdgeVColor");
         uEdgePxUV_ = glGetUniformLocation(program_, "uEdgePxUV");
 
-        torus_ = model::makeTorusGrid(sim_.width(), sim_.height(), 2.0f, 0.7f);
+        glUseProgram(blockProgram_);
+
+        uBlockMVP_ = glGetUniformLocation(blockProgram_, "uMVP");
+        uBlockGridSize_ = glGetUniformLocation(blockProgram_, "uGridSize");
+        uBlockRadii_ = glGetUniformLocation(blockProgram_, "uRadii");
+        uBlockSurface_ = glGetUniformLocation(blockProgram_, "uSurface");
+        uBlockSheet_ = glGetUniformLocation(blockProgram_, "uSheet");
+        uBlockFill_ = glGetUniformLocation(blockProgram_, "uFill");
+        uBlockHeight_ = glGetUniformLocation(blockProgram_, "uHeight");
+        uBlockState_ = glGetUniformLocation(blockProgram_, "uState");
+        uBlockPalette_ = glGetUniformLocation(blockProgram_, "uPalette");
+        uBlockLightDir_ = glGetUniformLocation(blockProgram_, "uLightDir");
     }
 
     Renderer3D::~Renderer3D() {
         destroyTorus(torus_);
+        if (blockVao_) glDeleteVertexArrays(1, &blockVao_);
+        if (blockProgram_) glDeleteProgram(blockProgram_);
         if (program_) glDeleteProgram(program_);
     }
 
-    void Renderer3D::rebuildMesh(int cols, int rows) {
-        destroyTorus(torus_);
-        torus_ = model::makeTorusGrid(cols, rows, 2.0f, 0.7f);
-    }
-
     void Renderer3D::draw(const core::OrbitCamera& cam, int viewportW, int viewportH) {
         float aspect = (viewportW > 0) ? (float)viewportW / (float)viewportH : 1.0f;
 
-        glm::mat4 proj = glm::perspective(glm::radians(25.0f), aspect, 0.1f, 200.0f);
+        const float fovY = glm::radians(kFovYDegrees);
+        glm::mat4 proj = glm::perspective(fovY, aspect, 0.1f, 200.0f);
         glm::mat4 view = cam.view();
         glm::mat4 model = glm::rotate(glm::mat4(1.0f), glm::half_pi<float>(), glm::vec3(1.0f, 0.0f, 0.0f));
         glm::mat4 mvp = proj * view * model;
 
         glUseProgram(program_);
 
+        // Tessellation follows the on-screen size only; grid resolution is resolved per fragment
+        const core::Topology topology = sim_.topology();
+        model::TorusTessellation tess = model::tessellationForView(torus_, cam.distance_, fovY, viewportH);
+        if (topology == core::Topology::KleinBottle || topology == core::Topology::ProjectivePlane) {
+            tess.minorSegments_ = tess.majorSegments_; // tighter folds than the torus tube
+        }
+
+        // The flat sheet keeps the cells square and spans the torus diameter
+        const float sheetExtent = torus_.outerRadius_ + torus_.innerRadius_;
+        const float longest = static_cast<float>(std::max(sim_.width(), sim_.height()));
+        const glm::vec2 sheet(sheetExtent * sim_.width() / longest, sheetExtent * sim_.height() / longest);
+
         glUniformMatrix4fv(uMVP_, 1, GL_FALSE, &mvp[0][0]);
+        glUniform2i(uSegments_, tess.majorSegments_, tess.minorSegments_);
+        glUniform2f(uRadii_, torus_.outerRadius_, torus_.innerRadius_);
+        glUniform1i(uSurface_, static_cast<int>(topology));
+        glUniform2f(uSheet_, sheet.x, sheet.y);
         glUniform1i(uState_, 0);
         glUniform2i(uGridSize_, sim_.width(), sim_.height());
-        glUniform3f(uDeadColor_, 1.0f, 1.0f, 1.0f);
-        glUniform3f(uAliveColor_, 0.0f, 0.0f, 0.0f);
+        glm::vec3 palette[core::kMaxStates];
+        statePalette(sim_.rule(), glm::vec3(1.0f), glm::vec3(0.0f), palette);
+        glUniform3fv(uPalette_, core::kMaxStates, &palette[0].x);
         glUniform1f(uLinePx_, 0.7f);
         glUniform3f(uLineColor_, 0.75f, 0.75f, 0.75f);
         glUniform3f(uEdgeUColor_, 0.30f, 0.50f, 1.00f);
         glUniform3f(uEdgeVColor_, 1.00f, 0.35f, 0.35f);
         glUniform1f(uEdgePxUV_, 2.0f);
 
+        glUniform1i(uAge_, 1);
+        glUniform1i(uAgeEnabled_, sim_.ageTexture() != 0);
+        glUniform3f(uYoungColor_, 0.10f, 0.55f, 0.30f);
+        glUniform3f(uTrailColor_, 0.98f, 0.72f, 0.40f);
+
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, sim_.ageTexture());
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, sim_.stateTexture());
 
+        // Only the torus is closed and orientable; the other surfaces (and their blocks) show both sides
+        const GLboolean culling = glIsEnabled(GL_CULL_FACE);
+        if (topology != core::Topology::Torus) glDisable(GL_CULL_FACE);
         glBindVertexArray(torus_.vao_);
-        glDrawElements(GL_TRIANGLES, torus_.indexCount_, GL_UNSIGNED_INT, 0);
+        glDrawArrays(GL_TRIANGLES, 0, tess.vertexCount());
+
+        // Live cells as blocks: one instanced draw, no per-cell CPU work
+        if (sim_.liveCellsEnabled() && sim_.liveCellCount() > 0) {
+            const glm::vec3 lightDir = glm::normalize(glm::vec3(0.4f, -0.3f, 0.85f));
+
+            glUseProgram(blockProgram_);
+            glUniformMatrix4fv(uBlockMVP_, 1, GL_FALSE, &mvp[0][0]);
+            glUniform2i(uBlockGridSize_, sim_.width(), sim_.height());
+            glUniform2f(uBlockRadii_, torus_.outerRadius_, torus_.innerRadius_);
+            glUniform1i(uBlockSurface_, static_cast<int>(topology));
+            glUniform2f(uBlockSheet_, sheet.x, sheet.y);
+            glUniform1f(uBlockFill_, 0.8f);
+            glUniform1f(uBlockHeight_, 0.6f);
+            glUniform1i(uBlockState_, 0);
+            statePalette(sim_.rule(), glm::vec3(1.0f), glm::vec3(0.20f, 0.45f, 0.85f), palette);
+            glUniform3fv(uBlockPalette_, core::kMaxStates, &palette[0].x);
+            glUniform3f(uBlockLightDir_, lightDir.x, lightDir.y, lightDir.z);
+
+            glBindVertexArray(blockVao_);
+            glDrawArraysInstanced(GL_TRIANGLES, 0, 30, sim_.liveCellCount());
+        }
+
+        if (culling) glEnable(GL_CULL_FACE);
 
         glBindVertexArray(0);
     }
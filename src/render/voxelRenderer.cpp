@@ -0,0 +1,96 @@
+#include "../../include/render/voxelRenderer.h"
+
+#include "../../include/utils/shaderUtils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace render {
+
+    // Edge of the cube the longest side of the volume is scaled to (about the torus size)
+    static constexpr float kVolumeExtent = 4.0f;
+
+    VoxelRenderer::VoxelRenderer() {
+        buildProgram();
+
+        glGenBuffers(1, &vbo_);
+        glGenVertexArrays(1, &vao_);
+        glBindVertexArray(vao_);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+        glEnableVertexAttribArray(0);
+        glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+        glVertexAttribDivisor(0, 1);
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    VoxelRenderer::~VoxelRenderer() {
+        if (vao_) glDeleteVertexArrays(1, &vao_);
+        if (vbo_) glDeleteBuffers(1, &vbo_);
+        if (program_) glDeleteProgram(program_);
+    }
+
+    void VoxelRenderer::reloadShaders() {
+        try {
+            buildProgram();
+        }
+        catch (const std::runtime_error& e) {
+            std::fprintf(stderr, "%s\n", e.what()); // keep drawing with the previous program
+        }
+    }
+
+    void VoxelRenderer::buildProgram() {
+        const GLuint program = makeProgram("voxel3d.vert", "voxel3d.frag");
+        if (program_) glDeleteProgram(program_);
+        program_ = program;
+
+        uMVP_ = glGetUniformLocation(program_, "uMVP");
+        uGridSize_ = glGetUniformLocation(program_, "uGridSize");
+        uFill_ = glGetUniformLocation(program_, "uFill");
+        uLightDir_ = glGetUniformLocation(program_, "uLightDir");
+    }
+
+    void VoxelRenderer::update(const core::Life3D& volume) {
+        const std::vector<uint32_t>& live = volume.liveCells();
+        gridW_ = volume.width();
+        gridH_ = volume.height();
+        gridD_ = volume.depth();
+        voxelCount_ = static_cast<GLsizei>(live.size());
+
+        // Orphan the old storage so the upload never waits for the previous draw
+        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+        glBufferData(GL_ARRAY_BUFFER, live.size() * sizeof(uint32_t), nullptr, GL_STREAM_DRAW);
+        if (!live.empty()) glBufferSubData(GL_ARRAY_BUFFER, 0, live.size() * sizeof(uint32_t), live.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void VoxelRenderer::draw(const core::OrbitCamera& cam, int viewportW, int viewportH) {
+        if (voxelCount_ == 0) return;
+        float aspect = (viewportW > 0) ? (float)viewportW / (float)viewportH : 1.0f;
+
+        // Same projection as the torus view, z up; cell (x, y, z) spans [x, x+1) etc.
+        const float fovY = glm::radians(25.0f);
+        const float scale = kVolumeExtent / static_cast<float>(std::max({ gridW_, gridH_, gridD_ }));
+        glm::mat4 proj = glm::perspective(fovY, aspect, 0.1f, 200.0f);
+        glm::mat4 model = glm::rotate(glm::mat4(1.0f), -glm::half_pi<float>(), glm::vec3(1.0f, 0.0f, 0.0f));
+        model = glm::scale(model, glm::vec3(scale));
+        model = glm::translate(model, -0.5f * glm::vec3(gridW_, gridH_, gridD_));
+        glm::mat4 mvp = proj * cam.view() * model;
+
+        const glm::vec3 lightDir = glm::normalize(glm::vec3(0.4f, -0.3f, 0.85f));
+
+        glUseProgram(program_);
+        glUniformMatrix4fv(uMVP_, 1, GL_FALSE, &mvp[0][0]);
+        glUniform3i(uGridSize_, gridW_, gridH_, gridD_);
+        glUniform1f(uFill_, 0.85f);
+        glUniform3f(uLightDir_, lightDir.x, lightDir.y, lightDir.z);
+
+        glBindVertexArray(vao_);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 36, voxelCount_);
+        glBindVertexArray(0);
+    }
+
+}
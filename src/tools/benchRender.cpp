@@ -0,0 +1,352 @@
+#include "../../include/core/camera.h"
+#include "../../include/core/simulation.h"
+#include "../../include/model/torus.h"
+#include "../../include/render/renderer2d.h"
+#include "../../include/render/renderer3d.h"
+#include "../../include/utils/headlessContext.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct Size {
+    int width = 0;
+    int height = 0;
+};
+
+// Offscreen colour + depth target of one resolution
+struct Target {
+    Size size;
+    GLuint fbo = 0;
+    GLuint color = 0;
+    GLuint depth = 0;
+};
+
+// Summary of one series of timings, in milliseconds
+struct Timing {
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double max = 0.0;
+};
+
+// Timings of one view at one resolution
+struct ViewTiming {
+    const char* view = "";
+    Size size;
+    Timing frame;
+    Timing gpu;
+};
+
+using Clock = std::chrono::steady_clock;
+
+static void printUsage() {
+    std::fputs(
+        "Usage: GameOfLifeRenderBench [options]\n"
+        "  --grids LIST        square grid sizes (default 256,1024,4096)\n"
+        "  --resolutions LIST  viewport sizes (default 640x360,1920x1080,3840x2160)\n"
+        "  --frames N          timed frames per case (default 60)\n"
+        "  --warmup N          untimed frames before each case (default 5)\n"
+        "  --view 2d|3d|both   renderers to time (default both)\n"
+        "  --blocks            extrude live cells in the 3D view\n"
+        "  --age               colour cells by age\n"
+        "  --out FILE          write the JSON report to FILE (default stdout)\n",
+        stderr);
+}
+
+static bool parseSize(const char* text, Size& size) {
+    return std::sscanf(text, "%dx%d", &size.width, &size.height) == 2 && size.width > 0 && size.height > 0;
+}
+
+// Comma-separated items, each parsed by parse(item, value)
+template <class T, class Parse>
+static bool parseList(const char* text, std::vector<T>& out, Parse parse) {
+    out.clear();
+    std::string list = text;
+    size_t start = 0;
+    while (start <= list.size()) {
+        const size_t comma = std::min(list.find(',', start), list.size());
+        T value{};
+        if (!parse(list.substr(start, comma - start).c_str(), value)) return false;
+        out.push_back(value);
+        start = comma + 1;
+    }
+    return !out.empty();
+}
+
+static double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static Timing summarize(std::vector<double> ms) {
+    Timing t;
+    if (ms.empty()) return t;
+    std::sort(ms.begin(), ms.end());
+    for (double v : ms) t.mean += v;
+    t.mean /= static_cast<double>(ms.size());
+    auto percentile = [&](double p) { return ms[std::min(ms.size() - 1, static_cast<size_t>(p * static_cast<double>(ms.size())))]; };
+    t.p50 = percentile(0.50);
+    t.p95 = percentile(0.95);
+    t.max = ms.back();
+    return t;
+}
+
+static void writeJsonString(std::FILE* f, const std::string& s) {
+    std::fputc('"', f);
+    for (char c : s) {
+        if (c == '"' || c == '\\') std::fputc('\\', f);
+        std::fputc(c, f);
+    }
+    std::fputc('"', f);
+}
+
+static void writeTiming(std::FILE* f, const char* name, const Timing& t) {
+    std::fprintf(f, "\"%s\":{\"mean\":%.4f,\"p50\":%.4f,\"p95\":%.4f,\"max\":%.4f}", name, t.mean, t.p50, t.p95, t.max);
+}
+
+static bool makeTarget(Size size, Target& t) {
+    t.size = size;
+    glGenFramebuffers(1, &t.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, t.fbo);
+    glGenRenderbuffers(1, &t.color);
+    glBindRenderbuffer(GL_RENDERBUFFER, t.color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size.width, size.height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, t.color);
+    glGenRenderbuffers(1, &t.depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, t.depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size.width, size.height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, t.depth);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return complete;
+}
+
+static void destroyTarget(Target& t) {
+    if (t.fbo) glDeleteFramebuffers(1, &t.fbo);
+    if (t.color) glDeleteRenderbuffers(1, &t.color);
+    if (t.depth) glDeleteRenderbuffers(1, &t.depth);
+    t = {};
+}
+
+// Time frames of one view: wall time until the GPU finished, and GL_TIME_ELAPSED
+template <class Draw>
+static void timeFrames(const Target& target, int warmup, int frames, GLuint query, Draw draw,
+                       std::vector<double>& cpuMs, std::vector<double>& gpuMs) {
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glViewport(0, 0, target.size.width, target.size.height);
+    for (int i = 0; i < warmup; ++i) draw();
+    glFinish();
+
+    cpuMs.clear();
+    gpuMs.clear();
+    for (int i = 0; i < frames; ++i) {
+        const Clock::time_point start = Clock::now();
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        draw();
+        glEndQuery(GL_TIME_ELAPSED);
+        glFinish();
+        cpuMs.push_back(millisecondsSince(start));
+
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+        gpuMs.push_back(static_cast<double>(ns) * 1e-6);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/**
+ * @brief Headless renderer benchmark: frame, texture upload and torus mesh times across
+ * grid sizes and resolutions, written as JSON for regression tracking.
+ * @return 0 on success, non-zero on failure.
+ */
+int main(int argc, char** argv) {
+    std::vector<int> grids = {256, 1024, 4096};
+    std::vector<Size> resolutions = {{640, 360}, {1920, 1080}, {3840, 2160}};
+    int frames = 60, warmup = 5;
+    bool view2d = true, view3d = true, blocks = false, age = false;
+    std::string outPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (!std::strcmp(arg, "--blocks")) { blocks = true; continue; }
+        if (!std::strcmp(arg, "--age")) { age = true; continue; }
+        if (!value) ok = false;
+        else if (!std::strcmp(arg, "--grids")) ok = parseList(value, grids, [](const char* s, int& v) { return (v = std::atoi(s)) > 0; });
+        else if (!std::strcmp(arg, "--resolutions")) ok = parseList(value, resolutions, parseSize);
+        else if (!std::strcmp(arg, "--frames")) ok = (frames = std::atoi(value)) > 0;
+        else if (!std::strcmp(arg, "--warmup")) ok = (warmup = std::atoi(value)) >= 0;
+        else if (!std::strcmp(arg, "--out")) outPath = value;
+        else if (!std::strcmp(arg, "--view")) {
+            view2d = std::strcmp(value, "3d") != 0;
+            view3d = std::strcmp(value, "2d") != 0;
+            ok = view2d != view3d || !std::strcmp(value, "both");
+        }
+        else ok = false;
+
+        if (!ok) {
+            printUsage();
+            return 2;
+        }
+        ++i;
+    }
+
+    utils::HeadlessContext context;
+    std::string error;
+    if (!context.create(error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    GLint maxTexture = 0, maxRenderbuffer = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTexture);
+    glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxRenderbuffer);
+
+    std::vector<Target> targets;
+    for (const Size& size : resolutions) {
+        Target t;
+        if (size.width > maxRenderbuffer || size.height > maxRenderbuffer || !makeTarget(size, t)) {
+            std::fprintf(stderr, "Cannot render at %dx%d\n", size.width, size.height);
+            destroyTarget(t);
+            for (Target& made : targets) destroyTarget(made);
+            return 1;
+        }
+        targets.push_back(t);
+    }
+
+    std::FILE* out = outPath.empty() ? stdout : std::fopen(outPath.c_str(), "wb");
+    if (!out) {
+        std::fprintf(stderr, "Cannot write %s\n", outPath.c_str());
+        return 1;
+    }
+
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    core::OrbitCamera camera;
+    int status = 0;
+
+    std::fputs("{\"renderer\":", out);
+    writeJsonString(out, context.renderer());
+    std::fprintf(out, ",\"frames\":%d,\"warmup\":%d,\"blocks\":%s,\"age\":%s,\n", frames, warmup, blocks ? "true" : "false", age ? "true" : "false");
+
+    // The torus has no vertex buffers (see model::TorusMesh): building it is one VAO, and
+    // the resolution only picks the tessellation the vertex shader expands
+    std::fputs("\"mesh\":[", out);
+    for (size_t r = 0; r < resolutions.size(); ++r) {
+        std::vector<double> ms;
+        model::TorusTessellation tess;
+        for (int i = 0; i < frames; ++i) {
+            const Clock::time_point start = Clock::now();
+            model::TorusMesh mesh = model::makeTorus(2.0f, 0.7f);
+            tess = model::tessellationForView(mesh, camera.distance_, glm::radians(render::Renderer3D::kFovYDegrees), resolutions[r].height);
+            model::destroyTorus(mesh);
+            ms.push_back(millisecondsSince(start));
+        }
+        std::fprintf(out, "%s\n{\"width\":%d,\"height\":%d,\"vertices\":%d,", r ? "," : "",
+            resolutions[r].width, resolutions[r].height, static_cast<int>(tess.vertexCount()));
+        writeTiming(out, "buildMs", summarize(ms));
+        std::fputc('}', out);
+    }
+    std::fputs("],\n\"grids\":[", out);
+
+    bool firstGrid = true;
+    for (const int n : grids) {
+        if (n > maxTexture) {
+            std::fprintf(stderr, "Skipping %dx%d grid: larger than GL_MAX_TEXTURE_SIZE (%d)\n", n, n, maxTexture);
+            continue;
+        }
+        std::fprintf(stderr, "Grid %dx%d\n", n, n);
+
+        // Everything is measured before the entry is written, so a failed grid leaves no partial JSON
+        Timing upload;
+        std::vector<ViewTiming> views;
+        try {
+            core::Simulation simulation(n, n);
+            simulation.setRewindCapacity(0);
+            {
+                // Reproducible soup at 30% density, as the exporter
+                std::vector<uint8_t> cells(static_cast<size_t>(n) * n);
+                std::mt19937 rng(1);
+                for (uint8_t& c : cells) c = (rng() % 10) < 3 ? 1 : 0;
+                simulation.setCells(cells.data());
+            }
+            simulation.setLiveCellsEnabled(blocks);
+            simulation.setAgeEnabled(age);
+
+            // The upload Simulation does after every step
+            std::vector<double> uploadMs;
+            glBindTexture(GL_TEXTURE_2D, simulation.stateTexture());
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            for (int i = 0; i < frames; ++i) {
+                const Clock::time_point start = Clock::now();
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, n, n, GL_RED, GL_UNSIGNED_BYTE, simulation.life().data());
+                glFinish();
+                uploadMs.push_back(millisecondsSince(start));
+            }
+            upload = summarize(uploadMs);
+
+            render::Renderer2D r2d(simulation);
+            render::Renderer3D r3d(simulation);
+            std::vector<double> cpuMs, gpuMs;
+            for (const Target& target : targets) {
+                const int w = target.size.width, h = target.size.height;
+                for (int v = 0; v < 2; ++v) {
+                    if (v == 0 ? !view2d : !view3d) continue;
+                    if (v == 0) {
+                        timeFrames(target, warmup, frames, query, [&] {
+                            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                            r2d.draw(w, h, -1, -1);
+                        }, cpuMs, gpuMs);
+                    }
+                    else {
+                        timeFrames(target, warmup, frames, query, [&] {
+                            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                            r3d.draw(camera, w, h);
+                        }, cpuMs, gpuMs);
+                    }
+                    views.push_back({ v == 0 ? "2d" : "3d", target.size, summarize(cpuMs), summarize(gpuMs) });
+                }
+            }
+        }
+        catch (const std::runtime_error& e) {
+            std::fprintf(stderr, "Grid %dx%d: %s\n", n, n, e.what());
+            status = 1;
+            continue;
+        }
+
+        const double megabytes = static_cast<double>(n) * n / (1024.0 * 1024.0);
+        std::fprintf(out, "%s\n{\"width\":%d,\"height\":%d,", firstGrid ? "" : ",", n, n);
+        writeTiming(out, "uploadMs", upload);
+        std::fprintf(out, ",\"uploadMBps\":%.1f,\"views\":[", upload.mean > 0.0 ? megabytes * 1000.0 / upload.mean : 0.0);
+        bool first = true;
+        for (const ViewTiming& view : views) {
+            std::fprintf(out, "%s\n {\"view\":\"%s\",\"width\":%d,\"height\":%d,", first ? "" : ",", view.view, view.size.width, view.size.height);
+            writeTiming(out, "frameMs", view.frame);
+            std::fputc(',', out);
+            writeTiming(out, "gpuMs", view.gpu);
+            std::fputc('}', out);
+            first = false;
+        }
+        std::fputs("]}", out);
+        firstGrid = false;
+    }
+    std::fputs("\n]}\n", out);
+
+    glDeleteQueries(1, &query);
+    for (Target& t : targets) destroyTarget(t);
+    const bool written = !std::ferror(out);
+    if (out != stdout && std::fclose(out) != 0) status = 1;
+    if (!written) {
+        std::fprintf(stderr, "Failed writing the report\n");
+        status = 1;
+    }
+    return status;
+}
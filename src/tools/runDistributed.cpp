@@ -0,0 +1,211 @@
+#include "../../include/core/domain.h"
+#include "../../include/core/gameLogic.h"
+#include "../../include/io/distributedLife.h"
+#include "../../include/io/patternFile.h"
+#include "../../include/io/socketTransport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+static void printUsage() {
+    std::fputs(
+        "Usage: GameOfLifeDistributed [options]\n"
+        "  --split CxR         subdomains across and down, one process each (default 2x2)\n"
+        "  --rank N            run only this rank (start one process per rank);\n"
+        "                      without it all ranks are forked locally (POSIX only)\n"
+        "  --size WxH          grid size (default 1024x1024, minimum size for patterns)\n"
+        "  --pattern FILE      start from a .gol, .rle or .mc file (default: random soup)\n"
+        "  --generations N     generations to simulate (default 1000)\n"
+        "  --halo K            halo depth: exchange every K generations (default 1)\n"
+        "  --transport tcp|unix  socket family (default tcp)\n"
+        "  --host ADDR         TCP address of all ranks (default 127.0.0.1)\n"
+        "  --port P            TCP port of rank 0; rank r uses P+r (default 47000)\n"
+        "  --path PREFIX       Unix socket prefix; rank r uses PREFIX.r (default /tmp/gol-halo)\n"
+        "  --gather N          also gather the grid on rank 0 every N generations\n"
+        "  --verify            compare the result with a single-process run on rank 0\n"
+        "  --out FILE          save the final grid from rank 0\n",
+        stderr);
+}
+
+static bool parseSize(const char* text, int& w, int& h) {
+    return std::sscanf(text, "%dx%d", &w, &h) == 2 && w > 0 && h > 0;
+}
+
+struct Options {
+    int columns = 2, rows = 2;
+    int gridW = 1024, gridH = 1024;
+    int halo = 1;
+    long long generations = 1000;
+    long long gatherEvery = 0;
+    bool verify = false;
+    std::string patternPath, outPath;
+    io::SocketEndpoint endpoint;
+};
+
+static core::Life initialGrid(const Options& opt) {
+    if (!opt.patternPath.empty()) {
+        io::ImportOptions import;
+        import.minWidth = opt.gridW;
+        import.minHeight = opt.gridH;
+        return io::loadPattern(opt.patternPath, import);
+    }
+
+    // Reproducible soup at 30% density
+    core::Life life(opt.gridW, opt.gridH);
+    std::mt19937 rng(1);
+    uint8_t* cells = life.data();
+    for (size_t i = 0; i < static_cast<size_t>(opt.gridW) * opt.gridH; ++i) cells[i] = (rng() % 10) < 3 ? 1 : 0;
+    return life;
+}
+
+static int runRank(const Options& opt, int rank) {
+    try {
+        // Rank 0 decides the grid size (patterns may enlarge it) and tells the others
+        core::Life initial(1, 1);
+        int size[2] = { opt.gridW, opt.gridH };
+        if (rank == 0) {
+            initial = initialGrid(opt);
+            size[0] = initial.gridWidth_;
+            size[1] = initial.gridHeight_;
+        }
+
+        // Who talks to whom depends only on the split, not on the grid size
+        const int ranks = opt.columns * opt.rows;
+        const core::DomainLayout split(size[0], size[1], opt.columns, opt.rows);
+        io::SocketTransport transport(opt.endpoint, rank, ranks, io::DistributedLife::peers(split, rank));
+
+        uint8_t sizeBytes[8];
+        std::memcpy(sizeBytes, size, sizeof(size));
+        if (rank == 0) {
+            std::vector<io::SendBuffer> sends;
+            for (int r = 1; r < ranks; ++r) sends.push_back({ r, sizeBytes, sizeof(sizeBytes) });
+            transport.exchange(sends, {});
+        }
+        else {
+            transport.exchange({}, { { 0, sizeBytes, sizeof(sizeBytes) } });
+            std::memcpy(size, sizeBytes, sizeof(size));
+        }
+
+        const core::DomainLayout layout(size[0], size[1], opt.columns, opt.rows);
+        io::DistributedLife life(layout, opt.halo, transport);
+        life.scatter(rank == 0 ? &initial : nullptr);
+
+        core::Life frame(rank == 0 ? size[0] : 1, rank == 0 ? size[1] : 1);
+        const auto t0 = std::chrono::steady_clock::now();
+        long long done = 0;
+        while (done < opt.generations) {
+            const long long batch = opt.gatherEvery > 0 ? std::min(opt.gatherEvery, opt.generations - done) : opt.generations - done;
+            life.step(static_cast<uint64_t>(batch));
+            done += batch;
+            if (opt.gatherEvery > 0 && done < opt.generations) life.gather(&frame);
+        }
+        life.gather(&frame);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        if (rank != 0) return 0;
+
+        const double cells = static_cast<double>(size[0]) * size[1] * static_cast<double>(opt.generations);
+        std::printf("%d ranks (%dx%d), %dx%d grid, halo %d: %lld generations in %.2f s (%.1f Mcells/s), rank 0 sent %.1f MB\n",
+            ranks, opt.columns, opt.rows, size[0], size[1], opt.halo, opt.generations, seconds,
+            seconds > 0.0 ? cells / seconds * 1e-6 : 0.0, static_cast<double>(transport.bytesSent()) / (1024.0 * 1024.0));
+
+        if (opt.verify) {
+            for (long long g = 0; g < opt.generations; ++g) initial.step();
+            const size_t count = static_cast<size_t>(size[0]) * size[1];
+            if (std::memcmp(initial.data(), frame.data(), count) != 0) {
+                std::fprintf(stderr, "Verification FAILED: the distributed result differs from Life::step()\n");
+                return 1;
+            }
+            std::printf("Verified: identical to a single-process run\n");
+        }
+        if (!opt.outPath.empty()) io::savePattern(opt.outPath, frame);
+    }
+    catch (const std::runtime_error& e) {
+        std::fprintf(stderr, "rank %d: %s\n", rank, e.what());
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Distributed run: step a grid split across processes that exchange halos over sockets.
+ * @return 0 on success, non-zero on failure.
+ */
+int main(int argc, char** argv) {
+    Options opt;
+    int rank = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (!std::strcmp(arg, "--verify")) { opt.verify = true; continue; }
+        if (!value) ok = false;
+        else if (!std::strcmp(arg, "--split")) ok = parseSize(value, opt.columns, opt.rows);
+        else if (!std::strcmp(arg, "--rank")) ok = (rank = std::atoi(value)) >= 0;
+        else if (!std::strcmp(arg, "--size")) ok = parseSize(value, opt.gridW, opt.gridH);
+        else if (!std::strcmp(arg, "--pattern")) opt.patternPath = value;
+        else if (!std::strcmp(arg, "--generations")) ok = (opt.generations = std::atoll(value)) >= 0;
+        else if (!std::strcmp(arg, "--halo")) ok = (opt.halo = std::atoi(value)) > 0;
+        else if (!std::strcmp(arg, "--gather")) ok = (opt.gatherEvery = std::atoll(value)) > 0;
+        else if (!std::strcmp(arg, "--host")) opt.endpoint.host = value;
+        else if (!std::strcmp(arg, "--port")) ok = (opt.endpoint.basePort = std::atoi(value)) > 0;
+        else if (!std::strcmp(arg, "--path")) opt.endpoint.path = value;
+        else if (!std::strcmp(arg, "--out")) opt.outPath = value;
+        else if (!std::strcmp(arg, "--transport")) {
+            if (!std::strcmp(value, "unix")) opt.endpoint.kind = io::SocketKind::Unix;
+            else ok = !std::strcmp(value, "tcp");
+        }
+        else ok = false;
+
+        if (!ok) {
+            printUsage();
+            return 2;
+        }
+        ++i;
+    }
+
+    const int ranks = opt.columns * opt.rows;
+    if (rank >= ranks) {
+        std::fprintf(stderr, "--rank must be below %d\n", ranks);
+        return 2;
+    }
+    if (rank >= 0) return runRank(opt, rank);
+
+#ifdef _WIN32
+    std::fputs("Start one process per rank with --rank 0..N-1\n", stderr);
+    return 2;
+#else
+    // Fork the other ranks; this process becomes rank 0
+    std::vector<pid_t> children;
+    for (int r = 1; r < ranks; ++r) {
+        const pid_t pid = fork();
+        if (pid == 0) std::_Exit(runRank(opt, r));
+        if (pid < 0) {
+            std::perror("fork");
+            return 1;
+        }
+        children.push_back(pid);
+    }
+
+    int result = runRank(opt, 0);
+    for (pid_t pid : children) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) result = 1;
+    }
+    return result;
+#endif
+}
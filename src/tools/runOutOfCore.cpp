@@ -0,0 +1,123 @@
+#include "../../include/core/gameLogic.h"
+#include "../../include/io/outOfCoreLife.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+static void printUsage() {
+    std::fputs(
+        "Usage: GameOfLifeOutOfCore FILE [options]\n"
+        "  --create WxH        first write a random soup of this size to FILE\n"
+        "  --density D         live fraction of the soup (default 0.3)\n"
+        "  --seed N            soup seed (default 1)\n"
+        "  --generations N     generations to simulate (default 100)\n"
+        "  --band-rows N       rows per band streamed through memory (default 1024)\n"
+        "  --per-pass K        generations per pass over the file (default 1)\n"
+        "  --work FILE         second file for the next generation (default FILE.next)\n"
+        "  --verify            also step the grid in memory and compare (grid must fit in RAM)\n",
+        stderr);
+}
+
+static bool parseSize(const char* text, int& w, int& h) {
+    return std::sscanf(text, "%dx%d", &w, &h) == 2 && w > 0 && h > 0;
+}
+
+/**
+ * @brief Step a grid kept in a memory-mapped file, for grids larger than RAM.
+ * @return 0 on success, non-zero on failure.
+ */
+int main(int argc, char** argv) {
+    std::string path, workPath;
+    int createW = 0, createH = 0;
+    double density = 0.3;
+    unsigned seed = 1;
+    long long generations = 100;
+    int bandRows = 1024;
+    int perPass = 1;
+    bool verify = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (!std::strcmp(arg, "--verify")) { verify = true; continue; }
+        if (arg[0] != '-' && path.empty()) { path = arg; continue; }
+        if (!value) ok = false;
+        else if (!std::strcmp(arg, "--create")) ok = parseSize(value, createW, createH);
+        else if (!std::strcmp(arg, "--density")) ok = (density = std::atof(value)) >= 0.0 && density <= 1.0;
+        else if (!std::strcmp(arg, "--seed")) seed = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        else if (!std::strcmp(arg, "--generations")) ok = (generations = std::atoll(value)) >= 0;
+        else if (!std::strcmp(arg, "--band-rows")) ok = (bandRows = std::atoi(value)) > 0;
+        else if (!std::strcmp(arg, "--per-pass")) ok = (perPass = std::atoi(value)) > 0;
+        else if (!std::strcmp(arg, "--work")) workPath = value;
+        else ok = false;
+
+        if (!ok) {
+            printUsage();
+            return 2;
+        }
+        ++i;
+    }
+    if (path.empty()) {
+        printUsage();
+        return 2;
+    }
+    if (workPath.empty()) workPath = path + ".next";
+
+    try {
+        if (createW > 0) {
+            // Reproducible soup, generated row by row so it never has to fit in memory
+            std::mt19937 rng(seed);
+            const uint32_t threshold = static_cast<uint32_t>(density * 65536.0);
+            io::OutOfCoreLife::create(path, createW, createH, [&](int, uint8_t* row) {
+                for (int x = 0; x < createW; ++x) row[x] = (rng() & 0xFFFFu) < threshold ? 1 : 0;
+            });
+        }
+
+        auto life = std::make_unique<io::OutOfCoreLife>(path, workPath, bandRows, perPass);
+        const int w = life->width();
+        const int h = life->height();
+
+        std::unique_ptr<core::Life> reference;
+        if (verify) {
+            reference = std::make_unique<core::Life>(w, h);
+            std::memcpy(reference->data(), life->cells(), static_cast<size_t>(w) * h);
+        }
+
+        const io::OutOfCoreStats stats = life->step(static_cast<uint64_t>(generations));
+        std::printf("%dx%d grid (%.1f MB), %d-row bands, %d generations per pass: %lld generations in %.2f s over %llu passes\n",
+            w, h, static_cast<double>(w) * h / 1e6, bandRows, perPass, generations, stats.seconds,
+            static_cast<unsigned long long>(stats.passes));
+        std::printf("read %.1f MB, wrote %.1f MB: %.1f MB/s, %.1f Mcells/s\n",
+            static_cast<double>(stats.bytesRead) / 1e6, static_cast<double>(stats.bytesWritten) / 1e6, stats.megabytesPerSecond(),
+            stats.seconds > 0.0 ? static_cast<double>(w) * h * static_cast<double>(generations) / stats.seconds * 1e-6 : 0.0);
+
+        if (reference) {
+            for (long long g = 0; g < generations; ++g) reference->step();
+            if (std::memcmp(reference->data(), life->cells(), static_cast<size_t>(w) * h) != 0) {
+                std::fprintf(stderr, "Verification FAILED: the out-of-core result differs from Life::step()\n");
+                return 1;
+            }
+            std::printf("Verified: identical to stepping in memory\n");
+        }
+
+        // Leave the result in FILE and drop the work file (unmapped first, for Windows)
+        const bool inWorkFile = life->currentPath() != path;
+        life.reset();
+        std::error_code ec;
+        if (inWorkFile) std::filesystem::rename(workPath, path, ec);
+        else std::filesystem::remove(workPath, ec);
+        if (ec) throw std::runtime_error("Cannot replace " + path + " with " + workPath + ": " + ec.message());
+    }
+    catch (const std::runtime_error& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "../../include/io/patternFile.h"
+#include "../../include/io/streamClient.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void printUsage() {
+    std::fputs(
+        "Usage: GameOfLifeClient [options]\n"
+        "  --host ADDR         server address (default 127.0.0.1)\n"
+        "  --port P            server port (default 47100)\n"
+        "  --frames N          frames to print before exiting, 0 = until the server closes (default 10)\n"
+        "  --play, --pause     start or stop the simulation\n"
+        "  --step N            compute N generations\n"
+        "  --speed S           set the speed in steps per second\n"
+        "  --set X,Y           make a cell alive (repeatable)\n"
+        "  --clear X,Y         make a cell dead (repeatable)\n"
+        "  --load FILE         replace the grid with a .gol, .rle or .mc file\n"
+        "  --verify            check every reconstructed frame against the server's population\n",
+        stderr);
+}
+
+/**
+ * @brief Client stub: connects to the app's stream server, sends commands in the order
+ *        given and prints the frames it receives.
+ * @return 0 on success, non-zero on failure.
+ */
+int main(int argc, char** argv) {
+    std::string host = "127.0.0.1";
+    int port = io::kDefaultStreamPort;
+    long long frames = 10;
+    bool verify = false;
+
+    // Commands run in command-line order once the first frame arrived
+    struct Command {
+        std::string name;
+        std::string value;
+    };
+    std::vector<Command> commands;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (!std::strcmp(arg, "--verify")) { verify = true; continue; }
+        if (!std::strcmp(arg, "--play") || !std::strcmp(arg, "--pause")) { commands.push_back({ arg, "" }); continue; }
+        if (!value) ok = false;
+        else if (!std::strcmp(arg, "--host")) host = value;
+        else if (!std::strcmp(arg, "--port")) ok = (port = std::atoi(value)) > 0;
+        else if (!std::strcmp(arg, "--frames")) ok = (frames = std::atoll(value)) >= 0;
+        else if (!std::strcmp(arg, "--step") || !std::strcmp(arg, "--speed") || !std::strcmp(arg, "--set") ||
+                 !std::strcmp(arg, "--clear") || !std::strcmp(arg, "--load")) commands.push_back({ arg, value });
+        else ok = false;
+
+        if (!ok) {
+            printUsage();
+            return 2;
+        }
+        ++i;
+    }
+
+    try {
+        io::StreamClient client(host, port);
+        if (!client.receiveFrame(5.0)) {
+            std::fprintf(stderr, "No frame from %s:%d\n", host.c_str(), port);
+            return 1;
+        }
+
+        for (const Command& c : commands) {
+            if (c.name == "--play") client.play();
+            else if (c.name == "--pause") client.pause();
+            else if (c.name == "--step") client.step(static_cast<uint32_t>(std::strtoul(c.value.c_str(), nullptr, 10)));
+            else if (c.name == "--speed") client.setSpeed(std::strtof(c.value.c_str(), nullptr));
+            else if (c.name == "--set" || c.name == "--clear") {
+                io::StreamCellEdit e;
+                if (std::sscanf(c.value.c_str(), "%d,%d", &e.x, &e.y) != 2) {
+                    printUsage();
+                    return 2;
+                }
+                e.alive = c.name == "--set" ? 1 : 0;
+                client.edit({ e });
+            }
+            else if (c.name == "--load") {
+                // Same placement as loading in the app: centred in a grid at least as large
+                io::ImportOptions opt;
+                opt.minWidth = static_cast<int>(client.frame().width);
+                opt.minHeight = static_cast<int>(client.frame().height);
+                client.load(io::loadPattern(c.value, opt));
+            }
+        }
+
+        for (long long shown = 0;;) {
+            const io::StreamFrameHeader& f = client.frame();
+            uint64_t population = 0;
+            for (uint8_t cell : client.cells()) population += cell == 1;
+
+            std::printf("gen %llu  %ux%u  population %llu  %s %.1f/s  %s, %u skipped, %.1f KB total\n",
+                static_cast<unsigned long long>(f.generation), f.width, f.height, static_cast<unsigned long long>(population),
+                f.running ? "running" : "paused", f.stepsPerSecond, f.keyframe ? "keyframe" : "delta", f.skipped,
+                static_cast<double>(client.bytesReceived()) / 1024.0);
+            if (verify && population != f.population) {
+                std::fprintf(stderr, "Verification FAILED: %llu live cells, the server has %llu\n",
+                    static_cast<unsigned long long>(population), static_cast<unsigned long long>(f.population));
+                return 1;
+            }
+            if (frames != 0 && ++shown >= frames) break;
+
+            // Paused servers only send frames on changes; keep waiting
+            while (!client.receiveFrame(1.0)) {}
+        }
+    }
+    catch (const std::runtime_error& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
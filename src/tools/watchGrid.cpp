@@ -0,0 +1,88 @@
+#include "../../include/io/sharedGridReader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+static void printUsage() {
+    std::fputs(
+        "Usage: GameOfLifeWatch [options]\n"
+        "  --name NAME         shared grid to follow (default gol-grid)\n"
+        "  --interval MS       time between samples (default 500)\n"
+        "  --samples N         stop after N samples (default: until the publisher exits)\n",
+        stderr);
+}
+
+/**
+ * @brief Example consumer of a shared grid: prints the population of the newest
+ *        generation at a fixed interval, reading the cells in place.
+ * @return 0 on success, non-zero on failure.
+ */
+int main(int argc, char** argv) {
+    std::string name = io::kDefaultSharedGridName;
+    int intervalMs = 500;
+    long long samples = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (!value) ok = false;
+        else if (!std::strcmp(arg, "--name")) name = value;
+        else if (!std::strcmp(arg, "--interval")) ok = (intervalMs = std::atoi(value)) > 0;
+        else if (!std::strcmp(arg, "--samples")) ok = (samples = std::atoll(value)) > 0;
+        else ok = false;
+
+        if (!ok) {
+            printUsage();
+            return 2;
+        }
+        ++i;
+    }
+
+    io::SharedGridReader reader;
+    std::string error;
+    if (!reader.open(name, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    uint64_t lastFrame = 0;
+    long long torn = 0;
+    for (long long taken = 0; samples == 0 || taken < samples; ++taken) {
+        // A resized grid moves to a new segment under the same name
+        if (reader.publisherClosed()) {
+            if (!reader.open(name, error)) {
+                std::printf("Publisher closed\n");
+                return 0;
+            }
+        }
+
+        io::SharedGridFrame frame;
+        if (reader.latest(frame)) {
+            // Work on the cells in place, then make sure the publisher did not reuse the slot
+            const size_t count = static_cast<size_t>(frame.width) * static_cast<size_t>(frame.height);
+            size_t population = 0;
+            for (size_t i = 0; i < count; ++i) population += frame.cells[i] == 1;
+
+            if (reader.valid(frame)) {
+                std::printf("gen %llu  %dx%d  population %zu  (%llu frames since last sample)\n",
+                    static_cast<unsigned long long>(frame.generation), frame.width, frame.height, population,
+                    static_cast<unsigned long long>(frame.frame - lastFrame));
+                lastFrame = frame.frame;
+            }
+            else {
+                std::printf("sample overwritten while reading (%lld so far), try a longer ring or a faster reader\n", ++torn);
+            }
+        }
+        else {
+            std::printf("waiting for frames\n");
+        }
+        std::fflush(stdout);
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "../../include/ui/profilerOverlay.h"
+
+namespace ui {
+
+    static double megabytes(size_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    void drawProfilerOverlay(ProfilerOverlayState& s, double now, const core::Life& life) {
+        // Sorting a few thousand samples per stage is cheap, but not every frame
+        if (s.lastRefresh < 0.0 || now - s.lastRefresh >= s.refreshPeriod) {
+            s.stats = utils::Profiler::instance().summarize(s.windowSeconds);
+            s.memory = utils::gridMemoryStats();
+            s.lastRefresh = now;
+        }
+
+        const float margin = 12.0f;
+        ImGui::SetNextWindowBgAlpha(0.45f);
+        ImGui::SetNextWindowPos(ImVec2(margin, margin), ImGuiCond_Always);
+        ImGui::Begin("Profiler", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav);
+
+        ImGui::Text("Frame profile, last %.0f s (ms)", s.windowSeconds);
+        ImGui::TextDisabled("F9: save trace.json");
+
+        if (ImGui::BeginTable("##Stages", 7, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Stage");
+            ImGui::TableSetupColumn("n");
+            ImGui::TableSetupColumn("last");
+            ImGui::TableSetupColumn("p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("max");
+            ImGui::TableHeadersRow();
+
+            for (const utils::ProfileStats& st : s.stats) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(st.name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", st.count);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", st.lastMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", st.p50Ms);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", st.p95Ms);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", st.p99Ms);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", st.maxMs);
+            }
+            ImGui::EndTable();
+        }
+
+        // Where the grid buffers live: huge pages cut TLB misses, bands keep pages per thread
+        const utils::GridMemoryStats& m = s.memory;
+        ImGui::Text("Grid memory: %.1f MB in %zu buffers, %zu-byte aligned, %d row band%s",
+            megabytes(m.bytes), m.buffers, utils::kGridAlignment, life.bands(), life.bands() == 1 ? "" : "s");
+        ImGui::Text("  huge pages %.1f MB, THP-advised %.1f MB, heap %.1f MB",
+            megabytes(m.explicitHugeBytes), megabytes(m.transparentBytes), megabytes(m.smallBytes));
+#ifdef __linux__
+        ImGui::TextDisabled("  kernel-backed huge pages (process): %.1f MB", megabytes(m.backedHugeBytes));
+#endif
+
+        ImGui::End();
+    }
+
+}
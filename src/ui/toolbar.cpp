@@ -1,9 +1,38 @@
 #include "../../include/ui/toolbar.h"
+#include "../../include/core/scheduler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
 
 namespace ui {
 
-    static int clamp10_100(int v) {
-        return v < 10 ? 10 : (v > 100 ? 100 : v);
+    // Grid size limits (the 3D mesh no longer depends on the grid resolution)
+    constexpr int kMinGridSize = 10;
+    constexpr int kMaxGridSize = 8192;
+
+    static int clampGridSize(int v) {
+        return v < kMinGridSize ? kMinGridSize : (v > kMaxGridSize ? kMaxGridSize : v);
+    }
+
+    // Highest frame-rate cap accepted
+    constexpr int kMaxFpsCap = 1000;
+
+    // Longest autosave interval accepted (one day)
+    constexpr int kMaxAutosaveSeconds = 86400;
+
+    // Volume edge limits (256^3 cells step in a few tens of milliseconds)
+    constexpr int kMinVolumeSize = 8;
+    constexpr int kMaxVolumeSize = 256;
+
+    // Menus shared by the main and the comparison toolbars
+    static const char* const kTopologies[] = {"Torus", "Klein bottle", "Projective plane", "Bounded"};
+    static const char* const kPresets[] = {"Conway", "Bosco", "Majority", "Brian's Brain", "Star Wars", "WireWorld"};
+    static const core::LifeRule kPresetRules[] = {core::kConwayRule, core::kBoscoRule, core::kMajorityRule,
+                                                  core::kBriansBrainRule, core::kStarWarsRule, core::kWireWorldRule};
+
+    const core::LifeRule& presetRule(int index) {
+        return kPresetRules[index < 0 || index >= IM_ARRAYSIZE(kPresetRules) ? 0 : index];
     }
 
     ToolbarActions drawToolbar(ToolbarState& s, const core::Simulation& sim) {
@@ -15,9 +44,10 @@ namespace ui {
         const int rightW = screenW - leftW;
         (void)rightW;
         const int margin = 12;
+        const int rowBottom = s.viewRows > 1 ? screenH / s.viewRows : screenH;  // bottom of the top row
 
         ImGui::SetNextWindowBgAlpha(0.45f);
-        ImGui::SetNextWindowPos(ImVec2((float)(leftW + rightW - margin), (float)(screenH - margin)), ImGuiCond_Always, ImVec2(1.0f, 1.0f));
+        ImGui::SetNextWindowPos(ImVec2((float)(leftW + rightW - margin), (float)(rowBottom - margin)), ImGuiCond_Always, ImVec2(1.0f, 1.0f));
         ImGui::Begin("Toolbar", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
 
         ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(12, 12));
@@ -33,6 +63,14 @@ namespace ui {
         if (ImGui::Button("Step", ImVec2(64.0f, h))) out.requestStep = true;
         ImGui::SameLine();
 
+        // Step back / Rewind (history kept by the simulation)
+        ImGui::BeginDisabled(sim.rewindDepth() == 0 && !sim.isRewinding());
+        if (ImGui::Button("Back", ImVec2(64.0f, h))) out.requestStepBack = true;
+        ImGui::SameLine();
+        if (ImGui::Button(sim.isRewinding() ? "Stop" : "Rewind", ImVec2(72.0f, h))) out.toggledRewind = true;
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+
         // Clear
         if (ImGui::Button("Clear", ImVec2(64.0f, h))) out.requestClear = true;
         ImGui::SameLine();
@@ -51,8 +89,8 @@ namespace ui {
 
         const ImGuiInputTextFlags numFlags = ImGuiInputTextFlags_CharsDecimal | ImGuiInputTextFlags_AutoSelectAll;
 
-        const float threeChars = ImGui::CalcTextSize("000").x;
-        const float inputWidth = threeChars + ImGui::GetStyle().FramePadding.x * 2.5f;
+        const float fourChars = ImGui::CalcTextSize("0000").x;
+        const float inputWidth = fourChars + ImGui::GetStyle().FramePadding.x * 2.5f;
 
         bool commitRows = false;
         bool commitCols = false;
@@ -68,12 +106,12 @@ namespace ui {
         commitRows = (ImGui::IsItemFocused() && ImGui::IsKeyPressed(ImGuiKey_Enter)) || ImGui::IsItemDeactivatedAfterEdit();
         ImGui::SameLine();
         if (ImGui::Button("-##rows", ImVec2(0.0f, h))) {
-            s.rowsInput = clamp10_100(s.rowsInput - 1);
+            s.rowsInput = clampGridSize(s.rowsInput - 1);
             commitRows = true;
         }
         ImGui::SameLine();
         if (ImGui::Button("+##rows", ImVec2(0.0f, h))) {
-            s.rowsInput = clamp10_100(s.rowsInput + 1);
+            s.rowsInput = clampGridSize(s.rowsInput + 1);
             commitRows = true;
         }
         ImGui::SameLine();
@@ -89,19 +127,346 @@ namespace ui {
         commitCols = (ImGui::IsItemFocused() && ImGui::IsKeyPressed(ImGuiKey_Enter)) || ImGui::IsItemDeactivatedAfterEdit();
         ImGui::SameLine();
         if (ImGui::Button("-##cols", ImVec2(0.0f, h))) {
-            s.colsInput = clamp10_100(s.colsInput - 1);
+            s.colsInput = clampGridSize(s.colsInput - 1);
             commitCols = true;
         }
         ImGui::SameLine();
         if (ImGui::Button("+##cols", ImVec2(0.0f, h))) {
-            s.colsInput = clamp10_100(s.colsInput + 1);
+            s.colsInput = clampGridSize(s.colsInput + 1);
             commitCols = true;
         }
+        ImGui::SameLine();
+
+        // How the edges are glued (the 3D view shows the matching surface)
+        int topology = static_cast<int>(sim.topology());
+        ImGui::SetNextItemWidth(150.0f);
+        if (ImGui::Combo("##Topology", &topology, kTopologies, IM_ARRAYSIZE(kTopologies))) out.newTopology = topology;
+        ImGui::SameLine();
+
+        // 3D blocks for live cells
+        bool blocks = sim.liveCellsEnabled();
+        if (ImGui::Checkbox("Blocks", &blocks)) out.toggledBlocks = true;
+        ImGui::SameLine();
+
+        // Age and trail colouring
+        bool age = sim.ageEnabled();
+        if (ImGui::Checkbox("Age", &age)) out.toggledAge = true;
+        ImGui::SameLine();
+
+        // Colour by connected component
+        bool labels = sim.labelsEnabled();
+        if (ImGui::Checkbox("Labels", &labels)) out.toggledLabels = true;
+        ImGui::SameLine();
+        if (const core::ComponentLabeler* labeler = sim.labeler()) {
+            ImGui::Text("%zu objects", labeler->components().size());
+            ImGui::SameLine();
+        }
+
+        // One grid buffer instead of two, at the cost of the step history
+        bool inPlace = sim.inPlace();
+        if (ImGui::Checkbox("Low memory", &inPlace)) out.toggledInPlace = true;
+        ImGui::SameLine();
+
+        // Larger-than-Life rule settings
+        ImGui::Checkbox("Rule", &s.showRule);
+        ImGui::SameLine();
+
+        // Volumetric automaton in place of the torus
+        bool volume = s.volume;
+        if (ImGui::Checkbox("Volume", &volume)) out.toggleVolume = true;
+        ImGui::SameLine();
+
+        // Frame profiler overlay (UI-only state)
+        ImGui::Checkbox("Profiler", &s.showProfiler);
+        ImGui::SameLine();
+
+        // Frame-rate cap on top of vsync (0 = off)
+        ImGui::AlignTextToFramePadding();
+        ImGui::TextUnformatted("Max FPS:");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(inputWidth);
+        ImGui::InputInt("##FpsCap", &s.fpsCap, 0, 0, numFlags);
+        s.fpsCap = s.fpsCap < 0 ? 0 : (s.fpsCap > kMaxFpsCap ? kMaxFpsCap : s.fpsCap);
+
+        // Editing tools (second row)
+        static const char* const kTools[] = {"Toggle", "Brush", "Eraser", "Fill rect", "Clear rect", "Random rect", "Paste"};
+        int tool = static_cast<int>(s.editTool);
+        ImGui::AlignTextToFramePadding();
+        ImGui::TextUnformatted("Tool:");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(140.0f);
+        if (ImGui::Combo("##Tool", &tool, kTools, IM_ARRAYSIZE(kTools))) s.editTool = static_cast<EditTool>(tool);
+        ImGui::SameLine();
+
+        if (s.editTool == EditTool::Brush || s.editTool == EditTool::Eraser) {
+            ImGui::SetNextItemWidth(140.0f);
+            ImGui::SliderInt("##Radius", &s.brushRadius, 0, 32, "Radius: %d", ImGuiSliderFlags_AlwaysClamp);
+            ImGui::SameLine();
+        }
+
+        // State painted by the drawing tools, for rules with more than two
+        const core::LifeRule& rule = sim.rule();
+        if (rule.states > 2 && (s.editTool == EditTool::Toggle || s.editTool == EditTool::Brush || s.editTool == EditTool::FillRect)) {
+            static const char* const kGenerationStates[] = {"Alive", "Dying", "Dying 2"};
+            static const char* const kWireStates[] = {"Head", "Tail", "Wire"};
+            const char* const* names = rule.family == core::RuleFamily::WireWorld ? kWireStates : kGenerationStates;
+            int paint = std::min(s.paintState, rule.states - 1) - 1;
+            ImGui::SetNextItemWidth(100.0f);
+            if (ImGui::Combo("##PaintState", &paint, names, rule.states - 1)) s.paintState = paint + 1;
+            ImGui::SameLine();
+        }
+        if (s.editTool == EditTool::Paste) {
+            char rotateLabel[32];
+            std::snprintf(rotateLabel, sizeof(rotateLabel), "Rotate %d###Rotate", s.pasteRotation * 90);
+            if (ImGui::Button(rotateLabel, ImVec2(0.0f, h))) s.pasteRotation = (s.pasteRotation + 1) % 4;
+            ImGui::SameLine();
+            ImGui::Checkbox("Flip", &s.pasteFlip);
+            ImGui::SameLine();
+            ImGui::BeginDisabled(s.ioBusy);
+            if (ImGui::Button("Stamp from file", ImVec2(0.0f, h))) out.requestStamp = true;
+            ImGui::EndDisabled();
+            ImGui::SameLine();
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted(s.stampName.empty() ? "(no stamp)" : s.stampName.c_str());
+            ImGui::SameLine();
+        }
+
+        // Random fills (the Random rect tool and the whole grid)
+        ImGui::SetNextItemWidth(150.0f);
+        ImGui::SliderFloat("##Density", &s.randomDensity, 0.0f, 1.0f, "Density: %.2f", ImGuiSliderFlags_AlwaysClamp);
+        ImGui::SameLine();
+        ImGui::AlignTextToFramePadding();
+        ImGui::TextUnformatted("Seed:");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(inputWidth);
+        ImGui::InputInt("##Seed", &s.randomSeed, 0, 0, numFlags);
+        ImGui::SameLine();
+        if (ImGui::Button("Randomize", ImVec2(0.0f, h))) out.requestRandomFill = true;
+        ImGui::SameLine();
+
+        // Comparison simulations, stepped with this one on the shared thread pool
+        if (ImGui::Button("Compare", ImVec2(0.0f, h))) out.requestAddView = true;
+        if (s.viewRows > 1) {
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(140.0f);
+            if (ImGui::SliderInt("##Priority", &s.priority, 1, core::SimulationScheduler::kMaxPriority, "Priority: %d", ImGuiSliderFlags_AlwaysClamp)) {
+                out.newPriority = s.priority;
+            }
+            ImGui::SameLine();
+            ImGui::AlignTextToFramePadding();
+            ImGui::Text("%.0f%% CPU", s.share * 100.0f);
+        }
+
+        // Pattern files (third row)
+        ImGui::AlignTextToFramePadding();
+        ImGui::TextUnformatted("File:");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(260.0f);
+        ImGui::InputText("##Path", s.patternPath, sizeof(s.patternPath));
+        ImGui::SameLine();
+
+        ImGui::BeginDisabled(s.ioBusy);
+        if (ImGui::Button("Load", ImVec2(64.0f, h))) out.requestLoad = true;
+        ImGui::SameLine();
+        if (ImGui::Button("Save", ImVec2(64.0f, h))) out.requestSave = true;
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+
+        // Periodic checkpoints to <file>.autosave.gol, written in the background
+        ImGui::AlignTextToFramePadding();
+        ImGui::TextUnformatted("Autosave s:");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(inputWidth * 1.25f);
+        ImGui::InputInt("##Autosave", &s.autosaveSeconds, 0, 0, numFlags);
+        s.autosaveSeconds = s.autosaveSeconds < 0 ? 0 : (s.autosaveSeconds > kMaxAutosaveSeconds ? kMaxAutosaveSeconds : s.autosaveSeconds);
+        ImGui::SameLine();
+        if (s.autosavedGeneration >= 0) {
+            ImGui::AlignTextToFramePadding();
+            ImGui::Text("gen %lld", s.autosavedGeneration);
+            ImGui::SameLine();
+        }
+
+        // Run recording and playback (<file>.golrec)
+        if (ImGui::Button(s.recording ? "Stop rec" : "Record", ImVec2(80.0f, h))) out.toggleRecording = true;
+        ImGui::SameLine();
+        ImGui::BeginDisabled(s.recording);
+        if (ImGui::Button("Replay", ImVec2(64.0f, h))) out.requestReplay = true;
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        ImGui::Checkbox("Export", &s.showExport);
+        ImGui::SameLine();
+
+        // Publish generations to shared memory for external readers
+        bool sharing = s.sharing;
+        if (ImGui::Checkbox("Share", &sharing)) out.toggleSharing = true;
+        ImGui::SameLine();
+
+        // Stream generations to network clients and take their commands
+        bool serving = s.serving;
+        if (ImGui::Checkbox("Serve", &serving)) out.toggleServer = true;
+        if (s.serving) {
+            ImGui::SameLine();
+            ImGui::AlignTextToFramePadding();
+            ImGui::Text("%d clients", s.streamClients);
+        }
+
+        if (s.ioBusy || !s.ioStatus.empty()) {
+            ImGui::SameLine();
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted(s.ioBusy ? "Working..." : s.ioStatus.c_str());
+        }
+
+        // Timeline (only while a recording is open)
+        if (s.playbackFrames > 0) {
+            int frame = s.playbackFrame;
+            ImGui::SetNextItemWidth(420.0f);
+            if (ImGui::SliderInt("##Timeline", &frame, 0, s.playbackFrames - 1, "Frame %d", ImGuiSliderFlags_AlwaysClamp)) {
+                out.seekFrame = frame;
+            }
+            ImGui::SameLine();
+            ImGui::AlignTextToFramePadding();
+            ImGui::Text("Gen %llu", s.playbackGeneration);
+            ImGui::SameLine();
+            if (ImGui::Button("Close", ImVec2(64.0f, h))) out.closeReplay = true;
+        }
+
+        // Offscreen frame export (settings are locked while a run is active)
+        if (s.showExport || s.exporting) {
+            static const char* const kViews[] = {"2D", "3D", "2D + 3D"};
+            static const char* const kFormats[] = {"PNG", "Raw RGBA"};
+
+            ImGui::BeginDisabled(s.exporting);
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Frames to:");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(160.0f);
+            ImGui::InputText("##ExportDir", s.exportDir, sizeof(s.exportDir));
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(inputWidth);
+            ImGui::InputInt("##ExportW", &s.exportWidth, 0, 0, numFlags);
+            ImGui::SameLine();
+            ImGui::TextUnformatted("x");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(inputWidth);
+            ImGui::InputInt("##ExportH", &s.exportHeight, 0, 0, numFlags);
+            ImGui::SameLine();
+            ImGui::TextUnformatted("every");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(inputWidth);
+            ImGui::InputInt("##ExportEvery", &s.exportEvery, 0, 0, numFlags);
+            if (s.exportEvery < 1) s.exportEvery = 1;
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(110.0f);
+            ImGui::Combo("##ExportView", &s.exportView, kViews, 3);
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(120.0f);
+            ImGui::Combo("##ExportFormat", &s.exportFormat, kFormats, 2);
+            ImGui::EndDisabled();
+            ImGui::SameLine();
+
+            if (ImGui::Button(s.exporting ? "Stop" : "Start", ImVec2(64.0f, h))) out.toggleExport = true;
+            if (s.exporting) {
+                ImGui::SameLine();
+                ImGui::AlignTextToFramePadding();
+                ImGui::Text("%llu frames", s.exportedFrames);
+            }
+        }
+
+        // Rule: presets, range, shape, states and the birth/survival intervals
+        if (s.showRule) {
+            static const char* const kShapes[] = {"Moore", "von Neumann"};
+            core::LifeRule& r = s.rule;
+            const core::LifeRule before = r;
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Rule:");
+            ImGui::SameLine();
+            for (int i = 0; i < IM_ARRAYSIZE(kPresets); ++i) {
+                if (ImGui::Button(kPresets[i], ImVec2(0.0f, h))) r = kPresetRules[i];
+                ImGui::SameLine();
+            }
+            // Generations: live cells that die fade through the extra states
+            if (r.family == core::RuleFamily::Totalistic) {
+                ImGui::SetNextItemWidth(140.0f);
+                ImGui::SliderInt("##Range", &r.range, 1, core::kMaxRange, "Range: %d", ImGuiSliderFlags_AlwaysClamp);
+                ImGui::SameLine();
+                int shape = static_cast<int>(r.shape);
+                ImGui::SetNextItemWidth(120.0f);
+                if (ImGui::Combo("##Shape", &shape, kShapes, IM_ARRAYSIZE(kShapes))) r.shape = static_cast<core::Neighbourhood>(shape);
+                ImGui::SameLine();
+                ImGui::Checkbox("Count self", &r.includeCenter);
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(110.0f);
+                ImGui::SliderInt("##States", &r.states, 2, core::kMaxStates, "States: %d", ImGuiSliderFlags_AlwaysClamp);
+                ImGui::SameLine();
+            }
+
+            // Intervals are bounded by the neighbourhood, whose size follows the settings above;
+            // a maximum one below the minimum makes an interval empty
+            const int maxCount = core::neighbourhoodSize(r);
+            auto interval = [&](const char* label, const char* id, int& lo, int& hi) {
+                ImGui::AlignTextToFramePadding();
+                ImGui::TextUnformatted(label);
+                ImGui::SameLine();
+                ImGui::PushID(id);
+                ImGui::SetNextItemWidth(inputWidth);
+                ImGui::InputInt("##Min", &lo, 0, 0, numFlags);
+                ImGui::SameLine();
+                ImGui::TextUnformatted("..");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(inputWidth);
+                ImGui::InputInt("##Max", &hi, 0, 0, numFlags);
+                ImGui::PopID();
+                lo = lo < 0 ? 0 : (lo > maxCount ? maxCount : lo);
+                hi = hi < lo - 1 ? lo - 1 : (hi > maxCount ? maxCount : hi);
+            };
+            if (r.family == core::RuleFamily::WireWorld) {
+                ImGui::AlignTextToFramePadding();
+                ImGui::TextUnformatted("WireWorld: wire next to 1-2 heads becomes a head");
+            }
+            else {
+                interval("Birth:", "Birth", r.birthMin, r.birthMax);
+                ImGui::SameLine();
+                interval("Survive:", "Survive", r.surviveMin, r.surviveMax);
+            }
+
+            out.ruleChanged = r != before;
+        }
+
+        // Volumetric automaton: rule, size and reseeding (uses the density and seed above)
+        if (s.volume) {
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("3D rule:");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(120.0f);
+            ImGui::InputText("##VolumeRule", s.volumeRule, sizeof(s.volumeRule));
+            out.volumeRuleChanged = (ImGui::IsItemFocused() && ImGui::IsKeyPressed(ImGuiKey_Enter)) || ImGui::IsItemDeactivatedAfterEdit();
+            for (const char* preset : { "4555", "5766" }) {
+                ImGui::SameLine();
+                if (ImGui::Button(preset, ImVec2(0.0f, h))) {
+                    std::snprintf(s.volumeRule, sizeof(s.volumeRule), "%s", preset);
+                    out.volumeRuleChanged = true;
+                }
+            }
+            ImGui::SameLine();
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Size:");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(inputWidth);
+            ImGui::InputInt("##VolumeSize", &s.volumeSize, 0, 0, numFlags);
+            const bool commitSize = (ImGui::IsItemFocused() && ImGui::IsKeyPressed(ImGuiKey_Enter)) || ImGui::IsItemDeactivatedAfterEdit();
+            s.volumeSize = s.volumeSize < kMinVolumeSize ? kMinVolumeSize : (s.volumeSize > kMaxVolumeSize ? kMaxVolumeSize : s.volumeSize);
+            ImGui::SameLine();
+            if (ImGui::Button("Reseed", ImVec2(0.0f, h)) || commitSize) out.requestVolumeReset = true;
+            ImGui::SameLine();
+            ImGui::AlignTextToFramePadding();
+            ImGui::Text("%zu live cells", s.volumeCells);
+        }
 
         // Apply only when requested (Enter or focus loss, or +/- buttons)
         if (commitRows || commitCols) {
-            const int newRows = clamp10_100(s.rowsInput);
-            const int newCols = clamp10_100(s.colsInput);
+            const int newRows = clampGridSize(s.rowsInput);
+            const int newCols = clampGridSize(s.colsInput);
 
             out.resizeRows = newRows;
             out.resizeCols = newCols;
@@ -116,4 +481,74 @@ namespace ui {
         return out;
     }
 
+    CompareToolbarActions drawCompareToolbar(CompareToolbarState& s, const core::Simulation& sim, int row, int rows) {
+        CompareToolbarActions out{};
+
+        const int screenW = (int)ImGui::GetIO().DisplaySize.x;
+        const int screenH = (int)ImGui::GetIO().DisplaySize.y;
+        const int margin = 12;
+        const int rowBottom = static_cast<int>(static_cast<int64_t>(screenH) * (row + 1) / rows);
+
+        // Every view needs its own window
+        char title[32];
+        std::snprintf(title, sizeof(title), "##CompareToolbar%d", row);
+        ImGui::SetNextWindowBgAlpha(0.45f);
+        ImGui::SetNextWindowPos(ImVec2((float)(screenW - margin), (float)(rowBottom - margin)), ImGuiCond_Always, ImVec2(1.0f, 1.0f));
+        ImGui::Begin(title, nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+
+        ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(12, 12));
+        ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 6.0f);
+
+        float h = ImGui::GetFrameHeight();
+
+        ImGui::AlignTextToFramePadding();
+        ImGui::Text("View %d", row + 1);
+        ImGui::SameLine();
+        if (ImGui::Button(sim.isRunning() ? "Pause" : "Play", ImVec2(64.0f, h))) out.toggledRun = true;
+        ImGui::SameLine();
+        if (ImGui::Button("Step", ImVec2(64.0f, h))) out.requestStep = true;
+        ImGui::SameLine();
+        if (ImGui::Button("Clear", ImVec2(64.0f, h))) out.requestClear = true;
+        ImGui::SameLine();
+        if (ImGui::Button("Randomize", ImVec2(0.0f, h))) out.requestRandomFill = true;
+        ImGui::SameLine();
+        if (ImGui::Button("Copy main", ImVec2(0.0f, h))) out.requestCopy = true;
+        ImGui::SameLine();
+
+        float speed = sim.stepsPerSecond();
+        ImGui::SetNextItemWidth(150.0f);
+        if (ImGui::SliderFloat("##Speed", &speed, 0.5f, 10.0f, "Speed: %.1f")) out.newSpeed = speed;
+        ImGui::SameLine();
+
+        // Presets only; a custom rule (copied from the main simulation) shows as such
+        static const char* const kRules[] = {"Conway", "Bosco", "Majority", "Brian's Brain", "Star Wars", "WireWorld", "Custom"};
+        int rule = IM_ARRAYSIZE(kPresets);
+        for (int i = 0; i < IM_ARRAYSIZE(kPresetRules); ++i) {
+            if (sim.rule() == kPresetRules[i]) rule = i;
+        }
+        ImGui::SetNextItemWidth(120.0f);
+        if (ImGui::Combo("##Rule", &rule, kRules, IM_ARRAYSIZE(kRules)) && rule < IM_ARRAYSIZE(kPresetRules)) out.newRulePreset = rule;
+        ImGui::SameLine();
+
+        int topology = static_cast<int>(sim.topology());
+        ImGui::SetNextItemWidth(150.0f);
+        if (ImGui::Combo("##Topology", &topology, kTopologies, IM_ARRAYSIZE(kTopologies))) out.newTopology = topology;
+        ImGui::SameLine();
+
+        ImGui::SetNextItemWidth(140.0f);
+        if (ImGui::SliderInt("##Priority", &s.priority, 1, core::SimulationScheduler::kMaxPriority, "Priority: %d", ImGuiSliderFlags_AlwaysClamp)) {
+            out.newPriority = s.priority;
+        }
+        ImGui::SameLine();
+        ImGui::AlignTextToFramePadding();
+        ImGui::Text("%.0f%% CPU", s.share * 100.0f);
+        ImGui::SameLine();
+        if (ImGui::Button("Close", ImVec2(64.0f, h))) out.requestClose = true;
+
+        ImGui::PopStyleVar(2);
+        ImGui::End();
+
+        return out;
+    }
+
 }
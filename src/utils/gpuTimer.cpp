@@ -0,0 +1,41 @@
+#include "../../include/utils/gpuTimer.h"
+#include "../../include/utils/profiler.h"
+
+namespace utils {
+
+    GpuTimer::GpuTimer(const char* name) : name_(name) {
+        glGenQueries(kLatency, queries_);
+    }
+
+    GpuTimer::~GpuTimer() {
+        glDeleteQueries(kLatency, queries_);
+    }
+
+    void GpuTimer::begin() {
+        // Harvest finished queries without waiting on the GPU
+        for (int i = 0; i < kLatency; ++i) {
+            if (!pending_[i]) continue;
+            GLint available = 0;
+            glGetQueryObjectiv(queries_[i], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) continue;
+            GLuint64 ns = 0;
+            glGetQueryObjectui64v(queries_[i], GL_QUERY_RESULT, &ns);
+            Profiler::instance().record(name_, issuedNs_[i], static_cast<uint64_t>(ns), Profiler::kGpuThread);
+            pending_[i] = false;
+        }
+
+        active_ = !pending_[next_];
+        if (!active_) return; // GPU is more than kLatency frames behind: skip this sample
+        issuedNs_[next_] = Profiler::nowNs();
+        glBeginQuery(GL_TIME_ELAPSED, queries_[next_]);
+    }
+
+    void GpuTimer::end() {
+        if (!active_) return;
+        glEndQuery(GL_TIME_ELAPSED);
+        pending_[next_] = true;
+        next_ = (next_ + 1) % kLatency;
+        active_ = false;
+    }
+
+}
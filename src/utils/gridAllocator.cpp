@@ -0,0 +1,166 @@
+#include "../../include/utils/gridAllocator.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cstdio>
+#include <sys/mman.h>
+#endif
+
+namespace utils {
+
+    namespace {
+
+        enum class Backing {
+            Small,
+            ExplicitHuge,
+            Transparent
+        };
+
+        struct Allocation {
+            Backing backing;
+            size_t bytes;   // reserved, after rounding
+        };
+
+        // Grid buffers are few and large, so a locked map is cheap enough for the stats
+        std::mutex registryMutex;
+        std::unordered_map<void*, Allocation> registry;
+
+        void record(void* memory, Backing backing, size_t bytes) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            registry[memory] = { backing, bytes };
+        }
+
+        size_t roundUp(size_t bytes, size_t unit) {
+            return (bytes + unit - 1) / unit * unit;
+        }
+
+#ifdef _WIN32
+
+        // Large pages need the "Lock pages in memory" privilege; without it this fails fast
+        void* mapLarge(size_t bytes, Backing& backing, size_t& reserved) {
+            const SIZE_T large = GetLargePageMinimum();
+            if (large) {
+                reserved = roundUp(bytes, large);
+                void* p = VirtualAlloc(nullptr, reserved, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+                if (p) {
+                    backing = Backing::ExplicitHuge;
+                    return p;
+                }
+            }
+            // Committed pages are only backed on first write, like anonymous mappings
+            reserved = roundUp(bytes, kHugePageBytes);
+            backing = Backing::Transparent;
+            return VirtualAlloc(nullptr, reserved, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        }
+
+        void unmapLarge(void* memory, size_t) {
+            VirtualFree(memory, 0, MEM_RELEASE);
+        }
+
+#else
+
+        void* mapLarge(size_t bytes, Backing& backing, size_t& reserved) {
+            reserved = roundUp(bytes, kHugePageBytes);
+            const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#ifdef MAP_HUGETLB
+            // Only succeeds if the administrator reserved huge pages (vm.nr_hugepages)
+            void* huge = mmap(nullptr, reserved, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+            if (huge != MAP_FAILED) {
+                backing = Backing::ExplicitHuge;
+                return huge;
+            }
+#endif
+
+            // Over-map and trim so the range starts on a huge page boundary
+            uint8_t* raw = static_cast<uint8_t*>(mmap(nullptr, reserved + kHugePageBytes, PROT_READ | PROT_WRITE, flags, -1, 0));
+            if (raw == MAP_FAILED) return nullptr;
+            uint8_t* aligned = reinterpret_cast<uint8_t*>(roundUp(reinterpret_cast<uintptr_t>(raw), kHugePageBytes));
+            if (aligned != raw) munmap(raw, static_cast<size_t>(aligned - raw));
+            const size_t tail = static_cast<size_t>(raw + reserved + kHugePageBytes - (aligned + reserved));
+            if (tail) munmap(aligned + reserved, tail);
+
+#ifdef MADV_HUGEPAGE
+            madvise(aligned, reserved, MADV_HUGEPAGE);
+#endif
+            backing = Backing::Transparent;
+            return aligned;
+        }
+
+        void unmapLarge(void* memory, size_t reserved) {
+            munmap(memory, reserved);
+        }
+
+#endif
+
+    }
+
+    void* allocateGrid(size_t bytes) {
+        if (bytes < kHugePageBytes) {
+            void* p = ::operator new(bytes ? bytes : 1, std::align_val_t(kGridAlignment));
+            record(p, Backing::Small, bytes);
+            return p;
+        }
+
+        Backing backing = Backing::Transparent;
+        size_t reserved = 0;
+        void* p = mapLarge(bytes, backing, reserved);
+        if (!p) throw std::bad_alloc();
+        record(p, backing, reserved);
+        return p;
+    }
+
+    void freeGrid(void* memory, size_t bytes) noexcept {
+        if (!memory) return;
+        Allocation allocation{ Backing::Small, bytes };
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            const auto it = registry.find(memory);
+            if (it != registry.end()) {
+                allocation = it->second;
+                registry.erase(it);
+            }
+        }
+
+        if (allocation.backing == Backing::Small) ::operator delete(memory, std::align_val_t(kGridAlignment));
+        else unmapLarge(memory, allocation.bytes);
+    }
+
+    GridMemoryStats gridMemoryStats() {
+        GridMemoryStats stats;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            for (const auto& entry : registry) {
+                const Allocation& a = entry.second;
+                ++stats.buffers;
+                stats.bytes += a.bytes;
+                if (a.backing == Backing::ExplicitHuge) stats.explicitHugeBytes += a.bytes;
+                else if (a.backing == Backing::Transparent) stats.transparentBytes += a.bytes;
+                else stats.smallBytes += a.bytes;
+            }
+        }
+
+#ifdef __linux__
+        // What the kernel actually promoted; THP may be disabled or still collapsing
+        if (FILE* f = std::fopen("/proc/self/smaps_rollup", "r")) {
+            char line[256];
+            while (std::fgets(line, sizeof(line), f)) {
+                unsigned long long kb = 0;
+                if (std::sscanf(line, "AnonHugePages: %llu kB", &kb) == 1) {
+                    stats.backedHugeBytes = static_cast<size_t>(kb) * 1024;
+                    break;
+                }
+            }
+            std::fclose(f);
+        }
+#endif
+        return stats;
+    }
+
+}
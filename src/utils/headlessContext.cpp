@@ -0,0 +1,109 @@
+#include "../../include/utils/headlessContext.h"
+
+#include <glad/glad.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstring>
+
+namespace utils {
+
+    // Mesa's display for machines without X11/Wayland (EGL_MESA_platform_surfaceless)
+    static EGLDisplay surfacelessDisplay() {
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+        const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if (!extensions || !std::strstr(extensions, "EGL_MESA_platform_surfaceless")) return EGL_NO_DISPLAY;
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (!getPlatformDisplay) return EGL_NO_DISPLAY;
+        return getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+#else
+        return EGL_NO_DISPLAY;
+#endif
+    }
+
+    HeadlessContext::~HeadlessContext() {
+        destroy();
+    }
+
+    bool HeadlessContext::create(std::string& error) {
+        destroy();
+
+        EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+            display = surfacelessDisplay();
+            if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+                error = "No EGL display available";
+                return false;
+            }
+        }
+        display_ = display;
+
+        if (!eglBindAPI(EGL_OPENGL_API)) {
+            error = "EGL does not support desktop OpenGL";
+            destroy();
+            return false;
+        }
+
+        // A pbuffer config gives a tiny default surface; rendering goes to FBOs anyway
+        const EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+            EGL_DEPTH_SIZE, 24,
+            EGL_NONE
+        };
+        EGLConfig config = nullptr;
+        EGLint configCount = 0;
+        if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount)) configCount = 0;
+
+        const EGLint contextAttribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+        EGLSurface surface = EGL_NO_SURFACE;
+        if (configCount > 0) {
+            const EGLint pbufferAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+            surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+        }
+        // Surfaceless displays have no pbuffer configs: use EGL_KHR_no_config_context
+        EGLContext context = eglCreateContext(display, configCount > 0 ? config : static_cast<EGLConfig>(nullptr), EGL_NO_CONTEXT, contextAttribs);
+        surface_ = surface;
+        context_ = context;
+        if (context == EGL_NO_CONTEXT) {
+            error = "Cannot create an OpenGL 3.3 core context";
+            destroy();
+            return false;
+        }
+        if (!eglMakeCurrent(display, surface, surface, context)) {
+            error = "Cannot make the OpenGL context current";
+            destroy();
+            return false;
+        }
+
+        if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+            error = "Failed to initialize GLAD";
+            destroy();
+            return false;
+        }
+        return true;
+    }
+
+    void HeadlessContext::destroy() {
+        if (!display_) return;
+        EGLDisplay display = static_cast<EGLDisplay>(display_);
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context_) eglDestroyContext(display, static_cast<EGLContext>(context_));
+        if (surface_) eglDestroySurface(display, static_cast<EGLSurface>(surface_));
+        eglTerminate(display);
+        display_ = surface_ = context_ = nullptr;
+    }
+
+    std::string HeadlessContext::renderer() const {
+        if (!context_) return {};
+        const GLubyte* name = glGetString(GL_RENDERER);
+        return name ? reinterpret_cast<const char*>(name) : "";
+    }
+
+}
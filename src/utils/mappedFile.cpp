@@ -0,0 +1,256 @@
+#include "../../include/utils/mappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+namespace utils {
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    WritableMappedFile::~WritableMappedFile() {
+        close();
+    }
+
+#ifdef _WIN32
+
+    bool MappedFile::open(const char* path) {
+        close();
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        file_ = file;
+        mapping_ = mapping;
+        data_ = static_cast<const uint8_t*>(view);
+        size_ = static_cast<size_t>(size.QuadPart);
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_) CloseHandle(file_);
+        data_ = nullptr;
+        mapping_ = nullptr;
+        file_ = nullptr;
+        size_ = 0;
+    }
+
+    bool WritableMappedFile::create(const std::string& path, size_t size, std::string& error) {
+        close();
+        if (size == 0) {
+            error = "Cannot map an empty file: " + path;
+            return false;
+        }
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            error = "Cannot create " + path;
+            return false;
+        }
+        file_ = file;
+        return map(size, path, error); // the mapping extends the file to its size
+    }
+
+    bool WritableMappedFile::open(const std::string& path, std::string& error) {
+        close();
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            error = "Cannot open " + path;
+            return false;
+        }
+        file_ = file;
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            close();
+            error = "Cannot map an empty file: " + path;
+            return false;
+        }
+        return map(static_cast<size_t>(size.QuadPart), path, error);
+    }
+
+    bool WritableMappedFile::map(size_t size, const std::string& path, std::string& error) {
+        const unsigned long long bytes = size;
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READWRITE, static_cast<DWORD>(bytes >> 32), static_cast<DWORD>(bytes), nullptr);
+        void* view = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, 0) : nullptr;
+        if (!view) {
+            close();
+            error = "Cannot map " + path;
+            return false;
+        }
+        data_ = static_cast<uint8_t*>(view);
+        size_ = size;
+        return true;
+    }
+
+    void WritableMappedFile::close() {
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_) CloseHandle(file_);
+        data_ = nullptr;
+        mapping_ = nullptr;
+        file_ = nullptr;
+        size_ = 0;
+    }
+
+    void WritableMappedFile::willNeed(size_t offset, size_t bytes) const {
+        if (!data_ || offset >= size_) return;
+#if _WIN32_WINNT >= 0x0602
+        WIN32_MEMORY_RANGE_ENTRY range{data_ + offset, std::min(bytes, size_ - offset)};
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+        (void)bytes;
+#endif
+    }
+
+    void WritableMappedFile::release(size_t offset, size_t bytes) const {
+        if (!data_ || offset >= size_) return;
+        bytes = std::min(bytes, size_ - offset);
+        FlushViewOfFile(data_ + offset, bytes);
+        VirtualUnlock(data_ + offset, bytes); // unlocking unlocked pages trims them from the working set
+    }
+
+#else
+
+    bool MappedFile::open(const char* path) {
+        close();
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping keeps the file alive
+        if (view == MAP_FAILED) return false;
+
+        madvise(view, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+        data_ = static_cast<const uint8_t*>(view);
+        size_ = static_cast<size_t>(st.st_size);
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+
+    bool WritableMappedFile::create(const std::string& path, size_t size, std::string& error) {
+        close();
+        if (size == 0) {
+            error = "Cannot map an empty file: " + path;
+            return false;
+        }
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            error = "Cannot create " + path + ": " + std::strerror(errno);
+            return false;
+        }
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            error = "Cannot size " + path + ": " + std::strerror(errno);
+            ::close(fd);
+            return false;
+        }
+        return map(fd, size, path, error);
+    }
+
+    bool WritableMappedFile::open(const std::string& path, std::string& error) {
+        close();
+        const int fd = ::open(path.c_str(), O_RDWR);
+        if (fd < 0) {
+            error = "Cannot open " + path + ": " + std::strerror(errno);
+            return false;
+        }
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            error = "Cannot map an empty file: " + path;
+            ::close(fd);
+            return false;
+        }
+        return map(fd, static_cast<size_t>(st.st_size), path, error);
+    }
+
+    bool WritableMappedFile::map(int fd, size_t size, const std::string& path, std::string& error) {
+        void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd); // the mapping keeps the file alive
+        if (view == MAP_FAILED) {
+            error = "Cannot map " + path + ": " + std::strerror(errno);
+            return false;
+        }
+        madvise(view, size, MADV_SEQUENTIAL);
+        data_ = static_cast<uint8_t*>(view);
+        size_ = size;
+        return true;
+    }
+
+    void WritableMappedFile::close() {
+        if (data_) munmap(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    static size_t pageBytes() {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return page;
+    }
+
+    void WritableMappedFile::willNeed(size_t offset, size_t bytes) const {
+        if (!data_ || offset >= size_) return;
+        // Whole pages around the range
+        const size_t begin = offset / pageBytes() * pageBytes();
+        const size_t end = std::min(size_, offset + bytes);
+        madvise(data_ + begin, end - begin, MADV_WILLNEED);
+    }
+
+    void WritableMappedFile::release(size_t offset, size_t bytes) const {
+        if (!data_ || offset >= size_) return;
+        // Whole pages inside the range (the last page of the file counts as whole)
+        const size_t page = pageBytes();
+        const size_t begin = (offset + page - 1) / page * page;
+        size_t end = std::min(size_, offset + bytes);
+        if (end < size_) end = end / page * page;
+        if (end <= begin) return;
+        msync(data_ + begin, end - begin, MS_ASYNC);
+        madvise(data_ + begin, end - begin, MADV_DONTNEED); // shared file pages: contents are kept
+    }
+
+#endif
+
+}
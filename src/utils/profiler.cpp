@@ -0,0 +1,154 @@
+#include "../../include/utils/profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+
+namespace utils {
+
+    static const std::chrono::steady_clock::time_point kEpoch = std::chrono::steady_clock::now();
+
+    Profiler::Profiler() : slots_(new Slot[kCapacity]) {}
+
+    Profiler& Profiler::instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    uint64_t Profiler::nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - kEpoch).count());
+    }
+
+    uint32_t Profiler::threadId() {
+        static std::atomic<uint32_t> nextId{1};
+        thread_local const uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    void Profiler::record(const char* name, uint64_t startNs, uint64_t durationNs, uint32_t thread) {
+        const uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+        Slot& s = slots_[index % kCapacity];
+
+        // Seqlock write: odd while the fields are inconsistent
+        s.seq.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.name.store(name, std::memory_order_relaxed);
+        s.startNs.store(startNs, std::memory_order_relaxed);
+        s.durationNs.store(durationNs, std::memory_order_relaxed);
+        s.thread.store(thread, std::memory_order_relaxed);
+        s.seq.store(2 * index + 2, std::memory_order_release);
+    }
+
+    void Profiler::snapshot(uint64_t sinceNs, std::vector<ProfileEvent>& out) const {
+        out.clear();
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        const uint64_t first = head > kCapacity ? head - kCapacity : 0;
+
+        for (uint64_t index = first; index < head; ++index) {
+            const Slot& s = slots_[index % kCapacity];
+            const uint64_t before = s.seq.load(std::memory_order_acquire);
+            if (before != 2 * index + 2) continue; // still being written, or already reused
+
+            ProfileEvent e;
+            e.name = s.name.load(std::memory_order_relaxed);
+            e.startNs = s.startNs.load(std::memory_order_relaxed);
+            e.durationNs = s.durationNs.load(std::memory_order_relaxed);
+            e.thread = s.thread.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.seq.load(std::memory_order_relaxed) != before) continue;
+            if (e.startNs >= sinceNs) out.push_back(e);
+        }
+
+        // Slots are claimed in order but scopes end out of order
+        std::sort(out.begin(), out.end(), [](const ProfileEvent& a, const ProfileEvent& b) { return a.startNs < b.startNs; });
+    }
+
+    std::vector<ProfileStats> Profiler::summarize(double seconds) const {
+        const uint64_t now = nowNs();
+        const uint64_t window = static_cast<uint64_t>(seconds * 1e9);
+        std::vector<ProfileEvent> events;
+        snapshot(now > window ? now - window : 0, events);
+
+        struct Samples {
+            bool gpu = false;
+            const char* name = nullptr;
+            std::vector<double> ms;
+        };
+        std::map<std::string, Samples> byName;
+        for (const ProfileEvent& e : events) {
+            Samples& s = byName[e.name];
+            s.name = e.name;
+            s.gpu = (e.thread == kGpuThread);
+            s.ms.push_back(static_cast<double>(e.durationNs) * 1e-6);
+        }
+
+        std::vector<ProfileStats> stats;
+        stats.reserve(byName.size());
+        for (auto& entry : byName) {
+            Samples& s = entry.second;
+            ProfileStats st;
+            st.name = s.name;
+            st.gpu = s.gpu;
+            st.count = s.ms.size();
+            st.lastMs = s.ms.back();
+
+            // Nearest-rank percentiles
+            std::sort(s.ms.begin(), s.ms.end());
+            auto rank = [&s](double p) {
+                const size_t i = static_cast<size_t>(p * static_cast<double>(s.ms.size() - 1) + 0.5);
+                return s.ms[std::min(i, s.ms.size() - 1)];
+            };
+            st.p50Ms = rank(0.50);
+            st.p95Ms = rank(0.95);
+            st.p99Ms = rank(0.99);
+            st.maxMs = s.ms.back();
+            stats.push_back(st);
+        }
+        return stats;
+    }
+
+    static void writeJsonString(std::FILE* f, const char* s) {
+        std::fputc('"', f);
+        for (; *s; ++s) {
+            if (*s == '"' || *s == '\\') std::fputc('\\', f);
+            std::fputc(*s, f);
+        }
+        std::fputc('"', f);
+    }
+
+    bool Profiler::writeChromeTrace(const std::string& path, double seconds, std::string& error) const {
+        const uint64_t now = nowNs();
+        const uint64_t window = static_cast<uint64_t>(seconds * 1e9);
+        std::vector<ProfileEvent> events;
+        snapshot(now > window ? now - window : 0, events);
+
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) {
+            error = "Cannot write " + path;
+            return false;
+        }
+
+        std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+        std::fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"GPU\"}}", kGpuThread);
+
+        // Complete ("X") events; GPU events start at their CPU submission time
+        for (const ProfileEvent& e : events) {
+            std::fputs(",\n{\"name\":", f);
+            writeJsonString(f, e.name);
+            std::fprintf(f, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                e.thread == kGpuThread ? "gpu" : "cpu", e.thread,
+                static_cast<double>(e.startNs) * 1e-3, static_cast<double>(e.durationNs) * 1e-3);
+        }
+        std::fputs("\n]}\n", f);
+
+        const bool ok = !std::ferror(f);
+        if (std::fclose(f) != 0 || !ok) {
+            error = "Failed writing " + path;
+            return false;
+        }
+        return true;
+    }
+
+}
@@ -1,16 +1,25 @@
 #include "../../include/utils/shaderUtils.h"
+#include "../../include/utils/embeddedShaders.h"
 
-#include <string>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <map>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
+#ifdef SHADER_HOT_RELOAD
 static std::string readTextFile(const char* path) {
     std::ifstream f(path, std::ios::binary);
     if (!f) throw std::runtime_error(std::string("Cannot open: ") + path);
     std::ostringstream ss; ss << f.rdbuf();
     return ss.str();
 }
+#endif
 
 static void checkShader(GLuint s, const char* dbg) {
     GLint ok = 0; glGetShaderiv(s, GL_COMPILE_STATUS, &ok);
@@ -38,13 +47,12 @@ static GLuint compileShaderFromSource(GLenum type, const char* src, const char*
     checkShader(s, dbg);
     return s;
 }
-static GLuint compileShaderFromFile(GLenum type, const char* path) {
-    std::string src = readTextFile(path);
-    return compileShaderFromSource(type, src.c_str(), path);
-}
 
-static GLuint linkProgram(GLuint vs, GLuint fs, const char* dbg) {
+static void setRetrievableHint(GLuint prog);
+
+static GLuint linkProgram(GLuint vs, GLuint fs, const char* dbg, bool retrievable = false) {
     GLuint prog = glCreateProgram();
+    if (retrievable) setRetrievableHint(prog);
     glAttachShader(prog, vs);
     glAttachShader(prog, fs);
     glLinkProgram(prog);
@@ -56,14 +64,192 @@ static GLuint linkProgram(GLuint vs, GLuint fs, const char* dbg) {
     return prog;
 }
 
-GLuint makeProgramFromFiles(const char* vsPath, const char* fsPath) {
-    GLuint vs = compileShaderFromFile(GL_VERTEX_SHADER, vsPath);
-    GLuint fs = compileShaderFromFile(GL_FRAGMENT_SHADER, fsPath);
-    return linkProgram(vs, fs, "vs+fs");
+// Program binary cache and shader sources
+
+namespace {
+
+    std::string g_cacheDir;   // empty: cache disabled
+
+    // File layout: header, then the driver's program binary
+    struct ProgramCacheHeader {
+        char magic[4] = {'G', 'O', 'L', 'P'};
+        uint32_t version = 1;
+        uint64_t key = 0;        // hash of driver strings and sources
+        uint32_t format = 0;     // driver binary format
+        uint32_t length = 0;     // binary size in bytes
+    };
+
+#ifdef SHADER_HOT_RELOAD
+    std::map<std::string, std::filesystem::file_time_type> g_watched; // path -> last seen write time
+    double g_lastPoll = -1.0;
+#endif
+
+}
+
+static uint64_t fnv1a(uint64_t h, const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        h ^= static_cast<uint8_t>(data[i]);
+        h *= 0x100000001B3ull;
+    }
+    return h;
 }
 
-GLuint makeProgramFromSource(const char* vsSource, const char* fsSource, const char* debugName) {
-    GLuint vs = compileShaderFromSource(GL_VERTEX_SHADER, vsSource, "vs-src");
-    GLuint fs = compileShaderFromSource(GL_FRAGMENT_SHADER, fsSource, "fs-src");
-    return linkProgram(vs, fs, debugName ? debugName : "src+src");
+static uint64_t hashString(uint64_t h, const char* s) {
+    h = fnv1a(h, s ? s : "", s ? std::strlen(s) : 0);
+    return fnv1a(h, "\0", 1); // separator so concatenations cannot collide
+}
+
+static uint64_t programKey(const std::string& vs, const std::string& fs) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    h = hashString(h, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    h = hashString(h, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    h = hashString(h, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    h = hashString(h, reinterpret_cast<const char*>(glGetString(GL_SHADING_LANGUAGE_VERSION)));
+    h = hashString(h, vs.c_str());
+    return hashString(h, fs.c_str());
+}
+
+// glGetProgramBinary is core in GL 4.1 and otherwise needs ARB_get_program_binary
+#if defined(GL_VERSION_4_1) || defined(GL_ARB_get_program_binary)
+static bool programBinarySupported() {
+    bool api = false;
+#ifdef GL_VERSION_4_1
+    api = api || GLAD_GL_VERSION_4_1;
+#endif
+#ifdef GL_ARB_get_program_binary
+    api = api || GLAD_GL_ARB_get_program_binary;
+#endif
+    if (!api) return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+static void setRetrievableHint(GLuint prog) {
+    if (programBinarySupported()) glProgramParameteri(prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+static GLuint loadCachedProgram(const std::string& path, uint64_t key) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return 0;
+
+    ProgramCacheHeader h;
+    f.read(reinterpret_cast<char*>(&h), sizeof(h));
+    if (!f || std::memcmp(h.magic, "GOLP", 4) != 0 || h.version != 1 || h.key != key) return 0;
+
+    std::vector<char> binary(h.length);
+    f.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+    if (!f) return 0;
+
+    // A driver update may reject an old binary; the caller then recompiles and overwrites it
+    GLuint prog = glCreateProgram();
+    glProgramBinary(prog, static_cast<GLenum>(h.format), binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint ok = 0;
+    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        glDeleteProgram(prog);
+        return 0;
+    }
+    return prog;
+}
+
+static void storeCachedProgram(GLuint prog, const std::string& path, uint64_t key) {
+    GLint length = 0;
+    glGetProgramiv(prog, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    ProgramCacheHeader h;
+    h.key = key;
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    glGetProgramBinary(prog, length, nullptr, &format, binary.data());
+    h.format = format;
+    h.length = static_cast<uint32_t>(length);
+
+    // Write to a temporary file and rename so a concurrent launch never reads half a file
+    std::error_code ec;
+    std::filesystem::create_directories(g_cacheDir, ec);
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f) return;
+        f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        f.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+        if (!f) return;
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) std::filesystem::remove(tmp, ec);
+}
+#else
+static bool programBinarySupported() { return false; }
+static void setRetrievableHint(GLuint) {}
+static GLuint loadCachedProgram(const std::string&, uint64_t) { return 0; }
+static void storeCachedProgram(GLuint, const std::string&, uint64_t) {}
+#endif
+
+static std::string shaderSource(const char* name) {
+#ifdef SHADER_HOT_RELOAD
+    const std::string path = std::string(SHADER_DIR) + "/" + name;
+    std::error_code ec;
+    g_watched[path] = std::filesystem::last_write_time(path, ec);
+    return readTextFile(path.c_str());
+#else
+    for (size_t i = 0; i < kEmbeddedShaderCount; ++i) {
+        if (std::strcmp(kEmbeddedShaders[i].name, name) == 0) return kEmbeddedShaders[i].source;
+    }
+    throw std::runtime_error(std::string("Unknown embedded shader: ") + name);
+#endif
+}
+
+GLuint makeProgram(const char* vsName, const char* fsName) {
+    const std::string vs = shaderSource(vsName);
+    const std::string fs = shaderSource(fsName);
+
+    // Hot-reload builds always compile: their sources change all the time
+#ifdef SHADER_HOT_RELOAD
+    const bool cache = false;
+#else
+    const bool cache = !g_cacheDir.empty() && programBinarySupported();
+#endif
+
+    uint64_t key = 0;
+    std::string path;
+    if (cache) {
+        key = programKey(vs, fs);
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+        path = (std::filesystem::path(g_cacheDir) / name).string();
+        if (GLuint prog = loadCachedProgram(path, key)) return prog;
+    }
+
+    GLuint vsId = compileShaderFromSource(GL_VERTEX_SHADER, vs.c_str(), vsName);
+    GLuint fsId = compileShaderFromSource(GL_FRAGMENT_SHADER, fs.c_str(), fsName);
+    GLuint prog = linkProgram(vsId, fsId, vsName, cache);
+    if (cache) storeCachedProgram(prog, path, key);
+    return prog;
+}
+
+void setProgramCacheDir(const std::string& dir) {
+    g_cacheDir = dir;
+}
+
+bool shadersChangedOnDisk(double now) {
+#ifdef SHADER_HOT_RELOAD
+    if (g_lastPoll >= 0.0 && now - g_lastPoll < 0.5) return false;
+    g_lastPoll = now;
+
+    bool changed = false;
+    for (auto& w : g_watched) {
+        std::error_code ec;
+        const auto t = std::filesystem::last_write_time(w.first, ec);
+        if (!ec && t != w.second) {
+            w.second = t;
+            changed = true;
+        }
+    }
+    return changed;
+#else
+    (void)now;
+    return false;
+#endif
 }
@@ -0,0 +1,166 @@
+#include "../../include/utils/sharedMemory.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utils {
+
+    SharedMemory::~SharedMemory() {
+        close();
+    }
+
+#ifdef _WIN32
+
+    // Session-local names, so no special privileges are needed
+    static std::string mappingName(const std::string& name) {
+        return "Local\\" + name;
+    }
+
+    bool SharedMemory::create(const std::string& name, size_t size, std::string& error) {
+        close();
+        const unsigned long long bytes = size;
+        HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(bytes >> 32), static_cast<DWORD>(bytes & 0xFFFFFFFFull), mappingName(name).c_str());
+        if (!mapping) {
+            error = "Cannot create shared memory '" + name + "' (error " + std::to_string(GetLastError()) + ")";
+            return false;
+        }
+        if (GetLastError() == ERROR_ALREADY_EXISTS) {
+            // The name lives on while any process maps it; its size cannot change
+            error = "Shared memory '" + name + "' is still mapped by another process";
+            CloseHandle(mapping);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+        if (!view) {
+            error = "Cannot map shared memory '" + name + "' (error " + std::to_string(GetLastError()) + ")";
+            CloseHandle(mapping);
+            return false;
+        }
+
+        mapping_ = mapping;
+        data_ = static_cast<uint8_t*>(view);
+        size_ = size;
+        ownedName_ = name;
+        return true;
+    }
+
+    bool SharedMemory::open(const std::string& name, std::string& error) {
+        close();
+        HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, mappingName(name).c_str());
+        if (!mapping) {
+            error = "No shared memory named '" + name + "'";
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        MEMORY_BASIC_INFORMATION info{};
+        if (!view || !VirtualQuery(view, &info, sizeof(info))) {
+            error = "Cannot map shared memory '" + name + "' (error " + std::to_string(GetLastError()) + ")";
+            if (view) UnmapViewOfFile(view);
+            CloseHandle(mapping);
+            return false;
+        }
+
+        mapping_ = mapping;
+        data_ = static_cast<uint8_t*>(view);
+        size_ = info.RegionSize; // rounded up to whole pages
+        return true;
+    }
+
+    void SharedMemory::close() {
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_); // the name disappears with the last handle
+        data_ = nullptr;
+        mapping_ = nullptr;
+        size_ = 0;
+        ownedName_.clear();
+    }
+
+#else
+
+    static std::string segmentName(const std::string& name) {
+        return "/" + name;
+    }
+
+    bool SharedMemory::create(const std::string& name, size_t size, std::string& error) {
+        close();
+        const std::string path = segmentName(name);
+
+        // Replace a stale segment (e.g. left behind by a crash) instead of inheriting its size
+        shm_unlink(path.c_str());
+        const int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (fd < 0) {
+            error = "Cannot create shared memory '" + name + "': " + std::strerror(errno);
+            return false;
+        }
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            error = "Cannot size shared memory '" + name + "': " + std::strerror(errno);
+            ::close(fd);
+            shm_unlink(path.c_str());
+            return false;
+        }
+
+        void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd); // the mapping keeps the segment alive
+        if (view == MAP_FAILED) {
+            error = "Cannot map shared memory '" + name + "': " + std::strerror(errno);
+            shm_unlink(path.c_str());
+            return false;
+        }
+
+        data_ = static_cast<uint8_t*>(view);
+        size_ = size;
+        ownedName_ = name;
+        return true;
+    }
+
+    bool SharedMemory::open(const std::string& name, std::string& error) {
+        close();
+        const int fd = shm_open(segmentName(name).c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            error = "No shared memory named '" + name + "': " + std::strerror(errno);
+            return false;
+        }
+
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            error = "Shared memory '" + name + "' is empty";
+            ::close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            error = "Cannot map shared memory '" + name + "': " + std::strerror(errno);
+            return false;
+        }
+
+        data_ = static_cast<uint8_t*>(view);
+        size_ = static_cast<size_t>(st.st_size);
+        return true;
+    }
+
+    void SharedMemory::close() {
+        if (data_) munmap(data_, size_);
+        if (!ownedName_.empty()) shm_unlink(segmentName(ownedName_).c_str());
+        data_ = nullptr;
+        size_ = 0;
+        ownedName_.clear();
+    }
+
+#endif
+
+}
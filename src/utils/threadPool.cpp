@@ -0,0 +1,155 @@
+#include "../../include/utils/threadPool.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace utils {
+
+    static inline uint64_t packSpan(uint64_t begin, uint64_t end) {
+        return end << 32 | begin;
+    }
+
+    ThreadPool::ThreadPool(size_t threads) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        slices_ = std::make_unique<Slice[]>(threads);
+        for (size_t i = 1; i < threads; ++i) workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        startCv_.notify_all();
+        for (std::thread& t : workers_) t.join();
+    }
+
+    ThreadPool& ThreadPool::shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task) {
+        if (count == 0) return;
+
+        // Single tasks, single-threaded pools, nested calls and huge counts need no hand-off
+        bool expected = false;
+        if (count == 1 || workers_.empty() || count > std::numeric_limits<uint32_t>::max() ||
+            !running_.compare_exchange_strong(expected, true)) {
+            for (size_t i = 0; i < count; ++i) task(i);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            const size_t threads = size();
+            for (size_t t = 0; t < threads; ++t) {
+                slices_[t].span.store(packSpan(count * t / threads, count * (t + 1) / threads), std::memory_order_relaxed);
+            }
+            pinned_ = false;
+            busy_ = workers_.size();
+            ++round_;
+        }
+        startCv_.notify_all();
+
+        runTasks(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCv_.wait(lock, [this] { return busy_ == 0; });
+        task_ = nullptr;
+        running_.store(false);
+    }
+
+    void ThreadPool::forEachThread(const std::function<void(size_t)>& task) {
+        bool expected = false;
+        if (workers_.empty() || !running_.compare_exchange_strong(expected, true)) {
+            for (size_t t = 0; t < size(); ++t) task(t);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            pinned_ = true;
+            busy_ = workers_.size();
+            ++round_;
+        }
+        startCv_.notify_all();
+
+        task(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCv_.wait(lock, [this] { return busy_ == 0; });
+        task_ = nullptr;
+        running_.store(false);
+    }
+
+    void ThreadPool::runTasks(size_t self) {
+        size_t index = 0;
+        for (;;) {
+            while (popOwn(self, index)) (*task_)(index);
+
+            // Own slice done: steal from the others, starting with the next thread so thieves spread out
+            bool stole = false;
+            for (size_t k = 1; k < size() && !stole; ++k) {
+                if (steal(self, (self + k) % size(), index)) {
+                    (*task_)(index);
+                    stole = true;
+                }
+            }
+            if (!stole) return; // every slice was empty; threads still running own what is left
+        }
+    }
+
+    bool ThreadPool::popOwn(size_t self, size_t& index) {
+        std::atomic<uint64_t>& span = slices_[self].span;
+        uint64_t current = span.load(std::memory_order_acquire);
+        for (;;) {
+            const uint64_t begin = current & 0xFFFFFFFFu, end = current >> 32;
+            if (begin >= end) return false;
+            if (span.compare_exchange_weak(current, packSpan(begin + 1, end), std::memory_order_acq_rel)) {
+                index = static_cast<size_t>(begin);
+                return true;
+            }
+        }
+    }
+
+    bool ThreadPool::steal(size_t self, size_t victim, size_t& index) {
+        std::atomic<uint64_t>& span = slices_[victim].span;
+        uint64_t current = span.load(std::memory_order_acquire);
+        for (;;) {
+            const uint64_t begin = current & 0xFFFFFFFFu, end = current >> 32;
+            if (begin >= end) return false;
+
+            // The victim keeps [begin, middle); the thief runs middle and keeps the rest
+            const uint64_t middle = begin + (end - begin) / 2;
+            if (span.compare_exchange_weak(current, packSpan(begin, middle), std::memory_order_acq_rel)) {
+                index = static_cast<size_t>(middle);
+                slices_[self].span.store(packSpan(middle + 1, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    void ThreadPool::workerLoop(size_t index) {
+        uint64_t seen = 0;
+        for (;;) {
+            bool pinned;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                startCv_.wait(lock, [&] { return stopping_ || round_ != seen; });
+                if (stopping_) return;
+                seen = round_;
+                pinned = pinned_;
+            }
+
+            if (pinned) (*task_)(index);
+            else runTasks(index);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--busy_ == 0) doneCv_.notify_one();
+        }
+    }
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdio>
+
+// Minimal checks for the test executables: report every failure, exit non-zero at the end
+
+inline int& checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++checkFailures();                                                             \
+        }                                                                                  \
+    } while (0)
+
+inline int checkResult() {
+    if (checkFailures() == 0) std::printf("All checks passed\n");
+    return checkFailures() == 0 ? 0 : 1;
+}
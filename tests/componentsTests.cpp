@@ -0,0 +1,149 @@
+#include "check.h"
+
+#include "core/components.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Cell (x, y) glued to a neighbour outside the grid, or false beyond a bounded edge
+static bool fold(core::Topology topology, int& x, int& y, int width, int height) {
+    switch (topology) {
+    case core::Topology::KleinBottle: return core::TopologyPolicy<core::Topology::KleinBottle>::fold(x, y, width, height);
+    case core::Topology::ProjectivePlane: return core::TopologyPolicy<core::Topology::ProjectivePlane>::fold(x, y, width, height);
+    case core::Topology::Bounded: return core::TopologyPolicy<core::Topology::Bounded>::fold(x, y, width, height);
+    default: return core::TopologyPolicy<core::Topology::Torus>::fold(x, y, width, height);
+    }
+}
+
+// Flood fill reference: component index per cell (-1 for dead cells)
+static std::vector<int> floodFill(const std::vector<uint8_t>& cells, int width, int height, core::Topology topology, int& count) {
+    std::vector<int> ids(cells.size(), -1);
+    std::vector<int> stack;
+    count = 0;
+    for (size_t start = 0; start < cells.size(); ++start) {
+        if (!cells[start] || ids[start] >= 0) continue;
+        ids[start] = count;
+        stack.push_back(static_cast<int>(start));
+        while (!stack.empty()) {
+            const int i = stack.back();
+            stack.pop_back();
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    int x = i % width + dx, y = i / width + dy;
+                    if (!fold(topology, x, y, width, height)) continue;
+                    const int j = y * width + x;
+                    if (cells[j] && ids[j] < 0) {
+                        ids[j] = count;
+                        stack.push_back(j);
+                    }
+                }
+            }
+        }
+        ++count;
+    }
+    return ids;
+}
+
+static std::vector<uint8_t> randomCells(int width, int height, uint32_t seed, int percent) {
+    std::vector<uint8_t> cells(static_cast<size_t>(width) * height);
+    for (uint8_t& c : cells) {
+        seed = seed * 1664525u + 1013904223u;
+        c = (seed >> 16) % 100 < static_cast<uint32_t>(percent);
+    }
+    return cells;
+}
+
+// The same partition of the live cells as the flood fill, whatever the topology and band count
+static void testMatchesFloodFill() {
+    utils::ThreadPool pool(4);
+    core::ComponentLabeler labeler(pool);
+    const core::Topology topologies[] = { core::Topology::Torus, core::Topology::KleinBottle,
+                                          core::Topology::ProjectivePlane, core::Topology::Bounded };
+    for (core::Topology topology : topologies) {
+        for (uint32_t seed = 1; seed <= 20; ++seed) {
+            const int width = 5 + static_cast<int>(seed * 7 % 40);
+            const int height = 4 + static_cast<int>(seed * 11 % 33);
+            const std::vector<uint8_t> cells = randomCells(width, height, seed, 20 + static_cast<int>(seed % 4) * 10);
+            int count = 0;
+            const std::vector<int> expected = floodFill(cells, width, height, topology, count);
+            labeler.label(cells.data(), width, height, topology);
+            CHECK(static_cast<int>(labeler.components().size()) == count);
+
+            // Labels and reference ids map one-to-one
+            std::vector<int> toLabel(static_cast<size_t>(count), -1);
+            std::vector<uint32_t> population(labeler.components().size() + 1, 0);
+            bool same = true;
+            for (size_t i = 0; i < cells.size(); ++i) {
+                const uint32_t label = labeler.labels()[i];
+                if (!cells[i]) {
+                    same &= label == 0;
+                    continue;
+                }
+                if (label == 0 || label > labeler.components().size()) {
+                    same = false;
+                    continue;
+                }
+                int& mapped = toLabel[static_cast<size_t>(expected[i])];
+                if (mapped < 0) mapped = static_cast<int>(label);
+                same &= mapped == static_cast<int>(label);
+                ++population[label];
+            }
+            CHECK(same);
+            for (size_t k = 0; k < labeler.components().size(); ++k) {
+                CHECK(labeler.components()[k].population == population[k + 1]);
+            }
+        }
+    }
+}
+
+// Blocks touching opposite edges are one object only where those edges are glued
+static void testEdges() {
+    const int width = 16, height = 12;
+    std::vector<uint8_t> cells(static_cast<size_t>(width) * height, 0);
+    auto set = [&](int x, int y) { cells[static_cast<size_t>(y) * width + x] = 1; };
+    set(0, 2); set(0, 3);
+    set(width - 1, 2); set(width - 1, 3);
+
+    core::ComponentLabeler labeler;
+    labeler.label(cells.data(), width, height, core::Topology::Torus);
+    CHECK(labeler.components().size() == 1);
+    labeler.label(cells.data(), width, height, core::Topology::Bounded);
+    CHECK(labeler.components().size() == 2);
+    CHECK(labeler.components().size() == 2 && labeler.components()[0].width == 1 && labeler.components()[0].height == 2);
+
+    // The Klein bottle glues (width - 1, y) to (0, height - 1 - y)
+    labeler.label(cells.data(), width, height, core::Topology::KleinBottle);
+    CHECK(labeler.components().size() == 2);
+    set(0, height - 1 - 2);
+    labeler.label(cells.data(), width, height, core::Topology::KleinBottle);
+    CHECK(labeler.components().size() == 2); // the new cell joins the right-hand block
+    CHECK(labeler.labels()[static_cast<size_t>(height - 1 - 2) * width] == labeler.labels()[static_cast<size_t>(2) * width + width - 1]);
+}
+
+// Translated copies hash alike on a bounded grid, including objects wider than half of it
+static void testBoundedHashes() {
+    const int width = 20, height = 10;
+    std::vector<uint8_t> cells(static_cast<size_t>(width) * height, 0);
+    for (int x = 0; x < 14; ++x) cells[static_cast<size_t>(1) * width + x] = 1;
+    cells[static_cast<size_t>(2) * width + 13] = 1;
+    for (int x = 5; x < 19; ++x) cells[static_cast<size_t>(6) * width + x] = 1;
+    cells[static_cast<size_t>(7) * width + 18] = 1;
+
+    core::ComponentLabeler labeler;
+    labeler.label(cells.data(), width, height, core::Topology::Bounded);
+    CHECK(labeler.components().size() == 2);
+    if (labeler.components().size() != 2) return;
+    const core::Component& a = labeler.components()[0];
+    const core::Component& b = labeler.components()[1];
+    CHECK(a.width == 14 && a.height == 2 && a.x == 0 && a.y == 1);
+    CHECK(b.width == 14 && b.height == 2 && b.x == 5 && b.y == 6);
+    CHECK(a.shapeHash == b.shapeHash);
+}
+
+int main() {
+    testMatchesFloodFill();
+    testEdges();
+    testBoundedHashes();
+    return checkResult();
+}
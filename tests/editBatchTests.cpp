@@ -0,0 +1,59 @@
+#include "check.h"
+
+#include "core/editBatch.h"
+
+#include <cstdint>
+#include <vector>
+
+static std::vector<uint8_t> randomCells(int width, int height, uint64_t seed) {
+    std::vector<uint8_t> cells(static_cast<size_t>(width) * height, 0);
+    core::EditBatch batch;
+    batch.randomFill(0, 0, width - 1, height - 1, 0.5f, seed);
+    batch.apply(cells.data(), width, height);
+    return cells;
+}
+
+// The same seed and rectangle give the same cells, also when only part of it is applied
+static void testReproducible() {
+    const int w = 61, h = 9;
+    const std::vector<uint8_t> a = randomCells(w, h, 7);
+    CHECK(a == randomCells(w, h, 7));
+
+    std::vector<uint8_t> clipped(static_cast<size_t>(w) * h, 0);
+    core::EditBatch batch;
+    batch.randomFill(-5, -3, w - 1, h - 1, 0.5f, 7);
+    batch.apply(clipped.data(), w, h);
+    std::vector<uint8_t> whole(static_cast<size_t>(w + 5) * (h + 3), 0);
+    core::EditBatch wholeBatch;
+    wholeBatch.randomFill(0, 0, w + 4, h + 2, 0.5f, 7);
+    wholeBatch.apply(whole.data(), w + 5, h + 3);
+    bool same = true;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) same &= clipped[static_cast<size_t>(y) * w + x] == whole[static_cast<size_t>(y + 3) * (w + 5) + x + 5];
+    }
+    CHECK(same);
+}
+
+// Neighbouring seeds must not give the same soup shifted by a few cells
+static void testSeedsNotShifted() {
+    const int w = 64, h = 8;
+    const std::vector<uint8_t> a = randomCells(w, h, 1);
+    const std::vector<uint8_t> b = randomCells(w, h, 2);
+    const int n = w * h;
+    for (int shift = -2 * w; shift <= 2 * w; ++shift) {
+        int matches = 0, overlap = 0;
+        for (int i = 0; i < n; ++i) {
+            const int j = i + shift;
+            if (j < 0 || j >= n) continue;
+            matches += a[i] == b[j];
+            ++overlap;
+        }
+        CHECK(matches < overlap);
+    }
+}
+
+int main() {
+    testReproducible();
+    testSeedsNotShifted();
+    return checkResult();
+}
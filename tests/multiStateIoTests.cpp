@@ -0,0 +1,130 @@
+#include "check.h"
+
+#include "core/gameLogic.h"
+#include "io/macrocell.h"
+#include "io/recording.h"
+#include "io/rleFormat.h"
+#include "io/streamClient.h"
+#include "io/streamServer.h"
+
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Random states 0..states-1, stepped a few times so every state occurs
+static core::Life statesGrid(const core::LifeRule& rule, int width, int height) {
+    core::Life life(width, height);
+    life.setRule(rule);
+    uint32_t x = 777;
+    for (int i = 0; i < width * height; ++i) {
+        x = x * 1664525u + 1013904223u;
+        life.data()[i] = static_cast<uint8_t>((x >> 24) % static_cast<uint32_t>(rule.states));
+    }
+    for (int g = 0; g < 3; ++g) life.step();
+    return life;
+}
+
+static bool sameCells(const uint8_t* a, const uint8_t* b, const core::Life& life) {
+    return std::memcmp(a, b, static_cast<size_t>(life.gridWidth_) * life.gridHeight_) == 0;
+}
+
+static uint64_t population(const uint8_t* cells, size_t count) {
+    uint64_t n = 0;
+    for (size_t i = 0; i < count; ++i) n += cells[i] == 1;
+    return n;
+}
+
+// RLE keeps the states and names the rule; Macrocell refuses them
+static void testPatternFiles() {
+    for (const core::LifeRule& rule : { core::kBriansBrainRule, core::kStarWarsRule, core::kWireWorldRule }) {
+        const core::Life life = statesGrid(rule, 29, 17);
+        const std::string path = tempPath("gol-test-states.rle");
+        io::writeRle(path.c_str(), life);
+        const core::Life loaded = io::readRle(path.c_str(), io::ImportOptions{});
+        CHECK(loaded.rule() == rule);
+        CHECK(loaded.gridWidth_ == 29 && loaded.gridHeight_ == 17 && sameCells(life.data(), loaded.data(), life));
+        std::filesystem::remove(path);
+    }
+
+    bool refused = false;
+    const std::string mc = tempPath("gol-test-states.mc");
+    try {
+        io::writeMacrocell(mc.c_str(), statesGrid(core::kBriansBrainRule, 16, 16));
+    }
+    catch (const std::runtime_error&) {
+        refused = true;
+    }
+    CHECK(refused);
+    std::filesystem::remove(mc);
+}
+
+// Every frame replays with its states, across keyframes
+static void testRecording() {
+    core::Life life = statesGrid(core::kStarWarsRule, 31, 19);
+    const size_t count = static_cast<size_t>(31) * 19;
+    const std::string path = tempPath("gol-test-states.golrec");
+
+    std::vector<std::vector<uint8_t>> frames;
+    io::Recorder recorder;
+    std::string error;
+    CHECK(recorder.start(path, 31, 19, 4, life.rule(), error));
+    for (int g = 0; g < 10; ++g) {
+        recorder.capture(life, static_cast<uint64_t>(g));
+        frames.emplace_back(life.data(), life.data() + count);
+        life.step();
+    }
+    recorder.stop();
+    CHECK(!recorder.failed());
+
+    io::Player player;
+    CHECK(player.open(path, error));
+    CHECK(player.rule() == core::kStarWarsRule);
+    CHECK(player.frameCount() == frames.size());
+    for (size_t i = frames.size(); i-- > 0;) {
+        CHECK(player.seek(i) && sameCells(player.cells().data(), frames[i].data(), life));
+    }
+    player.close();
+    std::filesystem::remove(path);
+}
+
+// Streamed frames carry the states and the population counts live cells only
+static void testStream() {
+    io::StreamServer server;
+    io::StreamServerSettings settings;
+    settings.host = "127.0.0.1";
+    settings.port = 0;
+    std::string error;
+    CHECK(server.start(settings, error));
+    if (!server.active()) return;
+
+    core::Life life = statesGrid(core::kBriansBrainRule, 40, 24);
+    const size_t count = static_cast<size_t>(40) * 24;
+    io::StreamClient client("127.0.0.1", server.port());
+    for (int g = 0; g < 4; ++g) {
+        bool received = false;
+        for (int tries = 0; tries < 200 && !received; ++tries) {
+            if (g == 0 || server.wantsGrid()) server.publish(life, static_cast<uint64_t>(g));
+            received = client.receiveFrame(0.01) && client.frame().generation == static_cast<uint64_t>(g);
+        }
+        CHECK(received);
+        CHECK(client.frame().states == 3);
+        CHECK(client.cells().size() == count && sameCells(client.cells().data(), life.data(), life));
+        CHECK(client.frame().population == population(life.data(), count));
+        life.step();
+        server.publish(life, static_cast<uint64_t>(g + 1));
+    }
+    server.stop();
+}
+
+int main() {
+    testPatternFiles();
+    testRecording();
+    testStream();
+    return checkResult();
+}
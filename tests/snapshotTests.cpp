@@ -0,0 +1,118 @@
+#include "check.h"
+
+#include "core/gameLogic.h"
+#include "io/autosave.h"
+#include "io/snapshot.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+static std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Random states 0..states-1, stepped a few times so every state occurs
+static core::Life statesGrid(const core::LifeRule& rule, int width, int height) {
+    core::Life life(width, height);
+    life.setRule(rule);
+    uint32_t x = 12345;
+    for (int i = 0; i < width * height; ++i) {
+        x = x * 1664525u + 1013904223u;
+        life.data()[i] = static_cast<uint8_t>((x >> 24) % static_cast<uint32_t>(rule.states));
+    }
+    for (int g = 0; g < 3; ++g) life.step();
+    return life;
+}
+
+static bool sameCells(const core::Life& a, const core::Life& b) {
+    return a.gridWidth_ == b.gridWidth_ && a.gridHeight_ == b.gridHeight_ &&
+           std::memcmp(a.data(), b.data(), static_cast<size_t>(a.gridWidth_) * a.gridHeight_) == 0;
+}
+
+// A checkpoint of a Generations rule restores every state and the rule, and continues identically
+static void testAutosaveGenerations() {
+    core::Life life = statesGrid(core::kStarWarsRule, 37, 21);
+    bool dying = false;
+    for (int i = 0; i < 37 * 21; ++i) dying |= life.data()[i] >= 2;
+    CHECK(dying);
+
+    const std::string path = tempPath("gol-test-autosave.gol");
+    io::Autosaver saver;
+    saver.buffer().assign(life.data(), life.data() + static_cast<size_t>(37) * 21);
+    CHECK(saver.save(path, 37, 21, 3, life.rule()));
+    io::AutosaveResult result;
+    while (!saver.poll(result)) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    CHECK(result.ok);
+
+    core::Life loaded = io::loadSnapshot(path.c_str());
+    CHECK(loaded.rule() == core::kStarWarsRule);
+    CHECK(sameCells(life, loaded));
+    for (int g = 0; g < 5; ++g) {
+        life.step();
+        loaded.step();
+    }
+    CHECK(sameCells(life, loaded));
+    std::filesystem::remove(path);
+}
+
+// Uncompressed multi-state snapshots, and two-state ones staying version 1
+static void testSaveSnapshot() {
+    const std::string path = tempPath("gol-test-snapshot.gol");
+    const core::Life brain = statesGrid(core::kBriansBrainRule, 13, 9);
+    io::saveSnapshot(path.c_str(), brain, false);
+    const core::Life loaded = io::loadSnapshot(path.c_str());
+    CHECK(loaded.rule() == core::kBriansBrainRule);
+    CHECK(sameCells(brain, loaded));
+
+    const core::Life conway = statesGrid(core::LifeRule{}, 13, 9);
+    io::saveSnapshot(path.c_str(), conway, true);
+    io::SnapshotHeader header{};
+    if (FILE* f = std::fopen(path.c_str(), "rb")) {
+        CHECK(std::fread(&header, sizeof(header), 1, f) == 1);
+        std::fclose(f);
+    }
+    CHECK(header.version == 1 && header.flags == io::kSnapshotPackBits);
+    CHECK(sameCells(conway, io::loadSnapshot(path.c_str())));
+    std::filesystem::remove(path);
+}
+
+// A tiny file claiming a huge grid is refused before the grid is allocated
+static void testHugeHeader() {
+    const std::string path = tempPath("gol-test-huge.gol");
+    auto refused = [&](uint32_t width, uint32_t height, uint32_t flags) {
+        io::SnapshotHeader header{};
+        header.width = width;
+        header.height = height;
+        header.flags = flags;
+        header.rowBytes = (width + 7) / 8;
+        header.payloadBytes = 64;
+        const uint8_t payload[64] = {};
+        if (FILE* f = std::fopen(path.c_str(), "wb")) {
+            std::fwrite(&header, sizeof(header), 1, f);
+            std::fwrite(payload, sizeof(payload), 1, f);
+            std::fclose(f);
+        }
+        try {
+            io::loadSnapshot(path.c_str());
+        }
+        catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    CHECK(refused(1u << 20, 1u << 20, io::kSnapshotPackBits));
+    CHECK(refused(1u << 15, 1u << 15, io::kSnapshotPackBits));
+    CHECK(refused(1u << 15, 1u << 15, 0));
+    std::filesystem::remove(path);
+}
+
+int main() {
+    testAutosaveGenerations();
+    testSaveSnapshot();
+    testHugeHeader();
+    return checkResult();
+}